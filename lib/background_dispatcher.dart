@@ -0,0 +1,226 @@
+// Background wakeup entrypoint for budgeted relay and queue work
+
+import 'dart:io' show Platform;
+
+import 'package:flutter/widgets.dart';
+import 'package:logging/logging.dart';
+import 'package:workmanager/workmanager.dart';
+
+import 'core/bluetooth/handshake_coordinator_factory.dart';
+import 'core/di/repository_provider_impl.dart';
+import 'core/di/service_locator.dart' show serviceRegistry;
+import 'core/messaging/mesh_relay_engine_factory.dart';
+import 'core/messaging/offline_message_queue.dart';
+import 'core/services/background_ble_delivery.dart';
+import 'core/services/background_relay_runner.dart';
+import 'core/services/security_manager.dart';
+import 'data/database/database_provider.dart';
+import 'data/database/secure_storage_vault.dart';
+import 'data/di/data_layer_service_registrar.dart';
+import 'data/repositories/contact_repository.dart';
+import 'data/repositories/message_repository.dart';
+import 'data/repositories/preferences_repository.dart';
+import 'data/repositories/user_preferences.dart';
+import 'data/services/ble_service_facade_factory.dart';
+import 'data/services/seen_message_store.dart';
+import 'domain/interfaces/i_ble_handshake_service.dart';
+import 'domain/interfaces/i_ble_service_facade.dart';
+import 'domain/interfaces/i_connection_service.dart';
+import 'domain/interfaces/i_database_provider.dart';
+import 'domain/interfaces/i_handshake_coordinator_factory.dart';
+import 'domain/interfaces/i_mesh_relay_engine_factory.dart';
+import 'domain/interfaces/i_repository_provider.dart';
+import 'domain/interfaces/i_seen_message_store.dart';
+import 'domain/interfaces/i_shared_message_queue_provider.dart';
+import 'domain/messaging/offline_message_queue_contract.dart';
+import 'domain/services/ephemeral_key_manager.dart';
+import 'domain/services/security_service_locator.dart';
+import 'domain/utils/app_logger.dart';
+
+/// Unique WorkManager name for the periodic relay wakeup.
+const String backgroundRelayTaskName = 'pak_connect.background_relay';
+
+final _logger = Logger('BackgroundDispatcher');
+
+/// Register the periodic background relay task (Android only).
+///
+/// iOS needs BGTaskScheduler identifiers in Info.plist before it can run
+/// WorkManager tasks, and desktop relays keep the foreground process alive.
+Future<void> scheduleBackgroundRelayWork() async {
+  if (!Platform.isAndroid) return;
+
+  try {
+    await Workmanager().initialize(backgroundRelayCallbackDispatcher);
+    await Workmanager().registerPeriodicTask(
+      backgroundRelayTaskName,
+      backgroundRelayTaskName,
+      frequency: const Duration(minutes: 15),
+    );
+    _logger.info('🌙 Background relay task scheduled');
+  } catch (e) {
+    _logger.warning('Failed to schedule background relay task: $e');
+  }
+}
+
+/// WorkManager isolate entrypoint.
+///
+/// Restores only [BackgroundServiceGraph] instead of `AppCore.initialize` so
+/// the OS time slice goes to queue work, not to UI-facing service startup.
+@pragma('vm:entry-point')
+void backgroundRelayCallbackDispatcher() {
+  Workmanager().executeTask((taskName, inputData) async {
+    if (taskName != backgroundRelayTaskName) return true;
+    return runBackgroundRelayWakeup();
+  });
+}
+
+/// Run one budgeted wakeup. Returns `false` only when restore failed, so the
+/// OS retries with backoff instead of treating the slice as done.
+///
+/// Skipped while the foreground app owns the queue in this process: its
+/// own flush loop is already running and holds the queue in memory.
+/// Without [deliveryHandler], queued work goes out over a
+/// [BackgroundBleDelivery] started on demand.
+Future<bool> runBackgroundRelayWakeup({
+  BackgroundWorkBudget budget = const BackgroundWorkBudget(),
+  BackgroundDeliveryHandler? deliveryHandler,
+}) async {
+  WidgetsFlutterBinding.ensureInitialized();
+  AppLogger.initialize();
+
+  if (ForegroundQueueOwnership.isHeld) {
+    _logger.info('🌙 Foreground app owns the queue - skipping wakeup');
+    return true;
+  }
+
+  BackgroundServiceGraph? graph;
+  BackgroundBleDelivery? bleDelivery;
+  try {
+    final restored = _buildBackgroundGraph();
+    graph = restored;
+    final restoreTime = await restored.restore();
+
+    if (deliveryHandler == null) {
+      final transport = _BackgroundTransport(restored);
+      bleDelivery = BackgroundBleDelivery(
+        startTransport: transport.start,
+        stopTransport: transport.stop,
+      );
+    }
+    final runner = BackgroundRelayRunner.forGraph(
+      restored,
+      deliveryHandler: deliveryHandler ?? bleDelivery!.call,
+      shouldYield: () => ForegroundQueueOwnership.isHeld,
+    );
+    await runner.runWakeup(budget: budget, restoreTime: restoreTime);
+    return true;
+  } catch (e, stackTrace) {
+    _logger.severe('❌ Background relay wakeup failed', e, stackTrace);
+    return false;
+  } finally {
+    await bleDelivery?.dispose();
+    graph?.dispose();
+  }
+}
+
+/// The stores relaying needs, built directly rather than through
+/// `setupServiceLocator`, which would register the whole data layer.
+BackgroundServiceGraph _buildBackgroundGraph() {
+  return BackgroundServiceGraph(
+    databaseProvider: DatabaseProvider(),
+    userPreferences: UserPreferences(),
+    preferencesRepository: PreferencesRepository(),
+    seenMessageStore: SeenMessageStore(),
+    repositoryProvider: RepositoryProviderImpl(
+      contactRepository: ContactRepository(),
+      messageRepository: MessageRepository(),
+    ),
+  );
+}
+
+/// What a BLE send needs (identity, Noise, BLE facade) on top of the
+/// restored graph.
+///
+/// Only the transport's own dependencies are registered: the graph's queue
+/// and stores plus the handshake and relay-engine factories. [stop] tears
+/// all of it down again, so the wakeup leaves no BLE stack running next to
+/// a foreground app and no stale registrations for the next wakeup.
+class _BackgroundTransport {
+  _BackgroundTransport(this._graph);
+
+  final BackgroundServiceGraph _graph;
+  final List<void Function()> _registrations = [];
+  IBLEServiceFacade? _facade;
+  SecurityManager? _securityManager;
+
+  Future<IConnectionService> start() async {
+    _register<ISharedMessageQueueProvider>(
+      _RestoredQueueProvider(_graph.messageQueue),
+    );
+    _register<IDatabaseProvider>(_graph.databaseProvider);
+    _register<ISeenMessageStore>(_graph.seenMessageStore);
+    final provider = _graph.repositoryProvider;
+    if (provider != null) _register<IRepositoryProvider>(provider);
+    _register<IHandshakeCoordinatorFactory>(
+      const CoreHandshakeCoordinatorFactory(),
+    );
+    _register<IMeshRelayEngineFactory>(const CoreMeshRelayEngineFactory());
+    configureBleTransportResolvers(serviceRegistry);
+
+    final securityManager = _securityManager = SecurityManager();
+    await securityManager.initialize(
+      secureStorage: SecureStorageVault.instance.asStorage(),
+    );
+    SecurityServiceLocator.configureServiceResolver(() => securityManager);
+    await EphemeralKeyManager.initialize(
+      await _graph.userPreferences.getPrivateKey(),
+    );
+
+    final facade = _facade = const DataBleServiceFacadeFactory().create();
+    await facade.initialize();
+    return facade as IConnectionService;
+  }
+
+  Future<void> stop() async {
+    final facade = _facade;
+    _facade = null;
+    try {
+      await facade?.dispose();
+    } finally {
+      _securityManager?.shutdown();
+      _securityManager = null;
+      SecurityServiceLocator.clearServiceResolver();
+      // Registered by the facade through the transport resolvers.
+      serviceRegistry.unregister<IBLEHandshakeService>();
+      for (final unregister in _registrations.reversed) {
+        unregister();
+      }
+      _registrations.clear();
+    }
+  }
+
+  void _register<T extends Object>(T instance) {
+    if (serviceRegistry.isRegistered<T>()) return;
+    serviceRegistry.registerSingleton<T>(instance);
+    _registrations.add(() => serviceRegistry.unregister<T>());
+  }
+}
+
+/// Hands the BLE stack the queue restored for this wakeup.
+class _RestoredQueueProvider implements ISharedMessageQueueProvider {
+  _RestoredQueueProvider(this._queue);
+
+  final OfflineMessageQueue _queue;
+
+  @override
+  bool get isInitialized => true;
+
+  @override
+  bool get isInitializing => false;
+
+  @override
+  Future<void> initialize() async {}
+
+  @override
+  OfflineMessageQueueContract get messageQueue => _queue;
+}
@@ -2,6 +2,8 @@
 
 import 'dart:async';
 import 'package:flutter/foundation.dart';
+import 'package:flutter/widgets.dart'
+    show AppLifecycleListener, AppLifecycleState, WidgetsBinding;
 import 'package:logging/logging.dart';
 
 import 'package:pak_connect/domain/services/adaptive_power_manager.dart';
@@ -13,7 +15,11 @@ import 'messaging/offline_message_queue.dart';
 import 'messaging/offline_queue_facade.dart';
 import 'messaging/mesh_relay_engine.dart';
 import 'package:pak_connect/domain/services/performance_monitor.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
+import 'package:pak_connect/domain/services/database_telemetry.dart';
 import 'security/contact_recognizer.dart';
+import 'services/background_relay_runner.dart' show ForegroundQueueOwnership;
 import 'services/message_queue_repository.dart';
 import 'services/queue_persistence_manager.dart';
 import 'services/security_manager.dart';
@@ -29,6 +35,7 @@ import '../domain/services/archive_management_service.dart';
 import '../domain/services/archive_search_service.dart';
 import '../domain/services/mesh_networking_service.dart';
 import '../domain/services/auto_archive_scheduler.dart';
+import '../domain/services/database_maintenance_scheduler.dart';
 import '../domain/services/notification_service.dart';
 import '../domain/services/notification_handler_factory.dart';
 import '../domain/services/hint_cache_manager.dart';
@@ -36,6 +43,7 @@ import '../domain/services/hint_scanner_service.dart';
 import '../domain/entities/message.dart';
 import '../domain/entities/preference_keys.dart';
 import '../domain/interfaces/i_archive_repository.dart';
+import '../domain/interfaces/i_ble_service_facade.dart';
 import '../domain/interfaces/i_chats_repository.dart';
 import '../domain/interfaces/i_contact_repository.dart';
 import '../domain/interfaces/i_database_provider.dart';
@@ -48,6 +56,7 @@ import '../domain/interfaces/i_user_preferences.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/services/message_router.dart';
 import 'di/app_services.dart';
+import 'di/initialization_graph.dart';
 import 'di/service_locator.dart';
 import '../domain/interfaces/i_connection_service.dart';
 
@@ -64,17 +73,20 @@ class AppCore {
   static AppCore? _instance;
 
   // Core components
-  late final BurstScanningController burstScanningController;
+  BurstScanningController? _burstScanningController;
   late final OfflineQueueFacade messageQueueFacade;
   late final OfflineMessageQueue messageQueue;
   late final ContactManagementService contactService;
   late final ChatManagementService chatService;
   late final ArchiveManagementService archiveManagementService;
   late final ArchiveSearchService archiveSearchService;
-  late final PerformanceMonitor performanceMonitor;
+  PerformanceMonitor? _performanceMonitor;
   // 🔧 REMOVED: BLEStateManager - BLEService creates its own instance
   // late final BLEStateManager bleStateManager;
-  late final BatteryOptimizer batteryOptimizer;
+  late final BatteryOptimizer batteryOptimizer = BatteryOptimizer();
+  DatabaseMaintenanceScheduler? _databaseMaintenance;
+  AppLifecycleListener? _maintenanceLifecycleListener;
+  IBLEServiceFacade? _bleFacade;
   late final IConnectionService bleService;
   late final MeshNetworkingService meshNetworkingService;
 
@@ -99,6 +111,9 @@ class AppCore {
   final Set<void Function(AppStatus)> _statusListeners = {};
   AppServices? _services;
   AppBootstrapServices? _bootstrapServices;
+  InitializationGraph? _initGraph;
+  Future<void>? _deferredInitialization;
+  Future<void>? _connectivityInitialization;
   @visibleForTesting
   static Future<void> Function()? initializationOverride;
   AppCore._();
@@ -123,6 +138,14 @@ class AppCore {
   /// Get initialization status
   bool get isInitialized => _isInitialized;
 
+  /// Created on first access; [dispose] only tears down what was created.
+  BurstScanningController get burstScanningController =>
+      _burstScanningController ??= BurstScanningController();
+
+  /// Created on first access; [dispose] only tears down what was created.
+  PerformanceMonitor get performanceMonitor =>
+      _performanceMonitor ??= PerformanceMonitor();
+
   /// Typed composition root snapshot for consumers moving off service locators.
   AppServices get services {
     final services = _services;
@@ -140,6 +163,47 @@ class AppCore {
       _initializationCompleter != null &&
       !_initializationCompleter!.isCompleted;
 
+  /// Per-node initialization timings (eager and, once run, deferred nodes).
+  Map<String, dynamic> get initializationTimings =>
+      _initGraph?.exportTimings() ?? const <String, dynamic>{};
+
+  /// Start deferred services (monitoring, power optimization, auto-archive,
+  /// archive search). Call after the first frame; repeated calls share one run.
+  Future<void> startDeferredInitialization() {
+    final graph = _initGraph;
+    if (!_isInitialized || graph == null) return Future<void>.value();
+    return _deferredInitialization ??= graph.runDeferred().then((_) {
+      _logger.info(
+        '🧩 Deferred services ready: ${graph.namesForTier(InitTier.deferred).where(graph.isComplete).join(', ')}',
+      );
+    });
+  }
+
+  /// Completes once BLE + mesh are up ([AppStatus.running]). READY does not
+  /// wait for them, so the chat list renders while the radio starts.
+  Future<void> get connectivityReady =>
+      _connectivityInitialization ?? Future<void>.value();
+
+  /// Bring up a deferred or lazy service early (e.g. archive search opened
+  /// before the deferred pass reached it).
+  Future<void> ensureServiceReady(String nodeName) {
+    final graph = _initGraph;
+    if (graph == null) {
+      return Future<void>.error(
+        AppCoreException('App core not initialized'),
+      );
+    }
+    return graph.ensure(nodeName);
+  }
+
+  /// Write the hot state snapshot now (app paused or about to exit) so the
+  /// next cold start restores from it instead of replaying the database.
+  Future<void> persistHotStateSnapshot() {
+    final snapshotStore = _bootstrapServices?.hotStateSnapshotStore;
+    if (!_isInitialized || snapshotStore == null) return Future<void>.value();
+    return snapshotStore.flush();
+  }
+
   /// Stream of app status changes
   Stream<AppStatus> get statusStream {
     _statusStream ??= Stream<AppStatus>.multi((controller) {
@@ -211,98 +275,24 @@ class AppCore {
       _logger.info('✅ DI container setup complete');
       if (_shouldAbortInitialization('dependency injection setup')) return;
 
-      // Load kill switches before bringing up subsystems.
-      final prefsRepo = _bootstrap.preferencesRepository;
-      await KillSwitches.load(
-        getBool: (key, {defaultValue = false}) =>
-            prefsRepo.getBool(key, defaultValue: defaultValue),
-      );
-      if (_shouldAbortInitialization('kill switch load')) return;
-
-      // Initialize repositories first
-      _logger.info('🗄️ Initializing repositories...');
-      final repoStart = DateTime.now();
-      await _initializeRepositories();
-      _logger.info(
-        '✅ Repositories initialized in ${DateTime.now().difference(repoStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('repository initialization')) return;
-
-      // Initialize seen message store after database setup
-      _logger.info('👀 Initializing SeenMessageStore...');
-      final seenMessageStore = _bootstrap.seenMessageStore;
-      await seenMessageStore.initialize();
-      MeshRelayEngine.configureDependencyResolvers(
-        seenMessageStoreResolver: () => seenMessageStore,
-      );
-      _logger.info('✅ SeenMessageStore initialized');
-      if (_shouldAbortInitialization('seen message store initialization')) {
-        return;
-      }
-
-      // 🔧 FIX P0: Initialize message queue FIRST before any BLE components can access it
-      _logger.info(
-        '📬 Initializing message queue (PRIORITY: before BLE/core services)...',
-      );
-      final queueStart = DateTime.now();
-      await _initializeMessageQueue();
-      _logger.info(
-        '✅ Message queue initialized in ${DateTime.now().difference(queueStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('message queue initialization')) return;
-
-      // Initialize monitoring
-      _logger.info('📊 Initializing monitoring...');
-      final monitorStart = DateTime.now();
-      await _initializeMonitoring();
-      _logger.info(
-        '✅ Monitoring initialized in ${DateTime.now().difference(monitorStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('monitoring initialization')) return;
-
-      // Initialize core services (may trigger BLEService initialization via providers)
-      _logger.info('🔧 Initializing core services...');
-      final servicesStart = DateTime.now();
-      await _initializeCoreServices();
-      _logger.info(
-        '✅ Core services initialized in ${DateTime.now().difference(servicesStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('core service initialization')) return;
-
-      // Initialize BLE integration
-      _logger.info('📡 Initializing BLE integration...');
-      final bleStart = DateTime.now();
-      await _initializeBLEIntegration();
-      _logger.info(
-        '✅ BLE integration initialized in ${DateTime.now().difference(bleStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('BLE integration')) return;
-
-      // Initialize enhanced features (battery, burst scanning)
-      _logger.info('⚡ Initializing enhanced features...');
-      final featuresStart = DateTime.now();
-      await _initializeEnhancedFeatures();
+      // Bring up the service graph. Independent nodes run concurrently; only
+      // eager nodes gate READY. BLE + mesh start right after READY, deferred
+      // nodes after the first frame.
+      final graph = _buildInitializationGraph();
+      _initGraph = graph;
+      _logger.info('🧩 Running eager initialization graph...');
+      await graph.runEager();
+      if (_shouldAbortInitialization('service graph initialization')) return;
       _logger.info(
-        '✅ Enhanced features initialized in ${DateTime.now().difference(featuresStart).inMilliseconds}ms',
+        '✅ Eager services ready: ${graph.timings.map((t) => '${t.name}=${t.duration.inMilliseconds}ms').join(', ')}',
       );
-      if (_shouldAbortInitialization('enhanced feature initialization')) {
-        return;
-      }
-
-      // Start integrated systems
-      _logger.info('🔄 Starting integrated systems...');
-      final systemsStart = DateTime.now();
-      await _startIntegratedSystems();
-      _logger.info(
-        '✅ Integrated systems started in ${DateTime.now().difference(systemsStart).inMilliseconds}ms',
-      );
-      if (_shouldAbortInitialization('integrated system startup')) return;
 
       _services = _buildAppServices();
       publishAppServices(_services!);
 
       _isInitialized = true;
       _initializationTime = DateTime.now();
+      _bootstrap.hotStateSnapshotStore?.startPeriodicFlush();
 
       // Emit ready status
       _emitStatus(AppStatus.ready);
@@ -313,6 +303,7 @@ class AppCore {
         '🎉 Application core initialized successfully in ${totalTime.inMilliseconds}ms',
       );
       _initializationCompleter?.complete();
+      _startConnectivity(graph);
     } catch (e, stackTrace) {
       _logger.severe('❌ Failed to initialize app core: $e');
       _logger.severe('Stack trace: $stackTrace');
@@ -332,6 +323,137 @@ class AppCore {
     }
   }
 
+  /// Bring up BLE + mesh without waiting for a frame and report RUNNING once
+  /// they are ready.
+  void _startConnectivity(InitializationGraph graph) {
+    final connectivity = graph
+        .ensure('bleIntegration')
+        .then(
+          (_) {
+            if (_disposeRequested) return;
+            _emitStatus(AppStatus.running);
+            _logger.info('🎯 Status changed to RUNNING (BLE + mesh ready)');
+          },
+          onError: (Object e, StackTrace stackTrace) {
+            if (_disposeRequested) return;
+            _logger.severe('❌ BLE integration failed: $e', e, stackTrace);
+            _emitStatus(AppStatus.error);
+            throw AppCoreException('BLE integration failed: $e');
+          },
+        );
+    connectivity.ignore();
+    _connectivityInitialization = connectivity;
+  }
+
+  /// Declare initialization nodes and their dependencies.
+  ///
+  /// Chat list and identity paths are eager. The BLE facade and mesh service
+  /// are only constructed before READY; starting them is a lazy node run
+  /// right after READY. Monitoring, power optimization, auto-archive and
+  /// archive search indexing are deferred past first frame.
+  InitializationGraph _buildInitializationGraph() {
+    return InitializationGraph(shouldAbort: () => _disposeRequested)
+      ..addAll([
+        InitNode(name: 'killSwitches', run: _loadKillSwitches),
+        InitNode(name: 'repositories', run: _initializeRepositories),
+        InitNode(
+          name: 'seenMessageStore',
+          dependsOn: const ['repositories'],
+          run: _initializeSeenMessageStore,
+        ),
+        // 🔧 FIX P0: queue must exist before any BLE component can access it
+        InitNode(
+          name: 'messageQueue',
+          dependsOn: const ['repositories', 'killSwitches'],
+          run: _initializeMessageQueue,
+        ),
+        InitNode(
+          name: 'notifications',
+          dependsOn: const ['repositories'],
+          run: _initializeNotifications,
+        ),
+        InitNode(
+          name: 'identity',
+          dependsOn: const ['repositories'],
+          run: _initializeIdentity,
+        ),
+        InitNode(
+          name: 'contacts',
+          dependsOn: const ['repositories'],
+          run: _initializeContactServices,
+        ),
+        InitNode(
+          name: 'chats',
+          dependsOn: const ['repositories'],
+          run: _initializeChatServices,
+        ),
+        InitNode(
+          name: 'transport',
+          dependsOn: const ['messageQueue', 'identity', 'chats'],
+          run: _createTransport,
+        ),
+        InitNode(
+          name: 'bleIntegration',
+          tier: InitTier.lazy,
+          dependsOn: const [
+            'killSwitches',
+            'seenMessageStore',
+            'notifications',
+            'contacts',
+            'transport',
+          ],
+          run: _initializeBLEIntegration,
+        ),
+        InitNode(
+          name: 'monitoring',
+          tier: InitTier.deferred,
+          run: _initializeMonitoring,
+        ),
+        InitNode(
+          name: 'powerOptimization',
+          tier: InitTier.deferred,
+          run: _initializeEnhancedFeatures,
+        ),
+        InitNode(
+          name: 'autoArchive',
+          tier: InitTier.deferred,
+          dependsOn: const ['chats'],
+          run: _startAutoArchive,
+        ),
+        InitNode(
+          name: 'dbMaintenance',
+          tier: InitTier.deferred,
+          dependsOn: const ['powerOptimization'],
+          run: _startDatabaseMaintenance,
+        ),
+        InitNode(
+          name: 'archiveSearch',
+          tier: InitTier.deferred,
+          dependsOn: const ['chats'],
+          run: () => archiveSearchService.initialize(),
+        ),
+      ]);
+  }
+
+  /// Load kill switches before bringing up subsystems.
+  Future<void> _loadKillSwitches() async {
+    final prefsRepo = _bootstrap.preferencesRepository;
+    await KillSwitches.load(
+      getBool: (key, {defaultValue = false}) =>
+          prefsRepo.getBool(key, defaultValue: defaultValue),
+    );
+  }
+
+  /// Initialize seen message store after database setup
+  Future<void> _initializeSeenMessageStore() async {
+    final seenMessageStore = _bootstrap.seenMessageStore;
+    await seenMessageStore.initialize();
+    MeshRelayEngine.configureDependencyResolvers(
+      seenMessageStoreResolver: () => seenMessageStore,
+    );
+    _logger.info('✅ SeenMessageStore initialized');
+  }
+
   /// Setup comprehensive logging
   void _setupLogging() {
     AppLogger.initialize();
@@ -390,22 +512,20 @@ class AppCore {
       repositoryProviderResolver: () => repositoryProvider,
     );
 
-    // Initialize async repository components
-    await userPreferences.getOrCreateKeyPair();
-    await archiveRepository.initialize();
-
     _logger.info('Repositories initialized');
   }
 
   /// Initialize monitoring systems
   Future<void> _initializeMonitoring() async {
-    performanceMonitor = PerformanceMonitor();
     await performanceMonitor.initialize();
     // Event-driven mode: disable periodic sampling, take initial snapshot.
     performanceMonitor.startMonitoring(enablePeriodic: false);
     performanceMonitor.collectSnapshot();
     _logger.info('Performance monitor initialized (event-driven)');
 
+    await MeshMetricsHistory.instance.initialize();
+    await DatabaseTelemetry.instance.initialize();
+
     // Initialize adaptive encryption strategy (FIX-013)
     // This checks performance metrics and decides whether to use isolate for encryption
     final adaptiveStrategy = AdaptiveEncryptionStrategy();
@@ -415,13 +535,12 @@ class AppCore {
     _logger.info('Monitoring systems initialized');
   }
 
-  /// Initialize core services
-  Future<void> _initializeCoreServices() async {
-    // Initialize notification service with dependency injection
-    // Platform-specific handler selection based on user preference:
-    // - Android: BackgroundNotificationHandlerImpl if enabled in settings
-    // - iOS/Windows/Linux/macOS: ForegroundNotificationHandler (safe default)
-
+  /// Initialize notification service with dependency injection
+  ///
+  /// Platform-specific handler selection based on user preference:
+  /// - Android: BackgroundNotificationHandlerImpl if enabled in settings
+  /// - iOS/Windows/Linux/macOS: ForegroundNotificationHandler (safe default)
+  Future<void> _initializeNotifications() async {
     // Check user preference for background notifications (Android only)
     final prefs = preferencesRepository;
     bool backgroundEnabled = PreferenceDefaults.backgroundNotifications;
@@ -452,11 +571,17 @@ class AppCore {
     _logger.info(
       'Notification service initialized with ${notificationHandler.runtimeType}',
     );
+  }
+
+  /// Initialize identity: keypair, Noise security manager, session ephemeral
+  /// key and topology node ID.
+  Future<void> _initializeIdentity() async {
+    await userPreferences.getOrCreateKeyPair();
 
     // Initialize SecurityManager with Noise Protocol
     _logger.info('🔒 Initializing SecurityManager with Noise Protocol...');
     final securityManager = SecurityManager();
-    await securityManager.initialize();
+    await securityManager.initialize(secureStorage: _bootstrap.secureStorage);
     securityService = securityManager;
     _logger.info('✅ SecurityManager initialized successfully');
 
@@ -486,8 +611,10 @@ class AppCore {
       // Non-critical for TopologyManager, but critical for ephemeral keys
       rethrow;
     }
+  }
 
-    // Initialize contact management (constructor-first composition)
+  /// Initialize contact management (constructor-first composition)
+  Future<void> _initializeContactServices() async {
     contactService = ContactManagementService.withDependencies(
       contactRepository: contactRepository,
       messageRepository: messageRepository,
@@ -499,8 +626,15 @@ class AppCore {
     );
     ContactRecognizer.configureContactRepository(contactRepository);
     _logger.info('Contact management service initialized');
+  }
+
+  /// Initialize archive and chat management (constructor-first composition)
+  ///
+  /// Archive search indexing is not part of this node; it runs in the
+  /// deferred `archiveSearch` node or on first search.
+  Future<void> _initializeChatServices() async {
+    await archiveRepository.initialize();
 
-    // Initialize archive services (constructor-first composition)
     archiveManagementService = ArchiveManagementService.withDependencies(
       archiveRepository: archiveRepository,
     );
@@ -511,7 +645,6 @@ class AppCore {
     );
     ArchiveSearchService.setInstance(archiveSearchService);
 
-    // Initialize chat management (constructor-first composition)
     chatService = ChatManagementService.withDependencies(
       chatsRepository: chatsRepository,
       messageRepository: messageRepository,
@@ -524,87 +657,93 @@ class AppCore {
     _logger.info('Chat management service initialized');
 
     AutoArchiveScheduler.configure(
-      preferencesRepository: prefs,
+      preferencesRepository: preferencesRepository,
       chatsRepository: chatsRepository,
       archiveManagementService: archiveManagementService,
     );
+  }
+
+  /// Construct the BLE facade and mesh service and publish them, without
+  /// touching the radio. Providers can resolve them at READY and wait on
+  /// their own initialization futures.
+  Future<void> _createTransport() async {
+    final bleFacade =
+        _bootstrap.bleServiceFacade ??
+        _bootstrap.bleServiceFacadeFactory.create();
+    _bleFacade = bleFacade;
+    final connectionService = bleFacade as IConnectionService;
+    MeshRelayEngine.configureDependencyResolvers(
+      persistentIdResolver: () => connectionService.myPersistentId,
+    );
+    sharedMessageQueueProvider = _bootstrap.sharedMessageQueueProvider;
+    final sharedQueueProvider = sharedMessageQueueProvider;
+    MessageRouter.configureQueueFactories(
+      standaloneQueueFactory: () => OfflineMessageQueue(),
+      initializedQueueFactory: () async {
+        final queue = OfflineMessageQueue();
+        await queue.initialize();
+        return queue;
+      },
+    );
+    MessageRouter.configureDependencyResolvers(
+      preferencesRepositoryResolver: () => preferencesRepository,
+      userPreferencesResolver: () => userPreferences,
+      sharedQueueProviderResolver: () => sharedQueueProvider,
+    );
 
-    _logger.info('Core services initialized');
+    bleService = connectionService;
+    meshNetworkingService = MeshNetworkingService(
+      bleService: bleService,
+      messageHandler: bleFacade.meshMessageHandler,
+      chatManagementService: chatService,
+      repositoryProvider: repositoryProvider,
+      sharedQueueProvider: sharedQueueProvider,
+      relayEngineFactory: (queue, spam) =>
+          _bootstrap.meshRelayEngineFactory.create(
+            messageQueue: queue,
+            spamPrevention: spam,
+            forceFloodMode: false,
+          ),
+      eventBus: _bootstrap.eventBus,
+    );
+
+    registerInitializedServices(
+      securityService: securityService,
+      connectionService: connectionService,
+      meshNetworkingService: meshNetworkingService,
+      meshRelayCoordinator: meshNetworkingService.relayCoordinator,
+      meshQueueSyncCoordinator: meshNetworkingService.queueCoordinator,
+      meshHealthMonitor: meshNetworkingService.healthMonitor,
+    );
+    _logger.info('📦 BLE + mesh services published to runtime composition');
   }
 
   /// Initialize BLE integration
-  /// Phase 1 Part C: Initialize BLEService and MeshNetworkingService,
-  /// then register in DI container for access via providers
+  /// Phase 1 Part C: Start the BLE facade, message router and
+  /// MeshNetworkingService built by [_createTransport]
   Future<void> _initializeBLEIntegration() async {
     _logger.info('📡 Initializing BLE + mesh stack via AppCore...');
 
     try {
-      final bleFacade =
-          _bootstrap.bleServiceFacade ?? _bootstrap.bleServiceFacadeFactory.create();
-      final connectionService = bleFacade as IConnectionService;
-      MeshRelayEngine.configureDependencyResolvers(
-        persistentIdResolver: () => connectionService.myPersistentId,
-      );
-      sharedMessageQueueProvider = _bootstrap.sharedMessageQueueProvider;
-      final sharedQueueProvider = sharedMessageQueueProvider;
-      MessageRouter.configureQueueFactories(
-        standaloneQueueFactory: () => OfflineMessageQueue(),
-        initializedQueueFactory: () async {
-          final queue = OfflineMessageQueue();
-          await queue.initialize();
-          return queue;
-        },
-      );
-      MessageRouter.configureDependencyResolvers(
-        preferencesRepositoryResolver: () => preferencesRepository,
-        userPreferencesResolver: () => userPreferences,
-        sharedQueueProviderResolver: () => sharedQueueProvider,
-      );
+      final bleFacade = _bleFacade!;
       if (!bleFacade.isInitialized) {
         await bleFacade.initialize();
         await MessageRouter.initialize(
-          connectionService,
+          bleService,
           offlineQueue: messageQueue,
           preferencesRepository: preferencesRepository,
-          sharedQueueProvider: sharedQueueProvider,
+          sharedQueueProvider: sharedMessageQueueProvider,
         );
       } else {
         _logger.fine('ℹ️ BLE facade already initialized; reusing instance');
       }
-
-      bleService = connectionService;
       _logger.info('✅ BLE facade initialized via AppCore');
 
-      final messageHandlerFacade = bleFacade.meshMessageHandler;
-
-      meshNetworkingService = MeshNetworkingService(
-        bleService: bleService,
-        messageHandler: messageHandlerFacade,
-        chatManagementService: chatService,
-        repositoryProvider: repositoryProvider,
-        sharedQueueProvider: sharedQueueProvider,
-        relayEngineFactory: (queue, spam) =>
-            _bootstrap.meshRelayEngineFactory.create(
-              messageQueue: queue,
-              spamPrevention: spam,
-              forceFloodMode: false,
-            ),
-      );
       await meshNetworkingService.initialize();
       _logger.info('🌐 MeshNetworkingService initialized successfully');
 
       // Phase 2: Wire change_log sync DB callbacks
       _wireChangeLogSync(meshNetworkingService);
-
-      registerInitializedServices(
-        securityService: securityService,
-        connectionService: connectionService,
-        meshNetworkingService: meshNetworkingService,
-        meshRelayCoordinator: meshNetworkingService.relayCoordinator,
-        meshQueueSyncCoordinator: meshNetworkingService.queueCoordinator,
-        meshHealthMonitor: meshNetworkingService.healthMonitor,
-      );
-      _logger.info('📦 BLE + mesh services published to runtime composition');
     } catch (e, stackTrace) {
       _logger.severe('❌ Failed to initialize BLE integration: $e');
       _logger.severe('Stack trace: $stackTrace');
@@ -793,6 +932,8 @@ class AppCore {
       onConnectivityCheck: _checkConnectivity,
     );
     messageQueue = messageQueueFacade.queue;
+    // Background wakeups in this process stand down while we own the queue.
+    ForegroundQueueOwnership.claim();
 
     final queueStats = messageQueue.getStatistics();
     final totalQueued =
@@ -804,60 +945,50 @@ class AppCore {
     );
   }
 
-  /// Initialize enhanced features (battery, scanning)
+  /// Initialize power optimization (battery monitoring)
+  ///
+  /// [burstScanningController] is created on first access and initialized
+  /// with the BLE service by its provider.
   Future<void> _initializeEnhancedFeatures() async {
-    // Initialize battery optimizer for power management
     _logger.info('🔋 Initializing battery optimizer...');
-    batteryOptimizer = BatteryOptimizer();
     await batteryOptimizer.initialize(
       onBatteryUpdate: (info) {
         _logger.info('🔋 Battery: ${info.level}% (${info.powerMode.name})');
+        _databaseMaintenance?.onConditionsChanged();
       },
       onPowerModeChanged: (mode) {
         _logger.info('🔋 Power mode changed to: ${mode.name}');
       },
     );
     _logger.info('✅ Battery optimizer initialized');
+  }
 
-    // Initialize burst scanning controller (replaces direct power manager)
-    burstScanningController = BurstScanningController();
-
-    // The controller will be fully initialized in _startIntegratedSystems()
-    _logger.info(
-      'Burst scanning controller created - will initialize with BLE service',
+  /// Start periodic incremental vacuum / optimize (deferred past first
+  /// frame); lifecycle and battery updates re-check the idle-and-charging
+  /// gate for the one-time full VACUUM
+  Future<void> _startDatabaseMaintenance() async {
+    if (_disposeRequested) return;
+
+    _databaseMaintenance = DatabaseMaintenanceScheduler(
+      databaseProvider: _bootstrap.databaseProvider,
+      // The one-time full VACUUM rewrites the whole file.
+      canRunHeavyWork: () =>
+          batteryOptimizer.getCurrentInfo().isCharging &&
+          WidgetsBinding.instance.lifecycleState == AppLifecycleState.paused,
+    )..start();
+    _maintenanceLifecycleListener = AppLifecycleListener(
+      onStateChange: (_) => _databaseMaintenance?.onConditionsChanged(),
     );
-
-    _logger.info('Enhanced features initialized');
+    _logger.info('✅ Database maintenance scheduled');
   }
 
-  /// Start integrated systems
-  Future<void> _startIntegratedSystems() async {
+  /// Start auto-archive scheduler (deferred past first frame)
+  Future<void> _startAutoArchive() async {
     if (_disposeRequested) {
-      _logger.info('Skipping integrated system startup during disposal');
+      _logger.info('Skipping auto-archive startup during disposal');
       return;
     }
 
-    _logger.info('Starting burst scanning integration...');
-
-    // Initialize burst scanning controller early to ensure it's ready
-    // This triggers the provider initialization during app startup rather than on first UI access
-    try {
-      _logger.info('🔧 Pre-initializing burst scanning controller...');
-      // Avoid timer-based startup delays here. They leak into widget tests and
-      // provide no useful ordering guarantee beyond yielding back to the loop.
-      await Future<void>.value();
-      if (_disposeRequested) {
-        _logger.info(
-          'Skipping burst scanning pre-initialization during disposal',
-        );
-        return;
-      }
-      _logger.info('✅ Burst scanning will initialize on provider access');
-    } catch (e) {
-      _logger.warning('⚠️ Burst scanning pre-initialization note: $e');
-    }
-
-    // Start auto-archive scheduler
     _logger.info('🗄️ Starting auto-archive scheduler...');
     try {
       await AutoArchiveScheduler.start();
@@ -871,8 +1002,6 @@ class AppCore {
       _logger.warning('⚠️ Auto-archive scheduler failed to start: $e');
       // Non-critical, continue initialization
     }
-
-    _logger.info('Integrated systems started');
   }
 
   AppServices _buildAppServices() {
@@ -1036,6 +1165,7 @@ class AppCore {
       performance: performanceMetrics,
       replayProtection: replayStats,
       uptime: DateTime.now().difference(_getInitTime()),
+      eventBus: _bootstrap.eventBus?.stats ?? const {},
     );
   }
 
@@ -1074,6 +1204,7 @@ class AppCore {
   void dispose() {
     final hadStarted = _isInitialized || _initializationCompleter != null;
     _disposeRequested = true;
+    _initGraph?.cancel();
 
     try {
       if (hadStarted) {
@@ -1082,7 +1213,8 @@ class AppCore {
 
       // Safe disposal with null checks
       try {
-        burstScanningController.dispose();
+        _burstScanningController?.dispose();
+        _burstScanningController = null;
       } catch (e) {
         _logger.warning('Error disposing burst scanning controller: $e');
       }
@@ -1093,6 +1225,8 @@ class AppCore {
         _logger.warning('Error disposing chat service: $e');
       }
 
+      ForegroundQueueOwnership.release();
+
       try {
         messageQueueFacade.dispose();
       } catch (e) {
@@ -1100,11 +1234,20 @@ class AppCore {
       }
 
       try {
-        performanceMonitor.dispose();
+        _performanceMonitor?.dispose();
+        _performanceMonitor = null;
       } catch (e) {
         _logger.warning('Error disposing performance monitor: $e');
       }
 
+      unawaited(MeshMetricsHistory.instance.flush());
+      unawaited(DatabaseTelemetry.instance.flush());
+
+      _maintenanceLifecycleListener?.dispose();
+      _maintenanceLifecycleListener = null;
+      _databaseMaintenance?.stop();
+      _databaseMaintenance = null;
+
       try {
         AutoArchiveScheduler.stop();
         AutoArchiveScheduler.clearConfiguration();
@@ -1129,6 +1272,13 @@ class AppCore {
       ArchiveSearchService.clearArchiveRepositoryResolver();
       ChatManagementService.clearDependencyResolvers();
       clearPublishedAppServices();
+      final snapshotStore = _bootstrapServices?.hotStateSnapshotStore;
+      if (snapshotStore != null) {
+        snapshotStore.dispose();
+        if (_isInitialized) {
+          unawaited(snapshotStore.flush());
+        }
+      }
       _bootstrapServices = null;
       _services = null;
 
@@ -1141,6 +1291,10 @@ class AppCore {
 
       _statusListeners.clear();
       _services = null;
+      _initGraph = null;
+      _deferredInitialization = null;
+      _connectivityInitialization = null;
+      _bleFacade = null;
       _initializationCompleter = null;
       _initializationTime = null;
       _isInitialized = false;
@@ -1170,12 +1324,16 @@ class AppStatistics {
   final ReplayProtectionStats replayProtection;
   final Duration uptime;
 
+  /// Per-channel counters of the app-level event bus
+  final Map<String, EventChannelStats> eventBus;
+
   const AppStatistics({
     required this.powerManagement,
     required this.messageQueue,
     required this.performance,
     required this.replayProtection,
     required this.uptime,
+    this.eventBus = const {},
   });
 
   /// Get overall app health score (0.0 - 1.0)
@@ -10,6 +10,9 @@ import 'package:pak_connect/core/security/noise/noise_encryption_service.dart';
 import 'package:pak_connect/core/security/noise/models/noise_models.dart';
 import 'package:pak_connect/core/security/noise/noise_session.dart';
 import 'package:pak_connect/domain/routing/topology_manager.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'handshake_timeout_manager.dart';
 import 'kk_pattern_tracker.dart';
@@ -40,6 +43,7 @@ class HandshakeCoordinator implements IHandshakeCoordinator {
 
   // State management
   ConnectionPhase _phase = ConnectionPhase.bleConnected;
+  DateTime? _handshakeStartedAt;
   final Set<void Function(ConnectionPhase)> _phaseListeners = {};
   @override
   Stream<ConnectionPhase> get phaseStream =>
@@ -197,6 +201,7 @@ class HandshakeCoordinator implements IHandshakeCoordinator {
       _logger.warning('⚠️ Handshake already in progress or complete');
       return;
     }
+    _handshakeStartedAt = DateTime.now();
 
     // Notify: Handshake starting (pause health checks)
     onHandshakeStateChanged?.call(true);
@@ -368,6 +373,7 @@ class HandshakeCoordinator implements IHandshakeCoordinator {
     final message = ProtocolMessage.identity(
       publicKey: _myEphemeralId, // ← Ephemeral ID (privacy-preserving)
       displayName: _myDisplayName,
+      capabilities: PeerCapabilities.local,
     );
 
     await _sendWithGuard(message, 'identity');
@@ -389,6 +395,11 @@ class HandshakeCoordinator implements IHandshakeCoordinator {
       ephemeralId: message.identityPublicKey!,
       displayName: message.identityDisplayName,
     );
+    // Wire features are picked per peer from what it advertised here
+    PeerCapabilityRegistry.instance.record(
+      message.identityPublicKey!,
+      message.identityCapabilities,
+    );
 
     // NOTE: Brute-force lockout removed here. The ephemeral ID is
     // unauthenticated at this stage, so an attacker could spoof a
@@ -412,6 +423,7 @@ class HandshakeCoordinator implements IHandshakeCoordinator {
       final response = ProtocolMessage.identity(
         publicKey: _myEphemeralId, // ← Send ephemeral ID
         displayName: _myDisplayName,
+        capabilities: PeerCapabilities.local,
       );
       await _sendWithGuard(response, 'identity (ack)');
       return;
@@ -212,6 +212,13 @@ class _HandshakeCoordinatorPhase2Helper {
 
     _owner._phase = ConnectionPhase.complete;
     _owner._emitPhase(_owner._phase);
+    final startedAt = _owner._handshakeStartedAt;
+    if (startedAt != null) {
+      MeshMetricsHistory.instance.record(
+        MeshMetricsHistory.handshakeLatencyMs,
+        DateTime.now().difference(startedAt).inMilliseconds.toDouble(),
+      );
+    }
     _owner.onHandshakeStateChanged?.call(false);
 
     if (_owner._peerState.theirNoisePublicKey != null) {
@@ -267,6 +274,7 @@ class _HandshakeCoordinatorPhase2Helper {
 
     _owner._phase = ConnectionPhase.failed;
     _owner._emitPhase(_owner._phase);
+    MeshMetricsHistory.instance.increment(MeshMetricsHistory.handshakeFailures);
     _owner.onHandshakeStateChanged?.call(false);
   }
 
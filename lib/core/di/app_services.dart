@@ -1,3 +1,4 @@
+import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:pak_connect/domain/interfaces/i_archive_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_chat_list_coordinator_factory.dart';
@@ -10,6 +11,7 @@ import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_export_service.dart';
 import 'package:pak_connect/domain/interfaces/i_group_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade_factory.dart';
+import 'package:pak_connect/domain/interfaces/i_hot_state_snapshot_store.dart';
 import 'package:pak_connect/domain/interfaces/i_import_service.dart';
 import 'package:pak_connect/domain/interfaces/i_intro_hint_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_message_repository.dart';
@@ -28,6 +30,7 @@ import 'package:pak_connect/domain/services/contact_management_service.dart';
 import 'package:pak_connect/domain/services/mesh/mesh_queue_sync_coordinator.dart';
 import 'package:pak_connect/domain/services/mesh/mesh_network_health_monitor.dart';
 import 'package:pak_connect/domain/services/mesh/mesh_relay_coordinator.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 
 /// Typed bootstrap dependency bundle resolved from the shared service registry.
 ///
@@ -55,6 +58,9 @@ class AppBootstrapServices {
     this.homeScreenFacadeFactory,
     this.chatConnectionManagerFactory,
     this.chatListCoordinatorFactory,
+    this.hotStateSnapshotStore,
+    this.secureStorage,
+    this.eventBus,
   });
 
   final IContactRepository contactRepository;
@@ -77,6 +83,11 @@ class AppBootstrapServices {
   final IHomeScreenFacadeFactory? homeScreenFacadeFactory;
   final IChatConnectionManagerFactory? chatConnectionManagerFactory;
   final IChatListCoordinatorFactory? chatListCoordinatorFactory;
+  final IHotStateSnapshotStore? hotStateSnapshotStore;
+  final FlutterSecureStorage? secureStorage;
+
+  /// App-level event bus shared by the BLE facade and chat list managers
+  final TypedEventBus? eventBus;
 
   AppServices buildRuntimeSnapshot({
     required IConnectionService connectionService,
@@ -0,0 +1,250 @@
+import 'dart:async';
+
+import 'package:logging/logging.dart';
+
+/// When an [InitNode] is brought up.
+enum InitTier {
+  /// Runs before `AppCore` reports ready.
+  eager,
+
+  /// Runs after the first frame via [InitializationGraph.runDeferred].
+  deferred,
+
+  /// Runs only when something calls [InitializationGraph.ensure].
+  lazy,
+}
+
+/// A single initialization step with its declared dependencies.
+class InitNode {
+  const InitNode({
+    required this.name,
+    required this.run,
+    this.dependsOn = const <String>[],
+    this.tier = InitTier.eager,
+  });
+
+  final String name;
+  final List<String> dependsOn;
+  final InitTier tier;
+  final Future<void> Function() run;
+}
+
+/// Outcome of a node run, exported for startup diagnostics.
+class InitNodeTiming {
+  const InitNodeTiming({
+    required this.name,
+    required this.tier,
+    required this.startedAt,
+    required this.duration,
+    required this.succeeded,
+    this.skipped = false,
+    this.error,
+  });
+
+  final String name;
+  final InitTier tier;
+
+  /// Offset from the start of the graph run.
+  final Duration startedAt;
+  final Duration duration;
+  final bool succeeded;
+  final bool skipped;
+  final String? error;
+
+  Map<String, dynamic> toJson() => {
+    'name': name,
+    'tier': tier.name,
+    'startedAtMs': startedAt.inMilliseconds,
+    'durationMs': duration.inMilliseconds,
+    'succeeded': succeeded,
+    if (skipped) 'skipped': true,
+    if (error != null) 'error': error,
+  };
+}
+
+/// Dependency-ordered initializer.
+///
+/// Every node starts as soon as all of its dependencies complete, so
+/// independent nodes run concurrently. Each node runs at most once; callers
+/// that need a node (directly or as a dependency) share the same future.
+/// A deferred or lazy node that an eager node depends on is pulled forward.
+class InitializationGraph {
+  static final _logger = Logger('InitializationGraph');
+
+  InitializationGraph({bool Function()? shouldAbort})
+    : _shouldAbort = shouldAbort;
+
+  final bool Function()? _shouldAbort;
+  final Map<String, InitNode> _nodes = <String, InitNode>{};
+  final Map<String, Future<void>> _running = <String, Future<void>>{};
+  final Set<String> _completed = <String>{};
+  final List<InitNodeTiming> _timings = <InitNodeTiming>[];
+  final Stopwatch _clock = Stopwatch();
+  bool _validated = false;
+  bool _cancelled = false;
+
+  void add(InitNode node) {
+    if (_nodes.containsKey(node.name)) {
+      throw StateError('Init node "${node.name}" registered twice');
+    }
+    _nodes[node.name] = node;
+    _validated = false;
+  }
+
+  void addAll(Iterable<InitNode> nodes) => nodes.forEach(add);
+
+  bool isComplete(String name) => _completed.contains(name);
+
+  Iterable<String> namesForTier(InitTier tier) =>
+      _nodes.values.where((n) => n.tier == tier).map((n) => n.name);
+
+  /// Completed node timings in completion order.
+  List<InitNodeTiming> get timings => List.unmodifiable(_timings);
+
+  /// Stop starting new nodes; nodes already running finish normally.
+  void cancel() => _cancelled = true;
+
+  /// Run every eager node. Throws the first node failure.
+  Future<void> runEager() => _runAll(namesForTier(InitTier.eager).toList());
+
+  /// Run every deferred node. Failures are logged and do not propagate, since
+  /// nothing UI-critical may depend on a deferred node.
+  Future<void> runDeferred() async {
+    final names = namesForTier(InitTier.deferred).toList();
+    _validate();
+    await Future.wait(
+      names.map(
+        (name) => _start(name).catchError((Object e) {
+          _logger.warning('Deferred init node "$name" failed: $e');
+        }),
+      ),
+    );
+  }
+
+  /// Run [name] (and its dependencies) if it has not run yet.
+  Future<void> ensure(String name) {
+    _validate();
+    return _start(name);
+  }
+
+  Map<String, dynamic> exportTimings() {
+    final totalsByTier = <String, int>{};
+    for (final timing in _timings) {
+      totalsByTier.update(
+        timing.tier.name,
+        (value) => value + timing.duration.inMilliseconds,
+        ifAbsent: () => timing.duration.inMilliseconds,
+      );
+    }
+    return {
+      'wallClockMs': _clock.elapsedMilliseconds,
+      'serialSumMsByTier': totalsByTier,
+      'nodes': _timings.map((t) => t.toJson()).toList(),
+    };
+  }
+
+  Future<void> _runAll(List<String> names) async {
+    _validate();
+    await Future.wait(names.map(_start));
+  }
+
+  Future<void> _start(String name) {
+    final existing = _running[name];
+    if (existing != null) return existing;
+
+    final node = _nodes[name];
+    if (node == null) {
+      return Future<void>.error(StateError('Unknown init node "$name"'));
+    }
+    if (!_clock.isRunning) _clock.start();
+
+    final future = Future.wait(node.dependsOn.map(_start)).then(
+      (_) => _runNode(node),
+    );
+    _running[name] = future;
+    return future;
+  }
+
+  Future<void> _runNode(InitNode node) async {
+    final startedAt = _clock.elapsed;
+    if (_cancelled || (_shouldAbort?.call() ?? false)) {
+      _timings.add(
+        InitNodeTiming(
+          name: node.name,
+          tier: node.tier,
+          startedAt: startedAt,
+          duration: Duration.zero,
+          succeeded: false,
+          skipped: true,
+        ),
+      );
+      return;
+    }
+
+    final stopwatch = Stopwatch()..start();
+    try {
+      await node.run();
+      stopwatch.stop();
+      _completed.add(node.name);
+      _timings.add(
+        InitNodeTiming(
+          name: node.name,
+          tier: node.tier,
+          startedAt: startedAt,
+          duration: stopwatch.elapsed,
+          succeeded: true,
+        ),
+      );
+      _logger.fine(
+        '✅ ${node.name} (${node.tier.name}) in ${stopwatch.elapsedMilliseconds}ms',
+      );
+    } catch (e) {
+      stopwatch.stop();
+      _timings.add(
+        InitNodeTiming(
+          name: node.name,
+          tier: node.tier,
+          startedAt: startedAt,
+          duration: stopwatch.elapsed,
+          succeeded: false,
+          error: e.toString(),
+        ),
+      );
+      rethrow;
+    }
+  }
+
+  /// Reject unknown dependencies and cycles before anything runs.
+  void _validate() {
+    if (_validated) return;
+
+    final visiting = <String>{};
+    final visited = <String>{};
+
+    void visit(String name, List<String> path) {
+      if (visited.contains(name)) return;
+      if (!visiting.add(name)) {
+        throw StateError(
+          'Init graph cycle: ${[...path, name].join(' -> ')}',
+        );
+      }
+      final node = _nodes[name];
+      if (node == null) {
+        throw StateError(
+          'Init node "${path.isEmpty ? name : path.last}" depends on '
+          'unknown node "$name"',
+        );
+      }
+      for (final dependency in node.dependsOn) {
+        visit(dependency, [...path, name]);
+      }
+      visiting.remove(name);
+      visited.add(name);
+    }
+
+    for (final name in _nodes.keys) {
+      visit(name, const <String>[]);
+    }
+    _validated = true;
+  }
+}
@@ -1,9 +1,12 @@
+import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:logging/logging.dart';
 import '../../domain/services/archive_management_service.dart';
 import '../../domain/services/archive_search_service.dart';
 import '../../domain/services/chat_management_service.dart';
 import '../../domain/services/contact_management_service.dart';
+import '../../domain/services/app_event_channels.dart';
 import '../../domain/services/security_service_locator.dart';
+import '../../domain/services/typed_event_bus.dart';
 import '../../domain/services/mesh_networking_service.dart';
 import '../services/security_manager.dart';
 import '../../domain/services/mesh/mesh_network_health_monitor.dart';
@@ -29,6 +32,7 @@ import 'package:pak_connect/domain/interfaces/i_chat_list_coordinator_factory.da
 import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_export_service.dart';
 import 'package:pak_connect/domain/interfaces/i_group_repository.dart';
+import 'package:pak_connect/domain/interfaces/i_hot_state_snapshot_store.dart';
 import 'package:pak_connect/domain/interfaces/i_import_service.dart';
 import 'package:pak_connect/domain/interfaces/i_intro_hint_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_preferences_repository.dart';
@@ -178,6 +182,16 @@ Future<void> setupServiceLocator() async {
       return;
     }
 
+    // One app-level event bus; owners look their channels up by name.
+    if (!serviceRegistry.isRegistered<TypedEventBus>()) {
+      serviceRegistry.registerSingleton<TypedEventBus>(
+        AppEventChannels.createBus(logger: Logger('AppEventBus')),
+      );
+      _logger.fine('✅ TypedEventBus registered');
+    } else {
+      _logger.fine('ℹ️ TypedEventBus already registered');
+    }
+
     // Register shared queue provider first (used by data-layer registrations).
     if (!serviceRegistry.isRegistered<ISharedMessageQueueProvider>()) {
       serviceRegistry.registerSingleton<ISharedMessageQueueProvider>(
@@ -222,7 +236,10 @@ Future<void> setupServiceLocator() async {
 
     if (!serviceRegistry.isRegistered<IHomeScreenFacadeFactory>()) {
       serviceRegistry.registerLazySingleton<IHomeScreenFacadeFactory>(
-        () => const HomeScreenFacadeFactory(),
+        () => HomeScreenFacadeFactory(
+          chatConnectionManagerFactory: serviceRegistry
+              .maybeResolve<IChatConnectionManagerFactory>(),
+        ),
       );
       _logger.fine('✅ IHomeScreenFacadeFactory registered');
     } else {
@@ -231,7 +248,9 @@ Future<void> setupServiceLocator() async {
 
     if (!serviceRegistry.isRegistered<IChatConnectionManagerFactory>()) {
       serviceRegistry.registerLazySingleton<IChatConnectionManagerFactory>(
-        () => const ChatConnectionManagerFactory(),
+        () => ChatConnectionManagerFactory(
+          eventBus: serviceRegistry.maybeResolve<TypedEventBus>(),
+        ),
       );
       _logger.fine('✅ IChatConnectionManagerFactory registered');
     } else {
@@ -310,6 +329,9 @@ AppBootstrapServices resolveAppBootstrapServices() {
         .maybeResolve<IChatConnectionManagerFactory>(),
     chatListCoordinatorFactory: _registry
         .maybeResolve<IChatListCoordinatorFactory>(),
+    hotStateSnapshotStore: _registry.maybeResolve<IHotStateSnapshotStore>(),
+    secureStorage: _registry.maybeResolve<FlutterSecureStorage>(),
+    eventBus: _registry.maybeResolve<TypedEventBus>(),
   );
 }
 
@@ -0,0 +1,174 @@
+import 'dart:convert';
+
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/constants/special_recipients.dart';
+import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
+import 'package:pak_connect/domain/utils/string_extensions.dart';
+
+/// DTN custody transfer for routed (point-to-point) relay bundles.
+///
+/// A bundle taken into custody is persisted in the relay queue under
+/// [chatIdPrefix], so it survives restarts, and the upstream holder is told
+/// it may drop its copy. Custody storage is bounded by bundle count and
+/// bytes; when full, the lowest-priority bundle closest to its deadline is
+/// evicted, but only for an incoming bundle that outranks it.
+///
+/// Bundles whose remaining lifetime is shorter than the predicted wait to
+/// meet the next hop again are forwarded without custody: if the immediate
+/// attempt fails, holding them would not get them delivered in time.
+///
+/// Acceptance is two-step: [tryAcceptCustody] only picks the victims, and
+/// [evict] drops them once the custody copy is actually queued, so a failed
+/// relay loses neither bundle.
+class CustodyManager {
+  /// Relay queue chat ID prefix marking custody-held copies.
+  static const String chatIdPrefix = 'custody_relay_';
+
+  static const int defaultMaxBundles = 64;
+  static const int defaultMaxBytes = 512 * 1024;
+
+  /// Encounter wait assumed for a next hop with no encounter history.
+  static const Duration defaultEncounterWait = Duration(minutes: 30);
+
+  final Logger _logger;
+  final OfflineMessageQueueContract _messageQueue;
+  final ConnectionQualityMonitor _qualityMonitor;
+  final int maxBundles;
+  final int maxBytes;
+
+  CustodyManager({
+    required Logger logger,
+    required OfflineMessageQueueContract messageQueue,
+    ConnectionQualityMonitor? qualityMonitor,
+    this.maxBundles = defaultMaxBundles,
+    this.maxBytes = defaultMaxBytes,
+  }) : _logger = logger,
+       _messageQueue = messageQueue,
+       _qualityMonitor = qualityMonitor ?? ConnectionQualityMonitor.instance;
+
+  /// Whether [message] is a relay copy held in custody
+  static bool isCustodyCopy(QueuedMessage message) =>
+      message.isRelayMessage && message.chatId.startsWith(chatIdPrefix);
+
+  /// Custody bundles currently held in the relay queue
+  List<QueuedMessage> heldBundles() =>
+      _messageQueue.activeMessages().where(isCustodyCopy).toList();
+
+  /// Decide whether to take custody of [relayMessage] before forwarding it
+  /// to [nextHopNodeId]. Returns null when declined; otherwise the
+  /// lower-ranked bundles to [evict] once the custody copy is queued.
+  CustodyAdmission? tryAcceptCustody({
+    required MeshRelayMessage relayMessage,
+    required String nextHopNodeId,
+    DateTime? now,
+  }) {
+    final metadata = relayMessage.relayMetadata;
+    // The originator already persists its own bundles.
+    if (!metadata.custody ||
+        metadata.isOriginator ||
+        SpecialRecipients.isBroadcast(metadata.finalRecipient)) {
+      return null;
+    }
+
+    final at = now ?? DateTime.now();
+    final truncatedMessageId = relayMessage.originalMessageId.length > 16
+        ? relayMessage.originalMessageId.shortId()
+        : relayMessage.originalMessageId;
+
+    final remaining = metadata.deadline.difference(at);
+    final wait =
+        _qualityMonitor.predictedEncounterWait(nextHopNodeId) ??
+        defaultEncounterWait;
+    if (remaining <= wait) {
+      _logger.fine(
+        '📦 Custody declined for $truncatedMessageId...: '
+        '${remaining.inMinutes}min left, next encounter ~${wait.inMinutes}min',
+      );
+      return null;
+    }
+
+    final size = _sizeOf(relayMessage.originalContent);
+    if (size > maxBytes) return null;
+
+    final held = heldBundles();
+    var count = held.length + 1;
+    var bytes = held.fold<int>(size, (sum, m) => sum + _sizeOf(m.content));
+    if (count <= maxBundles && bytes <= maxBytes) {
+      return const CustodyAdmission([]);
+    }
+
+    // Lowest priority first, then the bundle with the least lifetime left.
+    held.sort(
+      (a, b) => _compareRank(
+        a.priority,
+        _remainingLifetime(a, at),
+        b.priority,
+        _remainingLifetime(b, at),
+      ),
+    );
+    final victims = <QueuedMessage>[];
+    for (final bundle in held) {
+      if (count <= maxBundles && bytes <= maxBytes) break;
+      final outranksIncoming =
+          _compareRank(
+            bundle.priority,
+            _remainingLifetime(bundle, at),
+            metadata.priority,
+            remaining,
+          ) >=
+          0;
+      if (outranksIncoming) break;
+      victims.add(bundle);
+      count--;
+      bytes -= _sizeOf(bundle.content);
+    }
+
+    if (count > maxBundles || bytes > maxBytes) {
+      _logger.info(
+        '📦 Custody storage full - forwarding $truncatedMessageId... without custody',
+      );
+      return null;
+    }
+    return CustodyAdmission(victims);
+  }
+
+  /// Drop the bundles [admission] displaced; call once the custody copy
+  /// has been queued.
+  Future<void> evict(CustodyAdmission admission) async {
+    if (admission.victims.isEmpty) return;
+    for (final victim in admission.victims) {
+      await _messageQueue.removeMessage(victim.id);
+    }
+    _logger.info(
+      '📦 Evicted ${admission.victims.length} custody bundle(s) for a '
+      'higher-ranked one',
+    );
+  }
+
+  static int _sizeOf(String content) => utf8.encode(content).length;
+
+  static Duration _remainingLifetime(QueuedMessage message, DateTime now) {
+    final deadline = message.relayMetadata?.deadline ?? message.expiresAt;
+    return deadline == null ? Duration.zero : deadline.difference(now);
+  }
+
+  static int _compareRank(
+    MessagePriority priorityA,
+    Duration remainingA,
+    MessagePriority priorityB,
+    Duration remainingB,
+  ) {
+    final byPriority = priorityA.index.compareTo(priorityB.index);
+    if (byPriority != 0) return byPriority;
+    return remainingA.compareTo(remainingB);
+  }
+}
+
+/// A custody acceptance and the held bundles it displaces
+class CustodyAdmission {
+  final List<QueuedMessage> victims;
+
+  const CustodyAdmission(this.victims);
+}
@@ -9,6 +9,7 @@ import 'package:logging/logging.dart';
 import 'package:pak_connect/domain/messaging/mesh_relay_engine.dart'
     as domain_messaging;
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import 'package:pak_connect/domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/interfaces/i_repository_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
@@ -17,12 +18,17 @@ import '../../domain/values/id_types.dart';
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
 import 'package:pak_connect/domain/services/proof_of_work_service.dart';
 import 'package:pak_connect/domain/services/message_cost_policy.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/routing/network_topology_analyzer.dart';
 import 'package:pak_connect/domain/interfaces/i_mesh_routing_service.dart';
+import 'custody_manager.dart';
+import 'multipath_relay_sender.dart';
 import 'relay_config_manager.dart';
 import 'relay_policy.dart';
 import 'relay_decision_engine.dart';
 import 'relay_send_pipeline.dart';
+import 'stripe_assembler.dart';
 import 'package:pak_connect/domain/constants/special_recipients.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/models/security_level.dart';
@@ -50,6 +56,9 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
   final RelayConfigManager _relayConfig = RelayConfigManager();
   late final RelayDecisionEngine _decisionEngine;
   late final RelaySendPipeline _sendPipeline;
+  late final CustodyManager _custodyManager;
+  late final MultipathRelaySender _multipathSender;
+  final StripeAssembler _stripeAssembler = StripeAssembler(logger: _logger);
 
   // Node identification (NOT final to allow re-initialization in tests and node identity changes)
   late String _currentNodeId;
@@ -123,6 +132,14 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
       messageQueue: _messageQueue,
       spamPrevention: _spamPrevention,
     );
+    _custodyManager = CustodyManager(
+      logger: _logger,
+      messageQueue: _messageQueue,
+    );
+    _multipathSender = MultipathRelaySender(
+      logger: _logger,
+      sendPipeline: _sendPipeline,
+    );
   }
 
   /// Initialize the relay engine
@@ -232,6 +249,40 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
     List<String> availableNextHops = const [],
     ProtocolMessageType?
     messageType, // Phase 1: Added message type parameter for filtering
+  }) async {
+    final result = await _processIncomingRelay(
+      relayMessage: relayMessage,
+      fromNodeId: fromNodeId,
+      availableNextHops: availableNextHops,
+      messageType: messageType,
+    );
+    _recordHistory(result);
+    return result;
+  }
+
+  /// Feed the outcome into the persistent mesh metrics history
+  void _recordHistory(RelayProcessingResult result) {
+    final history = MeshMetricsHistory.instance;
+    switch (result.type) {
+      case RelayProcessingType.relayed:
+        history.increment(MeshMetricsHistory.relayed);
+      case RelayProcessingType.deliveredToSelf:
+        history.increment(MeshMetricsHistory.deliveredToSelf);
+      case RelayProcessingType.stripeBlock:
+        // Counted once, when the assembled transfer is delivered.
+        break;
+      case RelayProcessingType.dropped:
+      case RelayProcessingType.blocked:
+      case RelayProcessingType.error:
+        history.recordDrop(result.reason ?? result.type.name);
+    }
+  }
+
+  Future<RelayProcessingResult> _processIncomingRelay({
+    required MeshRelayMessage relayMessage,
+    required String fromNodeId,
+    required List<String> availableNextHops,
+    required ProtocolMessageType? messageType,
   }) async {
     try {
       final truncatedMessageId = relayMessage.originalMessageId.length > 16
@@ -343,6 +394,17 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
       }
 
       // Step 2: Check if we are the final recipient
+      if (isForUs && relayMessage.relayMetadata.stripe != null) {
+        // One block of a striped transfer: hold it until enough blocks
+        // are in, then deliver the whole transfer under its own ID.
+        await _seenMessageStore.markDelivered(relayMessage.originalMessageId);
+        final assembled = _stripeAssembler.add(relayMessage);
+        if (assembled == null) {
+          return RelayProcessingResult.stripeReceived();
+        }
+        relayMessage = assembled;
+      }
+
       if (isForUs) {
         await _deliverToCurrentNode(relayMessage);
         _totalDeliveredToSelf++;
@@ -386,16 +448,42 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
         return RelayProcessingResult.dropped('Message TTL exceeded');
       }
 
+      // Legacy peers cannot take a path we only know in compact form.
+      final nextHops = _hopsThatCanCarry(relayMessage, availableNextHops);
+
       // Step 4 & 5: Dumb flood broadcast (BitChat style)
       final canRouteDirectly =
           !forceFloodMode &&
           !isBroadcast &&
-          (availableNextHops.isNotEmpty || _routingService != null);
+          (nextHops.isNotEmpty || _routingService != null);
+
+      // Bundles we send ourselves come through here from our own node ID;
+      // this, not the peer-supplied path, decides relay quota exemption.
+      final isOriginator = fromNodeId == _currentNodeId;
 
       if (canRouteDirectly) {
+        final stripedRoutes = isOriginator
+            ? await _trySendStriped(relayMessage, nextHops)
+            : 0;
+        if (stripedRoutes > 0) {
+          await _seenMessageStore.markDelivered(relayMessage.originalMessageId);
+          _totalRelayed++;
+
+          final decision = RelayDecision.relayed(
+            messageId: relayMessage.originalMessageId,
+            nextHopNodeId: 'MULTIPATH($stripedRoutes)',
+            hopCount: relayMessage.relayMetadata.hopCount + 1,
+          );
+
+          onRelayDecision?.call(decision);
+          _updateStatistics();
+
+          return RelayProcessingResult.relayed('multipath_striped');
+        }
+
         final nextHop = await _decisionEngine.chooseNextHop(
           relayMessage: relayMessage,
-          availableHops: availableNextHops,
+          availableHops: nextHops,
         );
 
         if (nextHop == null) {
@@ -411,10 +499,14 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
           return RelayProcessingResult.dropped('No next hop available');
         }
 
+        final admission = _admitCustody(relayMessage, nextHop);
+        final custody = admission != null;
         final relayed = await _sendPipeline.relayToNextHop(
           relayMessage: relayMessage,
           nextHopNodeId: nextHop,
           onRelayMessage: onRelayMessage,
+          custody: custody,
+          isOriginator: isOriginator,
         );
         if (!relayed) {
           _totalDropped++;
@@ -430,6 +522,8 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
             'Relay hop could not be sent (TTL/path)',
           );
         }
+        // Displaced bundles go only once the custody copy is queued.
+        if (admission != null) await _evictForCustody(admission);
         await _seenMessageStore.markDelivered(relayMessage.originalMessageId);
         _totalRelayed++;
 
@@ -442,10 +536,13 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
         onRelayDecision?.call(decision);
         _updateStatistics();
 
-        return RelayProcessingResult.relayed(nextHop);
+        return RelayProcessingResult.relayed(
+          nextHop,
+          custodyAccepted: custody,
+        );
       }
 
-      if (availableNextHops.isEmpty) {
+      if (nextHops.isEmpty) {
         _totalDropped++;
         final decision = RelayDecision.dropped(
           messageId: relayMessage.originalMessageId,
@@ -458,8 +555,9 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
 
       final relayedCount = await _sendPipeline.broadcastToNeighbors(
         relayMessage: relayMessage,
-        availableNeighbors: availableNextHops,
+        availableNeighbors: nextHops,
         onRelayMessage: onRelayMessage,
+        isOriginator: isOriginator,
       );
       if (relayedCount <= 0) {
         _totalDropped++;
@@ -574,6 +672,12 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
         originalSender: wireSender,
         finalRecipient: wireRecipient,
         currentNodeId: _currentNodeId,
+        // Point-to-point bundles ask relays to take custody and carry a
+        // spray-and-wait replica budget; broadcasts do neither.
+        custody: !SpecialRecipients.isBroadcast(wireRecipient),
+        replicas: SpecialRecipients.isBroadcast(wireRecipient)
+            ? null
+            : RelayMetadata.defaultReplicaBudget,
       );
 
       // Compute proof-of-work if cost policy is active
@@ -606,6 +710,7 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
               ttl: baseMetadata.ttl,
               hopCount: baseMetadata.hopCount,
               routingPath: baseMetadata.routingPath,
+              compactPath: baseMetadata.compactPath,
               messageHash: baseMetadata.messageHash,
               priority: baseMetadata.priority,
               relayTimestamp: baseMetadata.relayTimestamp,
@@ -616,6 +721,8 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
               senderRateCount: baseMetadata.senderRateCount,
               powNonce: powNonce,
               powDifficulty: powDifficulty,
+              custody: baseMetadata.custody,
+              replicas: baseMetadata.replicas,
             )
           : baseMetadata;
 
@@ -631,6 +738,7 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
                 ttl: relayMetadata.ttl,
                 hopCount: relayMetadata.hopCount,
                 routingPath: relayMetadata.routingPath,
+                compactPath: relayMetadata.compactPath,
                 messageHash: relayMetadata.messageHash,
                 priority: relayMetadata.priority,
                 relayTimestamp: relayMetadata.relayTimestamp,
@@ -640,6 +748,8 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
                 sealedSender: true,
                 powNonce: relayMetadata.powNonce,
                 powDifficulty: relayMetadata.powDifficulty,
+                custody: relayMetadata.custody,
+                replicas: relayMetadata.replicas,
               )
             : relayMetadata,
         relayNodeId: _currentNodeId,
@@ -665,6 +775,69 @@ class MeshRelayEngine implements domain_messaging.MeshRelayEngine {
     }
   }
 
+  /// [hops] that can decode [relayMessage]'s path. Peers without compact
+  /// relay paths would read a path received in compact form as starting
+  /// with us, so they only get bundles whose every hop is known by full ID.
+  static List<String> _hopsThatCanCarry(
+    MeshRelayMessage relayMessage,
+    List<String> hops,
+  ) {
+    if (relayMessage.relayMetadata.hasFullRoutingPath) return hops;
+    return hops
+        .where(
+          (hop) => PeerCapabilityRegistry.instance.supports(
+            hop,
+            PeerCapabilities.compactRelayPath,
+          ),
+        )
+        .toList();
+  }
+
+  /// Stripe a large originated bundle over disjoint routes when possible;
+  /// returns the number of routes used (0 to send it on a single route)
+  Future<int> _trySendStriped(
+    MeshRelayMessage relayMessage,
+    List<String> availableNextHops,
+  ) async {
+    if (!MultipathRelaySender.isEligible(relayMessage)) return 0;
+    try {
+      return await _multipathSender.trySend(
+        relayMessage: relayMessage,
+        availableHops: availableNextHops,
+        routingService: _routingService,
+        onRelayMessage: onRelayMessage,
+      );
+    } catch (e) {
+      _logger.warning('Multipath striping failed, using one route: $e');
+      return 0;
+    }
+  }
+
+  /// Take custody of a routed bundle when it asks for it and storage allows
+  CustodyAdmission? _admitCustody(
+    MeshRelayMessage relayMessage,
+    String nextHopNodeId,
+  ) {
+    if (!relayMessage.relayMetadata.custody) return null;
+    try {
+      return _custodyManager.tryAcceptCustody(
+        relayMessage: relayMessage,
+        nextHopNodeId: nextHopNodeId,
+      );
+    } catch (e) {
+      _logger.warning('Custody check failed, relaying without custody: $e');
+      return null;
+    }
+  }
+
+  Future<void> _evictForCustody(CustodyAdmission admission) async {
+    try {
+      await _custodyManager.evict(admission);
+    } catch (e) {
+      _logger.warning('Custody eviction failed: $e');
+    }
+  }
+
   /// Check if current node should attempt to decrypt message (recipient optimization)
   @override
   Future<bool> shouldAttemptDecryption({
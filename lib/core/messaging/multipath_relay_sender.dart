@@ -0,0 +1,192 @@
+import 'dart:convert';
+
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/constants/special_recipients.dart';
+import 'package:pak_connect/domain/interfaces/i_mesh_routing_service.dart';
+import 'package:pak_connect/domain/interfaces/i_multipath_routing_service.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/routing/multipath_stripe_tracker.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
+import 'package:pak_connect/domain/services/proof_of_work_service.dart';
+import 'package:pak_connect/domain/utils/stripe_codec.dart';
+import 'package:pak_connect/domain/utils/string_extensions.dart';
+import 'relay_send_pipeline.dart';
+
+/// Stripes large originated bundles across node-disjoint routes.
+///
+/// The payload is block-coded with [StripeCodec] (data blocks plus one XOR
+/// parity block) and the blocks are spread over the routes in proportion
+/// to their estimated capacity, adjusted by [MultipathStripeTracker]
+/// progress feedback. Each block is an ordinary routed relay bundle, but
+/// older relays strip its stripe position and older destinations would
+/// deliver raw blocks, so only routes whose every hop and destination
+/// advertised [PeerCapabilities.stripedRelay] are used.
+class MultipathRelaySender {
+  /// Payloads below this many UTF-8 bytes always travel on one route
+  static const int minStripedBytes = 4 * 1024;
+  static const int targetBlockBytes = 2 * 1024;
+  static const int maxDataBlocks = 16;
+  static const int maxPaths = 3;
+
+  /// Largest payload that fits [maxDataBlocks] blocks of [targetBlockBytes];
+  /// receivers reject stripes claiming more
+  static const int maxStripedBytes = maxDataBlocks * targetBlockBytes;
+
+  final Logger _logger;
+  final RelaySendPipeline _sendPipeline;
+  final MultipathStripeTracker _tracker;
+
+  MultipathRelaySender({
+    required Logger logger,
+    required RelaySendPipeline sendPipeline,
+    MultipathStripeTracker? tracker,
+  }) : _logger = logger,
+       _sendPipeline = sendPipeline,
+       _tracker = tracker ?? MultipathStripeTracker.instance;
+
+  /// Whether [relayMessage] is a candidate for striping at all
+  static bool isEligible(MeshRelayMessage relayMessage) {
+    final metadata = relayMessage.relayMetadata;
+    // Stealth and sealed bundles are opaque until the whole payload is
+    // in, and relay queues carry only the plain content.
+    return metadata.isOriginator &&
+        metadata.stripe == null &&
+        !metadata.usesStealth &&
+        !metadata.sealedSender &&
+        relayMessage.encryptedPayload == null &&
+        !SpecialRecipients.isBroadcast(metadata.finalRecipient) &&
+        _isStripeSized(utf8.encode(relayMessage.originalContent).length);
+  }
+
+  /// Stripe [relayMessage], a bundle this node created, when the routing
+  /// service offers two or more disjoint routes. Returns the number of
+  /// routes used, or 0 when the bundle should take the single-route path
+  /// instead.
+  Future<int> trySend({
+    required MeshRelayMessage relayMessage,
+    required List<String> availableHops,
+    required IMeshRoutingService? routingService,
+    Function(MeshRelayMessage, String)? onRelayMessage,
+  }) async {
+    if (routingService is! IMultipathRoutingService ||
+        !isEligible(relayMessage)) {
+      return 0;
+    }
+    final metadata = relayMessage.relayMetadata;
+    final validHops = availableHops
+        .where((hop) => !metadata.hasNodeInPath(hop))
+        .toList();
+    if (validHops.length < 2) return 0;
+
+    var routes = await (routingService as IMultipathRoutingService)
+        .determineMultipathRoutes(
+          finalRecipient: metadata.finalRecipient,
+          availableHops: validHops,
+          priority: metadata.priority,
+          maxPaths: maxPaths,
+        );
+    final capable = routes.where(_supportsStriping).toList();
+    if (capable.length < 2) return 0;
+    routes = capable;
+
+    final content = relayMessage.originalContent;
+    final length = utf8.encode(content).length;
+    final dataBlocks = ((length + targetBlockBytes - 1) ~/ targetBlockBytes)
+        .clamp(routes.length, maxDataBlocks);
+    final encoded = StripeCodec.encode(content, dataBlocks);
+    final assignment = MultipathStripeTracker.assignBlocks({
+      for (final route in routes) route.firstHop: _tracker.weightOf(route),
+    }, encoded.length);
+
+    final sent = <int, (MeshRelayMessage, String)>{};
+    for (final hop in assignment.keys) {
+      for (final index in assignment[hop]!) {
+        final stripe = RelayStripe(
+          transferId: relayMessage.originalMessageId,
+          index: index,
+          dataBlocks: dataBlocks,
+          length: length,
+        );
+        final block = MeshRelayMessage.createRelay(
+          originalMessageId: stripe.messageId,
+          originalContent: encoded[index],
+          metadata: metadata.forStripe(
+            stripe,
+            powNonce: _proofOfWorkFor(metadata, index),
+          ),
+          relayNodeId: relayMessage.relayNodeId,
+          originalMessageType: relayMessage.originalMessageType,
+        );
+        final relayed = await _sendPipeline.relayToNextHop(
+          relayMessage: block,
+          nextHopNodeId: hop,
+          onRelayMessage: onRelayMessage,
+          isOriginator: true,
+        );
+        if (relayed) sent[index] = (block, hop);
+      }
+    }
+
+    // Without enough blocks out the destination could never rebuild it;
+    // the caller falls back to a single route for the whole bundle, so
+    // the blocks that did get queued must not follow it.
+    if (sent.length < dataBlocks) {
+      _logger.warning(
+        '🔀 Only ${sent.length}/$dataBlocks stripe blocks sent - not striping',
+      );
+      for (final (block, hop) in sent.values) {
+        await _sendPipeline.withdrawFromNextHop(block.originalMessageId, hop);
+      }
+      return 0;
+    }
+
+    _tracker.registerTransfer(
+      transferId: relayMessage.originalMessageId,
+      dataBlocks: dataBlocks,
+      blocks: sent,
+      resend: (block, hop) async {
+        await _sendPipeline.relayToNextHop(
+          relayMessage: block,
+          nextHopNodeId: hop,
+          onRelayMessage: onRelayMessage,
+          isOriginator: true,
+        );
+      },
+    );
+
+    final truncatedMessageId = relayMessage.originalMessageId.length > 16
+        ? relayMessage.originalMessageId.shortId()
+        : relayMessage.originalMessageId;
+    _logger.info(
+      '🔀 Striped $truncatedMessageId... ($length B) into $dataBlocks+1 '
+      'blocks over ${routes.length} routes',
+    );
+    return routes.length;
+  }
+
+  static bool _isStripeSized(int bytes) =>
+      bytes >= minStripedBytes && bytes <= maxStripedBytes;
+
+  /// Every relay on [route] and its destination keep and read stripe
+  /// positions
+  static bool _supportsStriping(MultipathRoute route) =>
+      PeerCapabilityRegistry.instance.allSupport(
+        route.route.hops.skip(1),
+        PeerCapabilities.stripedRelay,
+      );
+
+  /// Proof-of-work for block [index], at the difficulty the whole bundle
+  /// was stamped with
+  static int? _proofOfWorkFor(RelayMetadata metadata, int index) {
+    final difficulty = metadata.powDifficulty ?? 0;
+    if (difficulty <= 0) return null;
+    return ProofOfWorkService.compute(
+      challenge: ProofOfWorkService.buildChallenge(
+        RelayMetadata.stripeHash(metadata.messageHash, index),
+        metadata.relayTimestamp.millisecondsSinceEpoch,
+      ),
+      difficulty: difficulty,
+    )?.nonce;
+  }
+}
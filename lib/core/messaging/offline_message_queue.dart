@@ -7,6 +7,7 @@ import 'package:sqflite_common/sqflite.dart' as sqflite_common;
 import 'package:sqflite_common_ffi/sqflite_ffi.dart' as sqflite_ffi;
 import 'package:pak_connect/domain/interfaces/i_repository_provider.dart';
 import 'package:pak_connect/domain/services/message_security.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
 import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_message_queue_repository.dart';
@@ -22,6 +23,8 @@ import '../services/queue_bandwidth_allocator.dart';
 import 'offline_queue_store.dart';
 import 'offline_queue_scheduler.dart';
 import 'offline_queue_sync.dart';
+import 'outbox_ack_window.dart';
+import 'relay_queue_quota.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../../domain/messaging/offline_message_queue_contract.dart';
 import '../../domain/values/id_types.dart';
@@ -84,6 +87,13 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
   );
 
   late final QueueBandwidthAllocator _bandwidth = QueueBandwidthAllocator();
+  final RelayQueueQuota _relayQuota = RelayQueueQuota();
+  final OutboxAckWindow _outboxWindow = OutboxAckWindow();
+  Timer? _outboxTimer;
+
+  /// Outbox window sends in progress; the queue counts as online while a
+  /// peer flush is still draining, as it did for the whole flush before.
+  int _outboxSends = 0;
   late final _OfflineMessageQueueMaintenanceHelper _maintenanceHelper =
       _OfflineMessageQueueMaintenanceHelper(this);
 
@@ -97,6 +107,8 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
   // Connection monitoring
   bool _isOnline = false;
 
+  bool get _canDeliver => _isOnline || _outboxSends > 0;
+
   // Statistics
   int _totalQueued = 0;
   int _totalDelivered = 0;
@@ -186,6 +198,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     _store.setDatabaseProvider(_databaseProvider);
     await _store.initializePersistence(logger: _logger);
     await _queueSync.initialize();
+    _relayQuota.reconcile(_getAllMessages().where((m) => m.isRelayMessage));
     _startConnectivityMonitoring();
     _startPeriodicCleanup();
 
@@ -212,6 +225,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     try {
       // Apply favorites-based priority boost
@@ -222,10 +236,14 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
       // Use boosted priority without mutating parameter
       final effectivePriority = boostResult.priority;
 
-      // Validate per-peer queue limits
+      // Validate per-peer queue limits. Direct and relay messages are
+      // counted separately so relayed traffic cannot use up a contact's
+      // direct quota; relay storage is bounded by _relayQuota below.
       final validation = await _policy.validateQueueLimit(
         recipientPublicKey: recipientPublicKey,
-        allMessages: _getAllMessages(),
+        allMessages: _getAllMessages()
+            .where((m) => m.isRelayMessage == isRelayMessage)
+            .toList(),
       );
 
       if (!validation.isValid) {
@@ -256,17 +274,27 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
         attachments: attachments,
         attempts: 0,
         maxRetries: _getMaxRetriesForPriority(effectivePriority),
-        expiresAt: _calculateExpiryTime(now, effectivePriority),
+        expiresAt: _calculateExpiryTime(
+          now,
+          effectivePriority,
+          relayMetadata: relayMetadata,
+        ),
         isRelayMessage: isRelayMessage,
         relayMetadata: relayMetadata,
         originalMessageId: originalMessageId,
         relayNodeId: relayNodeId,
         messageHash: messageHash,
+        isOriginator: isOriginator,
       );
 
+      if (isRelayMessage) {
+        await _admitRelayMessage(queuedMessage);
+      }
+
       // Add to queue with priority ordering
       // PRIORITY 1 FIX: Route to appropriate queue (direct vs relay)
       _insertMessageByPriority(queuedMessage);
+      _relayQuota.charge(queuedMessage);
 
       if (persistToStorage) {
         await _saveMessageToStorage(queuedMessage);
@@ -287,7 +315,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
       );
 
       // Attempt immediate delivery if online
-      if (_isOnline) {
+      if (_canDeliver) {
         _tryDeliveryForMessage(queuedMessage);
       }
 
@@ -317,6 +345,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await queueMessage(
       chatId: chatId.value,
@@ -332,6 +361,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
     return MessageId(id);
   }
@@ -408,7 +438,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     // Execute scheduled deliveries
     for (final scheduledMessage in schedule.schedule) {
       Timer(scheduledMessage.delay, () {
-        if (_isOnline) {
+        if (_canDeliver) {
           _tryDeliveryForMessage(scheduledMessage.message);
         }
       });
@@ -520,6 +550,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     _logger.warning(
       'Delivery failed for ${message.id.shortId()}...: $reason (attempt ${message.attempts}/${message.maxRetries})',
     );
+    _releaseOutboxSlot(message.id);
 
     // Check retry policy (max retries + expiry) before scheduling another attempt
     final canRetry = _queueScheduler.shouldRetry(
@@ -558,7 +589,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
 
     // Schedule retry via scheduler
     _queueScheduler.registerRetryTimer(message.id, backoffDelay, () async {
-      if (_isOnline) {
+      if (_canDeliver) {
         await _tryDeliveryForMessage(message);
       } else {
         message.status = QueuedMessageStatus.pending;
@@ -640,7 +671,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
 
     await _saveQueueToStorage();
 
-    if (_isOnline) {
+    if (_canDeliver) {
       await _processQueue();
     }
   }
@@ -673,7 +704,7 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
 
     await _saveQueueToStorage();
 
-    if (_isOnline) {
+    if (_canDeliver) {
       await _processQueue();
     }
   }
@@ -683,6 +714,10 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
   Future<void> clearQueue() async {
     _cancelAllActiveRetries();
     _store.clearInMemoryQueues();
+    _relayQuota.clear();
+    _outboxWindow.clear();
+    _outboxTimer?.cancel();
+    _outboxTimer = null;
     await _saveQueueToStorage();
 
     _logger.info('Message queues cleared (direct and relay)');
@@ -747,28 +782,11 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
         '📤 Flushing ${peerMessages.length} queued messages for peer ${peerPublicKey.shortId(8)}... (direct: $directCount, relay: $relayCount)',
       );
 
-      // Mark peer as online temporarily for delivery
-      final wasOnline = _isOnline;
-      _isOnline = true;
-
-      // Process messages with small delays to avoid overwhelming connection
-      for (int i = 0; i < peerMessages.length; i++) {
-        final message = peerMessages[i];
-
-        // Small delay between messages
-        if (i > 0) {
-          await Future.delayed(Duration(milliseconds: 50));
-        }
-
-        final queueType = message.isRelayMessage ? 'relay' : 'direct';
-        _logger.fine(
-          '  Sending queued $queueType message: ${message.id.shortId()}...',
-        );
-        await _tryDeliveryForMessage(message);
-      }
-
-      // Restore original online state
-      _isOnline = wasOnline;
+      // Pipeline through the ACK window: the first messages go out back to
+      // back and each ACK or failure (in any order) releases the next one.
+      await _sendFromOutboxWindow(
+        _outboxWindow.enqueue(peerPublicKey, peerMessages.map((m) => m.id)),
+      );
 
       _logger.info(
         '✅ Queue flush complete for peer ${peerPublicKey.shortId(8)}...',
@@ -841,10 +859,84 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
     _store.insertMessageByPriority(message);
   }
 
+  /// Enforce relay byte quotas for [message], evicting lower-utility relay
+  /// messages to make room. Throws [MessageQueueException] when it does not
+  /// fit even after eviction.
+  Future<void> _admitRelayMessage(QueuedMessage message) async {
+    final decision = _relayQuota.admit(
+      message,
+      _getAllMessages().where((m) => m.isRelayMessage),
+    );
+    if (!decision.admitted) {
+      _logger.warning(
+        'Relay message ${message.id.shortId()}... rejected: ${decision.reason}',
+      );
+      throw MessageQueueException('Relay quota exceeded: ${decision.reason}');
+    }
+    for (final victim in decision.victims) {
+      _cancelRetryTimer(MessageId(victim.id));
+      _removeMessageFromQueue(MessageId(victim.id));
+      await _deleteMessageFromStorage(victim.id);
+    }
+    if (decision.victims.isNotEmpty) {
+      _logger.info(
+        '🧹 Evicted ${decision.victims.length} relay message(s) for ${message.id.shortId()}...',
+      );
+    }
+  }
+
   /// Remove message from queue
   /// PRIORITY 1 FIX: Remove from both queues
   void _removeMessageFromQueue(MessageId messageId) {
     _store.removeMessageFromQueue(messageId.value);
+    _relayQuota.release(messageId.value);
+    _releaseOutboxSlot(messageId.value);
+  }
+
+  /// Free [messageId]'s outbox window slot and send whatever it releases
+  void _releaseOutboxSlot(String messageId) {
+    final next = _outboxWindow.complete(messageId);
+    if (next.isNotEmpty) unawaited(_sendFromOutboxWindow(next));
+  }
+
+  /// Send messages released by the outbox window, in order
+  Future<void> _sendFromOutboxWindow(List<String> messageIds) async {
+    _outboxSends++;
+    try {
+      for (final id in messageIds) {
+        final message = getMessageById(id);
+        if (message == null ||
+            message.status != QueuedMessageStatus.pending) {
+          _releaseOutboxSlot(id);
+          continue;
+        }
+        final queueType = message.isRelayMessage ? 'relay' : 'direct';
+        _logger.fine(
+          '  Sending queued $queueType message: ${message.id.shortId()}...',
+        );
+        await _tryDeliveryForMessage(message);
+        // Hop ACKs never complete relay copies, so their slot is done once
+        // the transport has taken them.
+        if (message.isRelayMessage) _releaseOutboxSlot(id);
+      }
+    } finally {
+      _outboxSends--;
+    }
+    _armOutboxTimer();
+  }
+
+  /// Reclaim slots whose ACK never came, resuming the drain they blocked
+  void _armOutboxTimer() {
+    if (_outboxTimer != null || !_outboxWindow.hasInFlight) return;
+    _outboxTimer = Timer(_outboxWindow.slotTimeout, () {
+      _outboxTimer = null;
+      final next = _outboxWindow.reclaimExpired();
+      if (next.isNotEmpty) {
+        unawaited(_sendFromOutboxWindow(next));
+      } else {
+        _armOutboxTimer();
+      }
+    });
   }
 
   /// Get all messages from both queues (helper for dual-queue operations)
@@ -864,8 +956,17 @@ class OfflineMessageQueue implements OfflineMessageQueueContract {
 
   /// Calculate expiry time based on priority
   /// Urgent messages have longer TTL to ensure delivery even with long offline periods
-  DateTime _calculateExpiryTime(DateTime queuedAt, MessagePriority priority) {
-    return _queueScheduler.calculateExpiryTime(queuedAt, priority);
+  ///
+  /// Relay copies never outlive the bundle deadline set at origin, so each
+  /// hop (and each custody transfer) cannot restart the lifetime.
+  DateTime _calculateExpiryTime(
+    DateTime queuedAt,
+    MessagePriority priority, {
+    RelayMetadata? relayMetadata,
+  }) {
+    final expiry = _queueScheduler.calculateExpiryTime(queuedAt, priority);
+    final deadline = relayMetadata?.deadline;
+    return deadline != null && deadline.isBefore(expiry) ? deadline : expiry;
   }
 
   /// Check if message has expired
@@ -45,6 +45,15 @@ class _OfflineMessageQueueMaintenanceHelper {
 
   void updateStatistics() {
     final stats = _owner.getStatistics();
+    MeshMetricsHistory.instance
+      ..record(
+        MeshMetricsHistory.directQueueDepth,
+        stats.directQueueSize.toDouble(),
+      )
+      ..record(
+        MeshMetricsHistory.relayQueueDepth,
+        stats.relayQueueSize.toDouble(),
+      );
     _owner.onStatsUpdated?.call(stats);
   }
 
@@ -175,6 +184,16 @@ class _OfflineMessageQueueMaintenanceHelper {
       return false;
     });
 
+    for (final id in expiredIds) {
+      _owner._relayQuota.release(id);
+    }
+
+    // Relay storage is also bounded by byte quotas, not only by age:
+    // rebuild the ledger so quota checks between sweeps start from truth.
+    _owner._relayQuota.reconcile(
+      _owner._getAllMessages().where((m) => m.isRelayMessage),
+    );
+
     // Persist removal to storage
     if (expiredIds.isNotEmpty) {
       await saveQueueToStorage();
@@ -224,6 +243,8 @@ class _OfflineMessageQueueMaintenanceHelper {
 
   void dispose() {
     _owner._queueScheduler.dispose();
+    _owner._outboxTimer?.cancel();
+    _owner._outboxTimer = null;
     OfflineMessageQueue._logger.info('Offline message queue disposed');
   }
 }
@@ -153,6 +153,7 @@ class OfflineQueueFacade implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     return _queue.queueMessage(
       chatId: chatId,
@@ -168,6 +169,7 @@ class OfflineQueueFacade implements OfflineMessageQueueContract {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
   }
 
@@ -186,6 +188,7 @@ class OfflineQueueFacade implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) {
     return _queue.queueMessageWithIds(
       chatId: chatId,
@@ -201,6 +204,7 @@ class OfflineQueueFacade implements OfflineMessageQueueContract {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
   }
 
@@ -0,0 +1,102 @@
+import 'dart:collection';
+
+/// Per-peer sliding ACK window for draining the outbox.
+///
+/// A flush hands the window every pending message for a peer; up to
+/// [windowSize] of them are released for sending at once and the rest wait
+/// in order. Each ACK or failure frees its slot whatever order it arrives
+/// in, releasing the next waiting message, so encryption and fragmenting of
+/// later messages overlap earlier ones on the air while the link is never
+/// flooded with the whole backlog.
+class OutboxAckWindow {
+  static const int defaultWindowSize = 8;
+
+  /// Slots not freed by an ACK or failure within this time are reclaimed
+  /// (see [reclaimExpired]), so a send that never reports back cannot
+  /// stall the drain.
+  static const Duration defaultSlotTimeout = Duration(seconds: 15);
+
+  final int windowSize;
+  final Duration slotTimeout;
+
+  final Map<String, Map<String, DateTime>> _inFlight = {};
+  final Map<String, Queue<String>> _waiting = {};
+  final Map<String, String> _peerOf = {};
+
+  OutboxAckWindow({
+    this.windowSize = defaultWindowSize,
+    this.slotTimeout = defaultSlotTimeout,
+  });
+
+  /// Add [messageIds] (in send order) for [peer]; returns the IDs to send
+  /// now. IDs already in flight or waiting are ignored.
+  List<String> enqueue(
+    String peer,
+    Iterable<String> messageIds, {
+    DateTime? now,
+  }) {
+    final waiting = _waiting.putIfAbsent(peer, Queue.new);
+    for (final id in messageIds) {
+      if (_peerOf.containsKey(id)) continue;
+      _peerOf[id] = peer;
+      waiting.add(id);
+    }
+    return _release(peer, now ?? DateTime.now());
+  }
+
+  /// Free the slot held by [messageId]; returns the next IDs to send for
+  /// the same peer.
+  List<String> complete(String messageId, {DateTime? now}) {
+    final peer = _peerOf.remove(messageId);
+    if (peer == null) return const [];
+    if (_inFlight[peer]?.remove(messageId) == null) {
+      // Completed before it was released (e.g. removed from the queue).
+      _waiting[peer]?.remove(messageId);
+    }
+    return _release(peer, now ?? DateTime.now());
+  }
+
+  /// Reclaim slots past [slotTimeout] for every peer; returns the IDs
+  /// they release, to be sent by the caller.
+  List<String> reclaimExpired({DateTime? now}) {
+    final at = now ?? DateTime.now();
+    return [for (final peer in _inFlight.keys.toList()) ..._release(peer, at)];
+  }
+
+  /// Whether any slot is held, i.e. a later [reclaimExpired] may free one
+  bool get hasInFlight => _inFlight.isNotEmpty;
+
+  int inFlightFor(String peer) => _inFlight[peer]?.length ?? 0;
+  int waitingFor(String peer) => _waiting[peer]?.length ?? 0;
+
+  void clear() {
+    _inFlight.clear();
+    _waiting.clear();
+    _peerOf.clear();
+  }
+
+  List<String> _release(String peer, DateTime now) {
+    final inFlight = _inFlight.putIfAbsent(peer, () => {});
+    final stale = inFlight.entries
+        .where((e) => now.difference(e.value) >= slotTimeout)
+        .map((e) => e.key)
+        .toList();
+    for (final id in stale) {
+      inFlight.remove(id);
+      _peerOf.remove(id);
+    }
+
+    final waiting = _waiting[peer];
+    final released = <String>[];
+    while (waiting != null &&
+        waiting.isNotEmpty &&
+        inFlight.length < windowSize) {
+      final id = waiting.removeFirst();
+      inFlight[id] = now;
+      released.add(id);
+    }
+    if (inFlight.isEmpty) _inFlight.remove(peer);
+    if (waiting != null && waiting.isEmpty) _waiting.remove(peer);
+    return released;
+  }
+}
@@ -4,6 +4,7 @@ import 'package:logging/logging.dart';
 import 'package:pak_connect/domain/interfaces/i_mesh_routing_service.dart';
 import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
 import 'package:pak_connect/domain/routing/network_topology_analyzer.dart';
 import 'package:pak_connect/domain/services/ephemeral_key_manager.dart';
 import 'package:pak_connect/domain/constants/special_recipients.dart';
@@ -15,6 +16,7 @@ import '../../domain/values/id_types.dart';
 class RelayDecisionEngine {
   final Logger _logger;
   final ISeenMessageStore _seenMessageStore;
+  final ConnectionQualityMonitor _qualityMonitor;
   IMeshRoutingService? _routingService;
   NetworkTopologyAnalyzer? _topologyAnalyzer;
   String _currentNodeId;
@@ -29,10 +31,12 @@ class RelayDecisionEngine {
     required ISeenMessageStore seenMessageStore,
     IMeshRoutingService? routingService,
     NetworkTopologyAnalyzer? topologyAnalyzer,
+    ConnectionQualityMonitor? qualityMonitor,
     required String currentNodeId,
     String? myPersistentId,
   }) : _logger = logger,
        _seenMessageStore = seenMessageStore,
+       _qualityMonitor = qualityMonitor ?? ConnectionQualityMonitor.instance,
        _routingService = routingService,
        _topologyAnalyzer = topologyAnalyzer,
        _currentNodeId = currentNodeId,
@@ -228,12 +232,26 @@ class RelayDecisionEngine {
     }
   }
 
+  /// Pick the hop with the lowest expected time per delivery (ETX x RTT).
+  ///
+  /// Neighbours without history get a neutral cost, so a link known to be
+  /// good beats an unknown one and an unknown one beats a known-bad one.
+  /// Ties keep the caller's order.
   Future<String> _selectBestHopByQuality(List<String> validHops) async {
     if (validHops.length == 1) {
       return validHops.first;
     }
 
-    return validHops.first;
+    var bestHop = validHops.first;
+    var bestCost = _qualityMonitor.getLinkCost(bestHop);
+    for (final hop in validHops.skip(1)) {
+      final cost = _qualityMonitor.getLinkCost(hop);
+      if (cost < bestCost) {
+        bestHop = hop;
+        bestCost = cost;
+      }
+    }
+    return bestHop;
   }
 
   Future<ChatId?> chooseNextHopId({
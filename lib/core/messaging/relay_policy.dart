@@ -72,7 +72,10 @@ class RelayPolicy {
 
   /// Check if message type is a control message
   static bool _isControlMessage(ProtocolMessageType type) {
-    return type == ProtocolMessageType.ping || type == ProtocolMessageType.ack;
+    return type == ProtocolMessageType.ping ||
+        type == ProtocolMessageType.pong ||
+        type == ProtocolMessageType.ack ||
+        type == ProtocolMessageType.readReceipt;
   }
 
   /// Get relay-eligible message types (for documentation/testing)
@@ -0,0 +1,245 @@
+import 'dart:convert';
+
+import 'package:pak_connect/domain/entities/queue_enums.dart';
+import 'package:pak_connect/domain/entities/queued_message.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+
+/// Outcome of [RelayQueueQuota.admit]
+class RelayQuotaDecision {
+  final bool admitted;
+
+  /// Queued relay messages to evict before inserting the incoming one
+  final List<QueuedMessage> victims;
+
+  /// Which limit blocked the message, when not admitted
+  final String? reason;
+
+  const RelayQuotaDecision._(this.admitted, this.victims, this.reason);
+
+  static const RelayQuotaDecision admit = RelayQuotaDecision._(
+    true,
+    [],
+    null,
+  );
+
+  factory RelayQuotaDecision.evict(List<QueuedMessage> victims) =>
+      RelayQuotaDecision._(true, victims, null);
+
+  factory RelayQuotaDecision.reject(String reason) =>
+      RelayQuotaDecision._(false, const [], reason);
+}
+
+/// Byte quotas for messages this node queues on behalf of others.
+///
+/// Relayed messages are charged to their origin, their final destination
+/// and a global cap. Accounting is a ledger keyed by message ID, so a
+/// charge or release is O(1); only an insert that would break a quota pays
+/// for a reconcile against the live queue and a utility-ranked eviction.
+///
+/// Messages this node originated ([QueuedMessage.isOriginator], set by the
+/// local sender) are never charged: quotas bound what untrusted peers can
+/// make us store, and nothing a peer puts on the wire grants exemption.
+class RelayQueueQuota {
+  static const int defaultMaxTotalBytes = 2 * 1024 * 1024;
+  static const int defaultMaxBytesPerOrigin = 256 * 1024;
+  static const int defaultMaxBytesPerDestination = 256 * 1024;
+
+  final int maxTotalBytes;
+  final int maxBytesPerOrigin;
+  final int maxBytesPerDestination;
+
+  final Map<String, _Charge> _charges = {};
+  final Map<String, int> _bytesByOrigin = {};
+  final Map<String, int> _bytesByDestination = {};
+  int _totalBytes = 0;
+
+  RelayQueueQuota({
+    this.maxTotalBytes = defaultMaxTotalBytes,
+    this.maxBytesPerOrigin = defaultMaxBytesPerOrigin,
+    this.maxBytesPerDestination = defaultMaxBytesPerDestination,
+  });
+
+  int get totalBytes => _totalBytes;
+  int bytesFromOrigin(String origin) => _bytesByOrigin[origin] ?? 0;
+  int bytesToDestination(String destination) =>
+      _bytesByDestination[destination] ?? 0;
+
+  /// Whether [message] counts against relay quotas
+  static bool isCharged(QueuedMessage message) =>
+      message.isRelayMessage &&
+      message.relayMetadata != null &&
+      !message.isOriginator;
+
+  /// Expected value of keeping [message]; the lowest is evicted first.
+  ///
+  /// Product of: priority weight (1, 2, 4, 8 from low to urgent), fraction
+  /// of the bundle lifetime left, remaining spray budget (1 to 2x), and
+  /// fraction of the hop budget left. Delivered, failed and expired
+  /// messages are worth nothing.
+  static double utility(QueuedMessage message, DateTime now) {
+    if (message.status == QueuedMessageStatus.delivered ||
+        message.status == QueuedMessageStatus.failed) {
+      return 0;
+    }
+    final metadata = message.relayMetadata;
+    final priorityWeight = (1 << message.priority.index).toDouble();
+
+    final deadline = metadata?.deadline ?? message.expiresAt;
+    final lifetime = RelayMetadata.lifetimeFor(message.priority);
+    final lifeLeft = deadline == null
+        ? 1.0
+        : (deadline.difference(now).inMilliseconds / lifetime.inMilliseconds)
+              .clamp(0.0, 1.0);
+    if (lifeLeft <= 0) return 0;
+
+    final replicas = metadata?.replicas;
+    final replicaFactor = replicas == null
+        ? 1.0
+        : 1.0 +
+              replicas.clamp(0, RelayMetadata.defaultReplicaBudget) /
+                  RelayMetadata.defaultReplicaBudget;
+
+    final hopFactor = metadata == null || metadata.ttl <= 0
+        ? 1.0
+        : metadata.remainingHops.clamp(1, metadata.ttl) / metadata.ttl;
+
+    return priorityWeight * lifeLeft * replicaFactor * hopFactor;
+  }
+
+  /// Decide whether [incoming] fits, naming lower-utility victims from
+  /// [queued] when evicting them makes room.
+  RelayQuotaDecision admit(
+    QueuedMessage incoming,
+    Iterable<QueuedMessage> queued, {
+    DateTime? now,
+  }) {
+    if (!isCharged(incoming)) return RelayQuotaDecision.admit;
+    final charge = _Charge.of(incoming);
+    if (charge.bytes > maxTotalBytes ||
+        charge.bytes > maxBytesPerOrigin ||
+        charge.bytes > maxBytesPerDestination) {
+      return RelayQuotaDecision.reject('message larger than relay quota');
+    }
+    if (_fits(charge)) return RelayQuotaDecision.admit;
+
+    // The ledger can drift when messages leave the queue by paths that do
+    // not release them; rebuild it before evicting anything.
+    reconcile(queued);
+    if (_fits(charge)) return RelayQuotaDecision.admit;
+
+    final at = now ?? DateTime.now();
+    final incomingUtility = utility(incoming, at);
+    final candidates =
+        queued
+            .where((m) => isCharged(m) && m.id != incoming.id)
+            .map((m) => (message: m, utility: utility(m, at)))
+            .where((c) => c.utility < incomingUtility)
+            .toList()
+          ..sort((a, b) => a.utility.compareTo(b.utility));
+
+    var total = _totalBytes + charge.bytes;
+    var origin = bytesFromOrigin(charge.origin) + charge.bytes;
+    var destination = bytesToDestination(charge.destination) + charge.bytes;
+    final victims = <QueuedMessage>[];
+    for (final candidate in candidates) {
+      if (total <= maxTotalBytes &&
+          origin <= maxBytesPerOrigin &&
+          destination <= maxBytesPerDestination) {
+        break;
+      }
+      final victim = _Charge.of(candidate.message);
+      final sameOrigin = victim.origin == charge.origin;
+      final sameDestination = victim.destination == charge.destination;
+      final helps =
+          total > maxTotalBytes ||
+          (origin > maxBytesPerOrigin && sameOrigin) ||
+          (destination > maxBytesPerDestination && sameDestination);
+      if (!helps) continue;
+      victims.add(candidate.message);
+      total -= victim.bytes;
+      if (sameOrigin) origin -= victim.bytes;
+      if (sameDestination) destination -= victim.bytes;
+    }
+
+    if (total > maxTotalBytes) {
+      return RelayQuotaDecision.reject('relay storage full');
+    }
+    if (origin > maxBytesPerOrigin) {
+      return RelayQuotaDecision.reject('origin relay quota exceeded');
+    }
+    if (destination > maxBytesPerDestination) {
+      return RelayQuotaDecision.reject('destination relay quota exceeded');
+    }
+    return RelayQuotaDecision.evict(victims);
+  }
+
+  void charge(QueuedMessage message) {
+    if (!isCharged(message) || _charges.containsKey(message.id)) return;
+    final charge = _Charge.of(message);
+    _charges[message.id] = charge;
+    _apply(charge, 1);
+  }
+
+  void release(String messageId) {
+    final charge = _charges.remove(messageId);
+    if (charge != null) _apply(charge, -1);
+  }
+
+  /// Rebuild the ledger from the messages actually queued
+  void reconcile(Iterable<QueuedMessage> queued) {
+    clear();
+    for (final message in queued) {
+      charge(message);
+    }
+  }
+
+  void clear() {
+    _charges.clear();
+    _bytesByOrigin.clear();
+    _bytesByDestination.clear();
+    _totalBytes = 0;
+  }
+
+  bool _fits(_Charge charge) =>
+      _totalBytes + charge.bytes <= maxTotalBytes &&
+      bytesFromOrigin(charge.origin) + charge.bytes <= maxBytesPerOrigin &&
+      bytesToDestination(charge.destination) + charge.bytes <=
+          maxBytesPerDestination;
+
+  void _apply(_Charge charge, int sign) {
+    _totalBytes += sign * charge.bytes;
+    _adjust(_bytesByOrigin, charge.origin, sign * charge.bytes);
+    _adjust(_bytesByDestination, charge.destination, sign * charge.bytes);
+  }
+
+  static void _adjust(Map<String, int> totals, String key, int delta) {
+    final next = (totals[key] ?? 0) + delta;
+    if (next <= 0) {
+      totals.remove(key);
+    } else {
+      totals[key] = next;
+    }
+  }
+}
+
+class _Charge {
+  const _Charge(this.origin, this.destination, this.bytes);
+
+  final String origin;
+  final String destination;
+  final int bytes;
+
+  factory _Charge.of(QueuedMessage message) {
+    final metadata = message.relayMetadata!;
+    // A sealed sender hides the origin; charge the neighbour that handed
+    // the message over instead.
+    final origin = metadata.sealedSender
+        ? (message.relayNodeId ?? RelayMetadata.sealedSenderPlaceholder)
+        : metadata.originalSender;
+    return _Charge(
+      origin,
+      metadata.finalRecipient,
+      utf8.encode(message.content).length,
+    );
+  }
+}
@@ -1,12 +1,19 @@
 import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/entities/queue_enums.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
 import '../../domain/values/id_types.dart';
+import 'custody_manager.dart';
 
 /// Handles relay send pipeline (broadcast + next-hop delivery) independent of decision logic.
 class RelaySendPipeline {
+  /// Relay queue chat ID prefix for spray-and-wait copies held for direct
+  /// delivery to the destination.
+  static const String sprayWaitChatIdPrefix = 'spray_wait_';
+
   final Logger _logger;
   final OfflineMessageQueueContract _messageQueue;
   final SpamPreventionManager _spamPrevention;
@@ -24,6 +31,8 @@ class RelaySendPipeline {
     required String nextHopNodeId,
     Function(MeshRelayMessage, String)? onRelayMessage,
     Function(MessageId, MeshRelayMessage, String)? onRelayMessageIds,
+    bool custody = false,
+    bool isOriginator = false,
   }) async {
     try {
       MeshRelayMessage nextHopMessage;
@@ -35,9 +44,11 @@ class RelaySendPipeline {
         );
         return false;
       }
-      // Only persist originator hops; intermediate relays stay in-memory to
+      // Only persist originator hops and bundles taken into custody (bounded
+      // by CustodyManager); other intermediate relays stay in-memory to
       // prevent untrusted peers from exhausting local storage.
-      final persistToStorage = relayMessage.relayMetadata.isOriginator;
+      final persistToStorage =
+          relayMessage.relayMetadata.isOriginator || custody;
 
       await _spamPrevention.recordRelayOperation(
         fromNodeId: relayMessage.relayNodeId,
@@ -47,7 +58,11 @@ class RelaySendPipeline {
       );
 
       await _messageQueue.queueMessageWithIds(
-        chatId: ChatId('mesh_relay_$nextHopNodeId'),
+        chatId: ChatId(
+          custody
+              ? '${CustodyManager.chatIdPrefix}$nextHopNodeId'
+              : 'mesh_relay_$nextHopNodeId',
+        ),
         content: nextHopMessage.originalContent,
         recipientId: ChatId(nextHopNodeId),
         senderId: ChatId(nextHopMessage.relayMetadata.originalSender),
@@ -58,6 +73,11 @@ class RelaySendPipeline {
         relayNodeId: relayMessage.relayNodeId,
         messageHash: nextHopMessage.relayMetadata.messageHash,
         persistToStorage: persistToStorage,
+        isOriginator: isOriginator,
+      );
+      ConnectionQualityMonitor.instance.recordMessageSent(
+        nextHopNodeId,
+        nextHopMessage.originalMessageId,
       );
 
       onRelayMessage?.call(nextHopMessage, nextHopNodeId);
@@ -79,17 +99,38 @@ class RelaySendPipeline {
         'Relayed message $truncatedMessageId... to $truncatedNextHop...',
       );
       return true;
+    } on MessageQueueException catch (e) {
+      // Relay quota refused the bundle; drop it like any other hop limit.
+      _logger.info('🚫 Relay drop to $nextHopNodeId: ${e.message}');
+      return false;
     } catch (e) {
       _logger.severe('Failed to relay to next hop: $e');
       throw RelayException('Failed to relay message: $e');
     }
   }
 
+  /// Drop the queued copies of [originalMessageId] for [nextHopNodeId]
+  /// that have not gone out yet; returns how many were removed.
+  Future<int> withdrawFromNextHop(
+    String originalMessageId,
+    String nextHopNodeId,
+  ) async {
+    final copies = _messageQueue.relayCopiesFor(
+      originalMessageId,
+      nextHopNodeId,
+    );
+    for (final copy in copies) {
+      await _messageQueue.removeMessage(copy.id);
+    }
+    return copies.length;
+  }
+
   Future<int> broadcastToNeighbors({
     required MeshRelayMessage relayMessage,
     required List<String> availableNeighbors,
     Function(MeshRelayMessage, String)? onRelayMessage,
     Function(MessageId, MeshRelayMessage, String)? onRelayMessageIds,
+    bool isOriginator = false,
   }) async {
     try {
       // Only persist originator broadcasts; intermediate relays stay in-memory.
@@ -108,21 +149,33 @@ class RelaySendPipeline {
         return 0;
       }
 
+      final metadata = relayMessage.relayMetadata;
+      final plan = planSpray(
+        // Stealth hides the destination, so the wait phase could never end.
+        replicas: metadata.usesStealth ? null : metadata.replicas,
+        neighbors: validNeighbors,
+        destination: metadata.finalRecipient,
+      );
+
       final truncatedMessageId = relayMessage.originalMessageId.length > 16
           ? relayMessage.originalMessageId.shortId()
           : relayMessage.originalMessageId;
       _logger.info(
-        '📣 Broadcasting message $truncatedMessageId... to ${validNeighbors.length} neighbor(s)',
+        '📣 Broadcasting message $truncatedMessageId... to ${plan.shares.length} neighbor(s)'
+        '${plan.kept > 0 ? ' (keeping ${plan.kept} of ${metadata.replicas} copies)' : ''}',
       );
 
       int successCount = 0;
       int failCount = 0;
 
-      for (final neighborId in validNeighbors) {
+      for (final neighborId in plan.shares.keys) {
         try {
           MeshRelayMessage nextHopMessage;
           try {
-            nextHopMessage = relayMessage.nextHop(neighborId);
+            nextHopMessage = relayMessage.nextHop(
+              neighborId,
+              replicas: plan.shares[neighborId],
+            );
           } catch (e) {
             failCount++;
             final truncatedNeighbor = neighborId.length > 8
@@ -153,6 +206,7 @@ class RelaySendPipeline {
             relayNodeId: relayMessage.relayNodeId,
             messageHash: nextHopMessage.relayMetadata.messageHash,
             persistToStorage: persistToStorage,
+            isOriginator: isOriginator,
           );
 
           onRelayMessage?.call(nextHopMessage, neighborId);
@@ -182,6 +236,16 @@ class RelaySendPipeline {
         }
       }
 
+      if (plan.kept > 0 &&
+          await _queueWaitCopy(
+            relayMessage,
+            plan.kept,
+            persistToStorage: persistToStorage,
+            isOriginator: isOriginator,
+          )) {
+        successCount++;
+      }
+
       _logger.info(
         '📣 Broadcast complete: $successCount success, $failCount failed (total: ${validNeighbors.length})',
       );
@@ -191,4 +255,73 @@ class RelaySendPipeline {
       throw RelayException('Failed to broadcast message: $e');
     }
   }
+
+  /// Binary spray-and-wait split of a replica budget over [neighbors].
+  ///
+  /// Unbudgeted bundles (`replicas == null`) go to every neighbour. A
+  /// destination in range gets the bundle directly and nobody else does.
+  /// Otherwise each neighbour takes half of the copies still held, and the
+  /// remainder ([kept]) waits for direct delivery to the destination.
+  static ({Map<String, int?> shares, int kept}) planSpray({
+    required int? replicas,
+    required List<String> neighbors,
+    required String destination,
+  }) {
+    if (replicas == null) {
+      return (shares: {for (final id in neighbors) id: null}, kept: 0);
+    }
+    if (neighbors.contains(destination)) {
+      return (shares: {destination: 1}, kept: 0);
+    }
+    final shares = <String, int?>{};
+    var remaining = replicas;
+    for (final neighborId in neighbors) {
+      if (remaining <= 1) break;
+      final share = remaining ~/ 2;
+      shares[neighborId] = share;
+      remaining -= share;
+    }
+    return (shares: shares, kept: remaining);
+  }
+
+  /// Hold the copies left after spraying for direct delivery only: the
+  /// queue releases them when the destination itself connects.
+  Future<bool> _queueWaitCopy(
+    MeshRelayMessage relayMessage,
+    int replicas, {
+    required bool persistToStorage,
+    required bool isOriginator,
+  }) async {
+    final destination = relayMessage.relayMetadata.finalRecipient;
+    MeshRelayMessage waitMessage;
+    try {
+      waitMessage = relayMessage.nextHop(destination, replicas: replicas);
+    } catch (e) {
+      _logger.fine('⏳ No wait copy (TTL/path exhausted): $e');
+      return false;
+    }
+
+    // The neighbours already hold their copies; a rejected wait copy (e.g.
+    // over quota) must not fail the broadcast.
+    try {
+      await _messageQueue.queueMessageWithIds(
+        chatId: ChatId('$sprayWaitChatIdPrefix$destination'),
+        content: waitMessage.originalContent,
+        recipientId: ChatId(destination),
+        senderId: ChatId(waitMessage.relayMetadata.originalSender),
+        priority: waitMessage.relayMetadata.priority,
+        isRelayMessage: true,
+        relayMetadata: waitMessage.relayMetadata,
+        originalMessageId: waitMessage.originalMessageId,
+        relayNodeId: relayMessage.relayNodeId,
+        messageHash: waitMessage.relayMetadata.messageHash,
+        persistToStorage: persistToStorage,
+        isOriginator: isOriginator,
+      );
+    } catch (e) {
+      _logger.warning('⏳ Wait copy not queued: $e');
+      return false;
+    }
+    return true;
+  }
 }
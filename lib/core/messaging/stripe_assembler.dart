@@ -0,0 +1,113 @@
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/utils/stripe_codec.dart';
+import 'package:pak_connect/domain/utils/string_extensions.dart';
+
+import 'multipath_relay_sender.dart';
+
+/// Destination-side reassembly of striped transfers.
+///
+/// Blocks are held per transfer until any `dataBlocks` of them are in,
+/// whichever route they came over. Partial transfers are bounded in count
+/// and dropped once their bundle deadline passes, and a block whose stripe
+/// position is outside what [MultipathRelaySender] would produce is
+/// rejected before anything is allocated for it.
+class StripeAssembler {
+  static const int maxPendingTransfers = 16;
+
+  final Logger _logger;
+  final Map<String, _PendingTransfer> _pending = {};
+  final Set<String> _completed = {};
+
+  StripeAssembler({required Logger logger}) : _logger = logger;
+
+  /// Add one block; returns the whole transfer as a single relay message
+  /// (under the transfer ID) once it can be rebuilt, otherwise `null`.
+  MeshRelayMessage? add(MeshRelayMessage block, {DateTime? now}) {
+    final stripe = block.relayMetadata.stripe;
+    if (stripe == null || _completed.contains(stripe.transferId)) return null;
+    if (!isWellFormed(stripe)) {
+      _logger.warning('Rejecting out-of-range stripe for ${stripe.transferId}');
+      return null;
+    }
+    _expire(now ?? DateTime.now());
+
+    final pending = _pending.putIfAbsent(stripe.transferId, () {
+      if (_pending.length >= maxPendingTransfers) {
+        _pending.remove(_pending.keys.first);
+      }
+      return _PendingTransfer(
+        stripe: stripe,
+        deadline: block.relayMetadata.deadline,
+      );
+    });
+    if (stripe.dataBlocks != pending.stripe.dataBlocks ||
+        stripe.length != pending.stripe.length) {
+      _logger.warning('Inconsistent stripe block for ${stripe.transferId}');
+      return null;
+    }
+    pending.blocks[stripe.index] = block.originalContent;
+
+    final String? content;
+    try {
+      content = StripeCodec.decode(
+        pending.blocks,
+        dataBlocks: stripe.dataBlocks,
+        length: stripe.length,
+      );
+    } on FormatException catch (e) {
+      _logger.warning('Dropping corrupt striped transfer: $e');
+      _pending.remove(stripe.transferId);
+      return null;
+    }
+    if (content == null) return null;
+
+    _pending.remove(stripe.transferId);
+    _completed.add(stripe.transferId);
+    if (_completed.length > maxPendingTransfers * 4) {
+      _completed.remove(_completed.first);
+    }
+
+    final truncatedId = stripe.transferId.length > 16
+        ? stripe.transferId.shortId()
+        : stripe.transferId;
+    _logger.info(
+      '🔀 Reassembled $truncatedId... from ${pending.blocks.length} of '
+      '${stripe.dataBlocks + 1} blocks',
+    );
+    return MeshRelayMessage(
+      originalMessageId: stripe.transferId,
+      originalContent: content,
+      relayMetadata: block.relayMetadata,
+      relayNodeId: block.relayNodeId,
+      relayedAt: block.relayedAt,
+      originalMessageType: block.originalMessageType,
+    );
+  }
+
+  int get pendingTransfers => _pending.length;
+
+  /// Whether [stripe]'s block count, index and length are within the
+  /// sender's limits
+  static bool isWellFormed(RelayStripe stripe) {
+    final k = stripe.dataBlocks;
+    return k >= 1 &&
+        k <= MultipathRelaySender.maxDataBlocks &&
+        stripe.index >= 0 &&
+        stripe.index <= k &&
+        stripe.length >= 0 &&
+        stripe.length <= k * MultipathRelaySender.targetBlockBytes;
+  }
+
+  void _expire(DateTime now) {
+    _pending.removeWhere((_, pending) => now.isAfter(pending.deadline));
+  }
+}
+
+class _PendingTransfer {
+  _PendingTransfer({required this.stripe, required this.deadline});
+
+  final RelayStripe stripe;
+  final DateTime deadline;
+  final Map<int, String> blocks = {};
+}
@@ -15,8 +15,14 @@ class AppCoreSharedMessageQueueProvider implements ISharedMessageQueueProvider {
   @override
   bool get isInitializing => _appCore.isInitializing;
 
+  /// Completes once the transport is up too, since runtime consumers
+  /// resolve BLE and mesh services right after; the queue itself is
+  /// usable from [isInitialized].
   @override
-  Future<void> initialize() => _appCore.initialize();
+  Future<void> initialize() async {
+    await _appCore.initialize();
+    await _appCore.connectivityReady;
+  }
 
   @override
   OfflineMessageQueueContract get messageQueue => _appCore.messageQueue;
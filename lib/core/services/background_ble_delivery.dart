@@ -0,0 +1,111 @@
+// BLE transport for queued messages during background wakeups
+
+import 'dart:async';
+
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/interfaces/i_connection_service.dart';
+import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
+import 'package:pak_connect/domain/utils/string_extensions.dart';
+
+/// Delivers queued messages over BLE from a background wakeup.
+///
+/// The BLE stack is started only when the runner offers the first message,
+/// so wakeups that just prune never touch the radio. The first message then
+/// waits up to [connectWindow] for a link; later ones use whatever link is
+/// up. A message is sent only when the connected peer is its recipient, the
+/// same rule the foreground queue applies, and a completed GATT write counts
+/// as handed over (receivers drop re-sends by message ID).
+class BackgroundBleDelivery {
+  static final _logger = Logger('BackgroundBleDelivery');
+
+  BackgroundBleDelivery({
+    required Future<IConnectionService> Function() startTransport,
+    Future<void> Function()? stopTransport,
+    this.connectWindow = const Duration(seconds: 8),
+  }) : _startTransport = startTransport,
+       _stopTransport = stopTransport;
+
+  final Future<IConnectionService> Function() _startTransport;
+  final Future<void> Function()? _stopTransport;
+  final Duration connectWindow;
+
+  Future<IConnectionService?>? _transport;
+  bool _waitedForLink = false;
+
+  /// [BackgroundDeliveryHandler] entry point
+  Future<bool> call(QueuedMessage message) async {
+    if (message.recipientPublicKey.isEmpty) return false;
+    final service = await (_transport ??= _start());
+    if (service == null || !await _awaitLink(service)) return false;
+
+    if (!_isConnectedPeer(service, message.recipientPublicKey)) {
+      _logger.fine(
+        '🌙 Recipient of ${message.id.shortId()}... not connected - deferring',
+      );
+      return false;
+    }
+
+    return service.hasPeripheralConnection
+        ? service.sendPeripheralMessage(message.content, messageId: message.id)
+        : service.sendMessage(
+            message.content,
+            messageId: message.id,
+            originalIntendedRecipient: message.recipientPublicKey,
+          );
+  }
+
+  Future<void> dispose() async {
+    final transport = _transport;
+    if (transport == null) return;
+    _transport = null;
+    final service = await transport;
+    try {
+      await service?.stopScanning();
+    } catch (e) {
+      _logger.fine('Background scan stop failed: $e');
+    }
+    try {
+      await _stopTransport?.call();
+    } catch (e) {
+      _logger.warning('Background BLE shutdown failed: $e');
+    }
+  }
+
+  Future<IConnectionService?> _start() async {
+    try {
+      final service = await _startTransport();
+      await service.startScanning();
+      _logger.info('🌙 Background BLE transport started');
+      return service;
+    } catch (e) {
+      _logger.warning('🌙 Background BLE transport unavailable: $e');
+      return null;
+    }
+  }
+
+  Future<bool> _awaitLink(IConnectionService service) async {
+    if (service.canSendMessages) return true;
+    if (_waitedForLink) return false;
+    _waitedForLink = true;
+    try {
+      await service.connectionInfo
+          .firstWhere((_) => service.canSendMessages)
+          .timeout(connectWindow);
+      return true;
+    } on TimeoutException {
+      _logger.info('🌙 No peer link within ${connectWindow.inSeconds}s');
+      return false;
+    } on StateError {
+      return false;
+    }
+  }
+
+  static bool _isConnectedPeer(IConnectionService service, String peerId) {
+    final connected = <String?>{
+      service.currentSessionId,
+      service.theirEphemeralId,
+      service.theirPersistentKey,
+    };
+    return connected.contains(peerId);
+  }
+}
@@ -0,0 +1,526 @@
+// Budgeted relay/queue work for OS-granted background wakeups
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:isolate';
+import 'dart:ui' show IsolateNameServer;
+
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/entities/enhanced_message.dart';
+import 'package:pak_connect/domain/entities/message.dart';
+import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
+import 'package:pak_connect/domain/interfaces/i_preferences_repository.dart';
+import 'package:pak_connect/domain/interfaces/i_repository_provider.dart';
+import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
+import 'package:pak_connect/domain/interfaces/i_user_preferences.dart';
+import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
+import 'package:pak_connect/domain/utils/string_extensions.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+
+import '../messaging/mesh_relay_engine.dart';
+import '../messaging/offline_message_queue.dart';
+import 'message_queue_repository.dart';
+import 'queue_persistence_manager.dart';
+
+/// Attempts delivery of a queued message from a background wakeup.
+///
+/// Returns `true` when the message was handed to a transport and can be
+/// marked delivered, `false` when no route is available right now.
+typedef BackgroundDeliveryHandler = Future<bool> Function(QueuedMessage message);
+
+/// Marks the foreground queue owner as alive for wakeups in the same process.
+///
+/// The foreground [OfflineMessageQueue] keeps its own in-memory view of the
+/// queue, so a wakeup that removed or failed rows underneath it would make
+/// the two diverge. AppCore [claim]s ownership once its queue is up and
+/// [release]s it on dispose; wakeups skip (or stop early) while it is held.
+class ForegroundQueueOwnership {
+  static const String portName = 'pak_connect.foreground_queue';
+
+  static ReceivePort? _port;
+
+  static void claim() {
+    if (_port != null) return;
+    final port = ReceivePort();
+    IsolateNameServer.removePortNameMapping(portName);
+    IsolateNameServer.registerPortWithName(port.sendPort, portName);
+    _port = port;
+  }
+
+  static void release() {
+    final port = _port;
+    if (port == null) return;
+    IsolateNameServer.removePortNameMapping(portName);
+    port.close();
+    _port = null;
+  }
+
+  /// Whether a foreground queue in this process currently owns the queue
+  static bool get isHeld =>
+      IsolateNameServer.lookupPortByName(portName) != null;
+}
+
+/// Time and work limits for a single background wakeup.
+///
+/// Android WorkManager and iOS BGTaskScheduler both kill tasks that overrun
+/// their slice, so the runner stops [safetyMargin] before [timeBudget] to
+/// leave room for the final checkpoint write.
+class BackgroundWorkBudget {
+  const BackgroundWorkBudget({
+    this.timeBudget = const Duration(seconds: 25),
+    this.safetyMargin = const Duration(seconds: 3),
+    this.maxMessages = 50,
+    this.checkpointEvery = 10,
+  });
+
+  final Duration timeBudget;
+  final Duration safetyMargin;
+  final int maxMessages;
+
+  /// Persist the checkpoint after this many processed messages so an OS kill
+  /// mid-batch loses at most one slice of progress.
+  final int checkpointEvery;
+
+  Duration get usableTime {
+    final usable = timeBudget - safetyMargin;
+    return usable.isNegative ? Duration.zero : usable;
+  }
+}
+
+/// Progress persisted between background wakeups.
+class BackgroundRelayCheckpoint {
+  const BackgroundRelayCheckpoint({
+    this.resumeAfterMessageId,
+    this.totalWakeups = 0,
+    this.totalProcessed = 0,
+    this.lastWakeupAt,
+  });
+
+  /// Last message handled by the previous wakeup; the next one starts after it
+  /// so a backlog larger than one batch is drained round-robin.
+  final String? resumeAfterMessageId;
+  final int totalWakeups;
+  final int totalProcessed;
+  final DateTime? lastWakeupAt;
+
+  static const BackgroundRelayCheckpoint empty = BackgroundRelayCheckpoint();
+
+  BackgroundRelayCheckpoint copyWith({
+    String? resumeAfterMessageId,
+    int? totalWakeups,
+    int? totalProcessed,
+    DateTime? lastWakeupAt,
+  }) {
+    return BackgroundRelayCheckpoint(
+      resumeAfterMessageId: resumeAfterMessageId ?? this.resumeAfterMessageId,
+      totalWakeups: totalWakeups ?? this.totalWakeups,
+      totalProcessed: totalProcessed ?? this.totalProcessed,
+      lastWakeupAt: lastWakeupAt ?? this.lastWakeupAt,
+    );
+  }
+
+  Map<String, dynamic> toJson() => {
+    'resumeAfterMessageId': resumeAfterMessageId,
+    'totalWakeups': totalWakeups,
+    'totalProcessed': totalProcessed,
+    'lastWakeupAt': lastWakeupAt?.millisecondsSinceEpoch,
+  };
+
+  factory BackgroundRelayCheckpoint.fromJson(Map<String, dynamic> json) {
+    final lastWakeupMillis = json['lastWakeupAt'] as int?;
+    return BackgroundRelayCheckpoint(
+      resumeAfterMessageId: json['resumeAfterMessageId'] as String?,
+      totalWakeups: json['totalWakeups'] as int? ?? 0,
+      totalProcessed: json['totalProcessed'] as int? ?? 0,
+      lastWakeupAt: lastWakeupMillis != null
+          ? DateTime.fromMillisecondsSinceEpoch(lastWakeupMillis)
+          : null,
+    );
+  }
+}
+
+/// Work done during a single background wakeup.
+class BackgroundWakeupReport {
+  const BackgroundWakeupReport({
+    required this.restoreTime,
+    required this.workTime,
+    required this.candidates,
+    required this.processed,
+    required this.delivered,
+    required this.deferred,
+    required this.failed,
+    required this.expired,
+    required this.duplicates,
+    required this.budgetExhausted,
+    required this.checkpoint,
+  });
+
+  final Duration restoreTime;
+  final Duration workTime;
+  final int candidates;
+  final int processed;
+  final int delivered;
+  final int deferred;
+  final int failed;
+  final int expired;
+  final int duplicates;
+  final bool budgetExhausted;
+  final BackgroundRelayCheckpoint checkpoint;
+
+  Map<String, dynamic> toJson() => {
+    'restoreTimeMs': restoreTime.inMilliseconds,
+    'workTimeMs': workTime.inMilliseconds,
+    'candidates': candidates,
+    'processed': processed,
+    'delivered': delivered,
+    'deferred': deferred,
+    'failed': failed,
+    'expired': expired,
+    'duplicates': duplicates,
+    'budgetExhausted': budgetExhausted,
+    'totalWakeups': checkpoint.totalWakeups,
+  };
+
+  @override
+  String toString() =>
+      'BackgroundWakeup(processed: $processed/$candidates, delivered: $delivered, '
+      'deferred: $deferred, expired: $expired, duplicates: $duplicates, '
+      'failed: $failed, restore: ${restoreTime.inMilliseconds}ms, '
+      'work: ${workTime.inMilliseconds}ms, exhausted: $budgetExhausted)';
+}
+
+/// Minimal service graph restored for background wakeups.
+///
+/// Only the pieces relaying needs are brought up: database, identity keyring,
+/// seen-message filter and the persisted queue. Notification, archive,
+/// monitoring and UI-facing services stay cold, and the BLE stack starts only
+/// once there is something to deliver, which is what keeps restore inside a
+/// few hundred milliseconds instead of the full `AppCore.initialize` sequence.
+class BackgroundServiceGraph {
+  static final _logger = Logger('BackgroundServiceGraph');
+
+  BackgroundServiceGraph({
+    required this.databaseProvider,
+    required this.userPreferences,
+    required this.preferencesRepository,
+    required this.seenMessageStore,
+    this.repositoryProvider,
+    OfflineMessageQueue? messageQueue,
+  }) : messageQueue = messageQueue ?? OfflineMessageQueue();
+
+  final IDatabaseProvider databaseProvider;
+  final IUserPreferences userPreferences;
+  final IPreferencesRepository preferencesRepository;
+  final ISeenMessageStore seenMessageStore;
+  final IRepositoryProvider? repositoryProvider;
+  final OfflineMessageQueue messageQueue;
+
+  bool _restored = false;
+
+  bool get isRestored => _restored;
+
+  /// Restore the graph and return how long it took.
+  Future<Duration> restore() async {
+    final stopwatch = Stopwatch()..start();
+    if (_restored) return Duration.zero;
+
+    await databaseProvider.database;
+    MessageQueueRepository.configureDefaultDatabaseProvider(databaseProvider);
+    QueuePersistenceManager.configureDefaultDatabaseProvider(databaseProvider);
+
+    // Keyring and seen filter are independent of each other.
+    await Future.wait<void>([
+      userPreferences.getOrCreateKeyPair(),
+      seenMessageStore.initialize(),
+    ]);
+    MeshRelayEngine.configureDependencyResolvers(
+      seenMessageStoreResolver: () => seenMessageStore,
+      repositoryProviderResolver: () => repositoryProvider,
+    );
+
+    await messageQueue.initialize(
+      onMessageDelivered: _persistDeliveredMessage,
+      repositoryProvider: repositoryProvider,
+      databaseProvider: databaseProvider,
+    );
+
+    _restored = true;
+    stopwatch.stop();
+    _logger.info(
+      '🌙 Background graph restored in ${stopwatch.elapsedMilliseconds}ms',
+    );
+    return stopwatch.elapsed;
+  }
+
+  /// Mirrors AppCore's queue → repository hand-off so messages delivered in
+  /// the background still land in chat history.
+  Future<void> _persistDeliveredMessage(QueuedMessage queuedMessage) async {
+    final provider = repositoryProvider;
+    if (provider == null || queuedMessage.isRelayMessage) return;
+    try {
+      await provider.messageRepository.saveMessage(
+        EnhancedMessage(
+          id: MessageId(queuedMessage.id),
+          chatId: ChatId(queuedMessage.chatId),
+          content: queuedMessage.content,
+          timestamp: queuedMessage.queuedAt,
+          isFromMe: true,
+          status: MessageStatus.delivered,
+          replyToMessageId: queuedMessage.replyToMessageId != null
+              ? MessageId(queuedMessage.replyToMessageId!)
+              : null,
+        ),
+      );
+    } catch (e) {
+      _logger.warning(
+        'Failed to persist background delivery ${queuedMessage.id.shortId()}...: $e',
+      );
+    }
+  }
+
+  void dispose() {
+    if (!_restored) return;
+    messageQueue.dispose();
+    MeshRelayEngine.clearDependencyResolvers();
+    _restored = false;
+  }
+}
+
+/// Processes a bounded batch of queued and relay work per background wakeup.
+///
+/// Each wakeup:
+/// 1. drops expired messages and relay copies the seen filter already handled,
+/// 2. offers the rest to [BackgroundDeliveryHandler] in priority order,
+///    resuming after the last message handled by the previous wakeup,
+/// 3. stops before the OS budget runs out and checkpoints progress.
+class BackgroundRelayRunner {
+  static final _logger = Logger('BackgroundRelayRunner');
+
+  static const String checkpointKey = 'background_relay_checkpoint';
+  static const String lastReportKey = 'background_relay_last_report';
+
+  BackgroundRelayRunner({
+    required OfflineMessageQueueContract messageQueue,
+    required ISeenMessageStore seenMessageStore,
+    required IPreferencesRepository preferencesRepository,
+    BackgroundDeliveryHandler? deliveryHandler,
+    bool Function()? shouldYield,
+    DateTime Function()? clock,
+  }) : _messageQueue = messageQueue,
+       _seenMessageStore = seenMessageStore,
+       _preferencesRepository = preferencesRepository,
+       _deliveryHandler = deliveryHandler,
+       _shouldYield = shouldYield,
+       _clock = clock ?? DateTime.now;
+
+  factory BackgroundRelayRunner.forGraph(
+    BackgroundServiceGraph graph, {
+    BackgroundDeliveryHandler? deliveryHandler,
+    bool Function()? shouldYield,
+  }) {
+    return BackgroundRelayRunner(
+      messageQueue: graph.messageQueue,
+      seenMessageStore: graph.seenMessageStore,
+      preferencesRepository: graph.preferencesRepository,
+      deliveryHandler: deliveryHandler,
+      shouldYield: shouldYield,
+    );
+  }
+
+  final OfflineMessageQueueContract _messageQueue;
+  final ISeenMessageStore _seenMessageStore;
+  final IPreferencesRepository _preferencesRepository;
+  final BackgroundDeliveryHandler? _deliveryHandler;
+
+  /// Checked before each message; true stops the batch (e.g. the foreground
+  /// app came up and now owns the queue).
+  final bool Function()? _shouldYield;
+  final DateTime Function() _clock;
+
+  /// Run one budgeted wakeup.
+  Future<BackgroundWakeupReport> runWakeup({
+    BackgroundWorkBudget budget = const BackgroundWorkBudget(),
+    Duration restoreTime = Duration.zero,
+  }) async {
+    final stopwatch = Stopwatch()..start();
+    var checkpoint = await loadCheckpoint();
+    final candidates = _orderCandidates(
+      _messageQueue.getPendingMessages(),
+      checkpoint.resumeAfterMessageId,
+    );
+
+    var processed = 0;
+    var delivered = 0;
+    var deferred = 0;
+    var failed = 0;
+    var expired = 0;
+    var duplicates = 0;
+    var exhausted = false;
+    String? lastHandledId = checkpoint.resumeAfterMessageId;
+
+    for (final message in candidates) {
+      if (processed >= budget.maxMessages ||
+          stopwatch.elapsed >= budget.usableTime ||
+          (_shouldYield?.call() ?? false)) {
+        exhausted = true;
+        break;
+      }
+
+      final outcome = await _processMessage(message);
+      processed++;
+      lastHandledId = message.id;
+      switch (outcome) {
+        case _BackgroundOutcome.delivered:
+          delivered++;
+        case _BackgroundOutcome.deferred:
+          deferred++;
+        case _BackgroundOutcome.failed:
+          failed++;
+        case _BackgroundOutcome.expired:
+          expired++;
+        case _BackgroundOutcome.duplicate:
+          duplicates++;
+      }
+
+      if (budget.checkpointEvery > 0 &&
+          processed % budget.checkpointEvery == 0) {
+        await _saveCheckpoint(
+          checkpoint.copyWith(resumeAfterMessageId: lastHandledId),
+        );
+      }
+    }
+
+    // A fully drained pass restarts from the head next time.
+    checkpoint = BackgroundRelayCheckpoint(
+      resumeAfterMessageId: exhausted ? lastHandledId : null,
+      totalWakeups: checkpoint.totalWakeups + 1,
+      totalProcessed: checkpoint.totalProcessed + processed,
+      lastWakeupAt: _clock(),
+    );
+    await _saveCheckpoint(checkpoint);
+    stopwatch.stop();
+
+    final report = BackgroundWakeupReport(
+      restoreTime: restoreTime,
+      workTime: stopwatch.elapsed,
+      candidates: candidates.length,
+      processed: processed,
+      delivered: delivered,
+      deferred: deferred,
+      failed: failed,
+      expired: expired,
+      duplicates: duplicates,
+      budgetExhausted: exhausted,
+      checkpoint: checkpoint,
+    );
+    await _saveReport(report);
+    _logger.info('🌙 $report');
+    return report;
+  }
+
+  /// Load the persisted checkpoint, falling back to an empty one.
+  Future<BackgroundRelayCheckpoint> loadCheckpoint() async {
+    try {
+      final raw = await _preferencesRepository.getString(checkpointKey);
+      if (raw.isEmpty) return BackgroundRelayCheckpoint.empty;
+      return BackgroundRelayCheckpoint.fromJson(
+        jsonDecode(raw) as Map<String, dynamic>,
+      );
+    } catch (e) {
+      _logger.warning('Discarding unreadable background checkpoint: $e');
+      return BackgroundRelayCheckpoint.empty;
+    }
+  }
+
+  /// Report from the most recent wakeup, for diagnostics screens.
+  Future<Map<String, dynamic>?> loadLastReport() async {
+    try {
+      final raw = await _preferencesRepository.getString(lastReportKey);
+      if (raw.isEmpty) return null;
+      return jsonDecode(raw) as Map<String, dynamic>;
+    } catch (e) {
+      _logger.fine('No readable background report: $e');
+      return null;
+    }
+  }
+
+  Future<_BackgroundOutcome> _processMessage(QueuedMessage message) async {
+    final now = _clock();
+    final expiresAt = message.expiresAt;
+    if (expiresAt != null && now.isAfter(expiresAt)) {
+      await _messageQueue.removeMessage(message.id);
+      return _BackgroundOutcome.expired;
+    }
+
+    if (message.isRelayMessage) {
+      final originalId = message.originalMessageId ?? message.id;
+      if (_seenMessageStore.hasDelivered(originalId)) {
+        await _messageQueue.removeMessage(message.id);
+        return _BackgroundOutcome.duplicate;
+      }
+    }
+
+    final handler = _deliveryHandler;
+    if (handler == null) return _BackgroundOutcome.deferred;
+
+    try {
+      final sent = await handler(message);
+      if (!sent) return _BackgroundOutcome.deferred;
+      await _messageQueue.markMessageDelivered(message.id);
+      if (message.isRelayMessage) {
+        await _seenMessageStore.markDelivered(
+          message.originalMessageId ?? message.id,
+        );
+      }
+      return _BackgroundOutcome.delivered;
+    } catch (e) {
+      _logger.warning(
+        'Background delivery failed for ${message.id.shortId()}...: $e',
+      );
+      await _messageQueue.markMessageFailed(message.id, 'background: $e');
+      return _BackgroundOutcome.failed;
+    }
+  }
+
+  /// Priority order (then FIFO), rotated to start after [resumeAfterId].
+  List<QueuedMessage> _orderCandidates(
+    List<QueuedMessage> pending,
+    String? resumeAfterId,
+  ) {
+    final ordered = List<QueuedMessage>.of(pending)
+      ..sort((a, b) {
+        final priorityCompare = b.priority.index.compareTo(a.priority.index);
+        if (priorityCompare != 0) return priorityCompare;
+        return a.queuedAt.compareTo(b.queuedAt);
+      });
+    if (resumeAfterId == null) return ordered;
+
+    final index = ordered.indexWhere((m) => m.id == resumeAfterId);
+    if (index < 0 || index == ordered.length - 1) return ordered;
+    return [...ordered.sublist(index + 1), ...ordered.sublist(0, index + 1)];
+  }
+
+  Future<void> _saveCheckpoint(BackgroundRelayCheckpoint checkpoint) async {
+    try {
+      await _preferencesRepository.setString(
+        checkpointKey,
+        jsonEncode(checkpoint.toJson()),
+      );
+    } catch (e) {
+      _logger.warning('Failed to persist background checkpoint: $e');
+    }
+  }
+
+  Future<void> _saveReport(BackgroundWakeupReport report) async {
+    try {
+      await _preferencesRepository.setString(
+        lastReportKey,
+        jsonEncode(report.toJson()),
+      );
+    } catch (e) {
+      _logger.fine('Failed to persist background report: $e');
+    }
+  }
+}
+
+enum _BackgroundOutcome { delivered, deferred, failed, expired, duplicate }
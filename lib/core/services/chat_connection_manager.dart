@@ -10,6 +10,8 @@ import '../../domain/models/connection_info.dart';
 import 'package:pak_connect/domain/services/device_deduplication_manager.dart'
     show DiscoveredDevice;
 import 'package:pak_connect/domain/interfaces/i_connection_service.dart';
+import 'package:pak_connect/domain/services/app_event_channels.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 
 /// Service for managing chat connection status determination
 ///
@@ -26,13 +28,23 @@ class ChatConnectionManager implements IChatConnectionManager {
   final _logger = Logger('ChatConnectionManager');
 
   final IConnectionService? _bleService;
-  final Set<void Function(ConnectionStatus)> _connectionStatusListeners = {};
+  final TypedEventBus _eventBus;
+  final bool _ownsEventBus;
+  late final EventChannel<ConnectionStatus> _connectionStatus = _eventBus
+      .channel(AppEventChannels.connectionStatus);
 
   StreamSubscription? _peripheralConnectionSubscription;
   StreamSubscription? _discoveryDataSubscription;
 
-  ChatConnectionManager({IConnectionService? bleService})
-    : _bleService = bleService;
+  /// Statuses go out on [eventBus] (the app bus) or on a private bus.
+  ChatConnectionManager({
+    IConnectionService? bleService,
+    TypedEventBus? eventBus,
+  }) : _bleService = bleService,
+       _ownsEventBus = eventBus == null,
+       _eventBus =
+           eventBus ??
+           AppEventChannels.createBus(logger: Logger('ChatConnectionManager'));
 
   @override
   Future<void> initialize() async {
@@ -170,18 +182,14 @@ class ChatConnectionManager implements IChatConnectionManager {
     return false;
   }
 
+  /// Discovery updates arrive in bursts and subscribers only refresh the
+  /// chat list, so statuses are delivered once per frame.
   @override
   Stream<ConnectionStatus> get connectionStatusStream =>
-      Stream<ConnectionStatus>.multi((controller) {
-        void listener(ConnectionStatus status) {
-          controller.add(status);
-        }
+      _connectionStatus.stream(delivery: EventDelivery.frame);
 
-        _connectionStatusListeners.add(listener);
-        controller.onCancel = () {
-          _connectionStatusListeners.remove(listener);
-        };
-      });
+  /// Throughput and delivery latency of [connectionStatusStream]
+  EventChannelStats get connectionStatusStats => _connectionStatus.stats;
 
   @override
   Future<void> setupPeripheralConnectionListener() async {
@@ -256,21 +264,10 @@ class ChatConnectionManager implements IChatConnectionManager {
   Future<void> dispose() async {
     await _peripheralConnectionSubscription?.cancel();
     await _discoveryDataSubscription?.cancel();
-    _connectionStatusListeners.clear();
+    // The app bus outlives this manager and serves other subscribers.
+    if (_ownsEventBus) _eventBus.clear();
     _logger.info('♻️ ChatConnectionManager disposed');
   }
 
-  void _notify(ConnectionStatus status) {
-    for (final listener in List.of(_connectionStatusListeners)) {
-      try {
-        listener(status);
-      } catch (e, stackTrace) {
-        _logger.warning(
-          'Error notifying connection status listener: $e',
-          e,
-          stackTrace,
-        );
-      }
-    }
-  }
+  void _notify(ConnectionStatus status) => _connectionStatus.emit(status);
 }
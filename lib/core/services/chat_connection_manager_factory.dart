@@ -1,13 +1,17 @@
 import '../../domain/interfaces/i_chat_connection_manager.dart';
 import '../../domain/interfaces/i_chat_connection_manager_factory.dart';
 import '../../domain/interfaces/i_connection_service.dart';
+import '../../domain/services/typed_event_bus.dart';
 import 'chat_connection_manager.dart';
 
 class ChatConnectionManagerFactory implements IChatConnectionManagerFactory {
-  const ChatConnectionManagerFactory();
+  const ChatConnectionManagerFactory({this.eventBus});
+
+  /// App-level bus for `chat.connectionStatus`; a private one when null
+  final TypedEventBus? eventBus;
 
   @override
   IChatConnectionManager create({IConnectionService? bleService}) {
-    return ChatConnectionManager(bleService: bleService);
+    return ChatConnectionManager(bleService: bleService, eventBus: eventBus);
   }
 }
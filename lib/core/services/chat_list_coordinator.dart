@@ -3,6 +3,7 @@ import 'package:logging/logging.dart';
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart'
     hide ConnectionState;
 import '../../domain/interfaces/i_chat_list_coordinator.dart';
+import '../../domain/models/chat_list_model.dart';
 import '../../domain/models/connection_status.dart';
 import '../../domain/entities/chat_list_item.dart';
 import '../../domain/interfaces/i_chats_repository.dart';
@@ -15,26 +16,33 @@ import '../../domain/interfaces/i_connection_service.dart';
 /// - Periodic refresh (10s timer)
 /// - Global message listener for real-time updates
 /// - Surgical single chat item updates
+/// - Event-sourced row patches from the chat list change feed
 /// - Unread count stream management
 ///
 /// Pattern:
 /// - Uses optional DI for repository and BLE service (testability)
 /// - Exposes unreadCountStream for UI consumption
-/// - Maintains currentChats cache and isLoading state
+/// - Maintains currentChats as a keyed [ChatListModel] and isLoading state
+/// - With [changeEvents], each stored message, status, unread, rename or
+///   presence change patches one row and emits a [ChatListDiff]; the full
+///   query only runs when an event cannot be resolved locally
 class ChatListCoordinator implements IChatListCoordinator {
   final _logger = Logger('ChatListCoordinator');
 
   final IChatsRepository? _chatsRepository;
   final IConnectionService? _bleService;
 
-  List<ChatListItem> _currentChats = [];
+  final ChatListModel _model = ChatListModel();
+  final StreamController<ChatListDiff> _diffController =
+      StreamController.broadcast();
   bool _isLoading = true;
   String _searchQuery = '';
   Timer? _refreshTimer;
-  Timer? _connectionStatusDebounceTimer;
+  Timer? _reloadDebounceTimer;
   StreamSubscription? _globalMessageSubscription;
   StreamSubscription? _discoveryDataSubscription;
   StreamSubscription? _connectionStatusSubscription;
+  StreamSubscription? _changeEventSubscription;
   Map<String, DiscoveredEventArgs>? _lastDiscoveryData;
 
   // ✅ Phase 6D: Periodic unread count stream (no controller needed)
@@ -43,13 +51,19 @@ class ChatListCoordinator implements IChatListCoordinator {
   // Optional connection status stream for triggering refreshes
   final Stream<ConnectionStatus>? _connectionStatusStream;
 
+  // Optional row-level change feed; without it incoming BLE messages fall
+  // back to re-querying the most recent chat
+  final Stream<ChatListEvent>? _changeEvents;
+
   ChatListCoordinator({
     IChatsRepository? chatsRepository,
     IConnectionService? bleService,
     Stream<ConnectionStatus>? connectionStatusStream,
+    Stream<ChatListEvent>? changeEvents,
   }) : _chatsRepository = chatsRepository,
        _bleService = bleService,
-       _connectionStatusStream = connectionStatusStream;
+       _connectionStatusStream = connectionStatusStream,
+       _changeEvents = changeEvents;
 
   @override
   Future<void> initialize() async {
@@ -58,6 +72,7 @@ class ChatListCoordinator implements IChatListCoordinator {
     setupGlobalMessageListener();
     setupDiscoveryDataListener();
     setupConnectionStatusListener();
+    setupChangeEventListener();
     setupUnreadCountStream();
     _logger.info('✅ ChatListCoordinator initialized');
   }
@@ -66,11 +81,11 @@ class ChatListCoordinator implements IChatListCoordinator {
   Future<List<ChatListItem>> loadChats({String? searchQuery}) async {
     if (!_canLoadChats()) {
       _logger.warning('⚠️ Cannot load chats: dependencies not available');
-      return _currentChats;
+      return currentChats;
     }
 
     // Only show loading spinner on initial load or when list is empty
-    final showSpinner = _currentChats.isEmpty;
+    final showSpinner = _model.length == 0;
     if (showSpinner) {
       _isLoading = true;
     }
@@ -86,7 +101,7 @@ class ChatListCoordinator implements IChatListCoordinator {
         offset: null,
       );
 
-      _currentChats = chats;
+      _emit(_model.reset(chats));
       _searchQuery = searchQuery ?? '';
       _isLoading = false;
 
@@ -125,30 +140,8 @@ class ChatListCoordinator implements IChatListCoordinator {
       final mostRecentChat =
           updatedChats.first; // Already sorted by last message time
 
-      // 🎯 SURGICAL UPDATE: Only update this one chat in the list
-      final existingIndex = _currentChats.indexWhere(
-        (c) => c.chatId == mostRecentChat.chatId,
-      );
-
-      if (existingIndex != -1) {
-        // Chat exists - update it in place
-        _currentChats[existingIndex] = mostRecentChat;
-
-        // Re-sort to move updated chat to top (if needed)
-        _currentChats.sort((a, b) {
-          // Online chats first
-          if (a.isOnline && !b.isOnline) return -1;
-          if (!a.isOnline && b.isOnline) return 1;
-
-          // Then by last message time
-          final aTime = a.lastMessageTime ?? DateTime(1970);
-          final bTime = b.lastMessageTime ?? DateTime(1970);
-          return bTime.compareTo(aTime);
-        });
-      } else {
-        // New chat - add to top
-        _currentChats.insert(0, mostRecentChat);
-      }
+      // 🎯 SURGICAL UPDATE: Replace or insert only this chat at its slot
+      _emit(_model.upsert(mostRecentChat));
 
       _logger.fine(
         '🎯 Surgical update completed - only affected chat item updated',
@@ -175,7 +168,10 @@ class ChatListCoordinator implements IChatListCoordinator {
   Stream<int> get unreadCountStream => _unreadCountStream ?? Stream.empty();
 
   @override
-  List<ChatListItem> get currentChats => _currentChats;
+  List<ChatListItem> get currentChats => _model.items;
+
+  @override
+  Stream<ChatListDiff> get chatListChanges => _diffController.stream;
 
   @override
   bool get isLoading => _isLoading;
@@ -198,8 +194,11 @@ class ChatListCoordinator implements IChatListCoordinator {
       _globalMessageSubscription = bleService.receivedMessages.listen((
         content,
       ) async {
-        _logger.info('🔔 New message received - surgical update');
-        await updateSingleChatItem();
+        // The change feed patches the row once the message is stored.
+        if (_changeEvents == null) {
+          _logger.info('🔔 New message received - surgical update');
+          await updateSingleChatItem();
+        }
         refreshUnreadCount();
       });
 
@@ -229,29 +228,27 @@ class ChatListCoordinator implements IChatListCoordinator {
     }
   }
 
-  /// 🔄 Listen to connection status changes and trigger refresh with debounce
-  /// Prevents database starvation when discovery events fire rapidly
+  /// 🔄 Listen to connection status changes: patch the connected peer's row,
+  /// otherwise refresh with debounce
   void setupConnectionStatusListener() {
     try {
       final stream = _connectionStatusStream;
       if (stream == null) return;
 
-      _connectionStatusSubscription = stream.listen((_) {
-        // Cancel previous timer if exists
-        _connectionStatusDebounceTimer?.cancel();
-
-        // Set new debounce timer (500ms)
-        _connectionStatusDebounceTimer = Timer(
-          Duration(milliseconds: 500),
-          () async {
-            _logger.fine('🔄 Connection status changed, refreshing chats');
-            if (!_isLoading) {
-              await loadChats(
-                searchQuery: _searchQuery.isEmpty ? null : _searchQuery,
-              );
-            }
-          },
-        );
+      _connectionStatusSubscription = stream.listen((status) {
+        // A known peer connecting only flips its own row online.
+        final peerKey = _bleService?.theirPersistentKey;
+        if (status == ConnectionStatus.connected && peerKey != null) {
+          _applyChange(
+            ChatPresenceChanged(
+              publicKey: peerKey,
+              isOnline: true,
+              lastSeen: DateTime.now(),
+            ),
+          );
+          return;
+        }
+        _scheduleReload();
       });
 
       _logger.info('✅ Connection status listener set up (500ms debounce)');
@@ -261,6 +258,52 @@ class ChatListCoordinator implements IChatListCoordinator {
     }
   }
 
+  /// 🧩 Patch rows from the change feed instead of re-querying the list
+  void setupChangeEventListener() {
+    final events = _changeEvents;
+    if (events == null) return;
+    _changeEventSubscription = events.listen(_applyChange);
+    _logger.info('✅ Chat list change feed listener set up');
+  }
+
+  void _applyChange(ChatListEvent event) {
+    final patch = _model.apply(event);
+    if (patch.diff case final diff?) _emit(diff);
+    if (!patch.refetch) return;
+
+    switch (event) {
+      // A filtered list only shows rows that matched the query.
+      case ChatMessageInserted() when _searchQuery.isNotEmpty:
+        return;
+      // Unknown chat: its new message makes it the most recent one.
+      case ChatMessageInserted():
+        unawaited(updateSingleChatItem());
+      default:
+        _scheduleReload();
+    }
+  }
+
+  void _emit(ChatListDiff diff) {
+    if (!_diffController.isClosed) _diffController.add(diff);
+  }
+
+  /// Debounced full reload for changes the model cannot patch
+  /// Prevents database starvation when discovery events fire rapidly
+  void _scheduleReload() {
+    _reloadDebounceTimer?.cancel();
+    _reloadDebounceTimer = Timer(
+      Duration(milliseconds: 500),
+      () async {
+        _logger.fine('🔄 Chat list invalidated, refreshing chats');
+        if (!_isLoading) {
+          await loadChats(
+            searchQuery: _searchQuery.isEmpty ? null : _searchQuery,
+          );
+        }
+      },
+    );
+  }
+
   void setupUnreadCountStream() {
     // Create a simple periodic stream that updates unread count
     _unreadCountStream = Stream.periodic(Duration(seconds: 3), (_) {
@@ -309,10 +352,12 @@ class ChatListCoordinator implements IChatListCoordinator {
   @override
   Future<void> dispose() async {
     _refreshTimer?.cancel();
-    _connectionStatusDebounceTimer?.cancel();
+    _reloadDebounceTimer?.cancel();
     await _globalMessageSubscription?.cancel();
     await _discoveryDataSubscription?.cancel();
     await _connectionStatusSubscription?.cancel();
+    await _changeEventSubscription?.cancel();
+    await _diffController.close();
     // ✅ Phase 6D: No controller to close (using periodic stream)
     _logger.info('♻️ ChatListCoordinator disposed');
   }
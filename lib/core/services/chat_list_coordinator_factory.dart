@@ -3,6 +3,7 @@ import '../../domain/interfaces/i_chat_list_coordinator_factory.dart';
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/interfaces/i_connection_service.dart';
 import '../../domain/models/connection_status.dart';
+import '../../domain/services/chat_list_change_feed.dart';
 import 'chat_list_coordinator.dart';
 
 class ChatListCoordinatorFactory implements IChatListCoordinatorFactory {
@@ -18,6 +19,7 @@ class ChatListCoordinatorFactory implements IChatListCoordinatorFactory {
       chatsRepository: chatsRepository,
       bleService: bleService,
       connectionStatusStream: connectionStatusStream,
+      changeEvents: ChatListChangeFeed.instance.events,
     );
   }
 }
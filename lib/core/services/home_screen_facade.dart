@@ -11,6 +11,7 @@ import '../../domain/interfaces/i_chat_list_coordinator.dart';
 import '../../domain/interfaces/i_chat_list_coordinator_factory.dart';
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/interfaces/i_connection_service.dart';
+import '../../domain/models/chat_list_model.dart';
 import '../../domain/models/connection_status.dart';
 import '../../domain/models/connection_info.dart';
 import '../../domain/entities/chat_list_item.dart';
@@ -156,6 +157,9 @@ class HomeScreenFacade implements IHomeScreenFacade {
   @override
   List<ChatListItem> get chats => _listCoordinator.currentChats;
 
+  @override
+  Stream<ChatListDiff> get chatListChanges => _listCoordinator.chatListChanges;
+
   @override
   bool get isLoading => _listCoordinator.isLoading;
 
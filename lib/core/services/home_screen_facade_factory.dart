@@ -3,13 +3,17 @@ import 'package:flutter_riverpod/flutter_riverpod.dart';
 
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/services/chat_management_service.dart';
+import 'package:pak_connect/domain/interfaces/i_chat_connection_manager_factory.dart';
 import 'package:pak_connect/domain/interfaces/i_connection_service.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade_factory.dart';
 import 'home_screen_facade.dart';
 
 class HomeScreenFacadeFactory implements IHomeScreenFacadeFactory {
-  const HomeScreenFacadeFactory();
+  const HomeScreenFacadeFactory({this.chatConnectionManagerFactory});
+
+  /// Shared so home screens publish on the app-level event bus
+  final IChatConnectionManagerFactory? chatConnectionManagerFactory;
 
   @override
   IHomeScreenFacade create({
@@ -31,6 +35,7 @@ class HomeScreenFacadeFactory implements IHomeScreenFacadeFactory {
       interactionHandlerBuilder: interactionHandlerBuilder,
       enableListCoordinatorInitialization: enableListCoordinatorInitialization,
       enableInternalIntentListener: enableInternalIntentListener,
+      chatConnectionManagerFactory: chatConnectionManagerFactory,
     );
   }
 }
@@ -7,6 +7,7 @@ import '../../domain/values/id_types.dart';
 import 'package:pak_connect/domain/interfaces/i_message_queue_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/services/database_telemetry.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 
 /// Repository for offline message queue database operations
@@ -18,7 +19,9 @@ import 'package:pak_connect/domain/utils/string_extensions.dart';
 /// - Track retry attempts and delivery status
 class MessageQueueRepository implements IMessageQueueRepository {
   static final _logger = Logger('MessageQueueRepository');
+  static const String _table = 'offline_message_queue';
   static IDatabaseProvider? _defaultDatabaseProvider;
+  static DatabaseTelemetry get _telemetry => DatabaseTelemetry.instance;
 
   // In-memory queues
   final List<QueuedMessage> directMessageQueue;
@@ -65,7 +68,7 @@ class MessageQueueRepository implements IMessageQueueRepository {
     try {
       final db = await _getDatabase();
       final List<Map<String, dynamic>> results = await db.query(
-        'offline_message_queue',
+        _table,
         orderBy: 'priority DESC, queued_at ASC',
       );
 
@@ -102,10 +105,20 @@ class MessageQueueRepository implements IMessageQueueRepository {
       final db = await _getDatabase();
 
       // Use INSERT OR REPLACE for efficiency - updates if exists, inserts if not
-      await db.insert(
-        'offline_message_queue',
-        queuedMessageToDb(message),
-        conflictAlgorithm: ConflictAlgorithm.replace,
+      final row = queuedMessageToDb(message);
+      await _telemetry.time(
+        _table,
+        () => db.insert(
+          _table,
+          row,
+          conflictAlgorithm: ConflictAlgorithm.replace,
+        ),
+        write: true,
+      );
+      // Inserts and replaces look alike here; snapshots rebase the count.
+      _telemetry.recordWrite(
+        _table,
+        bytes: DatabaseTelemetry.estimateBytes(row),
       );
     } catch (e) {
       _logger.warning('Failed to save message ${message.id.shortId()}...: $e');
@@ -119,11 +132,16 @@ class MessageQueueRepository implements IMessageQueueRepository {
       final id = MessageId(messageId);
       final db = await _getDatabase();
 
-      await db.delete(
-        'offline_message_queue',
-        where: 'message_id = ?',
-        whereArgs: [id.value],
+      final deleted = await _telemetry.time(
+        _table,
+        () => db.delete(
+          _table,
+          where: 'message_id = ?',
+          whereArgs: [id.value],
+        ),
+        write: true,
       );
+      _telemetry.recordWrite(_table, rows: -deleted);
     } catch (e) {
       _logger.warning('Failed to delete message ${messageId.shortId()}...: $e');
     }
@@ -135,21 +153,30 @@ class MessageQueueRepository implements IMessageQueueRepository {
     try {
       final db = await _getDatabase();
 
+      var removed = 0;
+      var bytes = 0;
       // Use transaction for atomic operations
-      await db.transaction((txn) async {
-        // Clear and reinsert all messages
-        await txn.delete('offline_message_queue');
-
-        // Save direct messages
-        for (final message in directMessageQueue) {
-          await txn.insert('offline_message_queue', queuedMessageToDb(message));
-        }
-
-        // Save relay messages
-        for (final message in relayMessageQueue) {
-          await txn.insert('offline_message_queue', queuedMessageToDb(message));
-        }
-      });
+      await _telemetry.time(
+        _table,
+        () => db.transaction((txn) async {
+          // Clear and reinsert all messages
+          removed = await txn.delete(_table);
+
+          // Save direct and relay messages
+          for (final message in [...directMessageQueue, ...relayMessageQueue]) {
+            final row = queuedMessageToDb(message);
+            bytes += DatabaseTelemetry.estimateBytes(row);
+            await txn.insert(_table, row);
+          }
+        }),
+        write: true,
+      );
+      // Recorded after commit so a rolled-back rewrite counts nothing.
+      _telemetry.recordWrite(
+        _table,
+        rows: directMessageQueue.length + relayMessageQueue.length - removed,
+        bytes: bytes,
+      );
     } catch (e) {
       _logger.warning('Failed to save message queue: $e');
     }
@@ -340,6 +367,7 @@ class MessageQueueRepository implements IMessageQueueRepository {
           ? jsonEncode(message.attachments)
           : null,
       'sender_rate_count': message.senderRateCount,
+      'is_originator': message.isOriginator ? 1 : 0,
       'created_at': now,
       'updated_at': now,
     };
@@ -392,6 +420,7 @@ class MessageQueueRepository implements IMessageQueueRepository {
       relayNodeId: row['relay_node_id'] as String?,
       messageHash: row['message_hash'] as String?,
       senderRateCount: row['sender_rate_count'] as int? ?? 0,
+      isOriginator: (row['is_originator'] as int? ?? 0) == 1,
     );
   }
 }
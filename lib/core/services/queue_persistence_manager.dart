@@ -75,6 +75,7 @@ class QueuePersistenceManager implements IQueuePersistenceManager {
           reply_to_message_id TEXT,
           attachments_json TEXT,
           sender_rate_count INTEGER DEFAULT 0,
+          is_originator INTEGER DEFAULT 0,
           created_at INTEGER,
           updated_at INTEGER
         )
@@ -13,6 +13,7 @@ import '../security/noise/models/noise_models.dart';
 import '../security/sealed/sealed_encryption_service.dart';
 import 'package:pak_connect/domain/services/contact_crypto_service.dart';
 import 'package:pak_connect/domain/services/conversation_crypto_service.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../../domain/values/id_types.dart';
 import '../exceptions/encryption_exception.dart';
@@ -93,6 +94,7 @@ class SecurityManager implements ISecurityService {
     required String persistentPublicKey,
     required String ephemeralID,
   }) {
+    PeerCapabilityRegistry.instance.alias(persistentPublicKey, ephemeralID);
     if (_noiseService == null) {
       _logger.warning(
         'Cannot register identity mapping - Noise service not initialized',
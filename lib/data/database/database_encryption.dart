@@ -6,6 +6,8 @@ import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:logging/logging.dart';
 import 'dart:math';
 
+import 'secure_storage_vault.dart';
+
 /// Exception thrown when database encryption setup fails
 /// FIX-002: Custom exception for secure storage failures
 class DatabaseEncryptionException implements Exception {
@@ -19,7 +21,7 @@ class DatabaseEncryptionException implements Exception {
 class DatabaseEncryption {
   static final _logger = Logger('DatabaseEncryption');
   static const String _encryptionKeyStorageKey = 'db_encryption_key_v1';
-  static FlutterSecureStorage _secureStorage = const FlutterSecureStorage();
+  static SecureStorageVault _secureStorage = SecureStorageVault.instance;
 
   // 🔧 FIX: Cache encryption key to prevent duplicate secure storage reads
   static String? _cachedEncryptionKey;
@@ -42,8 +44,9 @@ class DatabaseEncryption {
 
     try {
       // Check if key already exists
+      // First secure read of a cold start: loads every app secret at once
       String? existingKey = await _secureStorage.read(
-        key: _encryptionKeyStorageKey,
+        _encryptionKeyStorageKey,
       );
 
       if (existingKey != null && existingKey.isNotEmpty) {
@@ -58,7 +61,7 @@ class DatabaseEncryption {
       final key = await _generateSecureKey();
 
       // Store in secure storage
-      await _secureStorage.write(key: _encryptionKeyStorageKey, value: key);
+      await _secureStorage.write(_encryptionKeyStorageKey, key);
 
       _logger.info('🔐 Generated and stored new database encryption key');
       _cachedEncryptionKey = key; // Cache it
@@ -98,7 +101,7 @@ class DatabaseEncryption {
   /// WARNING: This will make existing encrypted database unreadable!
   static Future<void> deleteEncryptionKey() async {
     try {
-      await _secureStorage.delete(key: _encryptionKeyStorageKey);
+      await _secureStorage.delete(_encryptionKeyStorageKey);
       _cachedEncryptionKey = null; // 🔧 FIX: Clear cache
       _logger.warning('🗑️ Database encryption key deleted');
     } catch (e) {
@@ -109,7 +112,7 @@ class DatabaseEncryption {
   /// Check if encryption key exists
   static Future<bool> hasEncryptionKey() async {
     try {
-      final key = await _secureStorage.read(key: _encryptionKeyStorageKey);
+      final key = await _secureStorage.read(_encryptionKeyStorageKey);
       return key != null && key.isNotEmpty;
     } catch (e) {
       _logger.warning('Failed to check encryption key existence: $e');
@@ -120,7 +123,7 @@ class DatabaseEncryption {
   /// Allow tests to override secure storage with an in-memory implementation.
   @visibleForTesting
   static void overrideSecureStorage(FlutterSecureStorage storage) {
-    _secureStorage = storage;
+    _secureStorage = SecureStorageVault(storage);
     _cachedEncryptionKey = null;
     _logger.warning(
       '⚠️ DatabaseEncryption secure storage overridden for tests',
@@ -130,7 +133,7 @@ class DatabaseEncryption {
   /// Reset secure storage override (restores real plugin usage).
   @visibleForTesting
   static void resetSecureStorageOverride() {
-    _secureStorage = const FlutterSecureStorage();
+    _secureStorage = SecureStorageVault.instance;
     _cachedEncryptionKey = null;
   }
 }
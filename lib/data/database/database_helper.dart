@@ -22,7 +22,7 @@ class DatabaseHelper {
   static Future<sqlcipher.Database>? _initializingDatabase;
   static const String _databaseName = 'pak_connect.db';
   static const int _databaseVersion =
-      12; // v12: Added last_synced_changelog_id for live P2P change_log sync
+      14; // v14: Added offline_message_queue.is_originator for relay quotas
   static int get currentVersion => _databaseVersion;
 
   /// Override database name for testing (allows using fresh database files)
@@ -433,6 +433,15 @@ class DatabaseHelper {
     // Enable foreign key constraints
     await db.execute('PRAGMA foreign_keys = ON');
 
+    // Let deleted pages be returned in small steps (see
+    // DatabaseMaintenanceScheduler). Only takes effect on a new file;
+    // existing files are converted by one full VACUUM when idle.
+    try {
+      await db.rawQuery('PRAGMA auto_vacuum = INCREMENTAL');
+    } catch (e) {
+      _logger.warning('Failed to set auto_vacuum (using default): $e');
+    }
+
     // Enable WAL mode for better concurrency
     // Note: PRAGMA journal_mode returns a result, so we must use rawQuery
     try {
@@ -641,6 +650,20 @@ class DatabaseHelper {
     }
   }
 
+  /// Bound parameters per statement on SQLite builds before 3.32
+  static const int maxBoundParameters = 999;
+
+  /// Split [values] into slices that each fit one `IN (...)` clause
+  static Iterable<List<T>> inClauseChunks<T>(
+    List<T> values, {
+    int size = maxBoundParameters,
+  }) sync* {
+    for (var start = 0; start < values.length; start += size) {
+      final end = start + size < values.length ? start + size : values.length;
+      yield values.sublist(start, end);
+    }
+  }
+
   /// Get database path (for debugging)
   static Future<String> getDatabasePath() async {
     final factory = Platform.isAndroid || Platform.isIOS
@@ -493,5 +493,41 @@ class DatabaseMigrationRunner {
         'Migration to v12 complete: Added last_synced_changelog_id column',
       );
     }
+
+    if (oldVersion < 13 && newVersion >= 13) {
+      logger.info('🔧 Backfilling chats.last_message_time...');
+
+      // Message saves now keep this column current; earlier rows were
+      // never written, so seed them from the messages table once.
+      await db.execute('''
+        UPDATE chats
+        SET last_message_time = (
+          SELECT MAX(m.timestamp) FROM messages m WHERE m.chat_id = chats.chat_id
+        )
+        WHERE EXISTS (SELECT 1 FROM messages m WHERE m.chat_id = chats.chat_id)
+      ''');
+
+      await db.execute('''
+        CREATE INDEX IF NOT EXISTS idx_chats_last_message
+        ON chats(last_message_time DESC)
+      ''');
+
+      logger.info(
+        'Migration to v13 complete: Backfilled chats.last_message_time',
+      );
+    }
+
+    if (oldVersion < 14 && newVersion >= 14) {
+      logger.info('🔧 Adding is_originator to offline_message_queue...');
+
+      // Relay quotas exempt only bundles this node created; earlier rows
+      // cannot be told apart and are charged like any relay.
+      await db.execute('''
+        ALTER TABLE offline_message_queue
+        ADD COLUMN is_originator INTEGER DEFAULT 0
+      ''');
+
+      logger.info('Migration to v14 complete: Added is_originator column');
+    }
   }
 }
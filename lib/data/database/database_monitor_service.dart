@@ -7,10 +7,15 @@
 /// - Growth rate analysis
 /// - Performance metrics
 /// - Anomaly detection
+///
+/// [captureSnapshot] scans every table and is meant for occasional use;
+/// [getLiveDashboardData] reads the incremental [DatabaseTelemetry]
+/// counters instead and is cheap enough to poll.
 library;
 
 import 'dart:io';
 import 'package:shared_preferences/shared_preferences.dart';
+import '../../domain/services/database_telemetry.dart';
 import 'database_helper.dart';
 
 /// Represents a snapshot of database metrics at a point in time
@@ -215,6 +220,7 @@ class DatabaseMonitorService {
       50; // Alert if growth > 50MB/day
   static const double _alertFragmentationThreshold =
       0.3; // Alert if >30% fragmented
+  static const double _alertTableLatencyMs = 100; // Mean over the last hour
 
   /// Capture current database metrics snapshot
   static Future<DatabaseSnapshot> captureSnapshot() async {
@@ -333,6 +339,11 @@ class DatabaseMonitorService {
       fragmentationRatio: fragmentationRatio,
     );
 
+    // Exact counts correct drift in the incremental row estimates.
+    DatabaseTelemetry.instance.rebase({
+      for (final table in tableMetrics.values) table.name: table.rowCount,
+    });
+
     // Store snapshot
     await _storeSnapshot(snapshot);
 
@@ -487,6 +498,75 @@ class DatabaseMonitorService {
     };
   }
 
+  /// Dashboard from incremental telemetry: no table scans, only a stat()
+  /// of the database file
+  static Future<Map<String, dynamic>> getLiveDashboardData({
+    DateTime? now,
+  }) async {
+    final at = now ?? DateTime.now();
+    final dbPath = await DatabaseHelper.getDatabasePath();
+    final file = File(dbPath);
+    final sizeBytes = await file.exists() ? await file.length() : 0;
+    final tables = DatabaseTelemetry.instance.tables(now: at);
+
+    final alerts = <MonitoringAlert>[];
+    final sizeMB = sizeBytes / 1024 / 1024;
+    if (sizeMB > _alertSizeThresholdMB) {
+      alerts.add(
+        MonitoringAlert(
+          severity: AlertSeverity.warning,
+          title: 'Large Database Size',
+          description:
+              'Database size (${sizeMB.toStringAsFixed(2)}MB) exceeds threshold '
+              '($_alertSizeThresholdMB MB).',
+          timestamp: at,
+          metadata: {'current_size_mb': sizeMB},
+        ),
+      );
+    }
+
+    final bytesLastDay = tables.values.fold<int>(
+      0,
+      (sum, table) => sum + table.bytesLastDay,
+    );
+    if (bytesLastDay > _alertGrowthRateMBPerDay * 1024 * 1024) {
+      alerts.add(
+        MonitoringAlert(
+          severity: AlertSeverity.info,
+          title: 'Rapid Database Growth',
+          description:
+              '${(bytesLastDay / 1024 / 1024).toStringAsFixed(2)} MB written in the last 24h.',
+          timestamp: at,
+          metadata: {'bytes_last_day': bytesLastDay},
+        ),
+      );
+    }
+
+    for (final table in tables.values) {
+      if (table.meanLatencyMs > _alertTableLatencyMs) {
+        alerts.add(
+          MonitoringAlert(
+            severity: AlertSeverity.warning,
+            title: 'Slow Queries: ${table.table}',
+            description:
+                'Statements on "${table.table}" averaged ${table.meanLatencyMs.toStringAsFixed(1)}ms '
+                'over the last hour (max ${table.maxLatencyMs.toStringAsFixed(1)}ms).',
+            timestamp: at,
+            metadata: table.toJson(),
+          ),
+        );
+      }
+    }
+
+    return {
+      'timestamp': at.toIso8601String(),
+      'total_size_bytes': sizeBytes,
+      'bytes_written_24h': bytesLastDay,
+      'tables': tables.map((name, table) => MapEntry(name, table.toJson())),
+      'alerts': alerts.map((a) => a.toJson()).toList(),
+    };
+  }
+
   /// Get historical snapshots
   static Future<List<DatabaseSnapshot>> getHistoricalSnapshots({
     int? limit,
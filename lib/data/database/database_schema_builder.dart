@@ -192,6 +192,7 @@ class DatabaseSchemaBuilder {
         reply_to_message_id TEXT,
         attachments_json TEXT,
         sender_rate_count INTEGER DEFAULT 0,
+        is_originator INTEGER DEFAULT 0,
 
         created_at INTEGER NOT NULL,
         updated_at INTEGER NOT NULL
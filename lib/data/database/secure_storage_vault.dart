@@ -0,0 +1,206 @@
+import 'dart:async';
+
+import 'package:flutter_secure_storage/flutter_secure_storage.dart';
+import 'package:logging/logging.dart';
+
+/// Read-through cache over [FlutterSecureStorage] for every app secret.
+///
+/// Each plugin read is a keychain/keystore call, and on Linux a libsecret
+/// D-Bus round trip. The first access loads all entries with one
+/// `readAll`; later reads are served from memory, so cold start costs one
+/// keyring round trip however many keys the app touches.
+///
+/// Writes go to the plugin first and reach the cache only once they have
+/// landed, so readers never see a value that is not stored. [writeAll]
+/// applies a batch to the cache in one step; if any key fails, the cache
+/// is dropped and reloaded from storage on next access.
+///
+/// Code that takes a [FlutterSecureStorage] (the Noise identity keys via
+/// `SecurityManager.initialize`) gets the same cache through [asStorage].
+class SecureStorageVault {
+  static final _logger = Logger('SecureStorageVault');
+
+  /// Vault over the app's default secure storage
+  static final SecureStorageVault instance = SecureStorageVault(
+    const FlutterSecureStorage(),
+  );
+
+  final FlutterSecureStorage _storage;
+  Map<String, String>? _entries;
+  Future<Map<String, String>>? _loading;
+  Future<void> _writeQueue = Future.value();
+
+  /// Bumped whenever the cache is dropped, so a readAll started before
+  /// then cannot install its older result
+  int _generation = 0;
+
+  SecureStorageVault(this._storage);
+
+  bool get isLoaded => _entries != null;
+
+  /// [FlutterSecureStorage] view whose reads and writes go through this
+  /// vault
+  FlutterSecureStorage asStorage() => _VaultStorage(this);
+
+  /// Load every entry in one round trip; concurrent callers share it.
+  /// [force] rereads storage even when already loaded.
+  Future<void> load({bool force = false}) async {
+    if (force) await invalidate();
+    await _load();
+  }
+
+  Future<String?> read(String key) async => (await _load())[key];
+
+  /// Values for [keys] from one consistent view of the cache
+  Future<Map<String, String?>> readMany(Iterable<String> keys) async {
+    final entries = await _load();
+    return {for (final key in keys) key: entries[key]};
+  }
+
+  Future<void> write(String key, String? value) => writeAll({key: value});
+
+  Future<void> delete(String key) => writeAll({key: null});
+
+  /// Store [values] together; a null value deletes its key
+  Future<void> writeAll(Map<String, String?> values) {
+    if (values.isEmpty) return Future.value();
+    return _serialized(() async {
+      final entries = await _load();
+      try {
+        await Future.wait([
+          for (final MapEntry(:key, :value) in values.entries)
+            value == null
+                ? _storage.delete(key: key)
+                : _storage.write(key: key, value: value),
+        ]);
+      } catch (e) {
+        _logger.warning('Secure storage batch write failed: $e');
+        _entries = null;
+        rethrow;
+      }
+      for (final MapEntry(:key, :value) in values.entries) {
+        if (value == null) {
+          entries.remove(key);
+        } else {
+          entries[key] = value;
+        }
+      }
+    });
+  }
+
+  Future<void> deleteAll() => _serialized(() async {
+    _drop();
+    await _storage.deleteAll();
+    _entries = {};
+  });
+
+  /// Forget cached secrets; the next access reloads them from storage
+  Future<void> invalidate() => _serialized(() async => _drop());
+
+  void _drop() {
+    _generation++;
+    _entries = null;
+    _loading = null;
+  }
+
+  Future<Map<String, String>> _load() {
+    final entries = _entries;
+    if (entries != null) return Future.value(entries);
+    return _loading ??= _readAll();
+  }
+
+  Future<Map<String, String>> _readAll() async {
+    final generation = _generation;
+    final stopwatch = Stopwatch()..start();
+    try {
+      final entries = Map<String, String>.of(await _storage.readAll());
+      // Dropped while reading: this result may predate the change.
+      if (generation != _generation) return _load();
+      _entries = entries;
+      _logger.info(
+        '🔐 Loaded ${entries.length} secure entries in '
+        '${stopwatch.elapsedMilliseconds}ms',
+      );
+      return entries;
+    } finally {
+      if (generation == _generation) _loading = null;
+    }
+  }
+
+  Future<void> _serialized(Future<void> Function() action) {
+    final next = _writeQueue.then((_) => action());
+    _writeQueue = next.then<void>((_) {}, onError: (Object _) {});
+    return next;
+  }
+}
+
+class _VaultStorage extends FlutterSecureStorage {
+  const _VaultStorage(this._vault);
+
+  final SecureStorageVault _vault;
+
+  @override
+  Future<String?> read({
+    required String key,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) => _vault.read(key);
+
+  @override
+  Future<Map<String, String>> readAll({
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) async => Map.of(await _vault._load());
+
+  @override
+  Future<bool> containsKey({
+    required String key,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) async => await _vault.read(key) != null;
+
+  @override
+  Future<void> write({
+    required String key,
+    required String? value,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) => _vault.write(key, value);
+
+  @override
+  Future<void> delete({
+    required String key,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) => _vault.delete(key);
+
+  @override
+  Future<void> deleteAll({
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) => _vault.deleteAll();
+}
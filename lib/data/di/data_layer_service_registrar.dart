@@ -1,5 +1,7 @@
+import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:logging/logging.dart';
 import 'package:pak_connect/data/database/database_provider.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
 import 'package:pak_connect/data/repositories/archive_repository.dart';
 import 'package:pak_connect/data/repositories/chats_repository.dart';
 import 'package:pak_connect/data/repositories/contact_repository.dart';
@@ -17,11 +19,13 @@ import 'package:pak_connect/data/services/ble_service_facade_factory.dart';
 import 'package:pak_connect/data/services/ble_state_manager.dart';
 import 'package:pak_connect/data/services/ble_state_manager_facade.dart';
 import 'package:pak_connect/data/services/ephemeral_contact_cleaner.dart';
+import 'package:pak_connect/data/services/hot_state_snapshot_store.dart';
 import 'package:pak_connect/data/services/export_import/export_service_adapter.dart';
 import 'package:pak_connect/data/services/export_import/import_service_adapter.dart';
 import 'package:pak_connect/data/services/mesh_routing_service.dart';
 import 'package:pak_connect/data/services/mesh_relay_handler.dart';
 import 'package:pak_connect/data/services/protocol_message_handler.dart';
+import 'package:pak_connect/data/services/read_receipt_sync_controller.dart';
 import 'package:pak_connect/data/services/relay_coordinator.dart';
 import 'package:pak_connect/data/services/seen_message_store.dart';
 import 'package:pak_connect/domain/interfaces/i_archive_repository.dart';
@@ -34,6 +38,7 @@ import 'package:pak_connect/domain/interfaces/i_contact_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_database_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_export_service.dart';
 import 'package:pak_connect/domain/interfaces/i_group_repository.dart';
+import 'package:pak_connect/domain/interfaces/i_hot_state_snapshot_store.dart';
 import 'package:pak_connect/domain/interfaces/i_identity_manager.dart';
 import 'package:pak_connect/domain/interfaces/i_import_service.dart';
 import 'package:pak_connect/domain/interfaces/i_intro_hint_repository.dart';
@@ -47,6 +52,8 @@ import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
 import 'package:pak_connect/domain/interfaces/i_service_registry.dart';
 import 'package:pak_connect/domain/interfaces/i_shared_message_queue_provider.dart';
 import 'package:pak_connect/domain/interfaces/i_user_preferences.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 
 /// Registers concrete data-layer implementations into the composition registry.
 ///
@@ -55,76 +62,12 @@ Future<void> registerDataLayerServices(
   IServiceRegistry services,
   Logger logger,
 ) async {
-  BLEHandshakeService.configureCoordinatorFactoryResolver(
-    () => services.resolve<IHandshakeCoordinatorFactory>(),
-  );
-  BLEServiceFacade.configureHandshakeServiceRegistrar((handshakeService) {
-    if (!services.isRegistered<IBLEHandshakeService>()) {
-      services.registerSingleton<IBLEHandshakeService>(handshakeService);
-    }
-  });
-  BLEMessageHandlerFacade.configureDependencyResolvers(
-    handshakeServiceResolver: () {
-      if (services.isRegistered<IBLEHandshakeService>()) {
-        return services.resolve<IBLEHandshakeService>();
-      }
-      return null;
-    },
-    seenMessageStoreResolver: () {
-      if (services.isRegistered<ISeenMessageStore>()) {
-        return services.resolve<ISeenMessageStore>();
-      }
-      return null;
-    },
-  );
-  BLEMessageHandlerFacadeImpl.configureDependencyResolvers(
-    legacyStateManagerResolver: () {
-      if (services.isRegistered<BLEStateManagerFacade>()) {
-        return services.resolve<BLEStateManagerFacade>().legacyStateManager;
-      }
-      if (services.isRegistered<IBLEStateManagerFacade>()) {
-        final facade = services.resolve<IBLEStateManagerFacade>();
-        if (facade is BLEStateManagerFacade) {
-          return facade.legacyStateManager;
-        }
-      }
-      if (services.isRegistered<BLEStateManager>()) {
-        return services.resolve<BLEStateManager>();
-      }
-      return null;
-    },
-    sharedQueueProviderResolver: () {
-      if (services.isRegistered<ISharedMessageQueueProvider>()) {
-        return services.resolve<ISharedMessageQueueProvider>();
-      }
-      return null;
-    },
-  );
-  ProtocolMessageHandler.configureIdentityManagerResolver(() {
-    if (services.isRegistered<IIdentityManager>()) {
-      return services.resolve<IIdentityManager>();
-    }
-    return null;
-  });
-  RelayCoordinator.configureDependencyResolvers(
-    sharedQueueProviderResolver: () {
-      if (services.isRegistered<ISharedMessageQueueProvider>()) {
-        return services.resolve<ISharedMessageQueueProvider>();
-      }
-      return null;
-    },
-    relayEngineFactoryResolver: () =>
-        services.resolve<IMeshRelayEngineFactory>(),
-  );
-  MeshRelayHandler.configureRelayEngineFactoryResolver(
-    () => services.resolve<IMeshRelayEngineFactory>(),
+  configureBleTransportResolvers(services);
+  ReadReceiptSyncController.instance.receiptsEnabled = () =>
+      PreferencesRepository().getBool(PreferenceKeys.showReadReceipts);
+  ChatsRepository.configureChatReadListener(
+    ReadReceiptSyncController.instance.recordChatRead,
   );
-  EphemeralContactCleaner.configureQueueRepositoryResolver(() {
-    if (services.isRegistered<IMessageQueueRepository>()) {
-      return services.resolve<IMessageQueueRepository>();
-    }
-    return null;
-  });
 
   // ===========================
   // REPOSITORIES
@@ -263,11 +206,26 @@ Future<void> registerDataLayerServices(
     logger.fine('✅ IImportService registered');
   }
 
+  if (!services.isRegistered<IHotStateSnapshotStore>()) {
+    final snapshotStore = HotStateSnapshotStore();
+    services.registerSingleton<IHotStateSnapshotStore>(snapshotStore);
+    SeenMessageStore.configureSnapshotStore(snapshotStore);
+    logger.fine('✅ IHotStateSnapshotStore registered');
+  }
+
   if (!services.isRegistered<ISeenMessageStore>()) {
     services.registerSingleton<ISeenMessageStore>(SeenMessageStore());
     logger.fine('✅ ISeenMessageStore registered');
   }
 
+  // Noise identity keys share the vault's cached readAll.
+  if (!services.isRegistered<FlutterSecureStorage>()) {
+    services.registerSingleton<FlutterSecureStorage>(
+      SecureStorageVault.instance.asStorage(),
+    );
+    logger.fine('✅ FlutterSecureStorage (vault) registered');
+  }
+
   if (!services.isRegistered<IDatabaseProvider>()) {
     services.registerSingleton<IDatabaseProvider>(DatabaseProvider());
     logger.fine('✅ IDatabaseProvider registered');
@@ -292,9 +250,96 @@ Future<void> registerDataLayerServices(
 
   if (!services.isRegistered<IBLEServiceFacadeFactory>()) {
     services.registerLazySingleton<IBLEServiceFacadeFactory>(
-      () => const DataBleServiceFacadeFactory(),
+      () => DataBleServiceFacadeFactory(
+        eventBus: services.maybeResolve<TypedEventBus>(),
+      ),
     );
     logger.fine('✅ IBLEServiceFacadeFactory registered');
   }
 }
 
+/// Points the BLE stack's static resolvers at [services].
+///
+/// Split out so a background wakeup can start the BLE facade without
+/// registering the rest of the data layer. The resolved factories and
+/// stores must be registered by the caller.
+void configureBleTransportResolvers(IServiceRegistry services) {
+  BLEHandshakeService.configureCoordinatorFactoryResolver(
+    () => services.resolve<IHandshakeCoordinatorFactory>(),
+  );
+  BLEServiceFacade.configureHandshakeServiceRegistrar((handshakeService) {
+    if (!services.isRegistered<IBLEHandshakeService>()) {
+      services.registerSingleton<IBLEHandshakeService>(handshakeService);
+    }
+  });
+  BLEMessageHandlerFacade.configureDependencyResolvers(
+    handshakeServiceResolver: () {
+      if (services.isRegistered<IBLEHandshakeService>()) {
+        return services.resolve<IBLEHandshakeService>();
+      }
+      return null;
+    },
+    seenMessageStoreResolver: () {
+      if (services.isRegistered<ISeenMessageStore>()) {
+        return services.resolve<ISeenMessageStore>();
+      }
+      return null;
+    },
+  );
+  BLEMessageHandlerFacadeImpl.configureDependencyResolvers(
+    legacyStateManagerResolver: () {
+      if (services.isRegistered<BLEStateManagerFacade>()) {
+        return services.resolve<BLEStateManagerFacade>().legacyStateManager;
+      }
+      if (services.isRegistered<IBLEStateManagerFacade>()) {
+        final facade = services.resolve<IBLEStateManagerFacade>();
+        if (facade is BLEStateManagerFacade) {
+          return facade.legacyStateManager;
+        }
+      }
+      if (services.isRegistered<BLEStateManager>()) {
+        return services.resolve<BLEStateManager>();
+      }
+      return null;
+    },
+    sharedQueueProviderResolver: () {
+      if (services.isRegistered<ISharedMessageQueueProvider>()) {
+        return services.resolve<ISharedMessageQueueProvider>();
+      }
+      return null;
+    },
+  );
+  ProtocolMessageHandler.configureIdentityManagerResolver(() {
+    if (services.isRegistered<IIdentityManager>()) {
+      return services.resolve<IIdentityManager>();
+    }
+    return null;
+  });
+  RelayCoordinator.configureDependencyResolvers(
+    sharedQueueProviderResolver: () {
+      if (services.isRegistered<ISharedMessageQueueProvider>()) {
+        return services.resolve<ISharedMessageQueueProvider>();
+      }
+      return null;
+    },
+    relayEngineFactoryResolver: () =>
+        services.resolve<IMeshRelayEngineFactory>(),
+  );
+  MeshRelayHandler.configureRelayEngineFactoryResolver(
+    () => services.resolve<IMeshRelayEngineFactory>(),
+  );
+  ConnectionQualityMonitor.configureStableKeyResolver((nodeId) {
+    if (services.isRegistered<IIdentityManager>()) {
+      return services
+          .resolve<IIdentityManager>()
+          .getPersistentKeyFromEphemeral(nodeId);
+    }
+    return null;
+  });
+  EphemeralContactCleaner.configureQueueRepositoryResolver(() {
+    if (services.isRegistered<IMessageQueueRepository>()) {
+      return services.resolve<IMessageQueueRepository>();
+    }
+    return null;
+  });
+}
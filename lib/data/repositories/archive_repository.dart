@@ -18,6 +18,7 @@ import '../../domain/utils/compression_util.dart';
 import 'archive_data_helper.dart';
 import 'archive_storage_utils.dart';
 import '../../domain/services/archive_crypto.dart';
+import '../../domain/services/database_telemetry.dart';
 
 import 'package:pak_connect/domain/values/id_types.dart';
 
@@ -146,30 +147,48 @@ class ArchiveRepository implements IArchiveRepository {
 
       // Store the archive in SQLite transaction
       final db = await DatabaseHelper.database;
+      final chatRow = _dataHelper.archivedChatToMap(
+        finalArchive,
+        ChatId(chatId),
+        archiveReason,
+        customData,
+      );
+      var messageBytes = 0;
+      var chatsDeleted = 0;
       await db.transaction((txn) async {
         // Insert archived chat
-        await txn.insert(
-          'archived_chats',
-          _dataHelper.archivedChatToMap(
-            finalArchive,
-            ChatId(chatId),
-            archiveReason,
-            customData,
-          ),
-        );
+        await txn.insert('archived_chats', chatRow);
 
         // Insert archived messages with searchable text for FTS5
         for (final message in finalArchive.messages) {
-          await txn.insert(
-            'archived_messages',
-            _dataHelper.archivedMessageToMap(message, finalArchive.id),
+          final messageRow = _dataHelper.archivedMessageToMap(
+            message,
+            finalArchive.id,
           );
+          messageBytes += DatabaseTelemetry.estimateBytes(messageRow);
+          await txn.insert('archived_messages', messageRow);
         }
 
         // Delete the chat from chats table (it's now in archived_chats)
-        await txn.delete('chats', where: 'chat_id = ?', whereArgs: [chatId]);
+        chatsDeleted = await txn.delete(
+          'chats',
+          where: 'chat_id = ?',
+          whereArgs: [chatId],
+        );
         // FTS5 index is automatically updated via triggers!
       });
+      DatabaseTelemetry.instance
+        ..recordWrite(
+          'archived_chats',
+          rows: 1,
+          bytes: DatabaseTelemetry.estimateBytes(chatRow),
+        )
+        ..recordWrite(
+          'archived_messages',
+          rows: finalArchive.messages.length,
+          bytes: messageBytes,
+        )
+        ..recordWrite('chats', rows: -chatsDeleted);
 
       // Clear original chat messages
       await _messageRepository.clearMessages(ChatId(chatId));
@@ -279,11 +298,17 @@ class ArchiveRepository implements IArchiveRepository {
 
       // Delete archive + cascade archived messages now that data is restored
       final db = await DatabaseHelper.database;
-      await db.delete(
+      final archivesDeleted = await db.delete(
         'archived_chats',
         where: 'archive_id = ?',
         whereArgs: [archiveId.value],
       );
+      // Archived messages go with it via ON DELETE CASCADE; the next full
+      // snapshot rebases their row estimate.
+      DatabaseTelemetry.instance.recordWrite(
+        'archived_chats',
+        rows: -archivesDeleted,
+      );
       _logger.info('Archive $archiveId deleted after restoration');
 
       return ArchiveOperationResult.success(
@@ -591,11 +616,17 @@ class ArchiveRepository implements IArchiveRepository {
 
       // Delete from database (CASCADE will auto-delete messages and FTS5 entries)
       final db = await DatabaseHelper.database;
-      await db.delete(
+      final archivesDeleted = await db.delete(
         'archived_chats',
         where: 'archive_id = ?',
         whereArgs: [archiveId.value],
       );
+      // Archived messages go with it via ON DELETE CASCADE; the next full
+      // snapshot rebases their row estimate.
+      DatabaseTelemetry.instance.recordWrite(
+        'archived_chats',
+        rows: -archivesDeleted,
+      );
 
       final operationTime = DateTime.now().difference(startTime);
       _recordOperationTime('delete', operationTime);
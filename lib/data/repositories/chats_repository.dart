@@ -4,6 +4,9 @@ import 'package:logging/logging.dart';
 import 'package:sqflite_sqlcipher/sqflite.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import '../../domain/entities/chat_list_item.dart';
+import '../../domain/models/chat_list_model.dart';
+import '../../domain/services/chat_list_change_feed.dart';
+import '../../domain/services/database_telemetry.dart';
 import 'package:pak_connect/domain/utils/chat_utils.dart';
 import '../database/database_helper.dart';
 import 'message_repository.dart';
@@ -11,11 +14,21 @@ import 'contact_repository.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 
-class ChatsRepository implements IChatsRepository {
+class ChatsRepository
+    implements IChatsRepository, IChatActivityIndex, IBulkChatOperations {
   static final _logger = Logger('ChatsRepository');
   final MessageRepository _messageRepository = MessageRepository();
   final ContactRepository _contactRepository = ContactRepository();
 
+  static Future<void> Function(ChatId chatId)? _chatReadListener;
+
+  /// Notified after a chat is marked read (drives aggregated read receipts).
+  static void configureChatReadListener(
+    Future<void> Function(ChatId chatId)? listener,
+  ) {
+    _chatReadListener = listener;
+  }
+
   // Note: UserPreferences removed after FIX-006 optimization
   // The JOIN query doesn't need myPublicKey since it uses direct contact matching
 
@@ -180,15 +193,20 @@ class ChatsRepository implements IChatsRepository {
 
     if (existing.isNotEmpty) {
       // Update existing chat
+      final update = {'unread_count': 0, 'updated_at': now};
       await db.update(
         'chats',
-        {'unread_count': 0, 'updated_at': now},
+        update,
         where: 'chat_id = ?',
         whereArgs: [chatId.value],
       );
+      DatabaseTelemetry.instance.recordWrite(
+        'chats',
+        bytes: DatabaseTelemetry.estimateBytes(update),
+      );
     } else {
       // Create new chat entry with 0 unread count
-      await db.insert('chats', {
+      await _insertChat(db, {
         'chat_id': chatId.value,
         'contact_public_key': null,
         'contact_name': 'Unknown',
@@ -197,6 +215,87 @@ class ChatsRepository implements IChatsRepository {
         'updated_at': now,
       });
     }
+
+    ChatListChangeFeed.instance.publish(
+      ChatUnreadChanged(chatId: chatId, unreadCount: 0),
+    );
+
+    try {
+      await _chatReadListener?.call(chatId);
+    } catch (e) {
+      _logger.warning('⚠️ Chat read listener failed: $e');
+    }
+  }
+
+  /// Reset unread counts of [chatIds] with one UPDATE per slice of ids.
+  /// Unlike [markChatAsRead], chats without a row are not created.
+  @override
+  Future<int> markChatsAsRead(List<ChatId> chatIds) async {
+    final ids = {for (final id in chatIds) id.value}.toList();
+    if (ids.isEmpty) return 0;
+
+    final db = await DatabaseHelper.database;
+    final now = DateTime.now().millisecondsSinceEpoch;
+    var updated = 0;
+    await db.transaction((txn) async {
+      for (final chunk in DatabaseHelper.inClauseChunks(ids)) {
+        updated += await txn.rawUpdate(
+          'UPDATE chats SET unread_count = 0, updated_at = ? '
+          'WHERE unread_count > 0 '
+          'AND chat_id IN (${List.filled(chunk.length, '?').join(', ')})',
+          [now, ...chunk],
+        );
+      }
+    });
+    DatabaseTelemetry.instance.recordWrite('chats');
+
+    if (updated > 0) {
+      ChatListChangeFeed.instance.publish(
+        ChatListInvalidated('$updated chats marked read'),
+      );
+    }
+
+    // Read receipts stay per chat; the listener aggregates them.
+    for (final chatId in chatIds) {
+      try {
+        await _chatReadListener?.call(chatId);
+      } catch (e) {
+        _logger.warning('⚠️ Chat read listener failed: $e');
+      }
+    }
+    return updated;
+  }
+
+  /// Delete [chatIds] and all their messages in one transaction
+  @override
+  Future<List<MessageId>> deleteChats(List<ChatId> chatIds) async {
+    final ids = {for (final id in chatIds) id.value}.toList();
+    if (ids.isEmpty) return const [];
+
+    final db = await DatabaseHelper.database;
+    var chatsDeleted = 0;
+    final deletedMessages = await db.transaction((txn) async {
+      final messages = await MessageRepository.deleteForChats(txn, ids);
+      for (final chunk in DatabaseHelper.inClauseChunks(ids)) {
+        chatsDeleted += await txn.delete(
+          'chats',
+          where: 'chat_id IN (${List.filled(chunk.length, '?').join(', ')})',
+          whereArgs: chunk,
+        );
+      }
+      return messages;
+    });
+    DatabaseTelemetry.instance
+      ..recordWrite('messages', rows: -deletedMessages.length)
+      ..recordWrite('chats', rows: -chatsDeleted);
+
+    ChatListChangeFeed.instance.publish(
+      ChatListInvalidated('$chatsDeleted chats deleted'),
+    );
+    _logger.info(
+      '🗑️ Deleted $chatsDeleted chats and ${deletedMessages.length} messages',
+    );
+    return deletedMessages;
   }
 
   /// Increment unread count for received message
@@ -215,15 +314,23 @@ class ChatsRepository implements IChatsRepository {
     if (existing.isNotEmpty) {
       // Increment existing count
       final currentCount = existing.first['unread_count'] as int? ?? 0;
+      final update = {'unread_count': currentCount + 1, 'updated_at': now};
       await db.update(
         'chats',
-        {'unread_count': currentCount + 1, 'updated_at': now},
+        update,
         where: 'chat_id = ?',
         whereArgs: [chatId.value],
       );
+      DatabaseTelemetry.instance.recordWrite(
+        'chats',
+        bytes: DatabaseTelemetry.estimateBytes(update),
+      );
+      ChatListChangeFeed.instance.publish(
+        ChatUnreadChanged(chatId: chatId, unreadCount: currentCount + 1),
+      );
     } else {
       // Create new chat entry with count = 1
-      await db.insert('chats', {
+      await _insertChat(db, {
         'chat_id': chatId.value,
         'contact_public_key': null,
         'contact_name': 'Unknown',
@@ -285,6 +392,15 @@ class ChatsRepository implements IChatsRepository {
 
   // PRIVATE HELPERS
 
+  Future<void> _insertChat(Database db, Map<String, Object?> row) async {
+    await db.insert('chats', row);
+    DatabaseTelemetry.instance.recordWrite(
+      'chats',
+      rows: 1,
+      bytes: DatabaseTelemetry.estimateBytes(row),
+    );
+  }
+
   ChatId _generateChatId(String otherPublicKey) {
     // Use the exact same logic as ChatUtils.generateChatId
     // chatId = theirId (simple and elegant)
@@ -331,6 +447,50 @@ class ChatsRepository implements IChatsRepository {
     return false;
   }
 
+  /// Range scan over idx_chats_last_message; archived chats leave the
+  /// table, so only chats still due for archiving are read.
+  @override
+  Future<List<InactiveChat>> getChatsInactiveSince(
+    DateTime cutoff, {
+    ChatActivityCursor? after,
+    int limit = 50,
+  }) async {
+    final db = await DatabaseHelper.database;
+    final cutoffMs = cutoff.millisecondsSinceEpoch;
+    final afterMs = after?.lastMessageTime.millisecondsSinceEpoch;
+    final keyset = after == null
+        ? ''
+        : 'AND (last_message_time > ? '
+              'OR (last_message_time = ? AND chat_id > ?))';
+
+    final rows = await db.rawQuery(
+      '''
+      SELECT chat_id, contact_name, last_message_time
+      FROM chats
+      WHERE last_message_time <= ?
+        $keyset
+      ORDER BY last_message_time ASC, chat_id ASC
+      LIMIT ?
+      ''',
+      [
+        cutoffMs,
+        if (after != null) ...[afterMs, afterMs, after.chatId.value],
+        limit,
+      ],
+    );
+
+    return [
+      for (final row in rows)
+        (
+          chatId: ChatId(row['chat_id'] as String),
+          contactName: row['contact_name'] as String,
+          lastMessageTime: DateTime.fromMillisecondsSinceEpoch(
+            row['last_message_time'] as int,
+          ),
+        ),
+    ];
+  }
+
   // =========================
   // STATISTICS METHODS
   // =========================
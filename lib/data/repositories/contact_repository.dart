@@ -2,24 +2,27 @@
 // Replaces SharedPreferences with efficient database queries
 
 import 'package:sqflite_sqlcipher/sqflite.dart';
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:crypto/crypto.dart';
 import 'dart:convert';
 import 'dart:typed_data';
 import 'package:logging/logging.dart';
 import '../../domain/models/security_level.dart';
 import '../database/database_helper.dart';
+import '../database/secure_storage_vault.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/interfaces/i_contact_repository.dart';
 import '../../domain/entities/contact.dart';
+import '../../domain/models/chat_list_model.dart';
+import '../../domain/services/chat_list_change_feed.dart';
+import '../../domain/services/database_telemetry.dart';
 import '../../domain/values/id_types.dart';
 
 export '../../domain/entities/contact.dart';
 
-class ContactRepository implements IContactRepository {
+class ContactRepository implements IContactRepository, IBulkContactOperations {
   static final _logger = Logger('ContactRepository');
   static const String _sharedSecretPrefix = 'shared_secret_';
-  final FlutterSecureStorage _secureStorage = const FlutterSecureStorage();
+  final SecureStorageVault _secureStorage = SecureStorageVault.instance;
 
   /// Get database instance
   Future<Database> get _db async => await DatabaseHelper.database;
@@ -56,6 +59,14 @@ class ContactRepository implements IContactRepository {
         isFavorite: existing.isFavorite,
       );
       await _storeContact(updated);
+      if (existing.displayName != displayName) {
+        ChatListChangeFeed.instance.publish(
+          ChatContactRenamed(
+            publicKey: userId.value,
+            displayName: displayName,
+          ),
+        );
+      }
     }
   }
 
@@ -237,22 +248,22 @@ class ContactRepository implements IContactRepository {
     }
   }
 
-  /// Cache shared secret (uses FlutterSecureStorage - NOT database)
+  /// Cache shared secret (uses secure storage - NOT database)
   @override
   Future<void> cacheSharedSecret(String publicKey, String sharedSecret) async {
     // Use SHA256 hash of full public key for consistent cache key generation
     final keyHash = sha256.convert(utf8.encode(publicKey)).toString();
     final key = _sharedSecretPrefix + keyHash.shortId();
-    await _secureStorage.write(key: key, value: sharedSecret);
+    await _secureStorage.write(key, sharedSecret);
   }
 
-  /// Get cached shared secret (from FlutterSecureStorage)
+  /// Get cached shared secret (from secure storage)
   @override
   Future<String?> getCachedSharedSecret(String publicKey) async {
     // Use SHA256 hash of full public key for consistent cache key generation
     final keyHash = sha256.convert(utf8.encode(publicKey)).toString();
     final key = _sharedSecretPrefix + keyHash.shortId();
-    return await _secureStorage.read(key: key);
+    return await _secureStorage.read(key);
   }
 
   /// Cache shared seed as bytes (for hint system)
@@ -266,7 +277,7 @@ class ContactRepository implements IContactRepository {
 
     // Convert bytes to base64 for storage
     final base64Seed = base64Encode(seedBytes);
-    await _secureStorage.write(key: key, value: base64Seed);
+    await _secureStorage.write(key, base64Seed);
   }
 
   /// Get cached shared seed as bytes (for hint system)
@@ -275,7 +286,7 @@ class ContactRepository implements IContactRepository {
     final keyHash = sha256.convert(utf8.encode(publicKey)).toString();
     final key = '$_sharedSecretPrefix${keyHash.shortId()}_seed';
 
-    final base64Seed = await _secureStorage.read(key: key);
+    final base64Seed = await _secureStorage.read(key);
     if (base64Seed == null) return null;
 
     try {
@@ -461,7 +472,7 @@ class ContactRepository implements IContactRepository {
       // Use SHA256 hash of full public key for consistent cache key generation
       final keyHash = sha256.convert(utf8.encode(publicKey)).toString();
       final key = _sharedSecretPrefix + keyHash.shortId();
-      await _secureStorage.delete(key: key);
+      await _secureStorage.delete(key);
       _logger.info(
         '🔒 SECURITY: Cleared cached secrets for ${publicKey.shortId(8)}...',
       );
@@ -550,6 +561,8 @@ class ContactRepository implements IContactRepository {
       );
 
       if (rowsDeleted > 0) {
+        DatabaseTelemetry.instance.recordWrite('contacts', rows: -rowsDeleted);
+
         // Try to clear cached secrets (best effort - don't fail if this fails)
         try {
           await clearCachedSecrets(publicKey);
@@ -570,6 +583,51 @@ class ContactRepository implements IContactRepository {
     }
   }
 
+  /// Delete [publicKeys] with one statement per slice of keys in one
+  /// transaction, then clear their cached secrets
+  @override
+  Future<List<String>> deleteContacts(List<String> publicKeys) async {
+    final keys = publicKeys.toSet().toList();
+    if (keys.isEmpty) return const [];
+
+    try {
+      final db = await _db;
+      final deleted = <String>[];
+      await db.transaction((txn) async {
+        for (final chunk in DatabaseHelper.inClauseChunks(keys)) {
+          final where =
+              'public_key IN (${List.filled(chunk.length, '?').join(', ')})';
+          final rows = await txn.query(
+            'contacts',
+            columns: ['public_key'],
+            where: where,
+            whereArgs: chunk,
+          );
+          deleted.addAll(rows.map((row) => row['public_key'] as String));
+          await txn.delete('contacts', where: where, whereArgs: chunk);
+        }
+      });
+      DatabaseTelemetry.instance.recordWrite('contacts', rows: -deleted.length);
+
+      // Secrets live in secure storage, outside the transaction.
+      for (final publicKey in deleted) {
+        try {
+          await clearCachedSecrets(publicKey);
+        } catch (e) {
+          _logger.warning(
+            'Failed to clear secrets during delete (non-fatal): $e',
+          );
+        }
+      }
+
+      _logger.info('🗑️ Deleted ${deleted.length}/${keys.length} contacts');
+      return deleted;
+    } catch (e) {
+      _logger.severe('❌ Failed to delete contacts: $e');
+      rethrow;
+    }
+  }
+
   /// Store contact in database (private helper)
   /// Uses UPDATE-then-INSERT to avoid REPLACE semantics which trigger FK cascades.
   Future<void> _storeContact(Contact contact) async {
@@ -588,6 +646,11 @@ class ContactRepository implements IContactRepository {
       data['created_at'] = DateTime.now().millisecondsSinceEpoch;
       await db.insert('contacts', data);
     }
+    DatabaseTelemetry.instance.recordWrite(
+      'contacts',
+      rows: rowsUpdated == 0 ? 1 : 0,
+      bytes: DatabaseTelemetry.estimateBytes(data),
+    );
   }
 
   // =========================
@@ -4,6 +4,9 @@ import 'package:logging/logging.dart';
 import 'package:sqflite_sqlcipher/sqflite.dart';
 import '../../domain/entities/message.dart';
 import '../../domain/entities/enhanced_message.dart';
+import '../../domain/models/chat_list_model.dart';
+import '../../domain/services/chat_list_change_feed.dart';
+import '../../domain/services/database_telemetry.dart';
 import '../database/database_helper.dart';
 import '../../domain/utils/compression_util.dart';
 import 'package:pak_connect/domain/utils/chat_utils.dart';
@@ -11,8 +14,9 @@ import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/interfaces/i_message_repository.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 
-class MessageRepository implements IMessageRepository {
+class MessageRepository implements IMessageRepository, IBulkMessageOperations {
   static final _logger = Logger('MessageRepository');
+  static DatabaseTelemetry get _telemetry => DatabaseTelemetry.instance;
 
   /// Get all messages for a specific chat, sorted by timestamp
   @override
@@ -20,11 +24,14 @@ class MessageRepository implements IMessageRepository {
     try {
       final db = await DatabaseHelper.database;
 
-      final results = await db.query(
+      final results = await _telemetry.time(
         'messages',
-        where: 'chat_id = ?',
-        whereArgs: [chatId.value],
-        orderBy: 'timestamp ASC',
+        () => db.query(
+          'messages',
+          where: 'chat_id = ?',
+          whereArgs: [chatId.value],
+          orderBy: 'timestamp ASC',
+        ),
       );
 
       return results.map(_fromDatabase).toList();
@@ -70,15 +77,35 @@ class MessageRepository implements IMessageRepository {
 
       // 🔧 FIX: Use INSERT OR IGNORE to prevent duplicate messages
       // If a message with the same ID already exists, this will silently skip the insert
-      final insertedId = await db.insert(
+      final row = _toDatabase(message, now, now);
+      final insertedId = await _telemetry.time(
         'messages',
-        _toDatabase(message, now, now),
-        conflictAlgorithm: ConflictAlgorithm.ignore, // Prevent duplicates
+        () => db.insert(
+          'messages',
+          row,
+          conflictAlgorithm: ConflictAlgorithm.ignore, // Prevent duplicates
+        ),
+        write: true,
       );
 
       // If the insert was ignored (duplicate), perform an update so status changes persist.
       if (insertedId == 0) {
         await updateMessage(message);
+      } else {
+        _telemetry.recordWrite(
+          'messages',
+          rows: 1,
+          bytes: DatabaseTelemetry.estimateBytes(row),
+        );
+        await _touchChatActivity(db, message);
+        ChatListChangeFeed.instance.publish(
+          ChatMessageInserted(
+            chatId: message.chatId,
+            content: message.content,
+            timestamp: message.timestamp,
+            failed: _isFailedOutgoing(message),
+          ),
+        );
       }
 
       _logger.info(
@@ -111,12 +138,30 @@ class MessageRepository implements IMessageRepository {
           ? existing.first['created_at'] as int
           : now;
 
-      await db.update(
+      final row = _toDatabase(message, createdAt, now);
+      await _telemetry.time(
         'messages',
-        _toDatabase(message, createdAt, now),
-        where: 'id = ?',
-        whereArgs: [message.id.value],
+        () => db.update(
+          'messages',
+          row,
+          where: 'id = ?',
+          whereArgs: [message.id.value],
+        ),
+        write: true,
       );
+      _telemetry.recordWrite(
+        'messages',
+        bytes: DatabaseTelemetry.estimateBytes(row),
+      );
+
+      if (message.isFromMe) {
+        ChatListChangeFeed.instance.publish(
+          ChatMessageStatusChanged(
+            chatId: message.chatId,
+            failed: _isFailedOutgoing(message),
+          ),
+        );
+      }
 
       _logger.fine('✅ Updated message ${message.id.value}');
     } catch (e) {
@@ -131,12 +176,20 @@ class MessageRepository implements IMessageRepository {
     try {
       final db = await DatabaseHelper.database;
 
-      await db.delete(
+      final rowsDeleted = await _telemetry.time(
         'messages',
-        where: 'chat_id = ?',
-        whereArgs: [chatId.value],
+        () => db.delete(
+          'messages',
+          where: 'chat_id = ?',
+          whereArgs: [chatId.value],
+        ),
+        write: true,
       );
+      _telemetry.recordWrite('messages', rows: -rowsDeleted);
 
+      ChatListChangeFeed.instance.publish(
+        const ChatListInvalidated('messages cleared'),
+      );
       _logger.info('✅ Cleared messages for chat ${chatId.value}');
     } catch (e) {
       _logger.severe('❌ Failed to clear messages: $e');
@@ -150,14 +203,22 @@ class MessageRepository implements IMessageRepository {
     try {
       final db = await DatabaseHelper.database;
 
-      final rowsDeleted = await db.delete(
+      final rowsDeleted = await _telemetry.time(
         'messages',
-        where: 'id = ?',
-        whereArgs: [messageId.value],
+        () => db.delete(
+          'messages',
+          where: 'id = ?',
+          whereArgs: [messageId.value],
+        ),
+        write: true,
       );
 
       final wasDeleted = rowsDeleted > 0;
       if (wasDeleted) {
+        _telemetry.recordWrite('messages', rows: -rowsDeleted);
+        ChatListChangeFeed.instance.publish(
+          const ChatListInvalidated('message deleted'),
+        );
         _logger.fine('✅ Deleted message ${messageId.value}');
       } else {
         _logger.warning('⚠️ Message ${messageId.value} not found');
@@ -170,6 +231,110 @@ class MessageRepository implements IMessageRepository {
     }
   }
 
+  /// Delete [messageIds] in one transaction, one statement per slice of
+  /// [DatabaseHelper.maxBoundParameters] ids
+  @override
+  Future<Map<MessageId, ChatId>> deleteMessagesByIds(
+    List<MessageId> messageIds,
+  ) async {
+    final ids = {for (final id in messageIds) id.value}.toList();
+    if (ids.isEmpty) return {};
+
+    try {
+      final db = await DatabaseHelper.database;
+      final deleted = <MessageId, ChatId>{};
+
+      await _telemetry.time(
+        'messages',
+        () => db.transaction((txn) async {
+          for (final chunk in DatabaseHelper.inClauseChunks(ids)) {
+            final where =
+                'id IN (${List.filled(chunk.length, '?').join(', ')})';
+            final rows = await txn.query(
+              'messages',
+              columns: ['id', 'chat_id'],
+              where: where,
+              whereArgs: chunk,
+            );
+            for (final row in rows) {
+              deleted[MessageId(row['id'] as String)] = ChatId(
+                row['chat_id'] as String,
+              );
+            }
+            await txn.delete('messages', where: where, whereArgs: chunk);
+          }
+        }),
+        write: true,
+      );
+
+      if (deleted.isNotEmpty) {
+        _telemetry.recordWrite('messages', rows: -deleted.length);
+        ChatListChangeFeed.instance.publish(
+          ChatListInvalidated('${deleted.length} messages deleted'),
+        );
+      }
+      _logger.info('🗑️ Deleted ${deleted.length}/${ids.length} messages');
+      return deleted;
+    } catch (e) {
+      _logger.severe('❌ Failed to delete messages in bulk: $e');
+      rethrow;
+    }
+  }
+
+  /// Delete all messages of [chatIds] in one transaction
+  @override
+  Future<List<MessageId>> clearMessagesForChats(List<ChatId> chatIds) async {
+    final ids = {for (final id in chatIds) id.value}.toList();
+    if (ids.isEmpty) return const [];
+
+    try {
+      final db = await DatabaseHelper.database;
+      final deleted = await _telemetry.time(
+        'messages',
+        () => db.transaction((txn) => deleteForChats(txn, ids)),
+        write: true,
+      );
+      _telemetry.recordWrite('messages', rows: -deleted.length);
+
+      ChatListChangeFeed.instance.publish(
+        ChatListInvalidated('messages cleared in ${ids.length} chats'),
+      );
+      _logger.info(
+        '✅ Cleared ${deleted.length} messages in ${ids.length} chats',
+      );
+      return deleted;
+    } catch (e) {
+      _logger.severe('❌ Failed to clear messages in bulk: $e');
+      rethrow;
+    }
+  }
+
+  /// Delete every message in [chatIds] through [executor] (usually a
+  /// caller's transaction); returns the deleted ids. Publishes and records
+  /// nothing, so callers report once the transaction has committed.
+  static Future<List<MessageId>> deleteForChats(
+    DatabaseExecutor executor,
+    List<String> chatIds,
+  ) async {
+    final deleted = <MessageId>[];
+    for (final chunk in DatabaseHelper.inClauseChunks(chatIds)) {
+      final where =
+          'chat_id IN (${List.filled(chunk.length, '?').join(', ')})';
+      final rows = await executor.query(
+        'messages',
+        columns: ['id'],
+        where: where,
+        whereArgs: chunk,
+      );
+      deleted.addAll(rows.map((row) => MessageId(row['id'] as String)));
+      await executor.delete('messages', where: where, whereArgs: chunk);
+    }
+    return deleted;
+  }
+
+  static bool _isFailedOutgoing(Message message) =>
+      message.isFromMe && message.status == MessageStatus.failed;
+
   /// Get all messages for interaction calculations
   @override
   Future<List<Message>> getAllMessages() async {
@@ -240,6 +405,90 @@ class MessageRepository implements IMessageRepository {
     }
   }
 
+  /// Newest inbound message in a chat (the read watermark anchor)
+  Future<MessageId?> getLatestIncomingMessageId(ChatId chatId) async {
+    try {
+      final db = await DatabaseHelper.database;
+      final results = await db.query(
+        'messages',
+        columns: ['id'],
+        where: 'chat_id = ? AND is_from_me = 0',
+        whereArgs: [chatId.value],
+        orderBy: 'timestamp DESC',
+        limit: 1,
+      );
+      if (results.isEmpty) return null;
+      return MessageId(results.first['id'] as String);
+    } catch (e) {
+      _logger.warning('⚠️ Failed to read latest inbound message: $e');
+      return null;
+    }
+  }
+
+  /// Stamp [receipt] onto our outgoing messages covered by a peer's read
+  /// watermark, in one statement.
+  ///
+  /// Covered means: the anchor itself and delivered messages at or before
+  /// the anchor (in our clock). Undelivered messages before the anchor may
+  /// still be in flight, so they wait for a later watermark. Returns the
+  /// number of messages updated.
+  Future<int> applyReadWatermark(
+    ChatId chatId, {
+    MessageId? anchor,
+    required MessageReadReceipt receipt,
+  }) async {
+    try {
+      final db = await DatabaseHelper.database;
+      final clauses = <String>[];
+      final args = <Object?>[];
+
+      if (anchor != null) {
+        final anchorRows = await db.query(
+          'messages',
+          columns: ['timestamp'],
+          where: 'id = ? AND chat_id = ? AND is_from_me = 1',
+          whereArgs: [anchor.value, chatId.value],
+          limit: 1,
+        );
+        if (anchorRows.isNotEmpty) {
+          clauses.add('(timestamp <= ? AND status = ?)');
+          args
+            ..add(anchorRows.first['timestamp'] as int)
+            ..add(MessageStatus.delivered.index);
+        }
+      }
+
+      if (anchor != null) {
+        clauses.add('id = ?');
+        args.add(anchor.value);
+      }
+
+      if (clauses.isEmpty) return 0;
+
+      final updated = await db.rawUpdate(
+        'UPDATE messages SET read_receipt_json = ?, updated_at = ? '
+        'WHERE chat_id = ? AND is_from_me = 1 AND read_receipt_json IS NULL '
+        'AND (${clauses.join(' OR ')})',
+        [
+          _encodeJson(receipt.toJson()),
+          DateTime.now().millisecondsSinceEpoch,
+          chatId.value,
+          ...args,
+        ],
+      );
+
+      if (updated > 0) {
+        _logger.fine(
+          '👁️ Read watermark marked $updated message(s) in ${chatId.value.shortId(8)}...',
+        );
+      }
+      return updated;
+    } catch (e) {
+      _logger.severe('❌ Failed to apply read watermark: $e');
+      return 0;
+    }
+  }
+
   // ========================================
   // PRIVATE HELPER METHODS
   // ========================================
@@ -295,27 +544,47 @@ class MessageRepository implements IMessageRepository {
         }
       }
 
-      await db.insert(
+      final row = {
+        'chat_id': chatId.value,
+        'contact_public_key': contactPublicKey,
+        'contact_name': contactName,
+        'unread_count': 0,
+        'is_archived': 0,
+        'is_muted': 0,
+        'is_pinned': 0,
+        'created_at': timestamp,
+        'updated_at': timestamp,
+      };
+      final insertedId = await db.insert(
         'chats',
-        {
-          'chat_id': chatId.value,
-          'contact_public_key': contactPublicKey,
-          'contact_name': contactName,
-          'unread_count': 0,
-          'is_archived': 0,
-          'is_muted': 0,
-          'is_pinned': 0,
-          'created_at': timestamp,
-          'updated_at': timestamp,
-        },
+        row,
         conflictAlgorithm:
             ConflictAlgorithm.ignore, // Prevent duplicates if concurrent
       );
+      if (insertedId != 0) {
+        _telemetry.recordWrite(
+          'chats',
+          rows: 1,
+          bytes: DatabaseTelemetry.estimateBytes(row),
+        );
+      }
 
       _logger.info('✅ Created chat entry for: ${chatId.value}');
     }
   }
 
+  /// Keep chats.last_message_time (the auto-archive index) current; only
+  /// moves forward so late-delivered older messages do not rewind it.
+  Future<void> _touchChatActivity(Database db, Message message) async {
+    final timestamp = message.timestamp.millisecondsSinceEpoch;
+    await db.rawUpdate(
+      'UPDATE chats SET last_message_time = ? '
+      'WHERE chat_id = ? '
+      'AND (last_message_time IS NULL OR last_message_time < ?)',
+      [timestamp, message.chatId.value, timestamp],
+    );
+  }
+
   /// Convert database row to Message/EnhancedMessage
   Message _fromDatabase(Map<String, dynamic> row) {
     // Check if this is an EnhancedMessage by looking for enhanced fields
@@ -1,10 +1,10 @@
 import 'package:shared_preferences/shared_preferences.dart';
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:pointycastle/export.dart';
 import 'package:logging/logging.dart';
 import 'dart:typed_data';
 import 'dart:math';
 import 'package:pak_connect/domain/interfaces/i_user_preferences.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
 
 class UserPreferences implements IUserPreferences {
   static final _logger = Logger('UserPreferences');
@@ -88,8 +88,7 @@ class UserPreferences implements IUserPreferences {
   Future<String> getPublicKey() async {
     _logger.info('🔑 Reading public key from secure storage...');
     final start = DateTime.now();
-    final storage = FlutterSecureStorage();
-    final publicKey = await storage.read(key: _publicKeyKey);
+    final publicKey = await SecureStorageVault.instance.read(_publicKeyKey);
     _logger.info(
       '✅ Public key read in ${DateTime.now().difference(start).inMilliseconds}ms',
     );
@@ -100,8 +99,7 @@ class UserPreferences implements IUserPreferences {
   Future<String> getPrivateKey() async {
     _logger.info('🔑 Reading private key from secure storage...');
     final start = DateTime.now();
-    final storage = FlutterSecureStorage();
-    final privateKey = await storage.read(key: _privateKeyKey);
+    final privateKey = await SecureStorageVault.instance.read(_privateKeyKey);
     _logger.info(
       '✅ Private key read in ${DateTime.now().difference(start).inMilliseconds}ms',
     );
@@ -152,9 +150,10 @@ class UserPreferences implements IUserPreferences {
     // Store securely
     _logger.info('🔑 Storing keys in secure storage...');
     final storeStart = DateTime.now();
-    final storage = FlutterSecureStorage();
-    await storage.write(key: _publicKeyKey, value: publicKeyHex);
-    await storage.write(key: _privateKeyKey, value: privateKeyHex);
+    await SecureStorageVault.instance.writeAll({
+      _publicKeyKey: publicKeyHex,
+      _privateKeyKey: privateKeyHex,
+    });
     _logger.info(
       '✅ Keys stored in ${DateTime.now().difference(storeStart).inMilliseconds}ms',
     );
@@ -169,9 +168,10 @@ class UserPreferences implements IUserPreferences {
 
   @override
   Future<void> regenerateKeyPair() async {
-    final storage = FlutterSecureStorage();
-    await storage.delete(key: _publicKeyKey);
-    await storage.delete(key: _privateKeyKey);
+    await SecureStorageVault.instance.writeAll({
+      _publicKeyKey: null,
+      _privateKeyKey: null,
+    });
     await _generateNewKeyPair();
   }
 
@@ -4,19 +4,23 @@ import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 import 'package:logging/logging.dart';
 
 import '../../domain/constants/ble_constants.dart';
+import 'linux_ble_notification_ring.dart';
 
 class BleConnectionGattController {
   BleConnectionGattController({
     required Logger logger,
     required CentralManager centralManager,
     required bool Function(Object error) isTransientConnectError,
+    BleNotificationBatchSource? notificationBatchSource,
   }) : _logger = logger,
        _centralManager = centralManager,
-       _isTransientConnectError = isTransientConnectError;
+       _isTransientConnectError = isTransientConnectError,
+       _notificationBatchSource = notificationBatchSource;
 
   final Logger _logger;
   final CentralManager _centralManager;
   final bool Function(Object error) _isTransientConnectError;
+  final BleNotificationBatchSource? _notificationBatchSource;
 
   Future<void> connectWithRetry({
     required Peripheral device,
@@ -144,6 +148,21 @@ class BleConnectionGattController {
       return;
     }
 
+    // An acquired link notifies only through the batch source, so it must
+    // not also be enabled through the plugin.
+    final source = _notificationBatchSource;
+    if (source != null &&
+        await source.acquire(
+          device.uuid.toString(),
+          characteristic.uuid.toString(),
+        )) {
+      _logger.info(
+        '⚡ Notifications for $formattedAddress use the native ring',
+      );
+      await Future.delayed(const Duration(milliseconds: 200));
+      return;
+    }
+
     await _centralManager.setCharacteristicNotifyState(
       device,
       characteristic,
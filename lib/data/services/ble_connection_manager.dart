@@ -19,6 +19,7 @@ import 'ephemeral_contact_cleaner.dart';
 import 'ble_connection_state_machine.dart';
 import 'ble_connection_gatt_controller.dart';
 import 'ble_connection_reconnect_policy.dart';
+import 'linux_ble_notification_ring.dart';
 
 part 'ble_connection_manager_runtime_server_links.dart';
 part 'ble_connection_manager_runtime_collision_policy.dart';
@@ -118,6 +119,7 @@ class BLEConnectionManager {
     required this.centralManager,
     required this.peripheralManager,
     PowerMode initialPowerMode = PowerMode.balanced,
+    BleNotificationBatchSource? notificationBatchSource,
   }) {
     _reconnectPolicy = BleConnectionReconnectPolicy(logger: _logger);
     _limitEnforcer = ConnectionLimitEnforcer(logger: _logger);
@@ -165,6 +167,7 @@ class BLEConnectionManager {
       logger: _logger,
       centralManager: centralManager,
       isTransientConnectError: _limitEnforcer.isTransientConnectError,
+      notificationBatchSource: notificationBatchSource,
     );
   }
 
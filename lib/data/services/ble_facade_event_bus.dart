@@ -1,131 +1,73 @@
 import 'package:logging/logging.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/spy_mode_info.dart';
-
+import 'package:pak_connect/domain/services/app_event_channels.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
+
+/// Facade-level BLE events on the app's [TypedEventBus] channels.
+///
+/// Streams deliver synchronously by default; UI consumers can pass
+/// [EventDelivery.frame] to receive at most one batch per frame. Without an
+/// injected [bus] the facade gets a private one.
 class BleFacadeEventBus {
-  BleFacadeEventBus({required Logger logger}) : _logger = logger;
-
-  final Logger _logger;
-
-  final Set<void Function(ConnectionInfo)> _connectionInfoListeners = {};
-  final Set<void Function(String)> _hintMatchListeners = {};
-  final Set<void Function(SpyModeInfo)> _spyModeListeners = {};
-  final Set<void Function(String)> _identityListeners = {};
-
-  Stream<ConnectionInfo> connectionInfoStream(ConnectionInfo currentInfo) {
-    return Stream<ConnectionInfo>.multi((controller) {
-      controller.add(currentInfo);
-
-      void listener(ConnectionInfo info) {
-        controller.add(info);
-      }
-
-      _connectionInfoListeners.add(listener);
-      controller.onCancel = () {
-        _connectionInfoListeners.remove(listener);
-      };
-    });
+  BleFacadeEventBus({
+    required Logger logger,
+    TypedEventBus? bus,
+    FrameScheduler? scheduleFrame,
+  }) : _ownsBus = bus == null,
+       _bus =
+           bus ??
+           AppEventChannels.createBus(
+             logger: logger,
+             scheduleFrame: scheduleFrame,
+           ) {
+    _connectionInfo = _bus.channel(AppEventChannels.connectionInfo);
+    _hintMatches = _bus.channel(AppEventChannels.hintMatch);
+    _spyMode = _bus.channel(AppEventChannels.spyMode);
+    _identityRevealed = _bus.channel(AppEventChannels.identityRevealed);
   }
 
-  Stream<String> hintMatchesStream() {
-    return Stream<String>.multi((controller) {
-      void listener(String hint) {
-        controller.add(hint);
-      }
-
-      _hintMatchListeners.add(listener);
-      controller.onCancel = () {
-        _hintMatchListeners.remove(listener);
-      };
-    });
+  final TypedEventBus _bus;
+  final bool _ownsBus;
+  late final EventChannel<ConnectionInfo> _connectionInfo;
+  late final EventChannel<String> _hintMatches;
+  late final EventChannel<SpyModeInfo> _spyMode;
+  late final EventChannel<String> _identityRevealed;
+
+  /// Per-channel throughput and dispatch latency
+  Map<String, EventChannelStats> get stats => _bus.stats;
+
+  Stream<ConnectionInfo> connectionInfoStream(
+    ConnectionInfo currentInfo, {
+    EventDelivery delivery = EventDelivery.sync,
+  }) {
+    // Within a frame only the newest connection snapshot matters.
+    return _connectionInfo.stream(
+      delivery: delivery,
+      keyOf: (_) => AppEventChannels.connectionInfo,
+      initial: () => currentInfo,
+    );
   }
 
-  Stream<SpyModeInfo> spyModeDetectedStream() {
-    return Stream<SpyModeInfo>.multi((controller) {
-      void listener(SpyModeInfo info) {
-        controller.add(info);
-      }
+  Stream<String> hintMatchesStream({
+    EventDelivery delivery = EventDelivery.sync,
+  }) => _hintMatches.stream(delivery: delivery);
 
-      _spyModeListeners.add(listener);
-      controller.onCancel = () {
-        _spyModeListeners.remove(listener);
-      };
-    });
-  }
+  Stream<SpyModeInfo> spyModeDetectedStream() => _spyMode.stream();
 
-  Stream<String> identityRevealedStream() {
-    return Stream<String>.multi((controller) {
-      void listener(String identity) {
-        controller.add(identity);
-      }
+  Stream<String> identityRevealedStream() => _identityRevealed.stream();
 
-      _identityListeners.add(listener);
-      controller.onCancel = () {
-        _identityListeners.remove(listener);
-      };
-    });
-  }
+  void emitConnectionInfo(ConnectionInfo info) => _connectionInfo.emit(info);
 
-  void emitConnectionInfo(ConnectionInfo info) {
-    for (final listener in List.of(_connectionInfoListeners)) {
-      try {
-        listener(info);
-      } catch (error, stackTrace) {
-        _logger.warning(
-          'Error notifying connection info listener: $error',
-          error,
-          stackTrace,
-        );
-      }
-    }
-  }
+  void emitHintMatch(String hint) => _hintMatches.emit(hint);
 
-  void emitHintMatch(String hint) {
-    for (final listener in List.of(_hintMatchListeners)) {
-      try {
-        listener(hint);
-      } catch (error, stackTrace) {
-        _logger.warning(
-          'Error notifying hint listener: $error',
-          error,
-          stackTrace,
-        );
-      }
-    }
-  }
+  void emitSpyMode(SpyModeInfo info) => _spyMode.emit(info);
 
-  void emitSpyMode(SpyModeInfo info) {
-    for (final listener in List.of(_spyModeListeners)) {
-      try {
-        listener(info);
-      } catch (error, stackTrace) {
-        _logger.warning(
-          'Error notifying spy mode listener: $error',
-          error,
-          stackTrace,
-        );
-      }
-    }
-  }
-
-  void emitIdentityRevealed(String contactId) {
-    for (final listener in List.of(_identityListeners)) {
-      try {
-        listener(contactId);
-      } catch (error, stackTrace) {
-        _logger.warning(
-          'Error notifying identity listener: $error',
-          error,
-          stackTrace,
-        );
-      }
-    }
-  }
+  void emitIdentityRevealed(String contactId) =>
+      _identityRevealed.emit(contactId);
 
+  /// Drop subscribers of a private bus; the app bus outlives the facade.
   void clear() {
-    _connectionInfoListeners.clear();
-    _hintMatchListeners.clear();
-    _spyModeListeners.clear();
-    _identityListeners.clear();
+    if (_ownsBus) _bus.clear();
   }
 }
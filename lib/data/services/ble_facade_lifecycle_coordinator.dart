@@ -1,4 +1,5 @@
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 import 'package:logging/logging.dart';
@@ -14,6 +15,7 @@ import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../../domain/services/device_deduplication_manager.dart';
 import 'ble_connection_manager.dart';
 import 'ble_connection_service.dart';
+import 'linux_ble_notification_ring.dart';
 
 class BleLifecycleCoordinator {
   BleLifecycleCoordinator({
@@ -25,6 +27,7 @@ class BleLifecycleCoordinator {
     required IBLEAdvertisingService Function() getAdvertisingService,
     required IBLEMessagingService Function() getMessagingService,
     required IBLEHandshakeService Function() getHandshakeService,
+    BleNotificationBatchSource? notificationBatchSource,
   }) : _logger = logger,
        _platformHost = platformHost,
        _connectionManager = connectionManager,
@@ -32,7 +35,8 @@ class BleLifecycleCoordinator {
        _getDiscoveryService = getDiscoveryService,
        _getAdvertisingService = getAdvertisingService,
        _getMessagingService = getMessagingService,
-       _getHandshakeService = getHandshakeService;
+       _getHandshakeService = getHandshakeService,
+       _notificationBatchSource = notificationBatchSource;
 
   final Logger _logger;
   final IBLEPlatformHost _platformHost;
@@ -42,6 +46,7 @@ class BleLifecycleCoordinator {
   final IBLEAdvertisingService Function() _getAdvertisingService;
   final IBLEMessagingService Function() _getMessagingService;
   final IBLEHandshakeService Function() _getHandshakeService;
+  final BleNotificationBatchSource? _notificationBatchSource;
 
   Timer? _serverHandshakeTimer;
   StreamSubscription<CentralConnectionStateChangedEventArgs>?
@@ -52,6 +57,7 @@ class BleLifecycleCoordinator {
   StreamSubscription<GATTCharacteristicWriteRequestedEventArgs>?
   _peripheralWriteSub;
   StreamSubscription<GATTCharacteristicNotifiedEventArgs>? _centralNotifySub;
+  StreamSubscription<List<BleNotificationFrame>>? _notificationBatchSub;
 
   bool _peripheralEventsBound = false;
   bool _connectionSetupComplete = false;
@@ -99,12 +105,14 @@ class BleLifecycleCoordinator {
     await _peripheralNotifyStateSub?.cancel();
     await _peripheralWriteSub?.cancel();
     await _centralNotifySub?.cancel();
+    await _notificationBatchSub?.cancel();
 
     _peripheralConnectionSub = null;
     _peripheralMtuSub = null;
     _peripheralNotifyStateSub = null;
     _peripheralWriteSub = null;
     _centralNotifySub = null;
+    _notificationBatchSub = null;
 
     _peripheralEventsBound = false;
     _connectionSetupComplete = false;
@@ -396,6 +404,8 @@ class BleLifecycleCoordinator {
   void _bindCentralNotificationHandler() {
     if (_centralNotifySub != null) return;
 
+    _bindNotificationBatchSource();
+
     try {
       _centralNotifySub = _platformHost.centralManager.characteristicNotified
           .listen((event) async {
@@ -412,24 +422,8 @@ class BleLifecycleCoordinator {
                 return;
               }
 
-              final handled = await _getHandshakeService()
-                  .handleIncomingHandshakeMessage(
-                    event.value,
-                    isFromPeripheral: false,
-                  );
-
-              if (handled) return;
-
               final deviceId = event.peripheral.uuid.toString();
-              final nodeId = DeviceDeduplicationManager.getDevice(
-                deviceId,
-              )?.ephemeralHint;
-
-              await _getMessagingService().processIncomingPeripheralData(
-                event.value,
-                senderDeviceId: deviceId,
-                senderNodeId: nodeId,
-              );
+              await _handleCentralNotification(deviceId, event.value);
             } catch (e, stack) {
               _logger.warning(
                 '⚠️ Failed to process central notification: $e',
@@ -442,4 +436,48 @@ class BleLifecycleCoordinator {
       _logger.fine('Central notify binding not supported: $e', e, stack);
     }
   }
+
+  /// Deliver frames from links whose notifications were acquired by the
+  /// native batch source (Linux runner ring). The plugin never sees those
+  /// frames, so each one arrives on exactly one of the two paths.
+  void _bindNotificationBatchSource() {
+    final source = _notificationBatchSource;
+    if (source == null || _notificationBatchSub != null) return;
+
+    _notificationBatchSub = source.batches.listen((frames) async {
+      for (final frame in frames) {
+        try {
+          await _handleCentralNotification(frame.peripheralId, frame.payload);
+        } catch (e, stack) {
+          _logger.warning(
+            '⚠️ Failed to process batched notification: $e',
+            e,
+            stack,
+          );
+        }
+      }
+    });
+  }
+
+  Future<void> _handleCentralNotification(
+    String deviceId,
+    Uint8List value,
+  ) async {
+    final handled = await _getHandshakeService().handleIncomingHandshakeMessage(
+      value,
+      isFromPeripheral: false,
+    );
+
+    if (handled) return;
+
+    final nodeId = DeviceDeduplicationManager.getDevice(
+      deviceId,
+    )?.ephemeralHint;
+
+    await _getMessagingService().processIncomingPeripheralData(
+      value,
+      senderDeviceId: deviceId,
+      senderNodeId: nodeId,
+    );
+  }
 }
@@ -7,6 +7,7 @@ import 'package:logging/logging.dart';
 import '../../domain/utils/message_fragmenter.dart';
 import '../../domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import '../../data/repositories/contact_repository.dart';
 import 'ble_state_manager.dart';
 import 'contact_event_handler.dart';
@@ -19,12 +20,14 @@ import '../../domain/messaging/offline_message_queue_contract.dart';
 import 'package:pak_connect/domain/messaging/message_ack_tracker.dart';
 import 'inbound_text_processor.dart';
 import 'protocol_message_dispatcher.dart';
+import 'read_receipt_sync_controller.dart';
 import '../../domain/messaging/message_chunk_sender.dart';
 import '../../domain/entities/message.dart';
 import '../../data/repositories/user_preferences.dart';
 import '../../data/repositories/message_repository.dart';
 import '../../domain/services/ephemeral_key_manager.dart';
 import '../../domain/services/signing_manager.dart';
+import '../../domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../../domain/values/id_types.dart';
 
@@ -217,6 +220,11 @@ class BLEMessageHandler {
               ackRoutingPath: ackRoutingPath,
             );
           },
+      onCustodyAck: (originalMessageId, custodian) =>
+          _meshRelayHandler.handleCustodyAck(
+            originalMessageId: originalMessageId,
+            custodian: custodian,
+          ),
       onQueueSyncReceived: (syncMessage, fromNodeId) {
         _queueSyncProcessor.handleDispatchedQueueSync(
           syncMessage: syncMessage,
@@ -544,6 +552,10 @@ class BLEMessageHandler {
           // ACKs are handled in ProtocolMessageDispatcher; ignore here.
           return null;
 
+        case ProtocolMessageType.ping:
+          _sendPong(senderPublicKey);
+          return null;
+
         case ProtocolMessageType.identity:
           return null;
 
@@ -576,6 +588,13 @@ class BLEMessageHandler {
           // Handle friend identity reveal in spy mode
           return await _handleFriendReveal(protocolMessage, senderPublicKey);
 
+        case ProtocolMessageType.readReceipt:
+          await ReadReceiptSyncController.instance.handleReadReceipt(
+            protocolMessage,
+            senderPublicKey,
+          );
+          return null;
+
         default:
           return null;
       }
@@ -742,8 +761,6 @@ class BLEMessageHandler {
     required int mtuSize,
     required BLEStateManager stateManager,
   }) async {
-    // Maintain signature for compatibility
-    final _ = stateManager;
     return await _queueSyncProcessor.sendQueueSyncMessage(
       centralManager: centralManager,
       peripheralManager: peripheralManager,
@@ -752,6 +769,11 @@ class BLEMessageHandler {
       messageCharacteristic: messageCharacteristic,
       syncMessage: syncMessage,
       mtuSize: mtuSize,
+      binary: PeerCapabilityRegistry.instance.supportsAny([
+        stateManager.currentSessionId,
+        stateManager.theirEphemeralId,
+        stateManager.theirPersistentKey,
+      ], PeerCapabilities.binaryQueueSync),
     );
   }
 
@@ -798,7 +820,13 @@ class BLEMessageHandler {
         return;
       }
 
-      final ackMessage = ProtocolMessage.ack(originalMessageId: messageId);
+      final ackMessage = ProtocolMessage.ack(
+        originalMessageId: messageId,
+        compact: PeerCapabilityRegistry.instance.supports(
+          senderPublicKey,
+          PeerCapabilities.compactAck,
+        ),
+      );
       onSendAckMessage!(ackMessage);
 
       final senderPreview = senderPublicKey != null
@@ -816,6 +844,24 @@ class BLEMessageHandler {
     }
   }
 
+  /// Answer a ping on the ACK path. Only peers that advertised
+  /// [PeerCapabilities.compactAck] know the pong type.
+  void _sendPong(String? senderPublicKey) {
+    final send = onSendAckMessage;
+    if (send == null ||
+        !PeerCapabilityRegistry.instance.supports(
+          senderPublicKey,
+          PeerCapabilities.compactAck,
+        )) {
+      return;
+    }
+    try {
+      send(ProtocolMessage.pong(compact: true));
+    } catch (e, stack) {
+      _logger.warning('⚠️ Failed to send pong: $e', e, stack);
+    }
+  }
+
   /// Handle inbound ACK by updating message status to delivered.
   Future<void> _handleInboundAck(
       String messageId, String senderPublicKey) async {
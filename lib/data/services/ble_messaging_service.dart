@@ -8,6 +8,7 @@ import 'package:flutter/services.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_messaging_service.dart';
 import '../../domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import '../../domain/utils/message_fragmenter.dart';
 import '../../domain/utils/binary_fragmenter.dart';
 import 'package:pak_connect/domain/constants/binary_payload_types.dart';
@@ -20,6 +21,7 @@ import 'package:pak_connect/domain/interfaces/i_ble_state_manager_facade.dart';
 import '../../data/repositories/contact_repository.dart';
 import '../../data/repositories/message_repository.dart';
 import '../../domain/services/device_deduplication_manager.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/services/security_service_locator.dart';
 import 'package:pak_connect/domain/models/ble_server_connection.dart';
 import 'package:pak_connect/domain/utils/chat_utils.dart';
@@ -321,6 +323,11 @@ class BLEMessagingService implements IBLEMessagingService {
 
     final protocolMessage = ProtocolMessage.queueSync(
       queueMessage: queueMessage,
+      binary: PeerCapabilityRegistry.instance.supportsAny([
+        _stateManager.currentSessionId,
+        _stateManager.theirEphemeralId,
+        _stateManager.theirPersistentKey,
+      ], PeerCapabilities.binaryQueueSync),
     );
     await _sendProtocolMessage(protocolMessage);
   }
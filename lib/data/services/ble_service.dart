@@ -23,6 +23,7 @@ class BLEService extends BLEServiceFacade {
     super.connectionManager,
     super.peripheralInitializer,
     super.advertisingManager,
+    super.eventBus,
   }) : super(
          stateManager: stateManagerFacade,
          legacyStateManager: stateManager,
@@ -30,6 +30,9 @@ import 'ble_advertising_service.dart';
 import 'ble_handshake_service.dart';
 import 'ble_facade_event_bus.dart';
 import 'ble_facade_lifecycle_coordinator.dart';
+import 'linux_ble_notification_ring.dart';
+import 'mesh_relay_handler.dart';
+import 'read_receipt_sync_controller.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_state_manager_facade.dart';
 import 'ble_state_manager.dart';
 import 'ble_state_manager_facade.dart';
@@ -45,6 +48,7 @@ import '../../domain/services/ble_platform_host.dart';
 import '../../domain/services/hint_scanner_service.dart';
 import '../../domain/services/device_deduplication_manager.dart';
 import 'package:pak_connect/domain/services/security_service_locator.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../repositories/user_preferences.dart';
 import '../../domain/services/ephemeral_key_manager.dart';
@@ -153,6 +157,7 @@ class BLEServiceFacade implements IBLEServiceFacade, IConnectionService {
     AdvertisingManager? advertisingManager,
     ContactRepository? contactRepository,
     IHandshakeCoordinatorFactory? handshakeCoordinatorFactory,
+    TypedEventBus? eventBus,
   }) : _platformHost =
            platformHost ??
            BlePlatformHost(
@@ -174,12 +179,16 @@ class BLEServiceFacade implements IBLEServiceFacade, IConnectionService {
        _handshakeService = handshakeService,
        _handshakeCoordinatorFactory = handshakeCoordinatorFactory,
        instanceId = ++_nextInstanceId {
-    _eventBus = BleFacadeEventBus(logger: _logger);
+    _eventBus = BleFacadeEventBus(logger: _logger, bus: eventBus);
+    // Shared: the connection manager acquires links into the ring and the
+    // lifecycle coordinator delivers what it drains.
+    final notificationRing = LinuxBleNotificationRing.tryOpen();
     _connectionManager =
         connectionManager ??
         BLEConnectionManager(
           centralManager: _platformHost.centralManager,
           peripheralManager: _platformHost.peripheralManager,
+          notificationBatchSource: notificationRing,
         );
     _connectionManager.onInboundDuplicateRejected = (address) {
       _handshakeService?.disposeHandshakeCoordinator();
@@ -228,6 +237,7 @@ class BLEServiceFacade implements IBLEServiceFacade, IConnectionService {
       getAdvertisingService: _getAdvertisingService,
       getMessagingService: _getMessagingService,
       getHandshakeService: _getHandshakeService,
+      notificationBatchSource: notificationRing,
     );
     _runtimeHelper = _BleServiceFacadeRuntimeHelper(this);
     _recordInstanceCreated();
@@ -271,6 +281,9 @@ class BLEServiceFacade implements IBLEServiceFacade, IConnectionService {
   @override
   Stream<String> get hintMatches => _eventBus.hintMatchesStream();
 
+  /// Throughput and dispatch latency of the facade's event channels
+  Map<String, EventChannelStats> get eventBusStats => _eventBus.stats;
+
   /// Get or create advertising service (lazy singleton)
   IBLEAdvertisingService _getAdvertisingService() {
     _advertisingManager
@@ -308,6 +321,32 @@ class BLEServiceFacade implements IBLEServiceFacade, IConnectionService {
     _messageHandlerFacade.onSendAckMessage = (protocolMessage) async {
       await service.sendHandshakeMessage(protocolMessage);
     };
+    // Aggregated read receipts go to the connected peer only; anything else
+    // stays pending in the controller until that peer reconnects.
+    ReadReceiptSyncController.instance.configureTransport((
+      chatId,
+      protocolMessage,
+    ) async {
+      final peer = chatId.value;
+      if (peer != _stateManager.theirPersistentKey &&
+          peer != _stateManager.currentSessionId) {
+        return false;
+      }
+      await service.sendHandshakeMessage(protocolMessage);
+      return true;
+    });
+    // Custody ACKs must reach the holder that sent us the bundle, which may
+    // no longer be the connected peer.
+    MeshRelayHandler.configurePeerAckTransport((peerId, protocolMessage) async {
+      final connected = <String?>{
+        _stateManager.theirPersistentKey,
+        _stateManager.theirEphemeralId,
+        _stateManager.currentSessionId,
+      };
+      if (!connected.contains(peerId)) return false;
+      await service.sendHandshakeMessage(protocolMessage);
+      return true;
+    });
     return service;
   }
 
@@ -1,11 +1,15 @@
 import 'package:pak_connect/domain/interfaces/i_ble_service_facade.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_service_facade_factory.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 
 import 'ble_service.dart';
 
 class DataBleServiceFacadeFactory implements IBLEServiceFacadeFactory {
-  const DataBleServiceFacadeFactory();
+  const DataBleServiceFacadeFactory({this.eventBus});
+
+  /// App-level bus the facade's channels live on; a private one when null
+  final TypedEventBus? eventBus;
 
   @override
-  IBLEServiceFacade create() => BLEService();
+  IBLEServiceFacade create() => BLEService(eventBus: eventBus);
 }
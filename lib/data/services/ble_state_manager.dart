@@ -589,11 +589,13 @@ class BLEStateManager implements IPairingStateManager {
 
   Future<void> handleContactStatus(
     bool theyHaveUsAsContact,
-    String theirPublicKey,
-  ) async {
+    String theirPublicKey, {
+    int? statusVersion,
+  }) async {
     await _contactStatusSyncController.handleContactStatus(
       theyHaveUsAsContact,
       theirPublicKey,
+      statusVersion: statusVersion,
     );
   }
 
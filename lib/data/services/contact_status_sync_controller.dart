@@ -51,6 +51,8 @@ class ContactStatusSyncController {
   final Map<String, bool> _lastSentContactStatus = {};
   final Map<String, DateTime> _lastStatusSentTime = {};
   final Map<String, bool> _lastReceivedContactStatus = {};
+  final Map<String, int> _sentStatusVersions = {};
+  final Map<String, int> _receivedStatusVersions = {};
   final Map<String, bool> _bilateralSyncComplete = {};
   final Set<String> _processedContactMessages = {};
   Timer? _contactSyncRetryTimer;
@@ -83,14 +85,28 @@ class ContactStatusSyncController {
     }
   }
 
+  /// [statusVersion] is the sender's per-peer version; when present, stale
+  /// or replayed updates are dropped before any state is touched.
   Future<void> handleContactStatus(
     bool theyHaveUsAsContact,
-    String theirPublicKey,
-  ) async {
+    String theirPublicKey, {
+    int? statusVersion,
+  }) async {
     _logger.fine(
       '📱 PROTOCOL: Received contact status - they have us: $theyHaveUsAsContact',
     );
 
+    if (statusVersion != null) {
+      final lastVersion = _receivedStatusVersions[theirPublicKey];
+      if (lastVersion != null && statusVersion <= lastVersion) {
+        _logger.fine(
+          '📱 PROTOCOL: Stale contact status v$statusVersion (have v$lastVersion) - ignoring',
+        );
+        return;
+      }
+      _receivedStatusVersions[theirPublicKey] = statusVersion;
+    }
+
     final previousStatus = _lastReceivedContactStatus[theirPublicKey];
     if (previousStatus == theyHaveUsAsContact) {
       _logger.fine('📱 PROTOCOL: Same status again - ignoring (loop guard)');
@@ -136,6 +152,7 @@ class ContactStatusSyncController {
     _lastSentContactStatus.remove(theirPublicKey);
     _lastStatusSentTime.remove(theirPublicKey);
     _lastReceivedContactStatus.remove(theirPublicKey);
+    _receivedStatusVersions.remove(theirPublicKey);
     _logger.fine('[ContactSync] SYNC RESET for ${theirPublicKey.shortId()}');
   }
 
@@ -144,6 +161,7 @@ class ContactStatusSyncController {
     _lastSentContactStatus.clear();
     _lastStatusSentTime.clear();
     _lastReceivedContactStatus.clear();
+    _receivedStatusVersions.clear();
     _bilateralSyncComplete.clear();
     _processedContactMessages.clear();
     _contactSyncRetryTimer?.cancel();
@@ -176,6 +194,11 @@ class ContactStatusSyncController {
 
       _lastSentContactStatus[theirPublicKey] = weHaveThem;
       _lastStatusSentTime[theirPublicKey] = DateTime.now();
+      if (statusChanged) {
+        _sentStatusVersions[theirPublicKey] = _nextStatusVersion(
+          _sentStatusVersions[theirPublicKey],
+        );
+      }
 
       await _doSendContactStatus(weHaveThem, theirPublicKey);
     } else {
@@ -194,6 +217,7 @@ class ContactStatusSyncController {
       final statusMessage = ProtocolMessage.contactStatus(
         hasAsContact: weHaveThem,
         publicKey: myPublicKey,
+        statusVersion: _sentStatusVersions[theirPublicKey],
       );
 
       onSendContactStatus?.call(statusMessage);
@@ -202,6 +226,13 @@ class ContactStatusSyncController {
     }
   }
 
+  /// Versions only need to grow per peer; seeding from the clock keeps them
+  /// monotonic across restarts without persisting a counter.
+  int _nextStatusVersion(int? previous) {
+    final now = DateTime.now().millisecondsSinceEpoch;
+    return previous == null || now > previous ? now : previous + 1;
+  }
+
   bool _checkAndMarkSyncComplete(
     String theirPublicKey,
     bool weHaveThem,
@@ -4,7 +4,6 @@
 
 import 'dart:convert';
 import 'dart:io';
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:logging/logging.dart';
 import 'package:path/path.dart';
 import 'package:shared_preferences/shared_preferences.dart';
@@ -13,6 +12,7 @@ import '../../database/database_helper.dart';
 import '../../database/database_backup_service.dart';
 import '../../repositories/preferences_repository.dart';
 import '../../repositories/user_preferences.dart';
+import '../../database/secure_storage_vault.dart';
 import 'export_bundle.dart';
 import 'encryption_utils.dart';
 import 'selective_backup_service.dart';
@@ -246,11 +246,18 @@ class ExportService {
 
   /// Collect encryption keys from secure storage
   static Future<Map<String, String>> _collectKeys() async {
-    final storage = const FlutterSecureStorage();
-
-    final dbKey = await storage.read(key: 'db_encryption_key_v1') ?? '';
-    final publicKey = await storage.read(key: 'ecdh_public_key_v2') ?? '';
-    final privateKey = await storage.read(key: 'ecdh_private_key_v2') ?? '';
+    // Reload so the bundle carries what is stored, not what was cached
+    final vault = SecureStorageVault.instance;
+    await vault.load(force: true);
+    final keys = await vault.readMany(const [
+      'db_encryption_key_v1',
+      'ecdh_public_key_v2',
+      'ecdh_private_key_v2',
+    ]);
+
+    final dbKey = keys['db_encryption_key_v1'] ?? '';
+    final publicKey = keys['ecdh_public_key_v2'] ?? '';
+    final privateKey = keys['ecdh_private_key_v2'] ?? '';
 
     if (dbKey.isEmpty || publicKey.isEmpty || privateKey.isEmpty) {
       throw Exception('Missing encryption keys in secure storage');
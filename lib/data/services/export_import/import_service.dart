@@ -5,13 +5,13 @@
 import 'dart:convert';
 import 'dart:io';
 import 'dart:typed_data';
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
 import 'package:logging/logging.dart';
 import 'package:shared_preferences/shared_preferences.dart';
 
 import '../../database/database_helper.dart';
 import '../../database/database_backup_service.dart';
 import '../../repositories/preferences_repository.dart';
+import '../../database/secure_storage_vault.dart';
 import 'export_bundle.dart';
 import 'encryption_utils.dart';
 import 'selective_restore_service.dart';
@@ -406,28 +406,16 @@ class ImportService {
       }
     }
 
-    const storage = FlutterSecureStorage();
-    await storage.deleteAll();
+    await SecureStorageVault.instance.deleteAll();
   }
 
   /// Restore encryption keys to secure storage.
   static Future<void> _restoreKeys(Map<String, dynamic> keys) async {
-    const storage = FlutterSecureStorage();
-
-    await storage.write(
-      key: 'db_encryption_key_v1',
-      value: keys['database_encryption_key'] as String,
-    );
-
-    await storage.write(
-      key: 'ecdh_public_key_v2',
-      value: keys['ecdh_public_key'] as String,
-    );
-
-    await storage.write(
-      key: 'ecdh_private_key_v2',
-      value: keys['ecdh_private_key'] as String,
-    );
+    await SecureStorageVault.instance.writeAll({
+      'db_encryption_key_v1': keys['database_encryption_key'] as String,
+      'ecdh_public_key_v2': keys['ecdh_public_key'] as String,
+      'ecdh_private_key_v2': keys['ecdh_private_key'] as String,
+    });
 
     _logger.info('Restored ${keys.length} encryption keys');
   }
@@ -639,9 +627,8 @@ class ImportService {
     await File(path).writeAsString(jsonEncode(data));
 
     // Sensitive keys/preferences go to secure storage, never plaintext disk
-    const storage = FlutterSecureStorage();
     final sensitive = jsonEncode({'keys': keys, 'preferences': preferences});
-    await storage.write(key: _checkpointSensitiveKey, value: sensitive);
+    await SecureStorageVault.instance.write(_checkpointSensitiveKey, sensitive);
 
     _logger.info('💾 Import checkpoint saved (keys in secure storage)');
   }
@@ -656,8 +643,9 @@ class ImportService {
       final data = jsonDecode(json) as Map<String, dynamic>;
 
       // Merge sensitive data back from secure storage
-      const storage = FlutterSecureStorage();
-      final sensitiveJson = await storage.read(key: _checkpointSensitiveKey);
+      final sensitiveJson = await SecureStorageVault.instance.read(
+        _checkpointSensitiveKey,
+      );
       if (sensitiveJson != null) {
         final sensitive =
             jsonDecode(sensitiveJson) as Map<String, dynamic>;
@@ -681,8 +669,7 @@ class ImportService {
         _logger.info('🧹 Import checkpoint cleared');
       }
       // Also wipe sensitive data from secure storage
-      const storage = FlutterSecureStorage();
-      await storage.delete(key: _checkpointSensitiveKey);
+      await SecureStorageVault.instance.delete(_checkpointSensitiveKey);
     } catch (e) {
       _logger.fine('Failed to clear checkpoint: $e');
     }
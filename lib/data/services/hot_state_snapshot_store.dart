@@ -0,0 +1,161 @@
+// File-backed snapshot of hot in-memory state for fast process restarts
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:logging/logging.dart';
+import 'package:path/path.dart';
+import 'package:path_provider/path_provider.dart';
+import 'package:pak_connect/domain/interfaces/i_hot_state_snapshot_store.dart';
+import 'package:pak_connect/domain/utils/hot_state_snapshot_codec.dart';
+
+/// Stores registered sections in a single [HotStateSnapshotCodec] file.
+///
+/// Reads happen once per process and all failures degrade to "no snapshot",
+/// so a missing plugin, a torn write or a format bump only costs the owners
+/// a normal database load.
+class HotStateSnapshotStore implements IHotStateSnapshotStore {
+  static final _logger = Logger('HotStateSnapshotStore');
+
+  static const String fileName = 'hot_state.snap';
+  static const Duration defaultFlushInterval = Duration(minutes: 5);
+
+  HotStateSnapshotStore({Future<Directory> Function()? directoryResolver})
+    : _directoryResolver = directoryResolver ?? getApplicationSupportDirectory;
+
+  final Future<Directory> Function() _directoryResolver;
+  final Map<int, _SectionProducer> _producers = <int, _SectionProducer>{};
+  Future<HotStateSnapshot?>? _loaded;
+  Future<void>? _flushInFlight;
+  Timer? _flushTimer;
+
+  @override
+  Future<Uint8List?> readSection(int tag, {required int version}) async {
+    final snapshot = await (_loaded ??= _load());
+    if (snapshot == null) return null;
+    final payload = snapshot.section(tag, version: version);
+    if (payload == null && snapshot.tags.contains(tag)) {
+      _logger.info(
+        '⚠️ Snapshot section $tag rejected (version/checksum mismatch)',
+      );
+    }
+    return payload;
+  }
+
+  @override
+  void registerSection(
+    int tag, {
+    required int version,
+    required Future<Uint8List?> Function() producer,
+  }) {
+    _producers[tag] = _SectionProducer(version, producer);
+  }
+
+  @override
+  Future<void> flush() {
+    // Coalesce overlapping triggers (pause + periodic) into one write.
+    return _flushInFlight ??= _writeSnapshot().whenComplete(() {
+      _flushInFlight = null;
+    });
+  }
+
+  @override
+  void startPeriodicFlush({Duration interval = defaultFlushInterval}) {
+    _flushTimer?.cancel();
+    _flushTimer = Timer.periodic(interval, (_) => unawaited(flush()));
+  }
+
+  @override
+  Future<void> invalidate() async {
+    try {
+      final file = await _file();
+      if (await file.exists()) {
+        await file.delete();
+      }
+      _loaded = Future<HotStateSnapshot?>.value(null);
+    } catch (e) {
+      _logger.warning('Failed to invalidate hot state snapshot: $e');
+    }
+  }
+
+  @override
+  void dispose() {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+  }
+
+  Future<File> _file() async {
+    final directory = await _directoryResolver();
+    return File(join(directory.path, fileName));
+  }
+
+  Future<HotStateSnapshot?> _load() async {
+    try {
+      final stopwatch = Stopwatch()..start();
+      final file = await _file();
+      if (!await file.exists()) return null;
+
+      final bytes = await file.readAsBytes();
+      final snapshot = HotStateSnapshotCodec.decode(bytes);
+      if (snapshot == null) {
+        _logger.info('⚠️ Hot state snapshot has unknown format, ignoring');
+        return null;
+      }
+      _logger.info(
+        '⚡ Hot state snapshot read: ${bytes.length} bytes, '
+        '${snapshot.tags.length} sections in ${stopwatch.elapsedMilliseconds}ms',
+      );
+      return snapshot;
+    } catch (e) {
+      _logger.fine('Hot state snapshot unavailable: $e');
+      return null;
+    }
+  }
+
+  Future<void> _writeSnapshot() async {
+    if (_producers.isEmpty) return;
+
+    try {
+      final sections = <HotStateSection>[];
+      for (final entry in _producers.entries.toList()) {
+        try {
+          final payload = await entry.value.producer();
+          if (payload != null) {
+            sections.add(
+              HotStateSection(
+                tag: entry.key,
+                version: entry.value.version,
+                payload: payload,
+              ),
+            );
+          }
+        } catch (e) {
+          _logger.warning('Snapshot section ${entry.key} skipped: $e');
+        }
+      }
+
+      final bytes = HotStateSnapshotCodec.encode(
+        sections,
+        writtenAt: DateTime.now(),
+      );
+      final file = await _file();
+      final temp = File('${file.path}.tmp');
+      await temp.writeAsBytes(bytes, flush: true);
+      await temp.rename(file.path);
+      _logger.fine(
+        '💾 Hot state snapshot written: ${bytes.length} bytes, '
+        '${sections.length} sections',
+      );
+    } catch (e) {
+      _logger.warning('Failed to write hot state snapshot: $e');
+    }
+  }
+}
+
+class _SectionProducer {
+  const _SectionProducer(this.version, this.producer);
+
+  final int version;
+  final Future<Uint8List?> Function() producer;
+}
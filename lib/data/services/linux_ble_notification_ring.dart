@@ -0,0 +1,311 @@
+// Batched inbound GATT notifications from the Linux runner's native ring
+
+import 'dart:async';
+import 'dart:ffi';
+import 'dart:io' show Platform;
+import 'dart:typed_data';
+
+import 'package:flutter/services.dart';
+import 'package:logging/logging.dart';
+
+/// One inbound GATT notification.
+class BleNotificationFrame {
+  const BleNotificationFrame({required this.connection, required this.payload});
+
+  /// Remote 48-bit Bluetooth address.
+  final int connection;
+
+  /// View into the batch buffer; valid for as long as the batch is held.
+  final Uint8List payload;
+
+  /// Peripheral ID as derived by `bluetooth_low_energy_linux`
+  /// (the address in the UUID node field).
+  String get peripheralId => '$_addressDerivedPrefix${_nodeHex(connection)}';
+
+  static const String _addressDerivedPrefix = '00000000-0000-0000-0000-';
+
+  /// Address encoded in [peripheralId] form, or `null` for IDs that are not
+  /// address-derived (other platforms, random UUIDs).
+  static int? connectionForPeripheralId(String peripheralId) {
+    final id = peripheralId.toLowerCase();
+    if (id.length != 36 || !id.startsWith(_addressDerivedPrefix)) return null;
+    return int.tryParse(id.substring(_addressDerivedPrefix.length), radix: 16);
+  }
+
+  static String _nodeHex(int connection) =>
+      (connection & 0xFFFFFFFFFFFF).toRadixString(16).padLeft(12, '0');
+}
+
+/// Decodes ring spans laid out by linux/runner/ble_notification_ring.h:
+/// `[u64 connection][u32 length][u32 reserved][payload padded to 8]`,
+/// host byte order.
+class BleNotificationBatchDecoder {
+  static const int headerSize = 16;
+
+  /// Frames in [span], in arrival order. Payloads are views into [span].
+  /// A truncated trailing record is ignored.
+  static List<BleNotificationFrame> decode(
+    Uint8List span, {
+    Endian endian = Endian.host,
+  }) {
+    final data = ByteData.sublistView(span);
+    final frames = <BleNotificationFrame>[];
+    var offset = 0;
+    while (offset + headerSize <= span.length) {
+      final connection = data.getUint64(offset, endian);
+      final length = data.getUint32(offset + 8, endian);
+      final start = offset + headerSize;
+      if (start + length > span.length) break;
+      frames.add(
+        BleNotificationFrame(
+          connection: connection,
+          payload: Uint8List.sublistView(span, start, start + length),
+        ),
+      );
+      offset = start + ((length + 7) & ~7);
+    }
+    return frames;
+  }
+
+  /// Group a batch by remote, preserving per-remote order.
+  static Map<int, List<BleNotificationFrame>> byConnection(
+    List<BleNotificationFrame> frames,
+  ) {
+    final grouped = <int, List<BleNotificationFrame>>{};
+    for (final frame in frames) {
+      grouped.putIfAbsent(frame.connection, () => []).add(frame);
+    }
+    return grouped;
+  }
+}
+
+/// Source of batched GATT notifications that bypasses the per-notification
+/// plugin path.
+abstract class BleNotificationBatchSource {
+  /// One event per batch.
+  Stream<List<BleNotificationFrame>> get batches;
+
+  /// Take over notifications of [characteristicUuid] (canonical string) on
+  /// the link to [peripheralId] instead of enabling them through the plugin.
+  ///
+  /// Completes with true once they arrive only through [batches]; with false
+  /// when the caller has to enable them through the plugin instead.
+  Future<bool> acquire(String peripheralId, String characteristicUuid);
+
+  void dispose();
+}
+
+/// FFI binding to the runner-side ring (linux/runner/ble_notification_ring*
+/// and bluez_notify_source*).
+///
+/// Acquired characteristics notify over a BlueZ socket that only the runner
+/// reads, so their frames never reach the plugin. The runner signals once
+/// per batch on [channelName]; the drain then copies each contiguous span
+/// out of native memory in a single copy (frames are retained by fragment
+/// reassembly after the ring slot is reused) and hands listeners views into
+/// that copy.
+class LinuxBleNotificationRing implements BleNotificationBatchSource {
+  static final _logger = Logger('LinuxBleNotificationRing');
+  static const String channelName = 'pak_connect/ble_notification_ring';
+
+  /// How long an acquire may take before the link falls back to the plugin.
+  static const Duration acquireTimeout = Duration(seconds: 3);
+
+  LinuxBleNotificationRing._(this._bindings);
+
+  /// The ring, or `null` off Linux or when the runner does not export it
+  /// (e.g. `flutter test`).
+  static LinuxBleNotificationRing? tryOpen() {
+    if (!Platform.isLinux) return null;
+    try {
+      final bindings = _RingBindings(DynamicLibrary.process());
+      if (bindings.available() != 1) return null;
+      return LinuxBleNotificationRing._(bindings);
+    } catch (e) {
+      _logger.fine('Native notification ring unavailable: $e');
+      return null;
+    }
+  }
+
+  final _RingBindings _bindings;
+  final Set<void Function(List<BleNotificationFrame>)> _listeners = {};
+  final Map<int, Completer<bool>> _pendingAcquires = {};
+  StreamSubscription<dynamic>? _eventSubscription;
+
+  @override
+  Stream<List<BleNotificationFrame>> get batches =>
+      Stream<List<BleNotificationFrame>>.multi((controller) {
+        void listener(List<BleNotificationFrame> batch) {
+          controller.add(batch);
+        }
+
+        _listeners.add(listener);
+        controller.onCancel = () {
+          _listeners.remove(listener);
+        };
+      });
+
+  @override
+  Future<bool> acquire(String peripheralId, String characteristicUuid) {
+    final connection = BleNotificationFrame.connectionForPeripheralId(
+      peripheralId,
+    );
+    final uuid = _uuidHalves(characteristicUuid);
+    if (connection == null || uuid == null) return Future.value(false);
+
+    final pending = _pendingAcquires[connection];
+    if (pending != null) return pending.future;
+
+    _listenForEvents();
+    if (_bindings.acquire(connection, uuid.$1, uuid.$2) != 1) {
+      return Future.value(false);
+    }
+    final completer = _pendingAcquires[connection] = Completer<bool>();
+    Timer(acquireTimeout, () {
+      if (!identical(_pendingAcquires[connection], completer)) return;
+      _pendingAcquires.remove(connection);
+      // A late success would leave the link notifying on both paths.
+      _bindings.releaseLink(connection);
+      _logger.warning('Native notify acquire timed out for $peripheralId');
+      completer.complete(false);
+    });
+    return completer.future;
+  }
+
+  void _listenForEvents() {
+    _eventSubscription ??= const EventChannel(
+      channelName,
+    ).receiveBroadcastStream().listen(_onEvent);
+  }
+
+  /// `null` signals a batch; `[connection, acquired]` an acquire outcome.
+  void _onEvent(dynamic event) {
+    if (event is List && event.length == 2) {
+      final connection = event[0] as int;
+      final acquired = event[1] == true;
+      _pendingAcquires.remove(connection)?.complete(acquired);
+      if (acquired) {
+        _logger.info(
+          '⚡ Native notification ring routing '
+          '${connection.toRadixString(16).padLeft(12, '0')}',
+        );
+      }
+      return;
+    }
+    drain();
+  }
+
+  static (int, int)? _uuidHalves(String characteristicUuid) {
+    final hex = characteristicUuid.replaceAll('-', '');
+    if (hex.length != 32) return null;
+    final parts = [
+      for (var i = 0; i < 32; i += 8)
+        int.tryParse(hex.substring(i, i + 8), radix: 16),
+    ];
+    if (parts.contains(null)) return null;
+    return ((parts[0]! << 32) | parts[1]!, (parts[2]! << 32) | parts[3]!);
+  }
+
+  /// Read every pending span. Exposed for the synthetic benchmark path.
+  void drain() {
+    _bindings.beginDrain();
+    final frames = <BleNotificationFrame>[];
+    while (true) {
+      final bytes = _bindings.peek();
+      if (bytes <= 0) break;
+      final span = Uint8List.fromList(_bindings.peekData().asTypedList(bytes));
+      _bindings.release(bytes);
+      frames.addAll(BleNotificationBatchDecoder.decode(span));
+    }
+    if (frames.isEmpty) return;
+
+    for (final listener in List.of(_listeners)) {
+      try {
+        listener(frames);
+      } catch (e, stackTrace) {
+        _logger.warning('Notification batch listener failed: $e', e, stackTrace);
+      }
+    }
+  }
+
+  /// Push [count] deterministic frames through the native ring.
+  void injectSynthetic({
+    required int connection,
+    required int count,
+    required int size,
+  }) {
+    _listenForEvents();
+    _bindings.injectSynthetic(connection, count, size);
+  }
+
+  /// Native counters: pushed frames/bytes, dropped frames, wakeups.
+  Map<String, int> getStatistics() => {
+    'pushedFrames': _bindings.stat(0),
+    'pushedBytes': _bindings.stat(1),
+    'droppedFrames': _bindings.stat(2),
+    'wakeups': _bindings.stat(3),
+  };
+
+  @override
+  void dispose() {
+    _bindings.stop();
+    unawaited(_eventSubscription?.cancel());
+    _eventSubscription = null;
+    _listeners.clear();
+    for (final pending in _pendingAcquires.values) {
+      pending.complete(false);
+    }
+    _pendingAcquires.clear();
+  }
+}
+
+class _RingBindings {
+  _RingBindings(DynamicLibrary library)
+    : available = library.lookupFunction<Int32 Function(), int Function()>(
+        'pak_ble_ring_available',
+      ),
+      acquire = library
+          .lookupFunction<
+            Int32 Function(Uint64, Uint64, Uint64),
+            int Function(int, int, int)
+          >('pak_ble_ring_acquire'),
+      releaseLink = library
+          .lookupFunction<Void Function(Uint64), void Function(int)>(
+            'pak_ble_ring_release_link',
+          ),
+      stop = library.lookupFunction<Void Function(), void Function()>(
+        'pak_ble_ring_stop',
+      ),
+      beginDrain = library.lookupFunction<Void Function(), void Function()>(
+        'pak_ble_ring_begin_drain',
+      ),
+      peek = library.lookupFunction<Int64 Function(), int Function()>(
+        'pak_ble_ring_peek',
+      ),
+      peekData = library
+          .lookupFunction<Pointer<Uint8> Function(), Pointer<Uint8> Function()>(
+            'pak_ble_ring_peek_data',
+          ),
+      release = library.lookupFunction<Void Function(Int64), void Function(int)>(
+        'pak_ble_ring_release',
+      ),
+      injectSynthetic = library
+          .lookupFunction<
+            Void Function(Uint64, Uint32, Uint32),
+            void Function(int, int, int)
+          >('pak_ble_ring_inject_synthetic'),
+      stat = library.lookupFunction<Uint64 Function(Int32), int Function(int)>(
+        'pak_ble_ring_stat',
+      );
+
+  final int Function() available;
+  final int Function(int, int, int) acquire;
+  final void Function(int) releaseLink;
+  final void Function() stop;
+  final void Function() beginDrain;
+  final int Function() peek;
+  final Pointer<Uint8> Function() peekData;
+  final void Function(int) release;
+  final void Function(int, int, int) injectSynthetic;
+  final int Function(int) stat;
+}
@@ -3,7 +3,12 @@ import 'package:pak_connect/domain/interfaces/i_mesh_relay_engine_factory.dart';
 import 'package:pak_connect/domain/messaging/mesh_relay_engine.dart'
     as domain_messaging;
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
+import 'package:pak_connect/domain/models/compact_routing_path.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
+import 'package:pak_connect/domain/routing/multipath_stripe_tracker.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import '../../domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import '../../domain/messaging/offline_message_queue_contract.dart';
@@ -25,6 +30,17 @@ class MeshRelayHandler {
     _relayEngineFactoryResolver = null;
   }
 
+  static Future<bool> Function(String peerId, ProtocolMessage message)?
+  _peerAckTransport;
+
+  /// Send hop-by-hop ACKs to one peer; resolves false when that peer is
+  /// not on a live link.
+  static void configurePeerAckTransport(
+    Future<bool> Function(String peerId, ProtocolMessage message)? transport,
+  ) {
+    _peerAckTransport = transport;
+  }
+
   MeshRelayHandler({
     Logger? logger,
     IMeshRelayEngineFactory? relayEngineFactory,
@@ -40,6 +56,12 @@ class MeshRelayHandler {
   bool _forceFloodRouting = false;
   List<String> Function()? _nextHopsProvider;
 
+  /// Metadata per relayed message ID, so compact ACK return paths can be
+  /// matched against our own hop digest and the hops we know by full ID.
+  /// Bounded; oldest entries drop first.
+  static const int _maxAckPaths = 256;
+  final Map<String, RelayMetadata> _ackPaths = {};
+
   Function(String originalMessageId, String content, String originalSender)?
   onRelayMessageReceived;
   Function(MessageId originalMessageId, String content, String originalSender)?
@@ -167,6 +189,7 @@ class MeshRelayHandler {
       }
 
       final metadata = RelayMetadata.fromJson(relayMetadata);
+      _rememberAckPath(originalMessageId, metadata);
       final originalContent = originalPayload['content'] as String? ?? '';
       final encryptedPayload = originalPayload['encrypted'] as String?;
 
@@ -203,16 +226,33 @@ class MeshRelayHandler {
             }
           }
           _logger.info('🔀 MESH RELAY: Message delivered to self');
+          // A striped transfer completes on one of its blocks; the
+          // originator queued it under the transfer ID.
           await _sendRelayAck(
-            originalMessageId: relayMessage.originalMessageId,
+            originalMessageId:
+                metadata.stripe?.transferId ?? relayMessage.originalMessageId,
             relayMetadata: relayMessage.relayMetadata,
             delivered: true,
           );
           return deliveredContent;
+        case RelayProcessingType.stripeBlock:
+          // Progress for the originator's stripe tracker, not delivery.
+          await _sendRelayAck(
+            originalMessageId: relayMessage.originalMessageId,
+            relayMetadata: relayMessage.relayMetadata,
+            delivered: false,
+          );
+          return null;
         case RelayProcessingType.relayed:
           _logger.info(
             '🔀 MESH RELAY: Message relayed to ${_preview(result.nextHopNodeId ?? 'unknown', 8)}',
           );
+          if (result.custodyAccepted) {
+            await _sendCustodyAck(
+              relayMessage.originalMessageId,
+              previousHolder: senderPublicKey,
+            );
+          }
           return null;
         case RelayProcessingType.dropped:
         case RelayProcessingType.blocked:
@@ -252,6 +292,16 @@ class MeshRelayHandler {
       _logger.info(
         '🔙 Received relayAck for $truncatedMessageId from $truncatedRelayNode',
       );
+      if (delivered) {
+        // relayNode is the neighbour that returned the ACK to us.
+        ConnectionQualityMonitor.instance.recordMessageAcknowledged(
+          relayNode,
+          originalMessageId,
+        );
+      }
+      // Per-path progress for blocks of transfers we striped; destinations
+      // ACK blocks as not (yet) delivered.
+      await MultipathStripeTracker.instance.recordAck(originalMessageId);
 
       final queuedMessage = _messageQueue?.getMessageById(originalMessageId);
 
@@ -267,10 +317,24 @@ class MeshRelayHandler {
       }
 
       if (ackRoutingPath != null && ackRoutingPath.isNotEmpty) {
-        final currentIndex = ackRoutingPath.indexOf(_currentNodeId!);
+        final relayed = _ackPaths[originalMessageId];
+        // Swap digests for the full IDs we know, so older hops (which only
+        // match full IDs) can still find themselves upstream.
+        final path = relayed == null
+            ? ackRoutingPath
+            : CompactRoutingPath.resolveEntries(
+                ackRoutingPath,
+                [...relayed.routingPath, _currentNodeId!],
+                key: relayed.messageHash,
+              );
+        final currentIndex = CompactRoutingPath.indexOfNode(
+          path,
+          _currentNodeId!,
+          key: relayed?.messageHash,
+        );
 
         if (currentIndex > 0) {
-          final previousHop = ackRoutingPath[currentIndex - 1];
+          final previousHop = path[currentIndex - 1];
 
           final truncatedPrevHop = previousHop.length > 8
               ? previousHop.shortId(8)
@@ -283,7 +347,7 @@ class MeshRelayHandler {
             relayNode: _currentNodeId!,
             delivered: delivered,
           );
-          forwardAck.payload['ackRoutingPath'] = ackRoutingPath;
+          forwardAck.payload['ackRoutingPath'] = path;
 
           onSendAckMessage?.call(forwardAck);
           _logger.info('✅ ACK propagated for $truncatedMessageId');
@@ -300,6 +364,33 @@ class MeshRelayHandler {
     }
   }
 
+  /// A downstream relay took custody of a bundle we forwarded to it: drop
+  /// our queued copies for that hop (custody is not end-to-end delivery).
+  Future<void> handleCustodyAck({
+    required String originalMessageId,
+    required String custodian,
+  }) async {
+    try {
+      final queue = _messageQueue;
+      if (queue == null) return;
+
+      ConnectionQualityMonitor.instance.recordMessageAcknowledged(
+        custodian,
+        originalMessageId,
+      );
+      final copies = queue.relayCopiesFor(originalMessageId, custodian);
+      for (final copy in copies) {
+        await queue.removeMessage(copy.id);
+      }
+      _logger.info(
+        '📦 Custody of ${_preview(originalMessageId, 16)} taken by '
+        '${_preview(custodian, 8)} - released ${copies.length} local copies',
+      );
+    } catch (e) {
+      _logger.severe('Failed to handle custody ACK: $e');
+    }
+  }
+
   Future<void> handleRelayAckWithId({
     required MessageId originalMessageId,
     required String relayNode,
@@ -368,6 +459,57 @@ class MeshRelayHandler {
     _spamPrevention?.dispose();
   }
 
+  void _rememberAckPath(String originalMessageId, RelayMetadata metadata) {
+    _ackPaths.remove(originalMessageId);
+    _ackPaths[originalMessageId] = metadata;
+    if (_ackPaths.length > _maxAckPaths) {
+      _ackPaths.remove(_ackPaths.keys.first);
+    }
+  }
+
+  /// Tell [previousHolder] (the peer that just sent us the bundle) that we
+  /// took custody, so it can drop its copy. If it cannot be reached its copy
+  /// simply stays queued; receivers drop the duplicate.
+  Future<void> _sendCustodyAck(
+    String originalMessageId, {
+    required String previousHolder,
+  }) async {
+    final currentNodeId = _currentNodeId;
+    final transport = _peerAckTransport;
+    if (currentNodeId == null || transport == null) {
+      _logger.warning('⚠️ Cannot send custody ACK - relay not wired');
+      return;
+    }
+    if (!PeerCapabilityRegistry.instance.supports(
+      previousHolder,
+      PeerCapabilities.custody,
+    )) {
+      _logger.fine(
+        '📦 ${_preview(previousHolder, 8)} predates custody ACKs - '
+        'keeping custody without one',
+      );
+      return;
+    }
+    try {
+      final sent = await transport(
+        previousHolder,
+        ProtocolMessage.relayAck(
+          originalMessageId: originalMessageId,
+          relayNode: currentNodeId,
+          delivered: false,
+          custody: true,
+        ),
+      );
+      if (!sent) {
+        _logger.fine(
+          '📦 ${_preview(previousHolder, 8)} left before the custody ACK',
+        );
+      }
+    } catch (e) {
+      _logger.warning('Failed to send custody ACK: $e');
+    }
+  }
+
   Future<void> _sendRelayAck({
     required String originalMessageId,
     required RelayMetadata relayMetadata,
@@ -429,7 +571,12 @@ class MeshRelayHandler {
         originalMessageId: message.originalMessageId,
         originalSender: message.relayMetadata.originalSender,
         finalRecipient: message.relayMetadata.finalRecipient,
-        relayMetadata: message.relayMetadata.toJson(),
+        relayMetadata: message.relayMetadata.toWireJson(
+          compact: PeerCapabilityRegistry.instance.supports(
+            nextHopNodeId,
+            PeerCapabilities.compactRelayPath,
+          ),
+        ),
         originalPayload: {
           // Only carry plaintext when no encrypted payload exists.
           // Prevents leaking cleartext to intermediate relay hops.
@@ -452,6 +599,10 @@ class MeshRelayHandler {
           '⚠️ Cannot forward relay: onSendRelayMessage callback not set',
         );
       }
+    } on RelayException catch (e) {
+      _logger.warning(
+        '🚫 Not forwarding to ${_preview(nextHopNodeId, 8)}: ${e.message}',
+      );
     } catch (e) {
       _logger.severe('Failed to handle relay to next hop: $e');
     }
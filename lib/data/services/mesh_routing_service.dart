@@ -7,6 +7,7 @@ import 'package:pak_connect/domain/routing/smart_router_stats.dart';
 import '../../domain/routing/route_calculator.dart';
 import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
 import 'package:pak_connect/domain/interfaces/i_mesh_routing_service.dart';
+import 'package:pak_connect/domain/interfaces/i_multipath_routing_service.dart';
 import '../../domain/entities/enhanced_message.dart';
 import 'package:pak_connect/domain/models/message_priority.dart';
 
@@ -21,13 +22,17 @@ import 'package:pak_connect/domain/models/message_priority.dart';
 /// - Update network topology as connections change
 /// - Expose routing statistics for diagnostics
 /// - Coordinate with BLE service for actual message sending
-class MeshRoutingService implements IMeshRoutingService {
+class MeshRoutingService
+    implements IMeshRoutingService, IMultipathRoutingService {
   static final _logger = Logger('MeshRoutingService');
 
   SmartMeshRouter? _smartRouter;
   NetworkTopologyAnalyzer? _topologyAnalyzer;
-  final RouteCalculator _routeCalculator = RouteCalculator();
-  final ConnectionQualityMonitor _qualityMonitor = ConnectionQualityMonitor();
+  final RouteCalculator _routeCalculator = RouteCalculator(
+    qualityMonitor: ConnectionQualityMonitor.instance,
+  );
+  final ConnectionQualityMonitor _qualityMonitor =
+      ConnectionQualityMonitor.instance;
 
   bool _isInitialized = false;
 
@@ -101,6 +106,28 @@ class MeshRoutingService implements IMeshRoutingService {
     }
   }
 
+  @override
+  Future<List<MultipathRoute>> determineMultipathRoutes({
+    required String finalRecipient,
+    required List<String> availableHops,
+    required MessagePriority priority,
+    int maxPaths = 3,
+  }) async {
+    if (!_isInitialized || _smartRouter == null) return const [];
+
+    try {
+      return await _smartRouter!.determineMultipathRoutes(
+        finalRecipient: finalRecipient,
+        availableHops: availableHops,
+        priority: priority,
+        maxPaths: maxPaths,
+      );
+    } catch (e) {
+      _logger.warning('⚠️ Multipath routing to $finalRecipient failed: $e');
+      return const [];
+    }
+  }
+
   @override
   void addConnection(String node1, String node2) {
     try {
@@ -7,6 +7,7 @@ import 'package:pak_connect/domain/models/spy_mode_info.dart';
 import '../../domain/models/security_level.dart';
 import '../../domain/services/ephemeral_key_manager.dart';
 import '../../domain/services/pairing_crypto_service.dart';
+import '../../domain/services/pairing_latency_tracker.dart';
 import '../../data/repositories/contact_repository.dart';
 import 'pairing_lifecycle_service.dart';
 import 'pairing_service.dart';
@@ -32,6 +33,7 @@ class PairingFlowController {
     PairingRequestCoordinator? pairingRequestCoordinator,
     PairingUiOrchestrator? pairingUiOrchestrator,
     PairingCryptoService? pairingCryptoService,
+    PairingLatencyTracker? latencyTracker,
   }) : _logger = logger,
        _contactRepository = contactRepository,
        _identityState = identityState,
@@ -39,6 +41,7 @@ class PairingFlowController {
        _myUserName = myUserNameProvider,
        _otherUserName = otherUserNameProvider,
        _pairingLifecycle = pairingLifecycleService,
+       _latency = latencyTracker ?? PairingLatencyTracker(),
        _pairingRequestCoordinator = pairingRequestCoordinator,
        _pairingUiOrchestrator =
            pairingUiOrchestrator ?? PairingUiOrchestrator(logger: logger) {
@@ -60,7 +63,7 @@ class PairingFlowController {
     _pairingService =
         pairingService ??
         PairingService(
-          getMyPersistentId: _getMyPersistentId,
+          getMyPersistentId: _prefetchMyPersistentId,
           getTheirSessionId: () => _theirPersistentKey ?? _currentSessionId,
           getTheirDisplayName: _otherUserName,
           onVerificationComplete: (theirId, sharedSecret, displayName) =>
@@ -80,6 +83,8 @@ class PairingFlowController {
   final String? Function() _myUserName;
   final String? Function() _otherUserName;
   final PairingLifecycleService _pairingLifecycle;
+  final PairingLatencyTracker _latency;
+  Future<String>? _myPersistentId;
   late final PairingCryptoService _pairingCrypto;
   late final PairingFailureHandler _pairingFailureHandler;
   PairingRequestCoordinator? _pairingRequestCoordinator;
@@ -121,11 +126,25 @@ class PairingFlowController {
   PairingInfo? get currentPairing => _pairingService.currentPairing;
   bool get isPaired => _theirPersistentKey != null;
 
-  String generatePairingCode() => _pairingService.generatePairingCode();
+  /// Show our code and start loading our persistent key while the user
+  /// reads theirs, so verification does not wait on key storage.
+  String generatePairingCode() {
+    final code = _pairingService.generatePairingCode();
+    _myPersistentId = null;
+    unawaited(_prefetchMyPersistentId());
+    return code;
+  }
+
   Future<bool> completePairing(String theirCode) async {
+    _latency.start();
     await _pairingService.completePairing(theirCode);
-    return _pairingState?.state == PairingState.completed &&
+    final completed =
+        _pairingState?.state == PairingState.completed &&
         _pairingState?.sharedSecret != null;
+    if (!completed && _pairingState?.state != PairingState.verifying) {
+      _latency.abandon();
+    }
+    return completed;
   }
 
   void handleReceivedPairingCode(String theirCode) =>
@@ -153,6 +172,7 @@ class PairingFlowController {
   }
 
   Future<void> _handleVerificationFailure(String reason) async {
+    _latency.abandon();
     await _pairingFailureHandler.handleVerificationFailure(
       previousPairing: _pairingState,
       currentSessionId: _currentSessionId,
@@ -211,6 +231,7 @@ class PairingFlowController {
   Future<void> cancelPairing({String? reason}) async {
     _ensureRequestCoordinator();
     await _pairingRequestCoordinator!.cancelPairing(reason: reason);
+    _latency.abandon();
     _pairingUiOrchestrator.scheduleStateClear(
       Duration(seconds: 1),
       () => _setPairingState(null),
@@ -433,6 +454,19 @@ class PairingFlowController {
     required String sharedSecret,
     required String? displayName,
   }) async {
+    _latency.mark(PairingStage.verified);
+    // The peer sends its key on its own verification, never in reply to
+    // ours, so ours can go out while the contact is still being written.
+    final keysSent = _exchangePersistentKeys().then(
+      (_) {
+        _latency.mark(PairingStage.keysSent);
+        return true;
+      },
+      onError: (Object e) {
+        _logger.severe('Persistent key exchange failed: $e');
+        return false;
+      },
+    );
     try {
       await _pairingLifecycle.ensureContactExistsAfterHandshake(
         _currentSessionId ?? theirId,
@@ -450,24 +484,43 @@ class PairingFlowController {
           displayName: displayName ?? _otherUserName(),
         );
       }
+      _latency.mark(PairingStage.contactSaved);
 
-      await _exchangePersistentKeys();
+      if (await keysSent) {
+        _latency.finish();
+      } else {
+        _latency.abandon();
+      }
     } catch (e) {
+      _latency.abandon();
       _logger.severe('Verification success handling failed: $e');
     }
   }
 
+  /// Our persistent key, loaded once per pairing code and shared by
+  /// verification and key exchange; a failed load is retried next time.
+  Future<String> _prefetchMyPersistentId() {
+    final pending = _myPersistentId ??= _getMyPersistentId();
+    pending.then<void>(
+      (_) {},
+      onError: (Object _) {
+        if (identical(_myPersistentId, pending)) _myPersistentId = null;
+      },
+    );
+    return pending;
+  }
+
   Future<void> _exchangePersistentKeys() async {
-    final myPersistentKey = await _getMyPersistentId();
+    final myPersistentKey = await _prefetchMyPersistentId();
 
     if (_theirEphemeralId == null) {
       _logger.warning('❌ Cannot exchange persistent keys - no ephemeral ID');
       return;
     }
 
-    final myEphId = EphemeralKeyManager.generateMyEphemeralKey();
     _logger.info(
-      '🔑 STEP 4: Exchanging persistent keys (my ephemeral: $myEphId)',
+      '🔑 STEP 4: Exchanging persistent keys (my ephemeral: '
+      '${EphemeralKeyManager.currentSessionKey})',
     );
 
     final message = ProtocolMessage.persistentKeyExchange(
@@ -31,6 +31,8 @@ class ProtocolMessageDispatcher {
       List<String>? ackRoutingPath,
     })?
     onRelayAckIds,
+    Future<void> Function(String originalMessageId, String custodian)?
+    onCustodyAck,
     void Function(QueueSyncMessage syncMessage, String fromNodeId)?
     onQueueSyncReceived,
     Logger? logger,
@@ -39,6 +41,7 @@ class ProtocolMessageDispatcher {
        _onAckReceived = onAckReceived,
        _onRelayAck = onRelayAck,
        _onRelayAckIds = onRelayAckIds,
+       _onCustodyAck = onCustodyAck,
        _onQueueSyncReceived = onQueueSyncReceived,
        _logger = logger ?? Logger('ProtocolMessageDispatcher');
 
@@ -65,6 +68,8 @@ class ProtocolMessageDispatcher {
     List<String>? ackRoutingPath,
   })?
   _onRelayAckIds;
+  final Future<void> Function(String originalMessageId, String custodian)?
+  _onCustodyAck;
   final void Function(QueueSyncMessage syncMessage, String fromNodeId)?
   _onQueueSyncReceived;
 
@@ -75,9 +80,8 @@ class ProtocolMessageDispatcher {
   }) async {
     switch (protocolMessage.type) {
       case ProtocolMessageType.ack:
-        final originalId =
-            protocolMessage.payload['originalMessageId'] as String? ??
-            protocolMessage.ackOriginalId;
+        // Control frame ACKs carry the ID without a payload map.
+        final originalId = protocolMessage.ackOriginalId;
 
         if (originalId == null) {
           _logger.warning('Received ACK with no originalMessageId');
@@ -105,14 +109,22 @@ class ProtocolMessageDispatcher {
 
       case ProtocolMessageType.ping:
         _logger.info('Received protocol ping');
+        // The message handler answers with a pong.
+        return await _onUnhandledMessage(
+          protocolMessage,
+          onMessageIdFound,
+          senderPublicKey,
+        );
+
+      case ProtocolMessageType.pong:
+        _logger.fine('Received protocol pong');
         return null;
 
       case ProtocolMessageType.relayAck:
         final originalMessageId = protocolMessage.relayAckOriginalMessageId;
         final relayNode = protocolMessage.relayAckRelayNode ?? 'unknown';
         final delivered = protocolMessage.relayAckDelivered;
-        final ackRoutingPath =
-            protocolMessage.payload['ackRoutingPath'] as List<dynamic>?;
+        final ackRoutingPath = protocolMessage.relayAckRoutingPath;
 
         if (originalMessageId == null) {
           _logger.warning('Received relayAck with no message ID');
@@ -121,19 +133,34 @@ class ProtocolMessageDispatcher {
 
         final messageId = MessageId(originalMessageId);
 
+        // Custody ACKs are hop-by-hop; they never mean end-to-end delivery.
+        // The custodian is the authenticated link peer, never the
+        // self-reported relayNode, so a neighbour can only release copies
+        // queued for itself.
+        if (protocolMessage.relayAckCustody) {
+          if (senderPublicKey == null || senderPublicKey.isEmpty) {
+            _logger.warning(
+              'Dropping custody ACK for ${messageId.value}: sender unknown',
+            );
+            return null;
+          }
+          await _onCustodyAck?.call(messageId.value, senderPublicKey);
+          return null;
+        }
+
         if (_onRelayAckIds != null) {
           await _onRelayAckIds(
             originalMessageId: messageId,
             relayNode: relayNode,
             delivered: delivered,
-            ackRoutingPath: ackRoutingPath?.cast<String>(),
+            ackRoutingPath: ackRoutingPath,
           );
         } else if (_onRelayAck != null) {
           await _onRelayAck(
             originalMessageId: messageId.value,
             relayNode: relayNode,
             delivered: delivered,
-            ackRoutingPath: ackRoutingPath?.cast<String>(),
+            ackRoutingPath: ackRoutingPath,
           );
         }
         return null;
@@ -10,6 +10,8 @@ import 'package:pak_connect/domain/models/encryption_method.dart';
 import 'package:pak_connect/domain/models/protocol_message.dart'
     as domain_models;
 import 'package:pak_connect/domain/models/protocol_message_type.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import '../../domain/services/ephemeral_key_manager.dart';
 import '../../domain/services/signing_manager.dart';
 import 'package:pak_connect/core/security/peer_protocol_version_guard.dart';
@@ -198,6 +200,11 @@ class ProtocolMessageHandler implements IProtocolMessageHandler {
 
       case ProtocolMessageType.ping:
         _logger.fine('📍 Received protocol ping');
+        _sendPong(fromNodeId);
+        return null;
+
+      case ProtocolMessageType.pong:
+        _logger.fine('📍 Received protocol pong');
         return null;
 
       case ProtocolMessageType.relayAck:
@@ -1002,6 +1009,27 @@ class ProtocolMessageHandler implements IProtocolMessageHandler {
     _onTextMessageReceived = callback;
   }
 
+  /// Only peers that advertised [PeerCapabilities.compactAck] know pongs.
+  void _sendPong(String fromNodeId) {
+    if (_onSendAckMessage == null) return;
+    if (!PeerCapabilityRegistry.instance.supports(
+      fromNodeId,
+      PeerCapabilities.compactAck,
+    )) {
+      return;
+    }
+
+    try {
+      _onSendAckMessage!.call(
+        domain_models.ProtocolMessage.pong(compact: true),
+      );
+    } catch (e) {
+      _logger.warning(
+        '⚠️ Failed to send pong to ${fromNodeId.shortId(8)}: $e',
+      );
+    }
+  }
+
   void _sendAck(String? messageId, String fromNodeId) {
     if (messageId == null || messageId.isEmpty) return;
     if (_onSendAckMessage == null) return;
@@ -1009,6 +1037,10 @@ class ProtocolMessageHandler implements IProtocolMessageHandler {
     try {
       final ackMessage = domain_models.ProtocolMessage.ack(
         originalMessageId: messageId,
+        compact: PeerCapabilityRegistry.instance.supports(
+          fromNodeId,
+          PeerCapabilities.compactAck,
+        ),
       );
       _onSendAckMessage!.call(ackMessage);
       _logger.info(
@@ -52,6 +52,7 @@ class QueueSyncProcessor {
         messageHashes: messageHashes,
         queueStats: queueSyncMessage.queueStats,
         gcsFilter: queueSyncMessage.gcsFilter,
+        messageIdDigests: queueSyncMessage.messageIdDigests,
       );
 
       _logger.info(
@@ -83,6 +84,8 @@ class QueueSyncProcessor {
   }
 
   /// Send queue synchronization message through either central or peripheral role.
+  ///
+  /// [binary] sends a compact frame; only for peers that advertised it.
   Future<bool> sendQueueSyncMessage({
     required CentralManager? centralManager,
     required PeripheralManager? peripheralManager,
@@ -91,10 +94,12 @@ class QueueSyncProcessor {
     required GATTCharacteristic messageCharacteristic,
     required QueueSyncMessage syncMessage,
     required int mtuSize,
+    bool binary = false,
   }) async {
     try {
       final protocolMessage = ProtocolMessage.queueSync(
         queueMessage: syncMessage,
+        binary: binary,
       );
 
       final jsonBytes = protocolMessage.toBytes();
@@ -122,7 +127,7 @@ class QueueSyncProcessor {
       }
 
       _logger.info(
-        '🔄 QUEUE SYNC: Sending sync message with ${syncMessage.messageIds.length} message IDs',
+        '🔄 QUEUE SYNC: Sending sync message with ${syncMessage.messageCount} message IDs (${jsonBytes.length}B)',
       );
 
       if (centralManager != null && connectedDevice != null) {
@@ -0,0 +1,223 @@
+import 'dart:async';
+
+import 'package:logging/logging.dart';
+
+import '../../domain/entities/enhanced_message.dart';
+import '../../domain/models/protocol_message.dart';
+import '../../domain/models/read_watermark.dart';
+import '../../domain/values/id_types.dart';
+import '../repositories/message_repository.dart';
+
+/// Aggregated read receipts: one watermark frame per chat instead of one
+/// receipt per message.
+///
+/// Local reads only advance per-chat state; a frame is sent lazily after
+/// [flushDelay], so opening a chat with hundreds of unread messages (or
+/// scrolling through it) produces a single small frame. Inbound frames are
+/// applied with one set-based UPDATE.
+class ReadReceiptSyncController {
+  static final _logger = Logger('ReadReceiptSyncController');
+
+  static ReadReceiptSyncController? _instance;
+  static ReadReceiptSyncController get instance =>
+      _instance ??= ReadReceiptSyncController();
+
+  /// Replace the shared instance (tests).
+  static void configureInstance(ReadReceiptSyncController controller) {
+    _instance?.dispose();
+    _instance = controller;
+  }
+
+  static void clearInstance() {
+    _instance?.dispose();
+    _instance = null;
+  }
+
+  ReadReceiptSyncController({
+    MessageRepository? messageRepository,
+    this.receiptsEnabled,
+    this.flushDelay = const Duration(seconds: 2),
+    this.retryDelay = const Duration(seconds: 30),
+  }) : _messageRepository = messageRepository ?? MessageRepository();
+
+  final MessageRepository _messageRepository;
+  final Duration flushDelay;
+  final Duration retryDelay;
+
+  /// User preference gate; when it returns false local read state still
+  /// advances but no frames are sent.
+  Future<bool> Function()? receiptsEnabled;
+
+  /// Sends a receipt frame to the peer behind [chatId]; returns false when
+  /// that peer is not reachable right now.
+  Future<bool> Function(ChatId chatId, ProtocolMessage message)? _transport;
+
+  // Outbound (we are the reader)
+  final Map<ChatId, String> _anchors = {};
+  final Map<ChatId, int> _versions = {};
+  final Set<ChatId> _dirty = {};
+  Timer? _flushTimer;
+
+  // Inbound (we are the sender)
+  final Map<ChatId, int> _appliedVersions = {};
+
+  int _framesSent = 0;
+  int _framesApplied = 0;
+  int _messagesMarked = 0;
+
+  void configureTransport(
+    Future<bool> Function(ChatId chatId, ProtocolMessage message)? transport,
+  ) {
+    _transport = transport;
+    if (transport != null && _dirty.isNotEmpty) {
+      _scheduleFlush(flushDelay);
+    }
+  }
+
+  /// Everything received in [chatId] so far has been read.
+  Future<void> recordChatRead(ChatId chatId) async {
+    final latest = await _messageRepository.getLatestIncomingMessageId(chatId);
+    if (latest == null) return;
+    recordReadUpTo(chatId, latest);
+  }
+
+  /// Advance the watermark for [chatId] to [anchor].
+  void recordReadUpTo(ChatId chatId, MessageId anchor) {
+    if (_anchors[chatId] == anchor.value) return;
+    _anchors[chatId] = anchor.value;
+    _markDirty(chatId);
+  }
+
+  /// Current outbound watermark for [chatId], or `null` when nothing was read.
+  ReadWatermark? watermarkFor(ChatId chatId) {
+    final version = _versions[chatId];
+    if (version == null) return null;
+    return ReadWatermark(version: version, anchorMessageId: _anchors[chatId]);
+  }
+
+  /// Send every pending watermark now.
+  Future<void> flush() async {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+    if (_dirty.isEmpty) return;
+
+    final transport = _transport;
+    if (transport == null) return;
+
+    final enabled = receiptsEnabled;
+    if (enabled != null && !await enabled()) {
+      _dirty.clear();
+      return;
+    }
+
+    var deferred = false;
+    for (final chatId in _dirty.toList()) {
+      final watermark = watermarkFor(chatId);
+      if (watermark == null || watermark.isEmpty) {
+        _dirty.remove(chatId);
+        continue;
+      }
+      try {
+        final sent = await transport(
+          chatId,
+          ProtocolMessage.readReceipt(watermark: watermark),
+        );
+        if (sent) {
+          _framesSent++;
+          // Only clear if nothing advanced while we were sending.
+          if (_versions[chatId] == watermark.version) {
+            _dirty.remove(chatId);
+          }
+        } else {
+          deferred = true;
+        }
+      } catch (e) {
+        _logger.warning('⚠️ Failed to send read watermark: $e');
+        deferred = true;
+      }
+    }
+
+    if (deferred) {
+      _scheduleFlush(retryDelay);
+    } else if (_dirty.isNotEmpty) {
+      _scheduleFlush(flushDelay);
+    }
+  }
+
+  /// Apply a peer's read watermark to our outgoing messages in [chatId].
+  Future<int> applyRemoteWatermark(
+    ChatId chatId,
+    ReadWatermark watermark, {
+    String? readBy,
+  }) async {
+    final applied = _appliedVersions[chatId];
+    if (applied != null && watermark.version <= applied) {
+      _logger.fine('👁️ Ignoring stale read watermark v${watermark.version}');
+      return 0;
+    }
+    _appliedVersions[chatId] = watermark.version;
+    _framesApplied++;
+
+    final updated = await _messageRepository.applyReadWatermark(
+      chatId,
+      anchor: watermark.anchorMessageId != null
+          ? MessageId(watermark.anchorMessageId!)
+          : null,
+      receipt: MessageReadReceipt(readAt: DateTime.now(), readBy: readBy),
+    );
+    _messagesMarked += updated;
+    return updated;
+  }
+
+  /// Protocol entry point for [ProtocolMessageType.readReceipt].
+  Future<void> handleReadReceipt(
+    ProtocolMessage message,
+    String? senderPublicKey,
+  ) async {
+    final watermark = message.readWatermark;
+    if (watermark == null ||
+        senderPublicKey == null ||
+        senderPublicKey.isEmpty) {
+      _logger.fine('👁️ Dropping read receipt without sender or watermark');
+      return;
+    }
+    await applyRemoteWatermark(
+      ChatId(senderPublicKey),
+      watermark,
+      readBy: senderPublicKey,
+    );
+  }
+
+  Map<String, dynamic> getStatistics() => {
+    'pendingChats': _dirty.length,
+    'framesSent': _framesSent,
+    'framesApplied': _framesApplied,
+    'messagesMarked': _messagesMarked,
+  };
+
+  void dispose() {
+    _flushTimer?.cancel();
+    _flushTimer = null;
+  }
+
+  void _markDirty(ChatId chatId) {
+    // Versions only need to grow per chat; seeding from the clock keeps
+    // them monotonic across restarts without persisting a counter.
+    final previous = _versions[chatId] ?? 0;
+    final now = DateTime.now().millisecondsSinceEpoch;
+    _versions[chatId] = now > previous ? now : previous + 1;
+    _dirty.add(chatId);
+    // Without a transport there is nobody to tell yet; configureTransport
+    // schedules the flush once one is wired.
+    if (_transport != null) {
+      _scheduleFlush(flushDelay);
+    }
+  }
+
+  void _scheduleFlush(Duration delay) {
+    if (_flushTimer?.isActive ?? false) return;
+    _flushTimer = Timer(delay, () {
+      unawaited(flush());
+    });
+  }
+}
@@ -8,9 +8,11 @@ import 'package:pak_connect/domain/messaging/mesh_relay_engine.dart'
     as domain_messaging;
 import '../../domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import '../../domain/values/id_types.dart';
 import 'package:pak_connect/domain/messaging/queue_sync_manager.dart';
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/constants/special_recipients.dart';
 import '../../domain/messaging/offline_message_queue_contract.dart';
@@ -238,13 +240,30 @@ class RelayCoordinator implements IRelayCoordinator {
       final nextRelayMessage = relayMessage.nextHop(nextHopDeviceId);
 
       // Convert metadata to Map<String, dynamic> for meshRelay() factory
+      // Older peers need the full routingPath to decode relay metadata;
+      // hop digests go only to peers that read them.
+      final compactPath = PeerCapabilityRegistry.instance.supports(
+        nextHopDeviceId,
+        PeerCapabilities.compactRelayPath,
+      );
+      if (!compactPath &&
+          !nextRelayMessage.relayMetadata.hasFullRoutingPath) {
+        _logger.warning(
+          '🚫 ${nextHopDeviceId.shortId(8)}... predates compact paths - '
+          'not forwarding a bundle received in compact form',
+        );
+        return;
+      }
       final metadataMap = <String, dynamic>{
         'originalSender': nextRelayMessage.relayMetadata.originalSender,
         'finalRecipient': nextRelayMessage.relayMetadata.finalRecipient,
         'currentNodeId': _currentNodeId,
         'hopCount': nextRelayMessage.relayMetadata.hopCount,
         'ttl': nextRelayMessage.relayMetadata.ttl,
-        'routingPath': nextRelayMessage.relayMetadata.routingPath,
+        if (!compactPath)
+          'routingPath': nextRelayMessage.relayMetadata.routingPath,
+        if (compactPath)
+          ...nextRelayMessage.relayMetadata.compactRoutingPath.toJson(),
         'messageHash': nextRelayMessage.relayMetadata.messageHash,
         'priority': nextRelayMessage.relayMetadata.priority.index,
         if (nextRelayMessage.relayMetadata.sealedSender)
@@ -439,6 +458,10 @@ class RelayCoordinator implements IRelayCoordinator {
       // Use ProtocolMessage.queueSync() factory (NOT createQueueSync)
       final protocolMessage = ProtocolMessage.queueSync(
         queueMessage: syncMessage,
+        binary: PeerCapabilityRegistry.instance.supports(
+          toNodeId,
+          PeerCapabilities.binaryQueueSync,
+        ),
       );
 
       _onSendAckMessage?.call(protocolMessage);
@@ -4,12 +4,16 @@
 
 import 'dart:async';
 import 'dart:collection'; // For LinkedHashSet
+import 'dart:typed_data';
 import 'package:flutter/foundation.dart';
 import 'package:logging/logging.dart';
 import 'package:sqflite_sqlcipher/sqflite.dart';
 import '../database/database_helper.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
+import 'package:pak_connect/domain/interfaces/i_hot_state_snapshot_store.dart';
+import 'package:pak_connect/domain/services/database_telemetry.dart';
+import 'package:pak_connect/domain/utils/hot_state_snapshot_codec.dart';
 import '../../domain/values/id_types.dart';
 
 /// Persistent store for tracking seen messages (delivered and read)
@@ -28,6 +32,26 @@ class SeenMessageStore implements ISeenMessageStore {
   static int? _maxIdsOverride;
   static bool _verboseLogging = false;
 
+  // Hot state snapshot section owned by this store
+  static const int snapshotSectionTag = 1;
+  static const int snapshotSectionVersion = 1;
+  static IHotStateSnapshotStore? _snapshotStore;
+
+  /// Restore from (and contribute to) [store] instead of always replaying
+  /// every seen_messages row on startup.
+  static void configureSnapshotStore(IHotStateSnapshotStore store) {
+    _snapshotStore = store;
+    store.registerSection(
+      snapshotSectionTag,
+      version: snapshotSectionVersion,
+      producer: () => instance._encodeSnapshot(),
+    );
+  }
+
+  static void clearSnapshotStore() {
+    _snapshotStore = null;
+  }
+
   // Singleton
   static SeenMessageStore? _instance;
   static SeenMessageStore get instance {
@@ -59,7 +83,9 @@ class SeenMessageStore implements ISeenMessageStore {
 
     try {
       await _ensureTableExists();
-      await _loadFromDatabase();
+      if (!await _restoreFromSnapshot()) {
+        await _loadFromDatabase();
+      }
       _initialized = true;
 
       _logger.info(
@@ -109,9 +135,7 @@ class SeenMessageStore implements ISeenMessageStore {
       final id = MessageId(messageId);
 
       // If already exists, just move to end (LRU)
-      if (_deliveredIds.contains(id)) {
-        _deliveredIds.remove(id);
-      }
+      final known = _deliveredIds.remove(id);
 
       _deliveredIds.add(id);
 
@@ -119,7 +143,7 @@ class SeenMessageStore implements ISeenMessageStore {
       await _trimSet(_deliveredIds, SeenType.delivered);
 
       // Persist to database
-      await _persistMessage(id, SeenType.delivered);
+      await _persistMessage(id, SeenType.delivered, isNew: !known);
 
       _trace('Marked message as delivered: ${messageId.shortId()}...');
     } catch (e) {
@@ -143,9 +167,7 @@ class SeenMessageStore implements ISeenMessageStore {
       final id = MessageId(messageId);
 
       // If already exists, just move to end (LRU)
-      if (_readIds.contains(id)) {
-        _readIds.remove(id);
-      }
+      final known = _readIds.remove(id);
 
       _readIds.add(id);
 
@@ -153,7 +175,7 @@ class SeenMessageStore implements ISeenMessageStore {
       await _trimSet(_readIds, SeenType.read);
 
       // Persist to database
-      await _persistMessage(id, SeenType.read);
+      await _persistMessage(id, SeenType.read, isNew: !known);
 
       _trace('Marked message as read: ${messageId.shortId()}...');
     } catch (e) {
@@ -181,7 +203,8 @@ class SeenMessageStore implements ISeenMessageStore {
       _readIds.clear();
 
       final db = await DatabaseHelper.database;
-      await db.delete('seen_messages');
+      final deleted = await db.delete('seen_messages');
+      DatabaseTelemetry.instance.recordWrite('seen_messages', rows: -deleted);
 
       _logger.info('Cleared all seen messages');
     } catch (e) {
@@ -308,6 +331,106 @@ class SeenMessageStore implements ISeenMessageStore {
     }
   }
 
+  /// Cheap summary of seen_messages used to decide whether a snapshot still
+  /// matches the database. Any insert, replace or trim moves either the
+  /// count or the newest timestamp.
+  Future<_SeenFingerprint> _readFingerprint() async {
+    final db = await DatabaseHelper.database;
+    final rows = await db.rawQuery(
+      'SELECT seen_type, COUNT(*) AS count, MAX(seen_at) AS latest '
+      'FROM seen_messages GROUP BY seen_type',
+    );
+    var fingerprint = const _SeenFingerprint();
+    for (final row in rows) {
+      final count = row['count'] as int? ?? 0;
+      final latest = row['latest'] as int? ?? 0;
+      if (row['seen_type'] == SeenType.delivered.name) {
+        fingerprint = fingerprint.copyWith(
+          deliveredCount: count,
+          deliveredLatest: latest,
+        );
+      } else if (row['seen_type'] == SeenType.read.name) {
+        fingerprint = fingerprint.copyWith(readCount: count, readLatest: latest);
+      }
+    }
+    return fingerprint;
+  }
+
+  /// Restore both LRU sets from the hot state snapshot.
+  ///
+  /// Returns false (caller falls back to [_loadFromDatabase]) when there is
+  /// no snapshot store, no usable section, or the database has changed since
+  /// the snapshot was written.
+  Future<bool> _restoreFromSnapshot() async {
+    final snapshotStore = _snapshotStore;
+    if (snapshotStore == null) return false;
+
+    try {
+      final stopwatch = Stopwatch()..start();
+      final payload = await snapshotStore.readSection(
+        snapshotSectionTag,
+        version: snapshotSectionVersion,
+      );
+      if (payload == null) return false;
+
+      final reader = HotStateReader(payload);
+      final stored = _SeenFingerprint.read(reader);
+      final current = await _readFingerprint();
+      if (stored != current) {
+        _logger.info('Seen message snapshot is stale, loading from database');
+        return false;
+      }
+
+      final delivered = _decodeIds(reader);
+      final read = _decodeIds(reader);
+      _deliveredIds
+        ..clear()
+        ..addAll(delivered);
+      _readIds
+        ..clear()
+        ..addAll(read);
+
+      _logger.info(
+        '⚡ Restored ${_deliveredIds.length} delivered, ${_readIds.length} read '
+        'from snapshot in ${stopwatch.elapsedMilliseconds}ms',
+      );
+      return true;
+    } catch (e) {
+      _logger.warning(
+        'Seen message snapshot unreadable, loading from database: $e',
+      );
+      _deliveredIds.clear();
+      _readIds.clear();
+      return false;
+    }
+  }
+
+  List<MessageId> _decodeIds(HotStateReader reader) {
+    final count = reader.u32();
+    return List<MessageId>.generate(
+      count,
+      (_) => MessageId(reader.string()),
+      growable: false,
+    );
+  }
+
+  /// Snapshot payload: database fingerprint, then delivered and read IDs in
+  /// LRU order (oldest first).
+  Future<Uint8List?> _encodeSnapshot() async {
+    if (!_initialized) return null;
+
+    final fingerprint = await _readFingerprint();
+    final writer = HotStateWriter();
+    fingerprint.write(writer);
+    for (final set in [_deliveredIds, _readIds]) {
+      writer.u32(set.length);
+      for (final id in set) {
+        writer.string(id.value);
+      }
+    }
+    return writer.takeBytes();
+  }
+
   /// Trim set to maxIdsPerType (LRU eviction)
   /// LinkedHashSet.toList() preserves insertion order (oldest first)
   /// So we take from the start to remove oldest entries (LRU semantics)
@@ -324,13 +447,15 @@ class SeenMessageStore implements ISeenMessageStore {
       final toRemove = list.take(set.length - limit).toList();
 
       // Remove from database
+      var deleted = 0;
       for (final messageId in toRemove) {
-        await db.delete(
+        deleted += await db.delete(
           'seen_messages',
           where: 'message_id = ? AND seen_type = ?',
           whereArgs: [messageId.value, type.name],
         );
       }
+      DatabaseTelemetry.instance.recordWrite('seen_messages', rows: -deleted);
 
       // Remove from in-memory set
       for (final messageId in toRemove) {
@@ -343,16 +468,34 @@ class SeenMessageStore implements ISeenMessageStore {
     }
   }
 
-  /// Persist message to database
-  Future<void> _persistMessage(MessageId messageId, SeenType type) async {
+  /// Persist message to database; [isNew] is false when it replaces a row
+  Future<void> _persistMessage(
+    MessageId messageId,
+    SeenType type, {
+    required bool isNew,
+  }) async {
     try {
       final db = await DatabaseHelper.database;
-
-      await db.insert('seen_messages', {
+      final row = {
         'message_id': messageId.value,
         'seen_type': type.name,
         'seen_at': DateTime.now().millisecondsSinceEpoch,
-      }, conflictAlgorithm: ConflictAlgorithm.replace);
+      };
+
+      await DatabaseTelemetry.instance.time(
+        'seen_messages',
+        () => db.insert(
+          'seen_messages',
+          row,
+          conflictAlgorithm: ConflictAlgorithm.replace,
+        ),
+        write: true,
+      );
+      DatabaseTelemetry.instance.recordWrite(
+        'seen_messages',
+        rows: isNew ? 1 : 0,
+        bytes: DatabaseTelemetry.estimateBytes(row),
+      );
     } catch (e) {
       _logger.warning('Failed to persist message: $e');
     }
@@ -446,3 +589,56 @@ class SeenMessageStore implements ISeenMessageStore {
 
 /// Type of seen message
 enum SeenType { delivered, read }
+
+class _SeenFingerprint {
+  const _SeenFingerprint({
+    this.deliveredCount = 0,
+    this.deliveredLatest = 0,
+    this.readCount = 0,
+    this.readLatest = 0,
+  });
+
+  factory _SeenFingerprint.read(HotStateReader reader) => _SeenFingerprint(
+    deliveredCount: reader.u32(),
+    deliveredLatest: reader.i64(),
+    readCount: reader.u32(),
+    readLatest: reader.i64(),
+  );
+
+  final int deliveredCount;
+  final int deliveredLatest;
+  final int readCount;
+  final int readLatest;
+
+  _SeenFingerprint copyWith({
+    int? deliveredCount,
+    int? deliveredLatest,
+    int? readCount,
+    int? readLatest,
+  }) => _SeenFingerprint(
+    deliveredCount: deliveredCount ?? this.deliveredCount,
+    deliveredLatest: deliveredLatest ?? this.deliveredLatest,
+    readCount: readCount ?? this.readCount,
+    readLatest: readLatest ?? this.readLatest,
+  );
+
+  void write(HotStateWriter writer) {
+    writer
+      ..u32(deliveredCount)
+      ..i64(deliveredLatest)
+      ..u32(readCount)
+      ..i64(readLatest);
+  }
+
+  @override
+  bool operator ==(Object other) =>
+      other is _SeenFingerprint &&
+      other.deliveredCount == deliveredCount &&
+      other.deliveredLatest == deliveredLatest &&
+      other.readCount == readCount &&
+      other.readLatest == readLatest;
+
+  @override
+  int get hashCode =>
+      Object.hash(deliveredCount, deliveredLatest, readCount, readLatest);
+}
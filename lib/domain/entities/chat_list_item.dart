@@ -23,6 +23,26 @@ class ChatListItem {
     this.lastSeen,
   });
 
+  ChatListItem copyWith({
+    String? contactName,
+    String? lastMessage,
+    DateTime? lastMessageTime,
+    int? unreadCount,
+    bool? isOnline,
+    bool? hasUnsentMessages,
+    DateTime? lastSeen,
+  }) => ChatListItem(
+    chatId: chatId,
+    contactName: contactName ?? this.contactName,
+    contactPublicKey: contactPublicKey,
+    lastMessage: lastMessage ?? this.lastMessage,
+    lastMessageTime: lastMessageTime ?? this.lastMessageTime,
+    unreadCount: unreadCount ?? this.unreadCount,
+    isOnline: isOnline ?? this.isOnline,
+    hasUnsentMessages: hasUnsentMessages ?? this.hasUnsentMessages,
+    lastSeen: lastSeen ?? this.lastSeen,
+  );
+
   bool get hasMessages => lastMessage != null;
 
   String get displayLastSeen {
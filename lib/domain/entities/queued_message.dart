@@ -57,6 +57,10 @@ class QueuedMessage {
   /// Rate limiting: sender's message count in current time window
   final int senderRateCount;
 
+  /// This node created the bundle. Set by the local sender, never taken
+  /// from the wire, so peers cannot claim relay quota exemption.
+  final bool isOriginator;
+
   QueuedMessage({
     required this.id,
     required this.chatId,
@@ -83,6 +87,7 @@ class QueuedMessage {
     this.relayNodeId,
     this.messageHash,
     this.senderRateCount = 0,
+    this.isOriginator = false,
   });
 
   /// Create a relay message from a MeshRelayMessage
@@ -95,22 +100,8 @@ class QueuedMessage {
     final queuedAt = relayMessage.relayedAt;
     final priority = relayMessage.relayMetadata.priority;
 
-    // Calculate expiry time based on priority
-    Duration ttl;
-    switch (priority) {
-      case MessagePriority.urgent:
-        ttl = Duration(hours: 24);
-        break;
-      case MessagePriority.high:
-        ttl = Duration(hours: 12);
-        break;
-      case MessagePriority.normal:
-        ttl = Duration(hours: 6);
-        break;
-      case MessagePriority.low:
-        ttl = Duration(hours: 3);
-        break;
-    }
+    // Expire with the bundle: relays never extend its lifetime
+    final expiresAt = relayMessage.relayMetadata.deadline;
 
     return QueuedMessage(
       id: '${relayMessage.originalMessageId}_relay_${DateTime.now().millisecondsSinceEpoch}',
@@ -122,7 +113,7 @@ class QueuedMessage {
       queuedAt: queuedAt,
       maxRetries: maxRetries,
       status: status,
-      expiresAt: queuedAt.add(ttl),
+      expiresAt: expiresAt,
       // Relay-specific fields
       isRelayMessage: true,
       relayMetadata: relayMessage.relayMetadata,
@@ -199,6 +190,7 @@ class QueuedMessage {
     if (relayNodeId != null) 'relayNodeId': relayNodeId,
     if (messageHash != null) 'messageHash': messageHash,
     'senderRateCount': senderRateCount,
+    if (isOriginator) 'isOriginator': true,
   };
 
   /// Create from JSON
@@ -237,5 +229,6 @@ class QueuedMessage {
     relayNodeId: json['relayNodeId'],
     messageHash: json['messageHash'],
     senderRateCount: json['senderRateCount'] ?? 0,
+    isOriginator: json['isOriginator'] ?? false,
   );
 }
@@ -1,6 +1,7 @@
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 
 import '../entities/chat_list_item.dart';
+import '../models/chat_list_model.dart';
 
 /// Interface for managing chat list operations.
 abstract class IChatListCoordinator {
@@ -22,6 +23,9 @@ abstract class IChatListCoordinator {
   /// Current loaded chats (cached from last load).
   List<ChatListItem> get currentChats;
 
+  /// Row-level changes to [currentChats], in the order they were applied.
+  Stream<ChatListDiff> get chatListChanges;
+
   /// Whether coordinator is currently loading.
   bool get isLoading;
 
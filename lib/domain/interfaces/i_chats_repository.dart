@@ -50,3 +50,37 @@ abstract class IChatsRepository {
   /// Cleanup orphaned ephemeral contacts (not in contact list)
   Future<int> cleanupOrphanedEphemeralContacts();
 }
+
+/// Chat row read from the last-activity index
+typedef InactiveChat = ({
+  ChatId chatId,
+  String contactName,
+  DateTime lastMessageTime,
+});
+
+/// Keyset position in the last-activity index (the last row already read)
+typedef ChatActivityCursor = ({DateTime lastMessageTime, ChatId chatId});
+
+/// Optional capability of an [IChatsRepository]: range reads over the
+/// chats' last-activity index, so callers only touch chats that have gone
+/// quiet instead of loading the whole chat list.
+abstract interface class IChatActivityIndex {
+  /// Chats whose last message is at or before [cutoff], oldest first,
+  /// starting after [after]; at most [limit] rows
+  Future<List<InactiveChat>> getChatsInactiveSince(
+    DateTime cutoff, {
+    ChatActivityCursor? after,
+    int limit = 50,
+  });
+}
+
+/// Optional capability of an [IChatsRepository]: multi-select chat actions
+/// as one transaction with one statement per table and a single change
+/// event, instead of a repository round trip per chat.
+abstract interface class IBulkChatOperations {
+  /// Reset unread counts of [chatIds]; returns the rows updated
+  Future<int> markChatsAsRead(List<ChatId> chatIds);
+
+  /// Delete [chatIds] and their messages; returns the deleted message ids
+  Future<List<MessageId>> deleteChats(List<ChatId> chatIds);
+}
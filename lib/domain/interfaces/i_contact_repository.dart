@@ -158,3 +158,10 @@ abstract class IContactRepository {
   /// Check if a contact is marked as favorite
   Future<bool> isContactFavorite(String publicKey);
 }
+
+/// Optional capability of an [IContactRepository]: multi-select deletes as
+/// one set-based statement in one transaction.
+abstract interface class IBulkContactOperations {
+  /// Delete [publicKeys]; returns the keys that existed and were removed
+  Future<List<String>> deleteContacts(List<String> publicKeys);
+}
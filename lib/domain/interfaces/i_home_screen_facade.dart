@@ -1,6 +1,7 @@
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 
 import '../entities/chat_list_item.dart';
+import '../models/chat_list_model.dart';
 import '../models/connection_info.dart';
 import '../models/connection_status.dart';
 import '../values/id_types.dart';
@@ -21,6 +22,9 @@ abstract class IHomeScreenFacade {
   /// Get currently loaded chats.
   List<ChatListItem> get chats;
 
+  /// Row-level changes to [chats], applied without re-querying the list.
+  Stream<ChatListDiff> get chatListChanges;
+
   /// Check if currently loading.
   bool get isLoading;
 
@@ -0,0 +1,32 @@
+import 'dart:typed_data';
+
+/// Fast-restore cache for hot in-memory state.
+///
+/// The snapshot is never authoritative: owners validate a section against
+/// their source of truth (SQLite) and rebuild from it when the section is
+/// missing, outdated or corrupt.
+abstract class IHotStateSnapshotStore {
+  /// Payload written by the owner of [tag] with [version], or `null`.
+  ///
+  /// The snapshot file is read once, on the first call.
+  Future<Uint8List?> readSection(int tag, {required int version});
+
+  /// Register a producer for [tag]. Producers are called on every [flush];
+  /// returning `null` omits the section from that write.
+  void registerSection(
+    int tag, {
+    required int version,
+    required Future<Uint8List?> Function() producer,
+  });
+
+  /// Collect all registered sections and atomically replace the snapshot.
+  Future<void> flush();
+
+  /// Flush on a fixed cadence until [dispose].
+  void startPeriodicFlush({Duration interval});
+
+  /// Delete the snapshot so the next start rebuilds from the database.
+  Future<void> invalidate();
+
+  void dispose();
+}
@@ -37,3 +37,16 @@ abstract class IMessageRepository {
   /// Migrate messages from one chat ID to another
   Future<void> migrateChatId(ChatId oldChatId, ChatId newChatId);
 }
+
+/// Optional capability of an [IMessageRepository]: set-based deletes for
+/// multi-select actions. Each call runs one statement per table inside one
+/// transaction and publishes a single change event.
+abstract interface class IBulkMessageOperations {
+  /// Delete [messageIds]; returns the chat each deleted message belonged to
+  Future<Map<MessageId, ChatId>> deleteMessagesByIds(
+    List<MessageId> messageIds,
+  );
+
+  /// Delete every message in [chatIds]; returns the deleted message ids
+  Future<List<MessageId>> clearMessagesForChats(List<ChatId> chatIds);
+}
@@ -0,0 +1,19 @@
+import 'package:pak_connect/domain/routing/routing_models.dart';
+import 'package:pak_connect/domain/models/message_priority.dart';
+
+/// Optional routing capability: disjoint routes for striped transfers.
+///
+/// Kept apart from [IMeshRoutingService] so existing routing services and
+/// test doubles stay valid; callers check for it with `is`.
+abstract class IMultipathRoutingService {
+  /// Up to [maxPaths] node-disjoint routes to [finalRecipient], best first,
+  /// each with an estimated capacity used to weight striping.
+  ///
+  /// Returns fewer than two routes when multipath delivery is not possible.
+  Future<List<MultipathRoute>> determineMultipathRoutes({
+    required String finalRecipient,
+    required List<String> availableHops,
+    required MessagePriority priority,
+    int maxPaths = 3,
+  });
+}
@@ -106,3 +106,36 @@ class NotificationConfig {
     return NotificationConfig.defaults();
   }
 }
+
+/// Inbound messages for one chat collapsed into a single notification
+class MessageNotificationDigest {
+  final String contactName;
+  final String? contactAvatar;
+  final String? contactPublicKey;
+
+  /// Messages received since the chat's notification was first posted
+  final int messageCount;
+
+  /// Most recent messages, oldest first (capped; see [messageCount])
+  final List<Message> recentMessages;
+
+  const MessageNotificationDigest({
+    required this.contactName,
+    required this.messageCount,
+    required this.recentMessages,
+    this.contactAvatar,
+    this.contactPublicKey,
+  });
+
+  Message get latest => recentMessages.last;
+
+  /// Stable per-chat notification ID so each digest replaces the last
+  String get notificationId => 'chat_${latest.chatId.value}';
+}
+
+/// Optional capability for handlers that render a [MessageNotificationDigest]
+/// natively (e.g. Android messaging style). Handlers without it receive the
+/// digest as a plain [INotificationHandler.showNotification].
+abstract interface class IMessageDigestNotificationHandler {
+  Future<void> showMessageDigestNotification(MessageNotificationDigest digest);
+}
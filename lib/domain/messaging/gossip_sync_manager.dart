@@ -211,7 +211,7 @@ class GossipSyncManager {
       final useGCS = syncRequest.gcsFilter != null;
       _logger.info(
         '📥 Handling sync request from ${fromPeerID.shortId(8)}... '
-        '(${syncRequest.messageIds.length} messages, hash: $hashPreview, '
+        '(${syncRequest.messageCount} messages, hash: $hashPreview, '
         'GCS: ${useGCS ? "${syncRequest.gcsFilter!.data.length}B" : "no"})',
       );
 
@@ -257,12 +257,9 @@ class GossipSyncManager {
           }
         }
       } else {
-        // Legacy: Use full ID list for exact matching
-        final peerMessageIds = syncRequest.messageIds.toSet();
-
-        // Check announcements
+        // Legacy: Use the ID list (or its digests) for exact matching
         for (final tracked in _latestAnnouncementByNode.values) {
-          if (!peerMessageIds.contains(tracked.messageId)) {
+          if (!syncRequest.hasMessageId(tracked.messageId)) {
             messagesToSend.add(tracked.message);
             _logger.fine(
               'Will send announcement: ${tracked.messageId.shortId()}...',
@@ -273,7 +270,9 @@ class GossipSyncManager {
 
       // STEP 4: Send excess queued messages via callback (Phase 1 fix)
       final excessMessages = _messageQueue.getExcessMessages(
-        syncRequest.messageIds,
+        syncRequest.messageIdDigests != null
+            ? syncRequest.knownMessageIds(_messageQueue.activeSyncMessageIds())
+            : syncRequest.messageIds,
       );
       _logger.fine(
         'Queue has ${excessMessages.length} messages peer doesn\'t have',
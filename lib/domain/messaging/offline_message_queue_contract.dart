@@ -48,6 +48,7 @@ abstract interface class OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   });
 
   Future<MessageId> queueMessageWithIds({
@@ -64,6 +65,7 @@ abstract interface class OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   });
 
   Future<int> removeMessagesForChat(String chatId);
@@ -120,3 +122,35 @@ abstract interface class OfflineMessageQueueContract {
 
   void dispose();
 }
+
+extension OfflineMessageQueueSyncIds on OfflineMessageQueueContract {
+  /// Queued messages not yet delivered or failed.
+  List<QueuedMessage> activeMessages() => [
+    for (final status in const [
+      QueuedMessageStatus.pending,
+      QueuedMessageStatus.sending,
+      QueuedMessageStatus.awaitingAck,
+      QueuedMessageStatus.retrying,
+    ])
+      ...getMessagesByStatus(status),
+  ];
+
+  /// IDs of queued messages a sync peer may still be missing (everything not
+  /// yet delivered or failed); candidates for resolving digest-only sync
+  /// frames via [QueueSyncMessage.knownMessageIds].
+  List<String> activeSyncMessageIds() => [
+    for (final message in activeMessages()) message.id,
+  ];
+
+  /// Active relay copies of [originalMessageId] queued for [nextHopId].
+  List<QueuedMessage> relayCopiesFor(
+    String originalMessageId,
+    String nextHopId,
+  ) => [
+    for (final message in activeMessages())
+      if (message.isRelayMessage &&
+          message.originalMessageId == originalMessageId &&
+          message.recipientPublicKey == nextHopId)
+        message,
+  ];
+}
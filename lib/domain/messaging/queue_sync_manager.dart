@@ -146,12 +146,28 @@ class QueueSyncManager {
         return QueueSyncResponse.alreadySynced();
       }
 
-      // Determine what needs to be synchronized
-      final inboundIds = syncMessage.messageIdValues
-          .map((id) => id.value)
-          .toList();
-      final missingIds = _messageQueue.getMissingMessageIds(inboundIds);
-      final excessMessages = _messageQueue.getExcessMessages(inboundIds);
+      // Determine what needs to be synchronized. Binary frames only carry
+      // ID digests, so resolve them against what we hold. Digests we lack
+      // cannot be named; the peer resolves our response against its queue
+      // and sends those messages back.
+      final List<String> missingIds;
+      final int missingCount;
+      final List<QueuedMessage> excessMessages;
+      if (syncMessage.messageIdDigests != null) {
+        final localIds = _messageQueue.activeSyncMessageIds();
+        missingIds = const <String>[];
+        missingCount = syncMessage.unknownMessageCount(localIds);
+        excessMessages = _messageQueue.getExcessMessages(
+          syncMessage.knownMessageIds(localIds),
+        );
+      } else {
+        final inboundIds = syncMessage.messageIdValues
+            .map((id) => id.value)
+            .toList();
+        missingIds = _messageQueue.getMissingMessageIds(inboundIds);
+        missingCount = missingIds.length;
+        excessMessages = _messageQueue.getExcessMessages(inboundIds);
+      }
 
       if (excessMessages.isNotEmpty) {
         if (onSendMessages != null) {
@@ -174,7 +190,7 @@ class QueueSyncManager {
       }
 
       // If there are no missing or excess messages, queues are already synchronized
-      if (missingIds.isEmpty && excessMessages.isEmpty) {
+      if (missingCount == 0 && excessMessages.isEmpty) {
         _logger.info(
           'No messages to sync - queues already synchronized with $fromNodeId',
         );
@@ -242,9 +258,13 @@ class QueueSyncManager {
       // The responder already sent us their excess in handleSyncRequest().
       // Now we reciprocate so both sides converge in a single round.
       int reverseMessagesSent = 0;
-      if (responseMessage.messageIds.isNotEmpty && onSendMessages != null) {
+      if (responseMessage.messageCount > 0 && onSendMessages != null) {
         final ourExcess = _messageQueue.getExcessMessages(
-          responseMessage.messageIds,
+          responseMessage.messageIdDigests != null
+              ? responseMessage.knownMessageIds(
+                  _messageQueue.activeSyncMessageIds(),
+                )
+              : responseMessage.messageIds,
         );
         if (ourExcess.isNotEmpty) {
           _logger.info(
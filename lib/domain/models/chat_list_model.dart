@@ -0,0 +1,266 @@
+import 'dart:collection';
+
+import '../entities/chat_list_item.dart';
+import '../values/id_types.dart';
+
+/// Row-level change published by the repositories that back the chat list
+sealed class ChatListEvent {
+  const ChatListEvent();
+}
+
+/// A message was stored in [chatId] (first insert only, not re-saves)
+final class ChatMessageInserted extends ChatListEvent {
+  final ChatId chatId;
+  final String content;
+  final DateTime timestamp;
+  final bool failed;
+
+  const ChatMessageInserted({
+    required this.chatId,
+    required this.content,
+    required this.timestamp,
+    this.failed = false,
+  });
+}
+
+/// An outgoing message in [chatId] changed delivery status
+final class ChatMessageStatusChanged extends ChatListEvent {
+  final ChatId chatId;
+  final bool failed;
+
+  const ChatMessageStatusChanged({required this.chatId, required this.failed});
+}
+
+final class ChatUnreadChanged extends ChatListEvent {
+  final ChatId chatId;
+  final int unreadCount;
+
+  const ChatUnreadChanged({required this.chatId, required this.unreadCount});
+}
+
+final class ChatContactRenamed extends ChatListEvent {
+  final String publicKey;
+  final String displayName;
+
+  const ChatContactRenamed({
+    required this.publicKey,
+    required this.displayName,
+  });
+}
+
+final class ChatPresenceChanged extends ChatListEvent {
+  final String publicKey;
+  final bool isOnline;
+  final DateTime? lastSeen;
+
+  const ChatPresenceChanged({
+    required this.publicKey,
+    required this.isOnline,
+    this.lastSeen,
+  });
+}
+
+/// Rows were deleted or the database was replaced; only a reload is safe
+final class ChatListInvalidated extends ChatListEvent {
+  final String reason;
+
+  const ChatListInvalidated(this.reason);
+}
+
+/// Minimal change to apply to a rendered chat list
+sealed class ChatListDiff {
+  const ChatListDiff();
+}
+
+final class ChatRowInserted extends ChatListDiff {
+  final int index;
+  final ChatListItem item;
+
+  const ChatRowInserted(this.index, this.item);
+}
+
+/// Row content changed without changing its position
+final class ChatRowUpdated extends ChatListDiff {
+  final int index;
+  final ChatListItem item;
+
+  const ChatRowUpdated(this.index, this.item);
+}
+
+/// Row content changed and it moved from [from] to [to]
+final class ChatRowMoved extends ChatListDiff {
+  final int from;
+  final int to;
+  final ChatListItem item;
+
+  const ChatRowMoved(this.from, this.to, this.item);
+}
+
+final class ChatListReset extends ChatListDiff {
+  final List<ChatListItem> items;
+
+  const ChatListReset(this.items);
+}
+
+/// Outcome of [ChatListModel.apply]: the diff to emit (if anything changed)
+/// and whether the row must be re-read because the event alone cannot
+/// settle it (unknown chat, cleared failure, invalidation).
+typedef ChatListPatch = ({ChatListDiff? diff, bool refetch});
+
+/// Keyed, ordered chat list patched in place by [ChatListEvent]s.
+///
+/// Rows are kept in the repository order (online first, then newest
+/// message) with chat-ID and public-key indexes, so an event is a hash
+/// lookup plus a binary search for the row's new slot; only rows between
+/// the old and new slot are shifted.
+class ChatListModel {
+  final List<ChatListItem> _items = [];
+  final Map<ChatId, int> _index = {};
+  final Map<String, ChatId> _byKey = {};
+
+  late final List<ChatListItem> items = UnmodifiableListView(_items);
+
+  int get length => _items.length;
+
+  ChatListItem? itemFor(ChatId chatId) {
+    final index = _index[chatId];
+    return index == null ? null : _items[index];
+  }
+
+  /// Replace every row with [items], already in display order
+  ChatListDiff reset(List<ChatListItem> items) {
+    _items
+      ..clear()
+      ..addAll(items);
+    _index.clear();
+    _byKey.clear();
+    _reindex(0, _items.length - 1);
+    return ChatListReset(this.items);
+  }
+
+  ChatListPatch apply(ChatListEvent event) {
+    switch (event) {
+      case ChatMessageInserted(:final chatId):
+        final row = itemFor(chatId);
+        if (row == null) return (diff: null, refetch: true);
+        // A late older message (relay, queue flush) must not rewind the
+        // preview; the store keeps MAX(timestamp) as well.
+        final previous = row.lastMessageTime;
+        final isLatest =
+            previous == null || !event.timestamp.isBefore(previous);
+        final failed = row.hasUnsentMessages || event.failed;
+        if (!isLatest && failed == row.hasUnsentMessages) {
+          return (diff: null, refetch: false);
+        }
+        return (
+          diff: _replace(
+            row.copyWith(
+              lastMessage: isLatest ? event.content : row.lastMessage,
+              lastMessageTime: isLatest ? event.timestamp : previous,
+              hasUnsentMessages: failed,
+            ),
+          ),
+          refetch: false,
+        );
+      case ChatMessageStatusChanged(:final chatId, :final failed):
+        final row = itemFor(chatId);
+        if (row == null || row.hasUnsentMessages == failed) {
+          return (diff: null, refetch: false);
+        }
+        // Other failed messages may remain; only the store can tell.
+        if (!failed) return (diff: null, refetch: true);
+        return (
+          diff: _replace(row.copyWith(hasUnsentMessages: true)),
+          refetch: false,
+        );
+      case ChatUnreadChanged(:final chatId, :final unreadCount):
+        final row = itemFor(chatId);
+        if (row == null || row.unreadCount == unreadCount) {
+          return (diff: null, refetch: false);
+        }
+        return (
+          diff: _replace(row.copyWith(unreadCount: unreadCount)),
+          refetch: false,
+        );
+      case ChatContactRenamed(:final publicKey, :final displayName):
+        final row = _rowForKey(publicKey);
+        if (row == null || row.contactName == displayName) {
+          return (diff: null, refetch: false);
+        }
+        return (
+          diff: _replace(row.copyWith(contactName: displayName)),
+          refetch: false,
+        );
+      case ChatPresenceChanged(:final publicKey, :final isOnline):
+        final row = _rowForKey(publicKey);
+        if (row == null || row.isOnline == isOnline) {
+          return (diff: null, refetch: false);
+        }
+        return (
+          diff: _replace(
+            row.copyWith(isOnline: isOnline, lastSeen: event.lastSeen),
+          ),
+          refetch: false,
+        );
+      case ChatListInvalidated():
+        return (diff: null, refetch: true);
+    }
+  }
+
+  /// Insert or replace [item] at its ordered position
+  ChatListDiff upsert(ChatListItem item) {
+    if (_index.containsKey(item.chatId)) return _replace(item);
+    final to = _slotFor(item, 0, _items.length);
+    _items.insert(to, item);
+    _reindex(to, _items.length - 1);
+    return ChatRowInserted(to, item);
+  }
+
+  ChatListItem? _rowForKey(String publicKey) {
+    final chatId = _byKey[publicKey];
+    return chatId == null ? null : itemFor(chatId);
+  }
+
+  ChatListDiff _replace(ChatListItem item) {
+    final from = _index[item.chatId]!;
+    final previous = _items[from];
+    if (previous.contactPublicKey != null) {
+      _byKey.remove(previous.contactPublicKey);
+    }
+    _items.removeAt(from);
+    final to = _slotFor(item, 0, _items.length);
+    _items.insert(to, item);
+    _reindex(from < to ? from : to, from < to ? to : from);
+    return from == to ? ChatRowUpdated(to, item) : ChatRowMoved(from, to, item);
+  }
+
+  /// First slot in [lo, hi) whose row does not sort before [item]
+  int _slotFor(ChatListItem item, int lo, int hi) {
+    while (lo < hi) {
+      final mid = (lo + hi) >> 1;
+      if (_compare(_items[mid], item) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  void _reindex(int from, int to) {
+    for (var i = from; i <= to; i++) {
+      final item = _items[i];
+      _index[item.chatId] = i;
+      final key = item.contactPublicKey;
+      if (key != null) _byKey[key] = item.chatId;
+    }
+  }
+
+  /// Same order as `IChatsRepository.getAllChats`
+  static int _compare(ChatListItem a, ChatListItem b) {
+    if (a.isOnline != b.isOnline) return a.isOnline ? -1 : 1;
+    final aTime = a.lastMessageTime ?? DateTime(1970);
+    final bTime = b.lastMessageTime ?? DateTime(1970);
+    return bTime.compareTo(aTime);
+  }
+}
@@ -0,0 +1,134 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+
+/// Wire form of a relay routing path.
+///
+/// Instead of full ephemeral keys (64+ bytes per hop), each hop is carried as
+/// a [digestLength]-byte HMAC-SHA256 of its node ID keyed by the message hash.
+/// Keying per message keeps digests unlinkable across messages while every
+/// node can still test "am I (or my neighbour) already in this path?".
+///
+/// Every hop keeps its digest, so loop checks and ACK return paths cover
+/// the whole route; the relay TTL already bounds the path length.
+class CompactRoutingPath {
+  /// Bytes kept per hop digest.
+  static const int digestLength = 4;
+
+  const CompactRoutingPath._({required this.key, required this.digests});
+
+  /// Empty path keyed by [key] (the relay message hash).
+  factory CompactRoutingPath.empty(String key) =>
+      CompactRoutingPath._(key: key, digests: const []);
+
+  /// Digest the full node IDs of [nodeIds] in path order.
+  factory CompactRoutingPath.fromNodeIds(
+    Iterable<String> nodeIds, {
+    required String key,
+  }) {
+    var path = CompactRoutingPath.empty(key);
+    for (final nodeId in nodeIds) {
+      path = path.appended(nodeId);
+    }
+    return path;
+  }
+
+  /// Key the digests are computed with.
+  final String key;
+
+  /// Hop digests, oldest first.
+  final List<int> digests;
+
+  /// Total hops in the path.
+  int get length => digests.length;
+
+  bool get isEmpty => length == 0;
+
+  /// Hex form of each digest, oldest first.
+  ///
+  /// These stand in for node IDs when the full IDs are not known locally,
+  /// e.g. in ACK return paths.
+  List<String> get entryIds =>
+      digests.map(_digestHex).toList(growable: false);
+
+  /// Keyed digest of [nodeId] for a path keyed by [key].
+  static int digestFor(String nodeId, String key) {
+    final mac = Hmac(sha256, utf8.encode(key)).convert(utf8.encode(nodeId));
+    var value = 0;
+    for (var i = 0; i < digestLength; i++) {
+      value = (value << 8) | mac.bytes[i];
+    }
+    return value;
+  }
+
+  /// Hex form of [nodeId]'s digest, matching [entryIds].
+  static String entryIdFor(String nodeId, String key) =>
+      _digestHex(digestFor(nodeId, key));
+
+  /// Index of [nodeId] in [entries], matching either the full ID or its
+  /// digest entry; -1 when absent.
+  ///
+  /// Without [key] only full-ID entries can match.
+  static int indexOfNode(List<String> entries, String nodeId, {String? key}) {
+    final direct = entries.indexOf(nodeId);
+    if (direct >= 0 || key == null) return direct;
+    return entries.indexOf(entryIdFor(nodeId, key));
+  }
+
+  /// Replace digest entries in [entries] with the full ID of any node in
+  /// [nodeIds] they match, so peers that only know full IDs can locate
+  /// themselves in an ACK return path.
+  static List<String> resolveEntries(
+    List<String> entries,
+    Iterable<String> nodeIds, {
+    required String key,
+  }) {
+    final byEntry = {for (final id in nodeIds) entryIdFor(id, key): id};
+    return [for (final entry in entries) byEntry[entry] ?? entry];
+  }
+
+  /// Whether [nodeId] is (probably) in the path.
+  ///
+  /// False positives are possible at roughly 2^-32 per hop; one only costs
+  /// a skipped relay candidate.
+  bool contains(String nodeId) => digests.contains(digestFor(nodeId, key));
+
+  /// Path with [nodeId] added as the newest hop.
+  CompactRoutingPath appended(String nodeId) => CompactRoutingPath._(
+    key: key,
+    digests: List.unmodifiable([...digests, digestFor(nodeId, key)]),
+  );
+
+  /// Wire fields merged into the relay metadata map.
+  ///
+  /// `rp` is the base64 digest list.
+  Map<String, dynamic> toJson() {
+    final packed = ByteData(digests.length * digestLength);
+    for (var i = 0; i < digests.length; i++) {
+      packed.setUint32(i * digestLength, digests[i]);
+    }
+    return {'rp': base64Encode(packed.buffer.asUint8List())};
+  }
+
+  /// Decode the wire fields from [json], or `null` when it carries none.
+  static CompactRoutingPath? fromJson(
+    Map<String, dynamic> json, {
+    required String key,
+  }) {
+    final rawDigests = json['rp'];
+    if (rawDigests is! String) return null;
+    final bytes = base64Decode(rawDigests);
+    final view = ByteData.sublistView(bytes);
+    final digests = [
+      for (var offset = 0;
+          offset + digestLength <= bytes.length;
+          offset += digestLength)
+        view.getUint32(offset),
+    ];
+    return CompactRoutingPath._(key: key, digests: List.unmodifiable(digests));
+  }
+
+  static String _digestHex(int digest) =>
+      digest.toRadixString(16).padLeft(digestLength * 2, '0');
+}
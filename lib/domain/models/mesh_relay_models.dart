@@ -2,7 +2,10 @@ import 'dart:convert';
 import 'package:crypto/crypto.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 import 'package:pak_connect/domain/models/stealth_envelope.dart';
+import 'compact_routing_path.dart';
+import 'message_id_digests.dart';
 import 'message_priority.dart';
+import 'peer_capabilities.dart';
 import '../utils/gcs_filter.dart';
 import 'protocol_message_type.dart'; // PHASE 2: For ProtocolMessageType
 
@@ -22,8 +25,15 @@ class RelayMetadata {
 
   /// Path of nodes that have relayed this message (for anti-loop protection)
   /// 🔐 PRIVACY: Contains EPHEMERAL session keys (rotates per session, not long-term identity)
+  ///
+  /// Only the hops known by full ID locally; for frames received in compact
+  /// form the earlier hops live in [compactPath].
   final List<String> routingPath;
 
+  /// Keyed hop digests decoded from a compact wire frame (covers every hop,
+  /// including those in [routingPath]). Null for locally originated paths.
+  final CompactRoutingPath? compactPath;
+
   /// Cryptographic hash of the original message for deduplication
   final String messageHash;
 
@@ -60,6 +70,19 @@ class RelayMetadata {
   /// Null or 0 means no PoW was computed (free tier / legacy).
   final int? powDifficulty;
 
+  /// DTN custody transfer requested: a relay that accepts custody persists
+  /// the bundle and ACKs custody upstream so the previous holder can drop
+  /// its copy. Relays that do not take custody forward best-effort.
+  final bool custody;
+
+  /// Spray-and-wait replica budget: copies the holder of this metadata may
+  /// still hand out. Null for broadcasts and legacy frames (unbudgeted).
+  final int? replicas;
+
+  /// Set when this bundle is one block of a transfer striped across
+  /// several disjoint routes; the destination reassembles the blocks.
+  final RelayStripe? stripe;
+
   const RelayMetadata({
     required this.ttl,
     required this.hopCount,
@@ -74,11 +97,22 @@ class RelayMetadata {
     this.senderRateCount = 0,
     this.powNonce,
     this.powDifficulty,
+    this.compactPath,
+    this.custody = false,
+    this.replicas,
+    this.stripe,
   });
 
   /// Whether this message uses stealth addressing (relay-opaque recipient).
   bool get usesStealth => stealthEnvelope != null;
 
+  /// Copies a source hands out for a budgeted (point-to-point) bundle.
+  static const int defaultReplicaBudget = 8;
+
+  /// Binary spray-and-wait: a holder of a single copy only delivers it
+  /// directly to the destination.
+  bool get inWaitPhase => replicas != null && replicas! <= 1;
+
   /// Sentinel value used when sender identity is sealed.
   static const String sealedSenderPlaceholder = 'sealed';
 
@@ -92,6 +126,8 @@ class RelayMetadata {
     required String originalSender,
     required String finalRecipient,
     required String currentNodeId,
+    bool custody = false,
+    int? replicas,
   }) {
     final ttl = _getTTLForPriority(priority);
     final timestamp = DateTime.now();
@@ -111,16 +147,21 @@ class RelayMetadata {
       relayTimestamp: timestamp,
       originalSender: originalSender,
       finalRecipient: finalRecipient,
+      custody: custody,
+      replicas: replicas,
     );
   }
 
   /// Create next hop metadata (increments hop count, adds to path)
-  RelayMetadata nextHop(String currentNodeId) {
+  ///
+  /// [replicas] is the share of the spray budget handed to that hop; by
+  /// default the whole budget moves with the bundle (forwarding).
+  RelayMetadata nextHop(String currentNodeId, {int? replicas}) {
     if (hopCount >= ttl) {
       throw RelayException('Message TTL exceeded');
     }
 
-    if (routingPath.contains(currentNodeId)) {
+    if (hasNodeInPath(currentNodeId)) {
       throw RelayException(
         'Loop detected: node $currentNodeId already in path',
       );
@@ -130,6 +171,7 @@ class RelayMetadata {
       ttl: ttl,
       hopCount: hopCount + 1,
       routingPath: [...routingPath, currentNodeId],
+      compactPath: compactPath?.appended(currentNodeId),
       messageHash: messageHash,
       priority: priority,
       relayTimestamp: relayTimestamp,
@@ -140,37 +182,126 @@ class RelayMetadata {
       senderRateCount: senderRateCount,
       powNonce: powNonce,
       powDifficulty: powDifficulty,
+      custody: custody,
+      replicas: replicas ?? this.replicas,
+      stripe: stripe,
     );
   }
 
+  /// Metadata for one block of a striped transfer.
+  ///
+  /// Each block needs its own [messageHash] (relays drop repeated hashes),
+  /// derived with [stripeHash]; any proof-of-work must be recomputed for it
+  /// and passed as [powNonce]. Only the originator stripes, so the path is
+  /// always the local full-ID form.
+  RelayMetadata forStripe(RelayStripe stripe, {int? powNonce}) => RelayMetadata(
+    ttl: ttl,
+    hopCount: hopCount,
+    routingPath: routingPath,
+    messageHash: stripeHash(messageHash, stripe.index),
+    priority: priority,
+    relayTimestamp: relayTimestamp,
+    originalSender: originalSender,
+    finalRecipient: finalRecipient,
+    stealthEnvelope: stealthEnvelope,
+    sealedSender: sealedSender,
+    senderRateCount: senderRateCount,
+    powNonce: powNonce,
+    powDifficulty: powDifficulty,
+    custody: custody,
+    replicas: replicas,
+    stripe: stripe,
+  );
+
+  /// Message hash of block [index] of the transfer hashed as [messageHash]
+  static String stripeHash(String messageHash, int index) =>
+      sha256.convert(utf8.encode('$messageHash#$index')).toString();
+
   /// Check if message should be relayed (TTL and loop check)
   bool get canRelay => hopCount < ttl;
 
   /// Check if current node is in routing path (loop detection)
-  bool hasNodeInPath(String nodeId) => routingPath.contains(nodeId);
+  bool hasNodeInPath(String nodeId) =>
+      routingPath.contains(nodeId) || (compactPath?.contains(nodeId) ?? false);
+
+  /// Number of hops recorded in the path
+  int get pathLength => compactPath?.length ?? routingPath.length;
+
+  /// Whether every hop is known by full ID. Bundles received in compact
+  /// form are not, and cannot go to peers without
+  /// [PeerCapabilities.compactRelayPath].
+  bool get hasFullRoutingPath =>
+      compactPath == null || routingPath.length >= compactPath!.length;
 
   /// Get remaining hops
   int get remainingHops => ttl - hopCount;
 
+  /// End of the bundle lifetime, fixed at origin so hops never extend it
+  DateTime get deadline => relayTimestamp.add(lifetimeFor(priority));
+
+  /// Bundle lifetime by priority (matches the offline queue expiry)
+  static Duration lifetimeFor(MessagePriority priority) {
+    switch (priority) {
+      case MessagePriority.urgent:
+        return const Duration(hours: 24);
+      case MessagePriority.high:
+        return const Duration(hours: 12);
+      case MessagePriority.normal:
+        return const Duration(hours: 6);
+      case MessagePriority.low:
+        return const Duration(hours: 3);
+    }
+  }
+
+  /// Path entries in order, one per hop.
+  ///
+  /// Hops known by full ID (always the newest ones) use it, so peers that
+  /// only match full IDs still find themselves; earlier hops of a compact
+  /// frame use their digest entry.
+  List<String> get _pathEntries {
+    final compact = compactPath;
+    if (compact == null || routingPath.length >= compact.length) {
+      return routingPath;
+    }
+    final entries = compact.entryIds;
+    return [
+      ...entries.take(entries.length - routingPath.length),
+      ...routingPath,
+    ];
+  }
+
   /// Get reverse routing path for ACK propagation
   /// This allows ACK to travel backward through the relay chain
-  List<String> get ackRoutingPath => routingPath.reversed.toList();
+  ///
+  /// For compact frames the entries are hop digests; relays locate themselves
+  /// with [CompactRoutingPath.indexOfNode] keyed by [messageHash].
+  List<String> get ackRoutingPath => _pathEntries.reversed.toList();
 
   /// Get previous hop in the chain (where to send ACK back to)
   /// Returns null if this is the originator (no previous hop)
   String? get previousHop {
-    if (routingPath.length < 2) return null;
-    return routingPath[routingPath.length - 2]; // Second-to-last node
+    final entries = _pathEntries;
+    if (entries.length < 2) return null;
+    return entries[entries.length - 2]; // Second-to-last node
   }
 
   /// Check if this is the originator of the message
-  bool get isOriginator => routingPath.length == 1;
+  bool get isOriginator => pathLength == 1;
+
+  /// Compact form of the path, keyed by [messageHash]
+  CompactRoutingPath get compactRoutingPath =>
+      compactPath ??
+      CompactRoutingPath.fromNodeIds(routingPath, key: messageHash);
 
   /// Convert to JSON for serialization
+  ///
+  /// Keeps full node IDs; used for local persistence. Relay frames use
+  /// [toWireJson].
   Map<String, dynamic> toJson() => {
     'ttl': ttl,
     'hopCount': hopCount,
     'routingPath': routingPath,
+    if (compactPath != null) ...compactPath!.toJson(),
     'messageHash': messageHash,
     'priority': priority.index,
     'relayTimestamp': relayTimestamp.millisecondsSinceEpoch,
@@ -184,13 +315,38 @@ class RelayMetadata {
     if (powNonce != null) 'powNonce': powNonce,
     if (powDifficulty != null && powDifficulty! > 0)
       'powDifficulty': powDifficulty,
+    if (custody) 'cu': true,
+    if (replicas != null) 'rb': replicas,
+    if (stripe != null) 'sp': stripe!.toJson(),
   };
 
-  /// Create from JSON
+  /// Convert to the on-air form.
+  ///
+  /// When [compact] is set (the next hop advertised
+  /// [PeerCapabilities.compactRelayPath]) the path travels only as keyed
+  /// hop digests ([CompactRoutingPath]). Older peers get the full
+  /// `routingPath` alone, which needs [hasFullRoutingPath].
+  Map<String, dynamic> toWireJson({bool compact = false}) {
+    final json = toJson();
+    final digests = compactRoutingPath.toJson();
+    if (compact) {
+      json.remove('routingPath');
+      return {...json, ...digests};
+    }
+    if (!hasFullRoutingPath) {
+      throw const RelayException('Path known only in compact form');
+    }
+    return json..removeWhere((key, _) => digests.containsKey(key));
+  }
+
+  /// Create from JSON (full form, or the compact wire form)
   factory RelayMetadata.fromJson(Map<String, dynamic> json) => RelayMetadata(
     ttl: json['ttl'],
     hopCount: json['hopCount'],
-    routingPath: List<String>.from(json['routingPath']),
+    routingPath: json['routingPath'] != null
+        ? List<String>.from(json['routingPath'])
+        : const <String>[],
+    compactPath: CompactRoutingPath.fromJson(json, key: json['messageHash']),
     messageHash: json['messageHash'],
     priority: MessagePriority.values[json['priority']],
     relayTimestamp: DateTime.fromMillisecondsSinceEpoch(json['relayTimestamp']),
@@ -203,6 +359,11 @@ class RelayMetadata {
     senderRateCount: json['senderRateCount'] ?? 0,
     powNonce: json['powNonce'] as int?,
     powDifficulty: json['powDifficulty'] as int?,
+    custody: json['cu'] == true,
+    replicas: json['rb'] as int?,
+    stripe: json['sp'] is Map
+        ? RelayStripe.fromJson(Map<String, dynamic>.from(json['sp'] as Map))
+        : null,
   );
 
   /// Get TTL based on priority level
@@ -235,6 +396,45 @@ class RelayMetadata {
   }
 }
 
+/// Position of one block within a striped transfer.
+///
+/// A transfer of [length] UTF-8 bytes is cut into [dataBlocks] equal blocks
+/// plus one XOR parity block (index [dataBlocks]), so any [dataBlocks] of
+/// the blocks rebuild it.
+class RelayStripe {
+  /// Message ID of the whole transfer
+  final String transferId;
+  final int index;
+  final int dataBlocks;
+  final int length;
+
+  const RelayStripe({
+    required this.transferId,
+    required this.index,
+    required this.dataBlocks,
+    required this.length,
+  });
+
+  bool get isParity => index == dataBlocks;
+
+  /// Message ID carried by this block on the wire
+  String get messageId => '$transferId#$index';
+
+  Map<String, dynamic> toJson() => {
+    't': transferId,
+    'i': index,
+    'k': dataBlocks,
+    'n': length,
+  };
+
+  factory RelayStripe.fromJson(Map<String, dynamic> json) => RelayStripe(
+    transferId: json['t'] as String,
+    index: json['i'] as int,
+    dataBlocks: json['k'] as int,
+    length: json['n'] as int,
+  );
+}
+
 /// Complete mesh relay message structure
 class MeshRelayMessage {
   /// Original message ID
@@ -307,8 +507,11 @@ class MeshRelayMessage {
   );
 
   /// Create next hop relay message
-  MeshRelayMessage nextHop(String nextRelayNodeId) {
-    final nextMetadata = relayMetadata.nextHop(nextRelayNodeId);
+  MeshRelayMessage nextHop(String nextRelayNodeId, {int? replicas}) {
+    final nextMetadata = relayMetadata.nextHop(
+      nextRelayNodeId,
+      replicas: replicas,
+    );
 
     return MeshRelayMessage(
       originalMessageId: originalMessageId,
@@ -370,6 +573,8 @@ class QueueSyncMessage {
   final String queueHash;
 
   /// List of message IDs in the queue (legacy mode, or fallback)
+  ///
+  /// Empty for frames received in binary form; see [messageIdDigests].
   final List<String> messageIds;
   List<MessageId> get messageIdValues => messageIds.map(MessageId.new).toList();
 
@@ -394,6 +599,9 @@ class QueueSyncMessage {
   /// Provides 98% bandwidth reduction (32KB → 512 bytes)
   final GCSFilterParams? gcsFilter;
 
+  /// Fixed-width ID digests carried instead of [messageIds] on binary frames
+  final MessageIdDigests? messageIdDigests;
+
   const QueueSyncMessage({
     required this.queueHash,
     required this.messageIds,
@@ -403,8 +611,39 @@ class QueueSyncMessage {
     this.messageHashes,
     this.queueStats,
     this.gcsFilter,
+    this.messageIdDigests,
   });
 
+  /// Number of message IDs the sender advertised
+  int get messageCount => messageIdDigests?.length ?? messageIds.length;
+
+  /// Whether the sender advertised [messageId]
+  bool hasMessageId(String messageId) =>
+      messageIdDigests?.contains(messageId) ?? messageIds.contains(messageId);
+
+  /// The advertised IDs, resolved against [localIds] when only digests
+  /// were sent (digests cannot be turned back into IDs).
+  List<String> knownMessageIds(Iterable<String> localIds) {
+    final digests = messageIdDigests;
+    if (digests == null) return messageIds;
+    return localIds.where(digests.contains).toList();
+  }
+
+  /// Advertised IDs none of [localIds] match. Digest frames cannot name
+  /// them, so they report none; see [unknownMessageCount].
+  List<String> unknownMessageIds(Iterable<String> localIds) {
+    if (messageIdDigests != null) return const <String>[];
+    final local = localIds.toSet();
+    return messageIds.where((id) => !local.contains(id)).toList();
+  }
+
+  /// How many advertised entries none of [localIds] match
+  int unknownMessageCount(Iterable<String> localIds) {
+    final digests = messageIdDigests;
+    if (digests == null) return unknownMessageIds(localIds).length;
+    return digests.unmatchedCount(localIds);
+  }
+
   /// Create queue sync request
   factory QueueSyncMessage.createRequest({
     required List<String> messageIds,
@@ -514,7 +753,7 @@ class QueueSyncMessage {
 
   /// Get missing message IDs compared to another queue
   List<String> getMissingMessages(List<String> otherMessageIds) {
-    return otherMessageIds.where((id) => !messageIds.contains(id)).toList();
+    return otherMessageIds.where((id) => !hasMessageId(id)).toList();
   }
 
   /// Convert to JSON
@@ -527,6 +766,8 @@ class QueueSyncMessage {
     if (messageHashes != null) 'messageHashes': messageHashes,
     if (queueStats != null) 'queueStats': queueStats!.toJson(),
     if (gcsFilter != null) 'gcsFilter': gcsFilter!.toJson(),
+    if (messageIdDigests != null)
+      'messageIdDigests': messageIdDigests!.toJson(),
   };
 
   /// Create from JSON
@@ -554,6 +795,9 @@ class QueueSyncMessage {
         gcsFilter: json['gcsFilter'] != null
             ? GCSFilterParams.fromJson(json['gcsFilter'])
             : null,
+        messageIdDigests: json['messageIdDigests'] != null
+            ? MessageIdDigests.fromJson(json['messageIdDigests'])
+            : null,
       );
 
   /// Generate hash for message queue state
@@ -609,12 +853,17 @@ class RelayProcessingResult {
   final String? nextHopNodeId;
   final String? reason;
 
+  /// Whether this node took custody of the bundle (see
+  /// [RelayMetadata.custody]) and should ACK custody upstream.
+  final bool custodyAccepted;
+
   const RelayProcessingResult._(
     this.type,
     this.content,
     this.nextHopNodeId,
-    this.reason,
-  );
+    this.reason, {
+    this.custodyAccepted = false,
+  });
 
   factory RelayProcessingResult.deliveredToSelf(String content) =>
       RelayProcessingResult._(
@@ -624,13 +873,25 @@ class RelayProcessingResult {
         null,
       );
 
-  factory RelayProcessingResult.relayed(String nextHopNodeId) =>
-      RelayProcessingResult._(
-        RelayProcessingType.relayed,
-        null,
-        nextHopNodeId,
-        null,
-      );
+  /// One block of a striped transfer arrived; the transfer is delivered
+  /// (with content) once enough blocks are in.
+  factory RelayProcessingResult.stripeReceived() => RelayProcessingResult._(
+    RelayProcessingType.stripeBlock,
+    null,
+    null,
+    null,
+  );
+
+  factory RelayProcessingResult.relayed(
+    String nextHopNodeId, {
+    bool custodyAccepted = false,
+  }) => RelayProcessingResult._(
+    RelayProcessingType.relayed,
+    null,
+    nextHopNodeId,
+    null,
+    custodyAccepted: custodyAccepted,
+  );
 
   factory RelayProcessingResult.dropped(String reason) =>
       RelayProcessingResult._(RelayProcessingType.dropped, null, null, reason);
@@ -652,7 +913,17 @@ class RelayProcessingResult {
 }
 
 /// Type of relay processing result
-enum RelayProcessingType { deliveredToSelf, relayed, dropped, blocked, error }
+///
+/// [stripeBlock] is one block of a striped transfer held for reassembly;
+/// only the assembled transfer counts as [deliveredToSelf].
+enum RelayProcessingType {
+  deliveredToSelf,
+  stripeBlock,
+  relayed,
+  dropped,
+  blocked,
+  error,
+}
 
 /// Relay decision information
 class RelayDecision {
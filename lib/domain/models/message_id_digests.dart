@@ -0,0 +1,92 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+
+/// Fixed-width SHA-256 prefixes of message IDs.
+///
+/// Compact stand-in for [QueueSyncMessage.messageIds] on sync frames: every
+/// ID costs [width] bytes whatever its textual length. The sender starts at
+/// the narrowest width and escalates whenever two of its own IDs collide, so
+/// the set always has one digest per distinct ID. The receiver can only test
+/// membership of IDs it already knows, which is all sync needs.
+class MessageIdDigests {
+  /// Candidate widths in bytes, narrowest first.
+  static const List<int> widths = [6, 8, 12, 16, 32];
+
+  MessageIdDigests._(this.width, this._digests);
+
+  /// Digest [messageIds] at the narrowest collision-free width.
+  factory MessageIdDigests.fromMessageIds(Iterable<String> messageIds) {
+    final hashes = [
+      for (final id in messageIds.toSet()) sha256.convert(utf8.encode(id)).bytes,
+    ];
+    for (final width in widths) {
+      final digests = {for (final hash in hashes) _key(hash, width)};
+      if (digests.length == hashes.length) {
+        return MessageIdDigests._(width, digests);
+      }
+    }
+    // Full SHA-256 collisions do not happen; keep whatever is distinct.
+    return MessageIdDigests._(
+      widths.last,
+      {for (final hash in hashes) _key(hash, widths.last)},
+    );
+  }
+
+  /// Wrap [packed] (concatenated [width]-byte digests) from the wire.
+  factory MessageIdDigests.fromPacked(Uint8List packed, {required int width}) {
+    if (!widths.contains(width)) {
+      throw FormatException('Unsupported message ID digest width: $width');
+    }
+    final digests = <String>{};
+    for (var offset = 0; offset + width <= packed.length; offset += width) {
+      digests.add(String.fromCharCodes(packed, offset, offset + width));
+    }
+    return MessageIdDigests._(width, digests);
+  }
+
+  /// Digest width in bytes.
+  final int width;
+
+  // Latin-1 strings of the raw digest bytes: cheap to hash and compare.
+  final Set<String> _digests;
+
+  int get length => _digests.length;
+
+  bool get isEmpty => _digests.isEmpty;
+
+  /// Whether [messageId] is (with probability 1 - n/2^(8*width)) in the set.
+  bool contains(String messageId) => _digests.contains(_digestOf(messageId));
+
+  /// Number of digests that none of [messageIds] account for.
+  int unmatchedCount(Iterable<String> messageIds) {
+    final remaining = {..._digests}..removeAll(messageIds.map(_digestOf));
+    return remaining.length;
+  }
+
+  /// Concatenated digests, [width] bytes each.
+  Uint8List toPacked() {
+    final packed = Uint8List(_digests.length * width);
+    var offset = 0;
+    for (final digest in _digests) {
+      packed.setRange(offset, offset + width, digest.codeUnits);
+      offset += width;
+    }
+    return packed;
+  }
+
+  Map<String, dynamic> toJson() => {'w': width, 'd': base64Encode(toPacked())};
+
+  factory MessageIdDigests.fromJson(Map<String, dynamic> json) =>
+      MessageIdDigests.fromPacked(
+        base64Decode(json['d'] as String),
+        width: json['w'] as int,
+      );
+
+  String _digestOf(String messageId) =>
+      _key(sha256.convert(utf8.encode(messageId)).bytes, width);
+
+  static String _key(List<int> hash, int width) =>
+      String.fromCharCodes(hash, 0, width);
+}
@@ -0,0 +1,36 @@
+/// Optional wire features a peer advertises in its identity frame.
+///
+/// Each feature is one bit. Peers that predate a feature never set its bit,
+/// so senders look the peer up in `PeerCapabilityRegistry` and keep the
+/// baseline format unless the bit is present.
+class PeerCapabilities {
+  const PeerCapabilities._();
+
+  /// Relay metadata may omit the full `routingPath` and carry only keyed
+  /// hop digests (`rp`).
+  static const int compactRelayPath = 1 << 0;
+
+  /// Queue sync may travel as a binary `QueueSyncCodec` frame (flags 0x02)
+  /// with message ID digests instead of JSON.
+  static const int binaryQueueSync = 1 << 1;
+
+  /// Understands custody ACKs (`relayAck` with `custody: true`). Older
+  /// nodes read any relay ACK as a delivery notice, so they never get one.
+  static const int custody = 1 << 2;
+
+  /// Relays keep a bundle's stripe position (`sp`) and destinations
+  /// reassemble striped transfers.
+  static const int stripedRelay = 1 << 3;
+
+  /// Unsigned ACKs and pings may travel as compact control frames (flags
+  /// 0x04) instead of JSON, and pings are answered with pongs.
+  static const int compactAck = 1 << 4;
+
+  /// Every capability this build understands; sent in our identity frame.
+  static const int local =
+      compactRelayPath | binaryQueueSync | custody | stripedRelay | compactAck;
+
+  /// Whether [capabilities] includes every bit of [capability].
+  static bool has(int capabilities, int capability) =>
+      capabilities & capability == capability;
+}
@@ -1,19 +1,22 @@
+import 'dart:collection';
 import 'dart:convert';
 import 'dart:typed_data';
 import 'package:pak_connect/domain/utils/compression_util.dart';
 import 'package:pak_connect/domain/utils/compression_config.dart';
+import 'package:pak_connect/domain/utils/queue_sync_codec.dart';
 import 'package:pak_connect/domain/models/crypto_header.dart';
 import 'package:pak_connect/domain/models/protocol_message_type.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 import '../constants/special_recipients.dart';
 import 'mesh_relay_models.dart';
+import 'peer_capabilities.dart';
+import 'read_watermark.dart';
 export 'package:pak_connect/domain/models/protocol_message_type.dart'
     show ProtocolMessageType, ProtocolMessageTypeWireId;
 
 class ProtocolMessage {
   final ProtocolMessageType type;
   final int version;
-  final Map<String, dynamic> payload;
   final DateTime timestamp;
   final String? signature;
   final bool useEphemeralSigning;
@@ -22,23 +25,107 @@ class ProtocolMessage {
   ProtocolMessage({
     required this.type,
     this.version = 1,
-    required this.payload,
+    required Map<String, dynamic> payload,
     required this.timestamp,
     this.signature,
     this.useEphemeralSigning = false,
     this.ephemeralSigningKey,
-  });
+  }) : _payload = payload,
+       _binaryQueueSync = null,
+       _controlBody = null;
+
+  /// Queue sync carried as a [QueueSyncCodec] frame instead of JSON.
+  ProtocolMessage._binaryQueueSync(
+    QueueSyncMessage message, {
+    Map<String, dynamic>? payload,
+  }) : type = ProtocolMessageType.queueSync,
+       version = 1,
+       timestamp = message.syncTimestamp,
+       signature = null,
+       useEphemeralSigning = false,
+       ephemeralSigningKey = null,
+       _payload = payload,
+       _binaryQueueSync = message,
+       _controlBody = null;
+
+  /// ACK, ping or pong carried as a compact control frame
+  ProtocolMessage._control(this.type, this.timestamp, String body)
+    : version = 1,
+      signature = null,
+      useEphemeralSigning = false,
+      ephemeralSigningKey = null,
+      _payload = null,
+      _binaryQueueSync = null,
+      _controlBody = body;
+
+  /// Flags bit: the body is a binary queue sync frame, not JSON.
+  static const int _binaryQueueSyncFlag = 0x02;
+
+  /// Flags bit: the body is a compact control frame (ACK, ping or pong),
+  /// not JSON.
+  static const int _controlFrameFlag = 0x04;
+
+  /// Flags, type and timestamp ahead of a control frame's body
+  static const int _controlHeaderBytes = 10;
+
+  Map<String, dynamic>? _payload;
+  final QueueSyncMessage? _binaryQueueSync;
+
+  /// Body of a control frame: an ACK's original message ID, empty for ping
+  /// and pong
+  final String? _controlBody;
+
+  /// Received payloads are read-only views, so views decoded from them
+  /// below are cached; locally built payloads may still be written to.
+  bool get _payloadIsFixed => _payload is UnmodifiableMapView;
+
+  /// JSON payload. Control and binary queue sync frames never decode into
+  /// a map; one is only built here for callers that still ask for it.
+  Map<String, dynamic> get payload =>
+      _payload ??=
+          _binaryQueueSync?.toJson() ??
+          switch (type) {
+            ProtocolMessageType.ack => {'originalMessageId': _controlBody},
+            _ => <String, dynamic>{},
+          };
 
   /// Serializes this protocol message to bytes with optional compression.
   ///
   /// Format (with compression):
-  /// - Flags: 1 byte (bit 0: IS_COMPRESSED = 0x01)
+  /// - Flags: 1 byte (bit 0: IS_COMPRESSED = 0x01, bit 1: BINARY_SYNC = 0x02)
   /// - Original size: 2 bytes (if compressed, big-endian)
   /// - Data: Variable length (JSON or compressed JSON)
   ///
+  /// Binary queue sync frames are `[0x02][QueueSyncCodec frame]`; they are
+  /// already dense, so compression is skipped.
+  ///
+  /// Compact ACKs (see [ack]), the most frequent inbound frame, are
+  /// control frames `[0x04][type:1][timestamp ms:8][UTF-8 original message
+  /// ID]` so the receiver handles them without JSON or a payload map.
+  /// Compact pings and pongs use the same header with an empty body.
+  ///
   /// Uses aggressive compression config for BLE transmission efficiency.
   /// Falls back to uncompressed if compression doesn't help.
   Uint8List toBytes({bool enableCompression = true}) {
+    final binaryQueueSync = _binaryQueueSync;
+    if (binaryQueueSync != null) {
+      final frame = QueueSyncCodec.encode(binaryQueueSync);
+      return Uint8List(1 + frame.length)
+        ..[0] = _binaryQueueSyncFlag
+        ..setRange(1, 1 + frame.length, frame);
+    }
+
+    final controlBody = _controlBody;
+    if (controlBody != null) {
+      final body = utf8.encode(controlBody);
+      final frame = ByteData(_controlHeaderBytes + body.length)
+        ..setUint8(0, _controlFrameFlag)
+        ..setUint8(1, type.wireType)
+        ..setInt64(2, timestamp.millisecondsSinceEpoch);
+      return frame.buffer.asUint8List()
+        ..setAll(_controlHeaderBytes, body);
+    }
+
     final json = {
       'type': type.wireType,
       'version': version,
@@ -99,6 +186,14 @@ class ProtocolMessage {
     try {
       // Read flags byte
       final flags = bytes[0];
+      if ((flags & _binaryQueueSyncFlag) != 0) {
+        return ProtocolMessage._binaryQueueSync(
+          QueueSyncCodec.decode(Uint8List.sublistView(bytes, 1)),
+        );
+      }
+      if ((flags & _controlFrameFlag) != 0) {
+        return _decodeControlFrame(bytes);
+      }
       final isCompressed = (flags & 0x01) != 0;
 
       Uint8List jsonBytes;
@@ -139,7 +234,7 @@ class ProtocolMessage {
       return ProtocolMessage(
         type: ProtocolMessageTypeWireId.fromWireType(json['type']),
         version: _requireInt(json, 'version'),
-        payload: _requirePayload(json),
+        payload: UnmodifiableMapView(_requirePayload(json)),
         timestamp: DateTime.fromMillisecondsSinceEpoch(
           _requireInt(json, 'timestamp'),
         ),
@@ -156,13 +251,43 @@ class ProtocolMessage {
     }
   }
 
+  static ProtocolMessage _decodeControlFrame(Uint8List bytes) {
+    if (bytes.length < _controlHeaderBytes) {
+      throw ArgumentError('Control frame too short');
+    }
+    final header = ByteData.sublistView(bytes, 0, _controlHeaderBytes);
+    final type = ProtocolMessageTypeWireId.fromWireType(header.getUint8(1));
+    switch (type) {
+      case ProtocolMessageType.ack:
+        break;
+      case ProtocolMessageType.ping || ProtocolMessageType.pong:
+        if (bytes.length != _controlHeaderBytes) {
+          throw ArgumentError('Control frame ${type.name} carries a body');
+        }
+      default:
+        throw ArgumentError('Not a control frame type: ${type.name}');
+    }
+    return ProtocolMessage._control(
+      type,
+      DateTime.fromMillisecondsSinceEpoch(header.getInt64(2)),
+      utf8.decode(Uint8List.sublistView(bytes, _controlHeaderBytes)),
+    );
+  }
+
   // Quick constructors
+  /// [capabilities] is the sender's [PeerCapabilities] mask; older peers
+  /// ignore the extra field.
   static ProtocolMessage identity({
     required String publicKey,
     required String displayName,
+    int? capabilities,
   }) => ProtocolMessage(
     type: ProtocolMessageType.identity,
-    payload: {'publicKey': publicKey, 'displayName': displayName},
+    payload: {
+      'publicKey': publicKey,
+      'displayName': displayName,
+      'caps': ?capabilities,
+    },
     timestamp: DateTime.now(),
   );
 
@@ -278,21 +403,41 @@ class ProtocolMessage {
     encrypted: encrypted,
   );
 
-  static ProtocolMessage ack({required String originalMessageId}) =>
-      ProtocolMessage(
-        type: ProtocolMessageType.ack,
-        payload: {'originalMessageId': originalMessageId},
-        timestamp: DateTime.now(),
-      );
+  /// [compact] sends a control frame instead of JSON; only for peers that
+  /// advertised [PeerCapabilities.compactAck], since older ones cannot
+  /// parse it.
+  static ProtocolMessage ack({
+    required String originalMessageId,
+    bool compact = false,
+  }) => compact
+      ? ProtocolMessage._control(
+          ProtocolMessageType.ack,
+          DateTime.now(),
+          originalMessageId,
+        )
+      : ProtocolMessage(
+          type: ProtocolMessageType.ack,
+          payload: {'originalMessageId': originalMessageId},
+          timestamp: DateTime.now(),
+        );
 
   static ProtocolMessage ackWithId({required MessageId originalMessageId}) =>
       ack(originalMessageId: originalMessageId.value);
 
-  static ProtocolMessage ping() => ProtocolMessage(
-    type: ProtocolMessageType.ping,
-    payload: {},
-    timestamp: DateTime.now(),
-  );
+  /// [compact] as for [ack]: a bodyless control frame for peers that
+  /// advertised [PeerCapabilities.compactAck].
+  static ProtocolMessage ping({bool compact = false}) =>
+      _keepalive(ProtocolMessageType.ping, compact: compact);
+
+  static ProtocolMessage pong({bool compact = false}) =>
+      _keepalive(ProtocolMessageType.pong, compact: compact);
+
+  static ProtocolMessage _keepalive(
+    ProtocolMessageType type, {
+    required bool compact,
+  }) => compact
+      ? ProtocolMessage._control(type, DateTime.now(), '')
+      : ProtocolMessage(type: type, payload: {}, timestamp: DateTime.now());
 
   static bool isProtocolMessage(String jsonString) {
     try {
@@ -342,15 +487,26 @@ class ProtocolMessage {
     timestamp: DateTime.now(),
   );
 
+  /// [statusVersion] grows each time the sender's status for this peer
+  /// changes, letting the receiver drop reordered or replayed updates.
   static ProtocolMessage contactStatus({
     required bool hasAsContact,
     required String publicKey,
+    int? statusVersion,
   }) => ProtocolMessage(
     type: ProtocolMessageType.contactStatus,
-    payload: {'hasAsContact': hasAsContact, 'publicKey': publicKey},
+    payload: {
+      'hasAsContact': hasAsContact,
+      'publicKey': publicKey,
+      'sv': ?statusVersion,
+    },
     timestamp: DateTime.now(),
   );
 
+  int? get contactStatusVersion => type == ProtocolMessageType.contactStatus
+      ? payload['sv'] as int?
+      : null;
+
   // ===== PAIRING PROTOCOL MESSAGES =====
 
   static ProtocolMessage pairingRequest({
@@ -395,8 +551,19 @@ class ProtocolMessage {
       ? payload['publicKey'] as String?
       : null;
 
+  /// Capability mask from an identity frame; 0 for peers that send none
+  int get identityCapabilities => type == ProtocolMessageType.identity
+      ? payload['caps'] as int? ?? 0
+      : 0;
+
   // Noise Protocol XX Handshake data helpers
-  Uint8List? get noiseHandshakeData {
+  // Nested decodes that handlers read more than once are memoized for
+  // received messages (see [_payloadIsFixed]).
+  Uint8List? get noiseHandshakeData =>
+      _payloadIsFixed ? _noiseHandshakeData : _decodeNoiseHandshakeData();
+  late final Uint8List? _noiseHandshakeData = _decodeNoiseHandshakeData();
+
+  Uint8List? _decodeNoiseHandshakeData() {
     if (type == ProtocolMessageType.noiseHandshake1 ||
         type == ProtocolMessageType.noiseHandshake2 ||
         type == ProtocolMessageType.noiseHandshake3) {
@@ -450,7 +617,11 @@ class ProtocolMessage {
   String? get senderId => type == ProtocolMessageType.textMessage
       ? payload['senderId'] as String?
       : null;
-  CryptoHeader? get cryptoHeader => type == ProtocolMessageType.textMessage
+  CryptoHeader? get cryptoHeader =>
+      _payloadIsFixed ? _cryptoHeader : _decodeCryptoHeader();
+  late final CryptoHeader? _cryptoHeader = _decodeCryptoHeader();
+  CryptoHeader? _decodeCryptoHeader() =>
+      type == ProtocolMessageType.textMessage
       ? CryptoHeader.fromJson(payload['crypto'])
       : null;
 
@@ -468,7 +639,7 @@ class ProtocolMessage {
 
   // Helper for ACK
   String? get ackOriginalId => type == ProtocolMessageType.ack
-      ? payload['originalMessageId'] as String?
+      ? _controlBody ?? payload['originalMessageId'] as String?
       : null;
   MessageId? get ackOriginalMessageIdValue => _wrapMessageId(ackOriginalId);
 
@@ -599,6 +770,10 @@ class ProtocolMessage {
 
   // Queue sync helpers
   QueueSyncMessage? get queueSyncMessage =>
+      _binaryQueueSync ??
+      (_payloadIsFixed ? _queueSyncMessage : _decodeQueueSyncMessage());
+  late final QueueSyncMessage? _queueSyncMessage = _decodeQueueSyncMessage();
+  QueueSyncMessage? _decodeQueueSyncMessage() =>
       type == ProtocolMessageType.queueSync
       ? QueueSyncMessage.fromJson(payload)
       : null;
@@ -626,6 +801,16 @@ class ProtocolMessage {
       ? (payload['delivered'] as bool? ?? false)
       : false;
 
+  /// Reverse path a relay ACK follows back toward the originator
+  List<String>? get relayAckRoutingPath => type == ProtocolMessageType.relayAck
+      ? (payload['ackRoutingPath'] as List<dynamic>?)?.cast<String>()
+      : null;
+
+  /// Hop-by-hop custody ACK: [relayAckRelayNode] took custody of the bundle.
+  bool get relayAckCustody => type == ProtocolMessageType.relayAck
+      ? (payload['custody'] as bool? ?? false)
+      : false;
+
   // Mesh relay constructors
   static ProtocolMessage meshRelay({
     required String originalMessageId,
@@ -668,23 +853,34 @@ class ProtocolMessage {
     originalMessageType: originalMessageType,
   );
 
-  static ProtocolMessage queueSync({required QueueSyncMessage queueMessage}) =>
-      ProtocolMessage(
-        type: ProtocolMessageType.queueSync,
-        payload: queueMessage.toJson(),
-        timestamp: DateTime.now(),
-      );
+  /// Queue sync frame; [binary] sends it as a compact [QueueSyncCodec]
+  /// frame (message IDs as digests) instead of JSON.
+  static ProtocolMessage queueSync({
+    required QueueSyncMessage queueMessage,
+    bool binary = false,
+  }) => binary
+      ? ProtocolMessage._binaryQueueSync(
+          queueMessage,
+          payload: queueMessage.toJson(),
+        )
+      : ProtocolMessage(
+          type: ProtocolMessageType.queueSync,
+          payload: queueMessage.toJson(),
+          timestamp: DateTime.now(),
+        );
 
   static ProtocolMessage relayAck({
     required String originalMessageId,
     required String relayNode,
     required bool delivered,
+    bool custody = false,
   }) => ProtocolMessage(
     type: ProtocolMessageType.relayAck,
     payload: {
       'originalMessageId': originalMessageId,
       'relayNode': relayNode,
       'delivered': delivered,
+      if (custody) 'custody': true,
     },
     timestamp: DateTime.now(),
   );
@@ -717,6 +913,20 @@ class ProtocolMessage {
     timestamp: DateTime.fromMillisecondsSinceEpoch(timestamp),
   );
 
+  // ===== READ STATE CONSTRUCTORS =====
+
+  /// Aggregated read receipt for the chat shared with the recipient.
+  static ProtocolMessage readReceipt({required ReadWatermark watermark}) =>
+      ProtocolMessage(
+        type: ProtocolMessageType.readReceipt,
+        payload: watermark.toPayload(),
+        timestamp: DateTime.now(),
+      );
+
+  ReadWatermark? get readWatermark => type == ProtocolMessageType.readReceipt
+      ? ReadWatermark.fromPayload(payload)
+      : null;
+
   // ===== HANDSHAKE PROTOCOL CONSTRUCTORS =====
 
   /// Phase 0: Connection ready signal
@@ -38,6 +38,9 @@ enum ProtocolMessageType {
 
   // ===== SPY MODE =====
   friendReveal, // Reveal persistent identity in spy mode
+  // ===== READ STATE =====
+  readReceipt, // Per-chat read watermark (link-local)
+  pong, // Reply to a ping
 }
 
 /// Stable numeric IDs for wire serialization.
@@ -73,6 +76,8 @@ const Map<ProtocolMessageType, int> _wireTypeByMessageType = {
   ProtocolMessageType.queueSync: 23,
   ProtocolMessageType.relayAck: 24,
   ProtocolMessageType.friendReveal: 25,
+  ProtocolMessageType.readReceipt: 26,
+  ProtocolMessageType.pong: 27,
 };
 
 final Map<int, ProtocolMessageType> _messageTypeByWireType = {
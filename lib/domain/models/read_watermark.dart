@@ -0,0 +1,38 @@
+/// Aggregated read state for one chat, sent as a single receipt frame.
+///
+/// Everything the reader received up to and including [anchorMessageId] has
+/// been read. The anchor is a message ID rather than a timestamp because
+/// inbound messages are stamped with the reader's clock; the sender resolves
+/// it against its own copy of the message.
+///
+/// Frames are full snapshots of the reader's state, so the receiver only
+/// needs the newest [version] and may drop anything older.
+class ReadWatermark {
+  const ReadWatermark({required this.version, this.anchorMessageId});
+
+  final int version;
+  final String? anchorMessageId;
+
+  bool get isEmpty => anchorMessageId == null;
+
+  bool isNewerThan(ReadWatermark? other) =>
+      other == null || version > other.version;
+
+  /// Compact wire payload: `v` version, `a` anchor.
+  Map<String, dynamic> toPayload() => {
+    'v': version,
+    if (anchorMessageId != null) 'a': anchorMessageId,
+  };
+
+  static ReadWatermark? fromPayload(Map<String, dynamic> payload) {
+    final version = payload['v'];
+    if (version is! int) return null;
+    return ReadWatermark(
+      version: version,
+      anchorMessageId: payload['a'] as String?,
+    );
+  }
+
+  @override
+  String toString() => 'ReadWatermark(v$version, anchor: $anchorMessageId)';
+}
@@ -1,43 +1,78 @@
 import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
 import 'dart:math';
+import 'package:crypto/crypto.dart';
 import 'package:logging/logging.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+import 'link_estimate.dart';
 import 'routing_models.dart';
 import '../interfaces/i_connection_service.dart';
 import '../utils/string_extensions.dart';
 import '../values/id_types.dart';
 
 /// Monitors connection quality and provides scoring for routing decisions
+///
+/// Each neighbour is tracked by one constant-space [LinkEstimate]. Links whose
+/// session node ID resolves to a stable identity (see
+/// [configureStableKeyResolver]) are persisted under a hash of that identity
+/// and re-attached when the neighbour reappears after a restart; links that
+/// only ever had an ephemeral ID stay in memory.
 class ConnectionQualityMonitor {
   static final _logger = Logger('ConnectionQualityMonitor');
 
+  /// Process-wide monitor shared by the router, route calculator and relay
+  /// decision engine so they all rank hops from the same link history.
+  static final ConnectionQualityMonitor instance = ConnectionQualityMonitor();
+
+  static String? Function(String nodeId)? _stableKeyResolver;
+
+  /// Map session node IDs to a stable neighbour identity (or `null`).
+  static void configureStableKeyResolver(
+    String? Function(String nodeId)? resolver,
+  ) {
+    _stableKeyResolver = resolver;
+  }
+
   final Map<String, ConnectionMetrics> _connectionMetrics = {};
-  final Map<String, List<double>> _latencyHistory = {};
-  final Map<String, List<double>> _signalHistory = {};
-  final Map<String, int> _messagesSent = {};
-  final Map<String, int> _messagesAcked = {};
+  final Map<String, LinkEstimate> _links = {};
+  // Persisted estimates not yet matched to a session node ID.
+  final Map<String, LinkEstimate> _restoredLinks = {};
+  // messageId -> (nodeId, sent at), to derive RTT when ACKs carry none.
+  final LinkedHashMap<String, (String, DateTime)> _pendingSends =
+      LinkedHashMap();
   final Map<String, DateTime> _lastUpdate = {};
+  int _totalMessagesSent = 0;
+  int _totalMessagesAcked = 0;
+  bool _linksLoaded = false;
+  bool _dirty = false;
 
   Timer? _monitoringTimer;
-  Timer? _historyCleanupTimer;
+  Timer? _persistTimer;
 
   static const Duration _monitoringInterval = Duration(seconds: 10);
-  static const int _maxHistoryEntries = 360; // 1 hour of 10-second intervals
+  static const Duration _persistInterval = Duration(minutes: 5);
+  static const Duration _linkRetention = Duration(days: 14);
+  static const int _maxLinks = 256;
+  static const int _maxPendingSends = 256;
+  static const String _linksKey = 'connection_quality_links_v1';
 
   /// Initialize the connection quality monitor
   Future<void> initialize() async {
     _logger.info('Initializing Connection Quality Monitor');
 
+    if (!_linksLoaded) {
+      _linksLoaded = true;
+      await _restoreLinks();
+    }
+
     // Start periodic monitoring (kept for now; can be tied to connection events later)
     _monitoringTimer ??= Timer.periodic(
       _monitoringInterval,
       (_) => _updateConnectionMetrics(),
     );
 
-    // Start history cleanup (kept but guarded to avoid duplicate timers)
-    _historyCleanupTimer ??= Timer.periodic(
-      Duration(minutes: 15),
-      (_) => _cleanupHistory(),
-    );
+    _persistTimer ??= Timer.periodic(_persistInterval, (_) => _persistLinks());
 
     _logger.info('Connection Quality Monitor initialized');
   }
@@ -50,15 +85,31 @@ class ConnectionQualityMonitor {
   ConnectionMetrics? getConnectionMetricsId(ChatId nodeId) =>
       getConnectionMetrics(nodeId.value);
 
+  /// Time-decayed link statistics for a neighbour, if any were observed
+  LinkEstimate? getLinkEstimate(String nodeId) => _lookupLink(nodeId);
+
+  /// Expected transmissions per delivery over the link to [nodeId]
+  double getLinkEtx(String nodeId) =>
+      _lookupLink(nodeId)?.etx() ?? 1.0 / LinkEstimate.priorDeliveryRatio;
+
+  /// Expected time per delivered frame (ETX x RTT bound), for ranking hops
+  double getLinkCost(String nodeId) {
+    final link = _lookupLink(nodeId);
+    if (link == null) {
+      return LinkEstimate.defaultRttMs / LinkEstimate.priorDeliveryRatio;
+    }
+    return link.etx() * link.rttBoundMs();
+  }
+
   /// Get connection quality score between current node and target
   Future<double> getConnectionScore(String nodeId) async {
     final metrics = _connectionMetrics[nodeId];
-    if (metrics == null) {
-      // No data available, return neutral score
-      return 0.5;
+    if (metrics != null) {
+      return metrics.qualityScore;
     }
 
-    return metrics.qualityScore;
+    // No measured metrics; fall back to the link estimate or neutral score
+    return _lookupLink(nodeId)?.score() ?? 0.5;
   }
 
   Future<double> getConnectionScoreId(ChatId nodeId) =>
@@ -66,7 +117,15 @@ class ConnectionQualityMonitor {
 
   /// Record a message sent to track delivery statistics
   void recordMessageSent(String nodeId, String messageId) {
-    _messagesSent[nodeId] = (_messagesSent[nodeId] ?? 0) + 1;
+    final now = DateTime.now();
+    _totalMessagesSent++;
+    _linkFor(nodeId, now).recordSent(now);
+    _pendingSends.remove(messageId);
+    _pendingSends[messageId] = (nodeId, now);
+    if (_pendingSends.length > _maxPendingSends) {
+      _pendingSends.remove(_pendingSends.keys.first);
+    }
+    _dirty = true;
     final truncatedNodeId = nodeId.length > 8 ? nodeId.shortId(8) : nodeId;
     _logger.fine('Message sent to $truncatedNodeId...: $messageId');
   }
@@ -80,11 +139,15 @@ class ConnectionQualityMonitor {
     String messageId, {
     double? latency,
   }) {
-    _messagesAcked[nodeId] = (_messagesAcked[nodeId] ?? 0) + 1;
+    final now = DateTime.now();
+    _totalMessagesAcked++;
 
-    if (latency != null) {
-      _recordLatency(nodeId, latency);
+    final pending = _pendingSends.remove(messageId);
+    if (latency == null && pending != null && pending.$1 == nodeId) {
+      latency = now.difference(pending.$2).inMilliseconds.toDouble();
     }
+    _linkFor(nodeId, now).recordAck(now, rttMs: latency);
+    _dirty = true;
 
     final truncatedNodeId = nodeId.length > 8 ? nodeId.shortId(8) : nodeId;
     _logger.fine(
@@ -119,16 +182,19 @@ class ConnectionQualityMonitor {
 
       // Measure signal strength (simulated for BLE - in real implementation use RSSI)
       final signalStrength = _measureSignalStrength(bleService);
-      _recordSignalStrength(nodeId, signalStrength);
+      recordSignalStrength(nodeId, signalStrength);
+
+      final link = _lookupLink(nodeId)!;
+      final now = DateTime.now();
 
       // Calculate packet loss rate
-      final packetLoss = _calculatePacketLoss(nodeId);
+      final packetLoss = _calculatePacketLoss(link, now);
 
-      // Get average latency
-      final avgLatency = _getAverageLatency(nodeId);
+      // Smoothed round-trip latency
+      final avgLatency = link.srttMs ?? LinkEstimate.defaultRttMs;
 
       // Estimate throughput based on recent activity
-      final throughput = _estimateThroughput(nodeId);
+      final throughput = _estimateThroughput(nodeId, link, now);
 
       // Create updated metrics
       final metrics = ConnectionMetrics(
@@ -236,14 +302,8 @@ class ConnectionQualityMonitor {
                   .reduce((a, b) => a + b) /
               totalConnections;
 
-    final totalMessagesSent = _messagesSent.values.fold(
-      0,
-      (sum, count) => sum + count,
-    );
-    final totalMessagesAcked = _messagesAcked.values.fold(
-      0,
-      (sum, count) => sum + count,
-    );
+    final totalMessagesSent = _totalMessagesSent;
+    final totalMessagesAcked = _totalMessagesAcked;
 
     final deliveryRate = totalMessagesSent > 0
         ? totalMessagesAcked / totalMessagesSent
@@ -280,68 +340,43 @@ class ConnectionQualityMonitor {
     }
   }
 
-  /// Record signal strength measurement
-  void _recordSignalStrength(String nodeId, double signalStrength) {
-    _signalHistory.putIfAbsent(nodeId, () => <double>[]).add(signalStrength);
-
-    // Limit history size
-    final history = _signalHistory[nodeId]!;
-    if (history.length > _maxHistoryEntries) {
-      history.removeAt(0);
-    }
+  /// Record a normalized (0-1) signal strength sample for a neighbour
+  void recordSignalStrength(String nodeId, double signalStrength) {
+    final now = DateTime.now();
+    _linkFor(nodeId, now).recordSignal(now, signalStrength);
+    _dirty = true;
   }
 
-  /// Record latency measurement
-  void _recordLatency(String nodeId, double latency) {
-    _latencyHistory.putIfAbsent(nodeId, () => <double>[]).add(latency);
-
-    // Limit history size
-    final history = _latencyHistory[nodeId]!;
-    if (history.length > _maxHistoryEntries) {
-      history.removeAt(0);
-    }
+  /// Record that a neighbour came into range (link established)
+  void recordEncounter(String nodeId) {
+    final now = DateTime.now();
+    _linkFor(nodeId, now).recordEncounter(now);
+    _dirty = true;
   }
 
-  /// Calculate packet loss rate for a connection
-  double _calculatePacketLoss(String nodeId) {
-    final sent = _messagesSent[nodeId] ?? 0;
-    final acked = _messagesAcked[nodeId] ?? 0;
+  /// Expected wait until [nodeId] is met again, `null` if unknown
+  Duration? predictedEncounterWait(String nodeId) =>
+      _lookupLink(nodeId)?.predictedEncounterWait(DateTime.now());
 
-    if (sent == 0) return 0.0;
+  /// Calculate packet loss rate for a connection
+  double _calculatePacketLoss(LinkEstimate link, DateTime now) {
+    if (link.sentAt(now) == 0) return 0.0;
 
-    final lossRate = 1.0 - (acked / sent);
+    final lossRate = 1.0 - link.deliveryRatio(now);
     return lossRate.clamp(0.0, 1.0);
   }
 
-  /// Get average latency for a connection
-  double _getAverageLatency(String nodeId) {
-    final latencies = _latencyHistory[nodeId];
-    if (latencies == null || latencies.isEmpty) {
-      return 1000.0; // Default 1 second latency
-    }
-
-    // Calculate moving average of recent latencies
-    final recentLatencies = latencies.length > 10
-        ? latencies.sublist(latencies.length - 10)
-        : latencies;
-
-    final sum = recentLatencies.reduce((a, b) => a + b);
-    return sum / recentLatencies.length;
-  }
-
   /// Estimate throughput based on recent activity
-  double _estimateThroughput(String nodeId) {
-    final sent = _messagesSent[nodeId] ?? 0;
-    final acked = _messagesAcked[nodeId] ?? 0;
+  double _estimateThroughput(String nodeId, LinkEstimate link, DateTime now) {
     final lastUpdate = _lastUpdate[nodeId];
 
-    if (lastUpdate == null || sent == 0) {
+    if (lastUpdate == null || link.sentAt(now) == 0) {
       return 0.5; // Default moderate throughput
     }
 
     // Simple throughput estimation based on success rate and recency
-    final successRate = acked / sent;
-    final timeSinceUpdate = DateTime.now().difference(lastUpdate).inSeconds;
+    final successRate = link.deliveryRatio(now);
+    final timeSinceUpdate = now.difference(lastUpdate).inSeconds;
 
     // Reduce throughput estimate if connection hasn't been used recently
     final recencyFactor = timeSinceUpdate < 60 ? 1.0 : 0.5;
@@ -423,48 +458,129 @@ class ConnectionQualityMonitor {
     );
   }
 
-  /// Clean up old history data
-  void _cleanupHistory() {
-    try {
-      // For simplicity, we'll just limit the size of history arrays
-      // In a real implementation, you'd store timestamps with each measurement
+  /// Existing link for [nodeId], adopting a persisted estimate if one
+  /// belongs to the same stable neighbour identity
+  LinkEstimate? _lookupLink(String nodeId) {
+    final link = _links[nodeId];
+    if (link != null || _restoredLinks.isEmpty) return link;
 
-      for (final history in _latencyHistory.values) {
-        if (history.length > _maxHistoryEntries) {
-          history.removeRange(0, history.length - _maxHistoryEntries);
-        }
-      }
+    final key = _persistKeyFor(nodeId);
+    final restored = key == null ? null : _restoredLinks.remove(key);
+    if (restored != null) {
+      _links[nodeId] = restored;
+    }
+    return restored;
+  }
+
+  LinkEstimate _linkFor(String nodeId, DateTime now) {
+    final existing = _lookupLink(nodeId);
+    if (existing != null) return existing;
+
+    if (_links.length >= _maxLinks) {
+      // Evict the neighbour seen least recently
+      final stalest = _links.entries.reduce(
+        (a, b) => a.value.lastSeen.isBefore(b.value.lastSeen) ? a : b,
+      );
+      _links.remove(stalest.key);
+    }
+    return _links[nodeId] = LinkEstimate(firstSeen: now);
+  }
+
+  /// Hash of the neighbour's stable identity; never the raw ID
+  String? _persistKeyFor(String nodeId) {
+    final stableKey = _stableKeyResolver?.call(nodeId);
+    if (stableKey == null || stableKey.isEmpty) return null;
+    return sha256.convert(utf8.encode(stableKey)).toString().substring(0, 32);
+  }
 
-      for (final history in _signalHistory.values) {
-        if (history.length > _maxHistoryEntries) {
-          history.removeRange(0, history.length - _maxHistoryEntries);
+  Future<void> _restoreLinks() async {
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      final data = prefs.getString(_linksKey);
+      if (data == null) return;
+
+      final cutoff = DateTime.now().subtract(_linkRetention);
+      final decoded = jsonDecode(data) as Map<String, dynamic>;
+      for (final entry in decoded.entries) {
+        final link = LinkEstimate.fromJson(entry.value as Map<String, dynamic>);
+        if (link != null && link.lastSeen.isAfter(cutoff)) {
+          _restoredLinks.putIfAbsent(entry.key, () => link);
         }
       }
+      _logger.info(
+        'Restored ${_restoredLinks.length} persisted link estimates',
+      );
+    } catch (e) {
+      _logger.warning('Failed to restore link estimates: $e');
+    }
+  }
+
+  /// Snapshot persistable links, dropping ones idle past the retention window
+  String _encodeLinks() {
+    final cutoff = DateTime.now().subtract(_linkRetention);
+    _links.removeWhere((_, link) => link.lastSeen.isBefore(cutoff));
+    _restoredLinks.removeWhere((_, link) => link.lastSeen.isBefore(cutoff));
+
+    final encoded = <String, dynamic>{
+      for (final entry in _restoredLinks.entries)
+        entry.key: entry.value.toJson(),
+    };
+    for (final entry in _links.entries) {
+      final key = _persistKeyFor(entry.key);
+      if (key != null) encoded[key] = entry.value.toJson();
+    }
+    return jsonEncode(encoded);
+  }
 
-      _logger.fine('Cleaned up connection quality history');
+  Future<void> _persistLinks() async {
+    if (!_dirty) return;
+    _dirty = false;
+    await _writeLinks(_encodeLinks());
+  }
+
+  Future<void> _writeLinks(String data) async {
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      await prefs.setString(_linksKey, data);
+      _logger.fine('Persisted connection quality link estimates');
     } catch (e) {
-      _logger.warning('History cleanup failed: $e');
+      _logger.warning('Failed to persist link estimates: $e');
     }
   }
 
-  /// Clear all monitoring data
-  void clearAll() {
+  void _clearMemory() {
     _connectionMetrics.clear();
-    _latencyHistory.clear();
-    _signalHistory.clear();
-    _messagesSent.clear();
-    _messagesAcked.clear();
+    _links.clear();
+    _restoredLinks.clear();
+    _pendingSends.clear();
     _lastUpdate.clear();
+    _totalMessagesSent = 0;
+    _totalMessagesAcked = 0;
+  }
+
+  /// Clear all monitoring data
+  ///
+  /// Persisted link history is replaced on the next save.
+  void clearAll() {
+    _clearMemory();
+    _dirty = true;
     _logger.info('Cleared all connection quality monitoring data');
   }
 
   /// Dispose of resources
+  ///
+  /// Link history is flushed first; the next [initialize] restores it.
   void dispose() {
     _monitoringTimer?.cancel();
     _monitoringTimer = null;
-    _historyCleanupTimer?.cancel();
-    _historyCleanupTimer = null;
-    clearAll();
+    _persistTimer?.cancel();
+    _persistTimer = null;
+    if (_linksLoaded && _dirty) {
+      unawaited(_writeLinks(_encodeLinks()));
+    }
+    _dirty = false;
+    _linksLoaded = false;
+    _clearMemory();
     _logger.info('Connection Quality Monitor disposed');
   }
 }
@@ -0,0 +1,228 @@
+import 'dart:math';
+
+/// Constant-space, time-decayed statistics for one neighbour link.
+///
+/// Replaces per-sample history lists: every observation folds into a handful
+/// of running values, so queries are O(1) and the record serializes to a
+/// few dozen bytes.
+///
+/// - RTT: smoothed mean and mean deviation (RFC 6298 gains).
+/// - Delivery: sent/acked counts that halve every [deliveryHalfLife], read
+///   through a Beta prior so new or long-idle links converge to
+///   [priorDeliveryRatio] instead of 0 or 1.
+/// - Signal: EWMA of normalized strength plus an EWMA of its deltas (trend).
+/// - Encounters: EWMA of the gap between link-ups, to predict when a
+///   neighbour that is out of range will be met again.
+///
+/// An ACK only arrives after both the frame and its ACK crossed the link, so
+/// [deliveryRatio] already estimates `df * dr` and [etx] is its inverse.
+class LinkEstimate {
+  static const Duration deliveryHalfLife = Duration(minutes: 30);
+  static const double priorDeliveryRatio = 0.9;
+  static const double _priorWeight = 2.0;
+  static const double _rttGain = 1 / 8;
+  static const double _rttVarGain = 1 / 4;
+  static const double _signalGain = 1 / 4;
+  static const double _encounterGain = 1 / 4;
+
+  /// Link-ups closer together than this are reconnects, not new encounters.
+  static const Duration minEncounterGap = Duration(minutes: 1);
+
+  /// RTT assumed for a link with no sample yet.
+  static const double defaultRttMs = 1000.0;
+
+  LinkEstimate({required DateTime firstSeen})
+    : lastSeen = firstSeen,
+      _decayedAt = firstSeen;
+
+  LinkEstimate._restore({
+    required this.lastSeen,
+    required DateTime decayedAt,
+    required double sent,
+    required double acked,
+    this.srttMs,
+    this.rttVarMs,
+    this.signal,
+    this.signalTrend = 0.0,
+    this.lastEncounter,
+    this.encounterIntervalMs,
+  }) : _sent = sent,
+       _acked = acked,
+       _decayedAt = decayedAt;
+
+  /// Smoothed round-trip time, `null` until the first sample.
+  double? srttMs;
+
+  /// Mean deviation of the round-trip time.
+  double? rttVarMs;
+
+  /// Smoothed signal strength in `[0, 1]`, `null` until the first sample.
+  double? signal;
+
+  /// Smoothed per-sample change of [signal]; negative while fading.
+  double signalTrend;
+
+  /// Last time anything was observed on this link.
+  DateTime lastSeen;
+
+  /// Start of the most recent encounter (link-up), if any.
+  DateTime? lastEncounter;
+
+  /// Smoothed gap between encounters, `null` until a second encounter.
+  double? encounterIntervalMs;
+
+  double _sent = 0.0;
+  double _acked = 0.0;
+  DateTime _decayedAt;
+
+  void recordSent(DateTime now) {
+    _decay(now);
+    _sent += 1;
+    lastSeen = now;
+  }
+
+  void recordAck(DateTime now, {double? rttMs}) {
+    _decay(now);
+    _acked += 1;
+    // An ACK for a frame sent before a restore may outnumber decayed sends.
+    if (_acked > _sent) _sent = _acked;
+    if (rttMs != null && rttMs >= 0) _recordRtt(rttMs);
+    lastSeen = now;
+  }
+
+  void recordSignal(DateTime now, double strength) {
+    final value = strength.clamp(0.0, 1.0).toDouble();
+    final previous = signal;
+    if (previous == null) {
+      signal = value;
+    } else {
+      final next = previous + _signalGain * (value - previous);
+      signalTrend += _signalGain * ((next - previous) - signalTrend);
+      signal = next;
+    }
+    lastSeen = now;
+  }
+
+  void recordEncounter(DateTime now) {
+    final previous = lastEncounter;
+    if (previous != null) {
+      final gapMs = now.difference(previous).inMilliseconds.toDouble();
+      if (gapMs < minEncounterGap.inMilliseconds) {
+        lastSeen = now;
+        return;
+      }
+      final interval = encounterIntervalMs;
+      encounterIntervalMs = interval == null
+          ? gapMs
+          : interval + _encounterGain * (gapMs - interval);
+    }
+    lastEncounter = now;
+    lastSeen = now;
+  }
+
+  /// Expected wait from [now] until the next encounter, `null` while there
+  /// is no interval estimate. Overdue neighbours predict one more interval.
+  Duration? predictedEncounterWait(DateTime now) {
+    final interval = encounterIntervalMs;
+    final last = lastEncounter;
+    if (interval == null || last == null) return null;
+    final elapsed = now.difference(last).inMilliseconds;
+    var waitMs = interval - elapsed;
+    if (waitMs <= 0) waitMs = interval;
+    return Duration(milliseconds: waitMs.round());
+  }
+
+  /// Decayed sends and ACKs, as of [now].
+  double sentAt(DateTime now) => _sent * _decayFactor(now);
+  double ackedAt(DateTime now) => _acked * _decayFactor(now);
+
+  /// Estimated probability that a frame and its ACK both get through.
+  double deliveryRatio([DateTime? now]) {
+    final factor = _decayFactor(now ?? DateTime.now());
+    final ratio =
+        (_acked * factor + priorDeliveryRatio * _priorWeight) /
+        (_sent * factor + _priorWeight);
+    return ratio.clamp(0.05, 1.0).toDouble();
+  }
+
+  /// Expected transmissions per delivered frame (1 is a perfect link).
+  double etx([DateTime? now]) => 1.0 / deliveryRatio(now);
+
+  /// Pessimistic RTT bound (`srtt + 4 * rttvar`) used to rank hops.
+  double rttBoundMs() {
+    final srtt = srttMs;
+    if (srtt == null) return defaultRttMs;
+    return srtt + 4 * (rttVarMs ?? 0.0);
+  }
+
+  /// Overall link score in `[0, 1]` combining delivery, RTT and signal.
+  double score([DateTime? now]) {
+    final delivery = deliveryRatio(now);
+    final latency = 1.0 - (rttBoundMs() / 5000.0).clamp(0.0, 1.0);
+    final strength = signal ?? 0.5;
+    final fading = signalTrend < 0 ? (-signalTrend * 2).clamp(0.0, 0.2) : 0.0;
+    return (delivery * 0.5 + latency * 0.25 + (strength - fading) * 0.25)
+        .clamp(0.0, 1.0)
+        .toDouble();
+  }
+
+  Map<String, dynamic> toJson() => {
+    'ls': lastSeen.millisecondsSinceEpoch,
+    'da': _decayedAt.millisecondsSinceEpoch,
+    's': _round(_sent),
+    'a': _round(_acked),
+    if (srttMs != null) 'rt': _round(srttMs!),
+    if (rttVarMs != null) 'rv': _round(rttVarMs!),
+    if (signal != null) 'sg': _round(signal!),
+    if (signalTrend != 0) 'st': _round(signalTrend),
+    if (lastEncounter != null) 'le': lastEncounter!.millisecondsSinceEpoch,
+    if (encounterIntervalMs != null) 'ei': encounterIntervalMs!.round(),
+  };
+
+  static LinkEstimate? fromJson(Map<String, dynamic> json) {
+    final lastSeen = json['ls'];
+    final decayedAt = json['da'];
+    if (lastSeen is! int || decayedAt is! int) return null;
+    return LinkEstimate._restore(
+      lastSeen: DateTime.fromMillisecondsSinceEpoch(lastSeen),
+      decayedAt: DateTime.fromMillisecondsSinceEpoch(decayedAt),
+      sent: (json['s'] as num?)?.toDouble() ?? 0.0,
+      acked: (json['a'] as num?)?.toDouble() ?? 0.0,
+      srttMs: (json['rt'] as num?)?.toDouble(),
+      rttVarMs: (json['rv'] as num?)?.toDouble(),
+      signal: (json['sg'] as num?)?.toDouble(),
+      signalTrend: (json['st'] as num?)?.toDouble() ?? 0.0,
+      lastEncounter: json['le'] is int
+          ? DateTime.fromMillisecondsSinceEpoch(json['le'] as int)
+          : null,
+      encounterIntervalMs: (json['ei'] as num?)?.toDouble(),
+    );
+  }
+
+  void _recordRtt(double rttMs) {
+    final srtt = srttMs;
+    if (srtt == null) {
+      srttMs = rttMs;
+      rttVarMs = rttMs / 2;
+      return;
+    }
+    rttVarMs =
+        (1 - _rttVarGain) * rttVarMs! + _rttVarGain * (srtt - rttMs).abs();
+    srttMs = (1 - _rttGain) * srtt + _rttGain * rttMs;
+  }
+
+  double _decayFactor(DateTime now) {
+    final elapsed = now.difference(_decayedAt).inMilliseconds;
+    if (elapsed <= 0) return 1.0;
+    return pow(0.5, elapsed / deliveryHalfLife.inMilliseconds).toDouble();
+  }
+
+  void _decay(DateTime now) {
+    final factor = _decayFactor(now);
+    _sent *= factor;
+    _acked *= factor;
+    if (now.isAfter(_decayedAt)) _decayedAt = now;
+  }
+
+  static double _round(double value) => (value * 1000).roundToDouble() / 1000;
+}
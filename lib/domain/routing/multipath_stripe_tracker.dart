@@ -0,0 +1,184 @@
+import 'package:logging/logging.dart';
+import '../models/mesh_relay_models.dart';
+import '../utils/string_extensions.dart';
+import 'routing_models.dart';
+
+/// Sends one block of a striped transfer through [nextHop].
+typedef StripeResend =
+    Future<void> Function(MeshRelayMessage stripe, String nextHop);
+
+/// Per-path progress feedback for striped (multipath) transfers.
+///
+/// The originator registers every transfer it stripes; block ACKs coming
+/// back from the destination feed two loops:
+///
+/// - Weights: each first hop keeps decayed sent/ACKed block counts, and
+///   [weightOf] scales a route's estimated capacity by its ACK ratio, so
+///   paths that fall behind get fewer blocks in later transfers.
+/// - Work stealing: when a path has every block of a transfer ACKed while
+///   another still has two or more outstanding, the last of those is resent
+///   through the faster path. The destination drops whichever copy is late.
+class MultipathStripeTracker {
+  static final _logger = Logger('MultipathStripeTracker');
+
+  static final MultipathStripeTracker instance = MultipathStripeTracker();
+
+  static const int maxTrackedTransfers = 16;
+
+  /// Sent-block count at which a path's counters are halved
+  static const double _decayAt = 32;
+
+  final Map<String, _PathProgress> _paths = {};
+  final Map<String, _OutgoingTransfer> _transfers = {};
+
+  /// [route]'s capacity scaled by how well its first hop ACKs blocks
+  double weightOf(MultipathRoute route) {
+    final progress = _paths[route.firstHop];
+    if (progress == null) return route.capacity;
+    return route.capacity * (progress.acked + 1) / (progress.sent + 1);
+  }
+
+  /// Assign [blockCount] blocks to first hops in proportion to [weights]
+  /// using smooth weighted round-robin, which interleaves the paths instead
+  /// of sending each path's share back to back.
+  static Map<String, List<int>> assignBlocks(
+    Map<String, double> weights,
+    int blockCount,
+  ) {
+    final assignment = {for (final hop in weights.keys) hop: <int>[]};
+    if (weights.isEmpty) return assignment;
+    final total = weights.values.fold<double>(0, (sum, w) => sum + w);
+    final current = {for (final hop in weights.keys) hop: 0.0};
+    for (var block = 0; block < blockCount; block++) {
+      String? best;
+      for (final hop in weights.keys) {
+        current[hop] = current[hop]! + weights[hop]!;
+        if (best == null || current[hop]! > current[best]!) best = hop;
+      }
+      current[best!] = current[best]! - total;
+      assignment[best]!.add(block);
+    }
+    return assignment;
+  }
+
+  /// Track a transfer whose [blocks] were sent through the first hop paired
+  /// with each; [resend] moves a block to another path.
+  void registerTransfer({
+    required String transferId,
+    required int dataBlocks,
+    required Map<int, (MeshRelayMessage, String)> blocks,
+    required StripeResend resend,
+  }) {
+    while (_transfers.length >= maxTrackedTransfers) {
+      _transfers.remove(_transfers.keys.first);
+    }
+    _transfers[transferId] = _OutgoingTransfer(
+      dataBlocks: dataBlocks,
+      blocks: {for (final e in blocks.entries) e.key: e.value.$1},
+      assignment: {for (final e in blocks.entries) e.key: e.value.$2},
+      resend: resend,
+    );
+    for (final (_, hop) in blocks.values) {
+      _progressFor(hop).recordSent();
+    }
+  }
+
+  /// Feed a delivered relay ACK for [messageId]; ignores anything that is
+  /// not a block of a transfer this node is striping.
+  Future<void> recordAck(String messageId) async {
+    final separator = messageId.lastIndexOf('#');
+    if (separator <= 0) return;
+    final transferId = messageId.substring(0, separator);
+    final transfer = _transfers[transferId];
+    final index = int.tryParse(messageId.substring(separator + 1));
+    if (transfer == null || index == null) return;
+
+    final hop = transfer.assignment[index];
+    if (hop == null || !transfer.acked.add(index)) return;
+    _progressFor(hop).recordAck();
+
+    if (transfer.acked.length >= transfer.dataBlocks) {
+      _transfers.remove(transferId);
+      _logger.fine('🔀 Striped transfer ${transferId.shortId()}... complete');
+      return;
+    }
+
+    final stolen = transfer.stealFor(hop);
+    if (stolen == null) return;
+    final truncatedHop = hop.length > 8 ? hop.shortId(8) : hop;
+    _logger.info(
+      '🔀 Rebalancing block $stolen of ${transferId.shortId()}... '
+      'to faster path $truncatedHop...',
+    );
+    _progressFor(hop).recordSent();
+    try {
+      await transfer.resend(transfer.blocks[stolen]!, hop);
+    } catch (e) {
+      _logger.warning('Failed to resend stripe block: $e');
+    }
+  }
+
+  int get trackedTransfers => _transfers.length;
+
+  void clear() {
+    _paths.clear();
+    _transfers.clear();
+  }
+
+  _PathProgress _progressFor(String hop) =>
+      _paths.putIfAbsent(hop, _PathProgress.new);
+}
+
+class _PathProgress {
+  double sent = 0;
+  double acked = 0;
+
+  void recordSent() {
+    sent += 1;
+    if (sent >= MultipathStripeTracker._decayAt) {
+      sent /= 2;
+      acked /= 2;
+    }
+  }
+
+  void recordAck() {
+    acked += 1;
+    if (acked > sent) sent = acked;
+  }
+}
+
+class _OutgoingTransfer {
+  _OutgoingTransfer({
+    required this.dataBlocks,
+    required this.blocks,
+    required this.assignment,
+    required this.resend,
+  });
+
+  final int dataBlocks;
+  final Map<int, MeshRelayMessage> blocks;
+  final Map<int, String> assignment;
+  final StripeResend resend;
+  final Set<int> acked = {};
+
+  /// Reassign one outstanding block to [fastHop] once it has nothing left
+  /// in flight, taking from the path with the most outstanding blocks.
+  int? stealFor(String fastHop) {
+    final outstanding = <String, List<int>>{};
+    for (final entry in assignment.entries) {
+      if (acked.contains(entry.key)) continue;
+      outstanding.putIfAbsent(entry.value, () => []).add(entry.key);
+    }
+    if (outstanding.containsKey(fastHop)) return null;
+
+    List<int>? slowest;
+    for (final blocks in outstanding.values) {
+      if (slowest == null || blocks.length > slowest.length) slowest = blocks;
+    }
+    if (slowest == null || slowest.length < 2) return null;
+
+    final block = slowest.last;
+    assignment[block] = fastHop;
+    return block;
+  }
+}
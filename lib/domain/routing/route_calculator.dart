@@ -1,12 +1,22 @@
 import 'dart:collection';
 import 'package:logging/logging.dart';
+import 'connection_quality_monitor.dart';
 import 'routing_models.dart';
 import '../utils/string_extensions.dart';
 
 /// Calculates optimal routes through the mesh network
+///
+/// With a [ConnectionQualityMonitor], the first hop of every route (from this
+/// node to a neighbour) uses measured link reliability and RTT instead of the
+/// topology's coarse quality bucket.
 class RouteCalculator {
   static final _logger = Logger('RouteCalculator');
 
+  final ConnectionQualityMonitor? _qualityMonitor;
+
+  RouteCalculator({ConnectionQualityMonitor? qualityMonitor})
+    : _qualityMonitor = qualityMonitor;
+
   final Map<String, List<MessageRoute>> _routeCache = {};
   final Map<String, DateTime> _cacheExpiry = {};
   static const Duration _cacheTimeout = Duration(minutes: 5);
@@ -44,8 +54,8 @@ class RouteCalculator {
             hops: [from, to],
             score: _calculateDirectScore(from, to, topology),
             quality: _getDirectQuality(from, to, topology),
-            estimatedLatency: 500, // Direct connection latency
-            reliability: 0.95,
+            estimatedLatency: _withFirstHopLatency(to, 500),
+            reliability: _linkReliability(to) ?? 0.95,
           ),
         );
         _logger.info('Direct route available');
@@ -60,7 +70,7 @@ class RouteCalculator {
             hops: [from, hop, to],
             score: _calculateSingleHopScore(from, hop, to, topology),
             quality: _getSingleHopQuality(from, hop, to, topology),
-            estimatedLatency: 1000, // Single hop relay latency
+            estimatedLatency: _withFirstHopLatency(hop, 1000),
             reliability: _calculateSingleHopReliability(
               from,
               hop,
@@ -135,7 +145,10 @@ class RouteCalculator {
           hops: completePath,
           score: _calculateMultiHopScore(completePath, topology),
           quality: _getMultiHopQuality(completePath, topology),
-          estimatedLatency: completePath.length * 800,
+          estimatedLatency: _withFirstHopLatency(
+            completePath[1],
+            completePath.length * 800,
+          ),
           reliability: _calculateMultiHopReliability(completePath, topology),
         );
         routes.add(route);
@@ -302,7 +315,8 @@ class RouteCalculator {
     final firstQuality = topology.getConnectionQuality(from, hop);
     final secondQuality = topology.getConnectionQuality(hop, to);
 
-    final firstReliability = _qualityToReliability(firstQuality);
+    final firstReliability =
+        _linkReliability(hop) ?? _qualityToReliability(firstQuality);
     final secondReliability = _qualityToReliability(secondQuality);
 
     // Combined reliability is the product of individual reliabilities
@@ -320,13 +334,25 @@ class RouteCalculator {
 
     for (int i = 0; i < path.length - 1; i++) {
       final quality = topology.getConnectionQuality(path[i], path[i + 1]);
-      final reliability = _qualityToReliability(quality);
+      final measured = i == 0 ? _linkReliability(path[1]) : null;
+      final reliability = measured ?? _qualityToReliability(quality);
       totalReliability *= reliability;
     }
 
     return totalReliability;
   }
 
+  /// Measured delivery ratio of this node's link to [neighbour], if known
+  double? _linkReliability(String neighbour) =>
+      _qualityMonitor?.getLinkEstimate(neighbour)?.deliveryRatio();
+
+  /// Replace the ~500 ms first-hop share of [estimate] with the measured RTT
+  int _withFirstHopLatency(String neighbour, int estimate) {
+    final srtt = _qualityMonitor?.getLinkEstimate(neighbour)?.srttMs;
+    if (srtt == null) return estimate;
+    return (estimate - 500 + srtt).round().clamp(0, 60000);
+  }
+
   /// Convert connection quality to reliability score
   double _qualityToReliability(ConnectionQuality? quality) {
     switch (quality) {
@@ -124,6 +124,44 @@ class MessageRoute {
   );
 }
 
+/// One of several node-disjoint routes used together to stripe a transfer
+class MultipathRoute {
+  final MessageRoute route;
+
+  /// Estimated deliveries per second through this route's first hop
+  final double capacity;
+
+  const MultipathRoute({required this.route, required this.capacity});
+
+  String get firstHop => route.hops[1];
+
+  /// Pick up to [maxPaths] routes from [ranked] (best first) that share no
+  /// node besides the endpoints, so one slow or lost relay stalls only its
+  /// own share of the stripes.
+  static List<MultipathRoute> selectDisjoint(
+    List<MessageRoute> ranked, {
+    required double Function(MessageRoute route) capacityOf,
+    int maxPaths = 3,
+  }) {
+    final used = <String>{};
+    final selected = <MultipathRoute>[];
+    for (final route in ranked) {
+      if (selected.length >= maxPaths) break;
+      if (route.hops.length < 2) continue;
+      // Every node after the source; a direct route's only entry is the
+      // destination itself, which no relay route uses as a first hop.
+      final nodes = route.hops.sublist(1, route.hops.length - 1);
+      final firstHop = route.hops[1];
+      if (used.contains(firstHop) || nodes.any(used.contains)) continue;
+      used
+        ..add(firstHop)
+        ..addAll(nodes);
+      selected.add(MultipathRoute(route: route, capacity: capacityOf(route)));
+    }
+    return selected;
+  }
+}
+
 /// Quality levels for routes
 enum RouteQuality { excellent, good, fair, poor, unusable }
 
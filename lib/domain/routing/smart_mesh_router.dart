@@ -143,6 +143,54 @@ class SmartMeshRouter {
     }
   }
 
+  /// Determine node-disjoint routes for striping one large transfer.
+  ///
+  /// Routes are ranked like [determineOptimalRoute] and each carries an
+  /// estimated capacity: route reliability over the first hop's expected
+  /// time per delivery (ETX x RTT). Returns fewer than two routes when the
+  /// destination is reachable through only one neighbour.
+  Future<List<MultipathRoute>> determineMultipathRoutes({
+    required String finalRecipient,
+    required List<String> availableHops,
+    required MessagePriority priority,
+    int maxPaths = 3,
+  }) async {
+    try {
+      await _updateTopologyWithCurrentHops(availableHops);
+
+      final routes = await _routeCalculator.calculateRoutes(
+        from: _currentNodeId,
+        to: finalRecipient,
+        availableHops: availableHops,
+        topology: _topologyAnalyzer.getNetworkTopology(),
+        maxHops: _getMaxHopsForPriority(priority),
+      );
+      if (routes.length < 2) return const [];
+
+      final ranked = await _scoreRoutes(routes)
+        ..sort(
+          (a, b) =>
+              _calculateBalancedScore(b).compareTo(_calculateBalancedScore(a)),
+        );
+      final paths = MultipathRoute.selectDisjoint(
+        ranked,
+        capacityOf: (route) =>
+            route.reliability *
+            1000 /
+            _qualityMonitor.getLinkCost(route.hops[1]),
+        maxPaths: maxPaths,
+      );
+
+      _logger.info(
+        '🔀 ${paths.length} disjoint route(s) to ${finalRecipient.shortId(8)}...',
+      );
+      return paths;
+    } catch (e) {
+      _logger.warning('Multipath route determination failed: $e');
+      return const [];
+    }
+  }
+
   /// Update network topology with current hop information
   Future<void> _updateTopologyWithCurrentHops(
     List<String> availableHops,
@@ -417,11 +465,13 @@ class SmartMeshRouter {
   }
 
   /// Clear all caches and reset state
+  ///
+  /// Link estimates stay: the quality monitor is shared with relay
+  /// selection and custody, and the router does not own it.
   Future<void> clearAll() async {
     _decisionCache.clear();
     _cacheExpiry.clear();
     _routeCalculator.clearCache();
-    _qualityMonitor.clearAll();
     _logger.info('Smart Mesh Router state cleared');
   }
 
@@ -429,7 +479,6 @@ class SmartMeshRouter {
   void dispose() {
     _maintenanceTimer?.cancel();
     _topologyAnalyzer.dispose();
-    _qualityMonitor.dispose();
     clearAll();
     _logger.info('Smart Mesh Router disposed');
   }
@@ -0,0 +1,39 @@
+import 'package:logging/logging.dart';
+
+import '../models/connection_info.dart';
+import '../models/connection_status.dart';
+import '../models/spy_mode_info.dart';
+import 'typed_event_bus.dart';
+
+/// Channels of the app-level [TypedEventBus].
+///
+/// The composition root registers every channel once; owners and
+/// subscribers look them up by name, so one [TypedEventBus.stats] covers all
+/// of them.
+abstract final class AppEventChannels {
+  static const connectionInfo = 'ble.connectionInfo';
+  static const hintMatch = 'ble.hintMatch';
+  static const spyMode = 'ble.spyMode';
+  static const identityRevealed = 'ble.identityRevealed';
+  static const connectionStatus = 'chat.connectionStatus';
+
+  static void registerAll(TypedEventBus bus) {
+    bus
+      ..register<ConnectionInfo>(connectionInfo)
+      ..register<String>(hintMatch)
+      ..register<SpyModeInfo>(spyMode)
+      ..register<String>(identityRevealed)
+      ..register<ConnectionStatus>(connectionStatus);
+  }
+
+  /// A bus with every channel registered; owners built without the app bus
+  /// (tests, background wakeups) use a private one.
+  static TypedEventBus createBus({
+    Logger? logger,
+    FrameScheduler? scheduleFrame,
+  }) {
+    final bus = TypedEventBus(logger: logger, scheduleFrame: scheduleFrame);
+    registerAll(bus);
+    return bus;
+  }
+}
@@ -2,6 +2,7 @@
 // Runs periodically based on user settings and archives chats with no recent activity
 
 import 'dart:async';
+import 'dart:math' as math;
 import 'package:logging/logging.dart';
 import '../interfaces/i_chats_repository.dart';
 import '../interfaces/i_preferences_repository.dart';
@@ -18,6 +19,13 @@ class AutoArchiveScheduler {
   static IPreferencesRepository? _preferencesRepository;
   static IChatsRepository? _chatsRepository;
   static ArchiveManagementService? _archiveManagementService;
+  static Future<int>? _activeCheck;
+
+  /// Bumped by [stop] so an in-flight sweep ends after its current chunk
+  static int _generation = 0;
+
+  /// Chats archived before yielding back to the event loop
+  static const int archiveChunkSize = 25;
 
   /// Configure required dependencies from the app composition root.
   static void configure({
@@ -85,6 +93,7 @@ class AutoArchiveScheduler {
 
   /// Stop the auto-archive scheduler
   static void stop() {
+    _generation++;
     _checkTimer?.cancel();
     _checkTimer = null;
     _isRunning = false;
@@ -109,8 +118,15 @@ class AutoArchiveScheduler {
   static bool get isRunning => _isRunning;
   static DateTime? get lastCheckTime => _lastCheckTime;
 
-  /// Internal method to check and archive inactive chats
-  static Future<int> _checkAndArchiveInactiveChats() async {
+  /// Internal method to check and archive inactive chats. Runs are
+  /// single-flight: a timer tick during a long sweep joins it.
+  static Future<int> _checkAndArchiveInactiveChats() {
+    return _activeCheck ??= _runCheck().whenComplete(() {
+      _activeCheck = null;
+    });
+  }
+
+  static Future<int> _runCheck() async {
     try {
       _logger.info('Starting auto-archive check...');
       _lastCheckTime = DateTime.now();
@@ -143,64 +159,31 @@ class AutoArchiveScheduler {
         'Checking for chats inactive since: $cutoffDate ($archiveAfterDays days ago)',
       );
 
-      // Get all chats
-      final allChats = await chatsRepo.getAllChats();
-
+      final generation = _generation;
       int archivedCount = 0;
       final List<String> archivedChatNames = [];
 
-      for (final chat in allChats) {
-        // Skip if no last message time (shouldn't happen, but be safe)
-        if (chat.lastMessageTime == null) {
-          _logger.fine('Skipping ${chat.contactName}: no last message time');
-          continue;
-        }
-
-        // Skip if recently active
-        if (chat.lastMessageTime!.isAfter(cutoffDate)) {
-          _logger.fine(
-            'Skipping ${chat.contactName}: active within $archiveAfterDays days',
-          );
-          continue;
-        }
-
-        // Calculate days inactive
-        final daysInactive = DateTime.now()
-            .difference(chat.lastMessageTime!)
-            .inDays;
-
-        _logger.info(
-          'Found inactive chat: ${chat.contactName} ($daysInactive days inactive)',
-        );
-
-        // Archive this inactive chat
-        try {
-          final result = await archiveService.archiveChat(
-            chatId: chat.chatId.value,
-            reason: 'Auto-archived after $daysInactive days of inactivity',
-            metadata: {
-              'auto_archived': true,
-              'last_activity': chat.lastMessageTime!.toIso8601String(),
-              'archived_at': DateTime.now().toIso8601String(),
-              'days_inactive': daysInactive,
-              'archive_threshold_days': archiveAfterDays,
-            },
-          );
-
-          if (result.success) {
+      await for (final chunk in _inactiveChatChunks(chatsRepo, cutoffDate)) {
+        for (final chat in chunk) {
+          if (await _archiveInactiveChat(
+            archiveService,
+            chat,
+            archiveAfterDays,
+          )) {
             archivedCount++;
             archivedChatNames.add(chat.contactName);
-            _logger.info(
-              '✅ Auto-archived: ${chat.contactName} (inactive for $daysInactive days)',
-            );
-          } else {
-            _logger.warning(
-              '❌ Failed to auto-archive ${chat.contactName}: ${result.message}',
-            );
           }
-        } catch (e) {
-          _logger.warning('❌ Error auto-archiving ${chat.contactName}: $e');
         }
+
+        if (generation != _generation) {
+          // Archived chats leave the index, so the next run resumes here.
+          _logger.info(
+            '⏸️ Auto-archive interrupted after $archivedCount chats',
+          );
+          break;
+        }
+        // Yield between chunks so frames keep rendering during long sweeps.
+        await Future<void>.delayed(Duration.zero);
       }
 
       if (archivedCount > 0) {
@@ -216,4 +199,91 @@ class AutoArchiveScheduler {
       return 0;
     }
   }
+
+  /// Inactive chats in archive-sized chunks, oldest first. Uses the
+  /// last-activity index when the repository has one, so a run only reads
+  /// chats that are due rather than the whole chat list.
+  static Stream<List<InactiveChat>> _inactiveChatChunks(
+    IChatsRepository chatsRepo,
+    DateTime cutoff,
+  ) async* {
+    if (chatsRepo is IChatActivityIndex) {
+      ChatActivityCursor? cursor;
+      while (true) {
+        final chunk = await chatsRepo.getChatsInactiveSince(
+          cutoff,
+          after: cursor,
+          limit: archiveChunkSize,
+        );
+        if (chunk.isEmpty) return;
+        yield chunk;
+        if (chunk.length < archiveChunkSize) return;
+        // Keyset cursor: chats that failed to archive are not re-read.
+        cursor = (
+          lastMessageTime: chunk.last.lastMessageTime,
+          chatId: chunk.last.chatId,
+        );
+      }
+    }
+
+    final allChats = await chatsRepo.getAllChats();
+    final inactive = <InactiveChat>[
+      for (final chat in allChats)
+        if (chat.lastMessageTime case final lastMessageTime?
+            when !lastMessageTime.isAfter(cutoff))
+          (
+            chatId: chat.chatId,
+            contactName: chat.contactName,
+            lastMessageTime: lastMessageTime,
+          ),
+    ]..sort((a, b) => a.lastMessageTime.compareTo(b.lastMessageTime));
+
+    for (var i = 0; i < inactive.length; i += archiveChunkSize) {
+      yield inactive.sublist(
+        i,
+        math.min(i + archiveChunkSize, inactive.length),
+      );
+    }
+  }
+
+  static Future<bool> _archiveInactiveChat(
+    ArchiveManagementService archiveService,
+    InactiveChat chat,
+    int archiveAfterDays,
+  ) async {
+    final daysInactive = DateTime.now()
+        .difference(chat.lastMessageTime)
+        .inDays;
+
+    _logger.info(
+      'Found inactive chat: ${chat.contactName} ($daysInactive days inactive)',
+    );
+
+    try {
+      final result = await archiveService.archiveChat(
+        chatId: chat.chatId.value,
+        reason: 'Auto-archived after $daysInactive days of inactivity',
+        metadata: {
+          'auto_archived': true,
+          'last_activity': chat.lastMessageTime.toIso8601String(),
+          'archived_at': DateTime.now().toIso8601String(),
+          'days_inactive': daysInactive,
+          'archive_threshold_days': archiveAfterDays,
+        },
+      );
+
+      if (result.success) {
+        _logger.info(
+          '✅ Auto-archived: ${chat.contactName} (inactive for $daysInactive days)',
+        );
+        return true;
+      }
+      _logger.warning(
+        '❌ Failed to auto-archive ${chat.contactName}: ${result.message}',
+      );
+    } catch (e) {
+      _logger.warning('❌ Error auto-archiving ${chat.contactName}: $e');
+    }
+    return false;
+  }
 }
@@ -35,7 +35,8 @@ import 'notification_navigation_service.dart';
 ///   body: 'World',
 /// );
 /// ```
-class BackgroundNotificationHandlerImpl implements INotificationHandler {
+class BackgroundNotificationHandlerImpl
+    implements INotificationHandler, IMessageDigestNotificationHandler {
   static final _logger = Logger('BackgroundNotificationHandlerImpl');
 
   /// Flutter local notifications plugin instance
@@ -172,18 +173,40 @@ class BackgroundNotificationHandlerImpl implements INotificationHandler {
     String? contactAvatar,
     String? contactPublicKey,
   }) async {
+    await _showConversation(
+      MessageNotificationDigest(
+        contactName: contactName,
+        contactAvatar: contactAvatar,
+        contactPublicKey: contactPublicKey,
+        messageCount: 1,
+        recentMessages: [message],
+      ),
+    );
+  }
+
+  @override
+  Future<void> showMessageDigestNotification(
+    MessageNotificationDigest digest,
+  ) => _showConversation(digest);
+
+  /// Post (or update in place) the chat's conversation notification.
+  /// The ID is keyed by chat so later digests replace earlier ones.
+  Future<void> _showConversation(MessageNotificationDigest digest) async {
     if (!_isInitialized) return;
 
+    final contactName = digest.contactName;
+    final latest = digest.latest;
     try {
       // Use messaging style for Android
       final messagingStyle = MessagingStyleInformation(
         Person(name: 'You'),
         messages: [
-          Message(
-            message.content,
-            message.timestamp,
-            Person(name: contactName),
-          ),
+          for (final message in digest.recentMessages)
+            Message(
+              message.content,
+              message.timestamp,
+              Person(name: contactName),
+            ),
         ],
         conversationTitle: contactName,
         groupConversation: false,
@@ -202,6 +225,9 @@ class BackgroundNotificationHandlerImpl implements INotificationHandler {
         enableVibration: true,
         visibility: NotificationVisibility.private,
         showWhen: true,
+        number: digest.messageCount,
+        // Re-posting a digest updates the existing notification silently.
+        onlyAlertOnce: true,
       );
 
       const iosDetails = DarwinNotificationDetails(
@@ -216,19 +242,24 @@ class BackgroundNotificationHandlerImpl implements INotificationHandler {
       );
 
       await _notificationsPlugin.show(
-        id: 'msg_${message.id}'.hashCode,
-        title: contactName,
-        body: message.content,
+        id: digest.notificationId.hashCode,
+        title: digest.messageCount > 1
+            ? '$contactName (${digest.messageCount})'
+            : contactName,
+        body: latest.content,
         notificationDetails: platformDetails,
         payload: jsonEncode({
           'type': 'message',
-          'chatId': message.chatId,
+          'chatId': latest.chatId.value,
           'contactName': contactName,
-          'contactPublicKey': contactPublicKey ?? '',
+          'contactPublicKey': digest.contactPublicKey ?? '',
         }),
       );
 
-      _logger.fine('Message notification shown from $contactName');
+      _logger.fine(
+        'Message notification shown from $contactName '
+        '(${digest.messageCount} message(s))',
+      );
     } catch (e, stackTrace) {
       _logger.severe('Failed to show message notification', e, stackTrace);
     }
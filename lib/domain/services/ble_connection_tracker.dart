@@ -1,5 +1,7 @@
 import 'package:logging/logging.dart';
 
+import 'mesh/mesh_metrics_history.dart';
+
 /// Centralized tracker for all BLE connections (client + server).
 /// Mirrors BitChat’s “first link wins” pattern so scanners can avoid
 /// initiating a second connection to the same device.
@@ -126,6 +128,7 @@ class BleConnectionTracker {
     // Success: clear pending attempt tracking for this address
     _pendingAttempts.remove(address);
     _disconnectCooldownUntil.remove(address);
+    _recordLinkCount();
     _logger.fine(
       '🔗 Tracked connection: ${_format(address)} (${isClient ? "client" : "server"})',
     );
@@ -136,11 +139,18 @@ class BleConnectionTracker {
     if (removed != null) {
       _logger.fine('🧹 Removed tracked connection: ${_format(address)}');
       markDisconnectCooldown(address);
+      _recordLinkCount();
     }
   }
 
+  void _recordLinkCount() => MeshMetricsHistory.instance.record(
+    MeshMetricsHistory.linkCount,
+    _connections.length.toDouble(),
+  );
+
   void clear({bool preserveDisconnectCooldowns = false}) {
     _connections.clear();
+    _recordLinkCount();
     _pendingAttempts.clear();
     if (!preserveDisconnectCooldowns) {
       _disconnectCooldownUntil.clear();
@@ -13,6 +13,7 @@ import 'archive_management_service.dart';
 import 'chat_management_models.dart';
 import 'chat_notification_service.dart';
 import 'chat_sync_service.dart';
+import 'notification_service.dart';
 
 import 'package:pak_connect/domain/values/id_types.dart';
 
@@ -95,6 +96,11 @@ class ChatLifecycleService {
     required List<MessageId> messageIds,
     bool deleteForEveryone = false,
   }) async {
+    final repository = _messageRepository;
+    if (repository is IBulkMessageOperations) {
+      return _deleteMessagesInBulk(repository, messageIds);
+    }
+
     try {
       int successCount = 0;
       int failureCount = 0;
@@ -148,6 +154,39 @@ class ChatLifecycleService {
     }
   }
 
+  /// One transaction for the whole selection instead of a scan of every
+  /// chat per message
+  Future<ChatOperationResult> _deleteMessagesInBulk(
+    IBulkMessageOperations repository,
+    List<MessageId> messageIds,
+  ) async {
+    try {
+      final deleted = await repository.deleteMessagesByIds(messageIds);
+      _cacheState.starredMessageIds.removeAll(deleted.keys);
+      if (deleted.isNotEmpty) {
+        await _syncService.saveStarredMessages();
+      }
+      for (final MapEntry(key: messageId, value: chatId) in deleted.entries) {
+        _notificationService.emitMessageUpdate(
+          MessageUpdateEvent.deleted(messageId, chatId),
+        );
+      }
+
+      final successCount = deleted.length;
+      final failureCount = messageIds.toSet().length - successCount;
+      if (failureCount == 0) {
+        return ChatOperationResult.success(
+          '$successCount message${successCount > 1 ? 's' : ''} deleted',
+        );
+      }
+      return ChatOperationResult.partial(
+        '$successCount deleted, $failureCount failed',
+      );
+    } catch (e) {
+      return ChatOperationResult.failure('Delete operation failed: $e');
+    }
+  }
+
   Future<ChatOperationResult> toggleChatArchive(
     String chatId, {
     String? reason,
@@ -241,23 +280,7 @@ class ChatLifecycleService {
 
   Future<ChatOperationResult> deleteChat(String chatId) async {
     try {
-      final chat = ChatId(chatId);
-      final chatMessages = await _messageRepository.getMessages(chat);
-      for (final message in chatMessages) {
-        _cacheState.starredMessageIds.remove(message.id);
-      }
-
-      await _messageRepository.clearMessages(chat);
-
-      _cacheState.archivedChats.remove(chat);
-      _cacheState.pinnedChats.remove(chat);
-
-      await _syncService.saveArchivedChats();
-      await _syncService.savePinnedChats();
-      await _syncService.saveStarredMessages();
-
-      _notificationService.emitChatUpdate(ChatUpdateEvent.deleted(chat));
-
+      await _deleteChats([ChatId(chatId)]);
       return ChatOperationResult.success('Chat deleted');
     } catch (e) {
       return ChatOperationResult.failure('Failed to delete chat: $e');
@@ -285,6 +308,106 @@ class ChatLifecycleService {
     }
   }
 
+  /// Delete several chats and all their messages in one transaction
+  Future<ChatOperationResult> deleteChats(List<String> chatIds) async {
+    try {
+      final chats = [for (final id in chatIds) ChatId(id)];
+      await _deleteChats(chats);
+      return ChatOperationResult.success('${chats.length} chats deleted');
+    } catch (e) {
+      return ChatOperationResult.failure('Failed to delete chats: $e');
+    }
+  }
+
+  /// Shared by [deleteChat] and [deleteChats] so one chat and a selection
+  /// leave the same state behind: chat rows and messages removed together
+  /// and the chats dropped from the archive, pin and star caches.
+  /// Repositories without [IBulkChatOperations] cannot remove chat rows, so
+  /// only their messages are cleared.
+  Future<void> _deleteChats(List<ChatId> chats) async {
+    final repository = _chatsRepository;
+    final deletedMessages = <MessageId>[];
+    if (repository is IBulkChatOperations) {
+      deletedMessages.addAll(await repository.deleteChats(chats));
+    } else {
+      for (final chat in chats) {
+        final chatMessages = await _messageRepository.getMessages(chat);
+        deletedMessages.addAll(chatMessages.map((message) => message.id));
+        await _messageRepository.clearMessages(chat);
+      }
+    }
+
+    _cacheState.starredMessageIds.removeAll(deletedMessages);
+    _cacheState.archivedChats.removeAll(chats);
+    _cacheState.pinnedChats.removeAll(chats);
+    await _syncService.saveArchivedChats();
+    await _syncService.savePinnedChats();
+    await _syncService.saveStarredMessages();
+
+    for (final chat in chats) {
+      _notificationService.emitChatUpdate(ChatUpdateEvent.deleted(chat));
+    }
+  }
+
+  /// Clear the messages of several chats in one transaction
+  Future<ChatOperationResult> clearChatsMessages(List<String> chatIds) async {
+    final repository = _messageRepository;
+    if (repository is! IBulkMessageOperations) {
+      return _perChat(chatIds, clearChatMessages, 'cleared');
+    }
+
+    try {
+      final chats = [for (final id in chatIds) ChatId(id)];
+      final deleted = await repository.clearMessagesForChats(chats);
+
+      if (_cacheState.starredMessageIds.isNotEmpty) {
+        _cacheState.starredMessageIds.removeAll(deleted);
+        await _syncService.saveStarredMessages();
+      }
+      for (final chat in chats) {
+        _notificationService.emitChatUpdate(
+          ChatUpdateEvent.messagesCleared(chat),
+        );
+      }
+      return ChatOperationResult.success('${chats.length} chats cleared');
+    } catch (e) {
+      return ChatOperationResult.failure('Failed to clear messages: $e');
+    }
+  }
+
+  /// Reset unread counts of several chats with one statement
+  Future<ChatOperationResult> markChatsAsRead(List<ChatId> chatIds) async {
+    try {
+      final repository = _chatsRepository;
+      if (repository is IBulkChatOperations) {
+        await repository.markChatsAsRead(chatIds);
+      } else {
+        for (final chatId in chatIds) {
+          await repository.markChatAsRead(chatId);
+        }
+      }
+      chatIds.forEach(NotificationService.clearMessageNotifications);
+      return ChatOperationResult.success('${chatIds.length} chats read');
+    } catch (e) {
+      return ChatOperationResult.failure('Failed to mark chats read: $e');
+    }
+  }
+
+  Future<ChatOperationResult> _perChat(
+    List<String> chatIds,
+    Future<ChatOperationResult> Function(String chatId) operation,
+    String verb,
+  ) async {
+    var failed = 0;
+    for (final chatId in chatIds) {
+      if (!(await operation(chatId)).success) failed++;
+    }
+    final done = chatIds.length - failed;
+    return failed == 0
+        ? ChatOperationResult.success('$done chats $verb')
+        : ChatOperationResult.partial('$done $verb, $failed failed');
+  }
+
   Future<ChatAnalytics> getChatAnalytics(String chatId) async {
     try {
       final chat = ChatId(chatId);
@@ -0,0 +1,32 @@
+import 'dart:async';
+
+import '../models/chat_list_model.dart';
+
+/// Process-wide stream of [ChatListEvent]s.
+///
+/// Repositories publish after each committed write that changes a chat
+/// row; chat list coordinators subscribe and patch their [ChatListModel]
+/// instead of re-running the full chat list query.
+class ChatListChangeFeed {
+  static ChatListChangeFeed? _instance;
+  static ChatListChangeFeed get instance =>
+      _instance ??= ChatListChangeFeed();
+
+  /// Replace the shared instance (tests).
+  static void configureInstance(ChatListChangeFeed feed) {
+    _instance?.dispose();
+    _instance = feed;
+  }
+
+  final StreamController<ChatListEvent> _controller =
+      StreamController.broadcast();
+
+  Stream<ChatListEvent> get events => _controller.stream;
+
+  void publish(ChatListEvent event) {
+    if (_controller.isClosed || !_controller.hasListener) return;
+    _controller.add(event);
+  }
+
+  void dispose() => _controller.close();
+}
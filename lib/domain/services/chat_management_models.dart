@@ -90,6 +90,27 @@ class MessageSearchResult {
     required this.hasMore,
   });
 
+  /// Build a result from matches in display order, grouped by chat
+  factory MessageSearchResult.fromResults({
+    required List<EnhancedMessage> results,
+    required String query,
+    required Duration searchTime,
+    bool hasMore = false,
+  }) {
+    final resultsByChat = <String, List<EnhancedMessage>>{};
+    for (final message in results) {
+      resultsByChat.putIfAbsent(message.chatId.value, () => []).add(message);
+    }
+    return MessageSearchResult(
+      results: results,
+      resultsByChat: resultsByChat,
+      query: query,
+      totalResults: results.length,
+      searchTime: searchTime,
+      hasMore: hasMore,
+    );
+  }
+
   factory MessageSearchResult.empty() => MessageSearchResult(
     results: [],
     resultsByChat: {},
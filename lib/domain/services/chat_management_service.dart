@@ -14,6 +14,7 @@ import 'chat_lifecycle_service.dart';
 import 'chat_management_models.dart';
 import 'chat_notification_service.dart';
 import 'chat_sync_service.dart';
+import 'search_session.dart';
 
 import 'package:pak_connect/domain/values/id_types.dart';
 
@@ -217,6 +218,25 @@ class ChatManagementService {
     limit: limit,
   );
 
+  /// Stream live search matches page by page (see [SearchSession])
+  Stream<List<EnhancedMessage>> streamMessageSearch({
+    required String query,
+    String? chatId,
+    MessageSearchFilter? filter,
+    SearchCancelToken? cancelToken,
+  }) => _syncService.streamMessageSearch(
+    query: query,
+    chatId: chatId,
+    filter: filter,
+    cancelToken: cancelToken,
+  );
+
+  bool messageMatchesQuery(EnhancedMessage message, String query) =>
+      _syncService.messageMatchesQuery(message, query);
+
+  void recordMessageSearch(String query) =>
+      _syncService.recordMessageSearch(query);
+
   /// Search messages across live and archived chats
   Future<UnifiedSearchResult> searchMessagesUnified({
     required String query,
@@ -272,6 +292,18 @@ class ChatManagementService {
   Future<ChatOperationResult> clearChatMessages(String chatId) =>
       _lifecycleService.clearChatMessages(chatId);
 
+  /// Delete several chats and their messages in one transaction
+  Future<ChatOperationResult> deleteChats(List<String> chatIds) =>
+      _lifecycleService.deleteChats(chatIds);
+
+  /// Clear the messages of several chats in one transaction
+  Future<ChatOperationResult> clearChatsMessages(List<String> chatIds) =>
+      _lifecycleService.clearChatsMessages(chatIds);
+
+  /// Mark several chats read with one statement
+  Future<ChatOperationResult> markChatsAsRead(List<ChatId> chatIds) =>
+      _lifecycleService.markChatsAsRead(chatIds);
+
   /// Get chat statistics and analytics
   Future<ChatAnalytics> getChatAnalytics(String chatId) =>
       _lifecycleService.getChatAnalytics(chatId);
@@ -9,6 +9,7 @@ import '../entities/archived_message.dart';
 import '../models/archive_models.dart';
 import 'archive_search_service.dart';
 import 'chat_management_models.dart';
+import 'search_session.dart';
 import '../values/id_types.dart';
 
 /// Handles cache persistence, search, and sync-related chat workflows
@@ -41,7 +42,8 @@ class ChatSyncService {
     if (_isInitialized) return;
 
     await _loadCachedData();
-    await _archiveSearchService.initialize();
+    // Archive search indexing is brought up on first search (or by AppCore's
+    // deferred init pass) so it stays off the chat list startup path.
 
     _isInitialized = true;
     _logger.info('ChatSyncService initialized');
@@ -148,6 +150,45 @@ class ChatSyncService {
     }
   }
 
+  /// Stream live-message matches one chat at a time, newest chats first
+  /// and newest messages first within each page. [cancelToken] is checked
+  /// before every chat is read, so a superseded search stops querying the
+  /// database. Unlike [searchMessages] this does not record history; call
+  /// [recordMessageSearch] when the user commits to a query.
+  Stream<List<EnhancedMessage>> streamMessageSearch({
+    required String query,
+    String? chatId,
+    MessageSearchFilter? filter,
+    SearchCancelToken? cancelToken,
+  }) async* {
+    if (query.trim().isEmpty) return;
+
+    final chatIds = chatId != null
+        ? [ChatId(chatId)]
+        : (await _chatsRepository.getAllChats()).map((chat) => chat.chatId);
+
+    for (final id in chatIds) {
+      if (cancelToken?.isCancelled ?? false) return;
+      final messages = await _messageRepository.getMessages(id);
+      var matches = _performMessageTextSearch(
+        messages.reversed.map(EnhancedMessage.fromMessage).toList(),
+        query,
+      );
+      if (filter != null) {
+        matches = _applyMessageSearchFilter(matches, filter);
+      }
+      if (matches.isNotEmpty) yield matches;
+    }
+  }
+
+  /// Whether [message] matches [query] under the live text search rules
+  bool messageMatchesQuery(EnhancedMessage message, String query) =>
+      _performMessageTextSearch([message], query).isNotEmpty;
+
+  void recordMessageSearch(String query) {
+    if (query.trim().isNotEmpty) _addToMessageSearchHistory(query);
+  }
+
   Future<UnifiedSearchResult> searchMessagesUnified({
     required String query,
     String? chatId,
@@ -195,6 +236,7 @@ class ChatSyncService {
       if (includeArchives) {
         try {
           final archiveFilter = _convertToArchiveFilter(filter, chatId);
+          await _archiveSearchService.initialize();
           final archiveSearchResult = await _archiveSearchService.search(
             query: query,
             filter: archiveFilter,
@@ -272,6 +314,7 @@ class ChatSyncService {
           filter: _convertFromArchiveFilter(filter),
           includeArchives: false,
         );
+        await _archiveSearchService.initialize();
         final archiveResult = await _archiveSearchService.search(
           query: query,
           filter: filter,
@@ -283,6 +326,7 @@ class ChatSyncService {
           query: query,
         );
       } else if (includeArchives) {
+        await _archiveSearchService.initialize();
         return await _archiveSearchService.search(
           query: query,
           filter: filter,
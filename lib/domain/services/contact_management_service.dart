@@ -235,7 +235,7 @@ class ContactManagementService {
       await _contactRepository.clearCachedSecrets(userId.value);
 
       // Remove from groups
-      await _removeContactFromAllGroups(userId);
+      await _removeContactsFromAllGroups({userId.value});
 
       // Delete the contact (this will require implementing delete in IContactRepository)
       await _deleteContactFromRepository(userId);
@@ -252,6 +252,11 @@ class ContactManagementService {
 
   /// Bulk delete contacts
   Future<BulkOperationResult> deleteContacts(List<String> publicKeys) async {
+    final repository = _contactRepository;
+    if (repository is IBulkContactOperations) {
+      return _deleteContactsInBulk(repository, publicKeys);
+    }
+
     int successCount = 0;
     int failureCount = 0;
     final List<String> failedDeletes = [];
@@ -274,6 +279,35 @@ class ContactManagementService {
     );
   }
 
+  /// One transaction for the whole selection; group membership is saved
+  /// once
+  Future<BulkOperationResult> _deleteContactsInBulk(
+    IBulkContactOperations repository,
+    List<String> publicKeys,
+  ) async {
+    try {
+      final deleted = (await repository.deleteContacts(publicKeys)).toSet();
+      await _removeContactsFromAllGroups(deleted);
+
+      final failed = publicKeys.where((key) => !deleted.contains(key));
+      _logger.info('Contacts deleted: ${deleted.length}/${publicKeys.length}');
+      return BulkOperationResult(
+        totalOperations: publicKeys.length,
+        successCount: deleted.length,
+        failureCount: failed.length,
+        failedItems: failed.toList(),
+      );
+    } catch (e) {
+      _logger.severe('Failed to delete contacts: $e');
+      return BulkOperationResult(
+        totalOperations: publicKeys.length,
+        successCount: 0,
+        failureCount: publicKeys.length,
+        failedItems: publicKeys,
+      );
+    }
+  }
+
   /// Get contact statistics and analytics
   Future<ContactAnalytics> getContactAnalytics() async {
     try {
@@ -583,10 +617,12 @@ class ContactManagementService {
   }
 
   /// Remove contact from all groups
-  Future<void> _removeContactFromAllGroups(UserId userId) async {
+  Future<void> _removeContactsFromAllGroups(Set<String> publicKeys) async {
     bool modified = false;
     for (final group in _contactGroups.values) {
-      if (group.memberPublicKeys.remove(userId.value)) {
+      final before = group.memberPublicKeys.length;
+      group.memberPublicKeys.removeAll(publicKeys);
+      if (group.memberPublicKeys.length != before) {
         group.lastModified = DateTime.now();
         modified = true;
       }
@@ -0,0 +1,206 @@
+import 'dart:async';
+
+import 'package:logging/logging.dart';
+import 'package:sqflite_sqlcipher/sqflite.dart';
+
+import '../interfaces/i_database_provider.dart';
+
+/// Cooperative cancellation checked between maintenance steps
+class MaintenanceCancelToken {
+  bool _cancelled = false;
+
+  bool get isCancelled => _cancelled;
+
+  void cancel() => _cancelled = true;
+}
+
+/// Outcome of one [DatabaseMaintenanceScheduler] run
+class MaintenanceRunReport {
+  /// Free pages returned to the file system by incremental vacuum
+  final int pagesReclaimed;
+
+  /// Free pages still in the file when the run ended
+  final int pagesRemaining;
+
+  /// The one-time full VACUUM switching to auto_vacuum=INCREMENTAL ran
+  final bool convertedToIncremental;
+  final bool optimized;
+  final bool cancelled;
+  final Duration elapsed;
+
+  const MaintenanceRunReport({
+    required this.pagesReclaimed,
+    required this.pagesRemaining,
+    required this.convertedToIncremental,
+    required this.optimized,
+    required this.cancelled,
+    required this.elapsed,
+  });
+
+  Map<String, dynamic> toJson() => {
+    'pages_reclaimed': pagesReclaimed,
+    'pages_remaining': pagesRemaining,
+    'converted_to_incremental': convertedToIncremental,
+    'optimized': optimized,
+    'cancelled': cancelled,
+    'elapsed_ms': elapsed.inMilliseconds,
+  };
+}
+
+/// Reclaims space left behind by deleted messages and archives.
+///
+/// Each run is time-boxed and cancellable between steps:
+/// 1. `PRAGMA incremental_vacuum` in small page batches until the free
+///    list is empty or [runBudget] is spent; the rest waits for next run.
+/// 2. `PRAGMA optimize` to refresh planner statistics.
+///
+/// The first run starts [startupDelay] after [start], then every
+/// [interval]. Databases created before auto_vacuum=INCREMENTAL need one
+/// full VACUUM for the mode to take effect. That rewrites the whole file,
+/// so it only runs when [canRunHeavyWork] reports the device idle and
+/// charging; while it is pending, [onConditionsChanged] re-checks on
+/// lifecycle and charging changes instead of waiting for the next tick.
+class DatabaseMaintenanceScheduler {
+  static final _logger = Logger('DatabaseMaintenanceScheduler');
+
+  static const Duration defaultInterval = Duration(hours: 6);
+  static const Duration defaultStartupDelay = Duration(minutes: 1);
+  static const Duration defaultRunBudget = Duration(milliseconds: 500);
+
+  /// Pages freed per incremental_vacuum call (4 KB pages: 256 KB)
+  static const int defaultPagesPerStep = 64;
+
+  static const int _autoVacuumIncremental = 2;
+
+  final IDatabaseProvider _databaseProvider;
+  final bool Function() _canRunHeavyWork;
+  final Duration interval;
+  final Duration startupDelay;
+  final Duration runBudget;
+  final int pagesPerStep;
+
+  Timer? _timer;
+  Timer? _startupTimer;
+  bool _conversionPending = false;
+  Future<MaintenanceRunReport>? _activeRun;
+  MaintenanceCancelToken? _activeToken;
+  MaintenanceRunReport? _lastReport;
+
+  DatabaseMaintenanceScheduler({
+    required IDatabaseProvider databaseProvider,
+    bool Function()? canRunHeavyWork,
+    this.interval = defaultInterval,
+    this.startupDelay = defaultStartupDelay,
+    this.runBudget = defaultRunBudget,
+    this.pagesPerStep = defaultPagesPerStep,
+  }) : _databaseProvider = databaseProvider,
+       _canRunHeavyWork = canRunHeavyWork ?? (() => false);
+
+  bool get isRunning => _timer != null;
+  MaintenanceRunReport? get lastReport => _lastReport;
+
+  /// The full VACUUM is still owed and waits for [canRunHeavyWork]
+  bool get conversionPending => _conversionPending;
+
+  void start() {
+    if (_timer != null) return;
+    _startupTimer = Timer(startupDelay, () => unawaited(runNow()));
+    _timer = Timer.periodic(interval, (_) => unawaited(runNow()));
+    _logger.info('🧹 Maintenance scheduled every ${interval.inHours}h');
+  }
+
+  /// Stop the timers and cancel an in-flight run after its current step
+  void stop() {
+    _startupTimer?.cancel();
+    _startupTimer = null;
+    _timer?.cancel();
+    _timer = null;
+    _activeToken?.cancel();
+  }
+
+  /// Lifecycle or charging state changed: run the pending conversion now
+  /// if the device just became idle and charging
+  void onConditionsChanged() {
+    if (!isRunning || !_conversionPending || _activeRun != null) return;
+    if (!_canRunHeavyWork()) return;
+    _logger.info('🧹 Device idle and charging - running maintenance');
+    unawaited(runNow());
+  }
+
+  /// Run maintenance now; joins a run already in progress
+  Future<MaintenanceRunReport> runNow({MaintenanceCancelToken? token}) {
+    final active = _activeRun;
+    if (active != null) return active;
+
+    final runToken = token ?? MaintenanceCancelToken();
+    _activeToken = runToken;
+    return _activeRun = _run(runToken).whenComplete(() {
+      _activeRun = null;
+      _activeToken = null;
+    });
+  }
+
+  Future<MaintenanceRunReport> _run(MaintenanceCancelToken token) async {
+    final stopwatch = Stopwatch()..start();
+    var reclaimed = 0;
+    var remaining = 0;
+    var converted = false;
+    var optimized = false;
+
+    try {
+      final db = await _databaseProvider.database;
+
+      if (await _pragmaInt(db, 'auto_vacuum') == _autoVacuumIncremental) {
+        remaining = await _pragmaInt(db, 'freelist_count');
+        while (remaining > 0 &&
+            !token.isCancelled &&
+            stopwatch.elapsed < runBudget) {
+          await db.rawQuery('PRAGMA incremental_vacuum($pagesPerStep)');
+          final left = await _pragmaInt(db, 'freelist_count');
+          reclaimed += remaining - left;
+          if (left >= remaining) break;
+          remaining = left;
+          // Let queued queries through between batches.
+          await Future<void>.delayed(Duration.zero);
+        }
+      } else if (!token.isCancelled && _canRunHeavyWork()) {
+        _logger.info('🧹 Converting database to auto_vacuum=INCREMENTAL...');
+        await db.rawQuery('PRAGMA auto_vacuum = INCREMENTAL');
+        await db.execute('VACUUM');
+        converted = true;
+        _conversionPending = false;
+      } else {
+        _conversionPending = true;
+      }
+
+      if (!token.isCancelled) {
+        await db.rawQuery('PRAGMA optimize');
+        optimized = true;
+      }
+    } catch (e) {
+      _logger.warning('Database maintenance failed: $e');
+    }
+
+    final report = MaintenanceRunReport(
+      pagesReclaimed: reclaimed,
+      pagesRemaining: remaining,
+      convertedToIncremental: converted,
+      optimized: optimized,
+      cancelled: token.isCancelled,
+      elapsed: stopwatch.elapsed,
+    );
+    _lastReport = report;
+    _logger.info(
+      '🧹 Maintenance: $reclaimed pages reclaimed, $remaining left '
+      '(${report.elapsed.inMilliseconds}ms'
+      '${report.cancelled ? ', cancelled' : ''})',
+    );
+    return report;
+  }
+
+  static Future<int> _pragmaInt(Database db, String pragma) async {
+    final rows = await db.rawQuery('PRAGMA $pragma');
+    if (rows.isEmpty) return 0;
+    return (rows.first.values.first as num?)?.toInt() ?? 0;
+  }
+}
@@ -0,0 +1,295 @@
+import 'dart:async';
+import 'dart:convert';
+
+import 'package:logging/logging.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+
+import 'mesh/mesh_metrics_history.dart';
+
+/// Live per-table figures derived from [DatabaseTelemetry]
+class TableTelemetry {
+  final String table;
+
+  /// Row count at the last full snapshot plus net writes since; null until
+  /// a snapshot has seeded the baseline.
+  final int? estimatedRows;
+
+  /// Net rows inserted minus deleted since the baseline
+  final int rowDelta;
+  final int bytesWritten;
+  final int writes;
+  final int reads;
+
+  final int writesLastHour;
+  final int bytesLastDay;
+  final double meanLatencyMs;
+  final double maxLatencyMs;
+
+  const TableTelemetry({
+    required this.table,
+    required this.estimatedRows,
+    required this.rowDelta,
+    required this.bytesWritten,
+    required this.writes,
+    required this.reads,
+    required this.writesLastHour,
+    required this.bytesLastDay,
+    required this.meanLatencyMs,
+    required this.maxLatencyMs,
+  });
+
+  Map<String, dynamic> toJson() => {
+    'table': table,
+    'estimated_rows': estimatedRows,
+    'row_delta': rowDelta,
+    'bytes_written': bytesWritten,
+    'writes': writes,
+    'reads': reads,
+    'writes_last_hour': writesLastHour,
+    'bytes_last_day': bytesLastDay,
+    'mean_latency_ms': meanLatencyMs.toStringAsFixed(2),
+    'max_latency_ms': maxLatencyMs.toStringAsFixed(2),
+  };
+}
+
+/// Incremental database health counters fed from the repository layer.
+///
+/// Repositories report each write's row delta and approximate payload size
+/// and time their statements through [time]. Rates and latencies go into a
+/// [MeshMetricsHistory] of fixed-size rollups; lifetime totals and the row
+/// baseline are persisted as a small JSON summary. Reading figures never
+/// touches the database, so dashboards and relays can poll freely.
+///
+/// Row estimates drift where SQLite changes rows on its own (cascades,
+/// triggers); each full snapshot calls [rebase] to correct them.
+class DatabaseTelemetry {
+  static final _logger = Logger('DatabaseTelemetry');
+
+  static final DatabaseTelemetry instance = DatabaseTelemetry();
+
+  static const String _summaryKey = 'db_telemetry_summary_v1';
+  static const String _historyKey = 'db_telemetry_history_v1';
+
+  /// Tables tracked before further ones are ignored (3 series each)
+  static const int maxTables = 16;
+
+  final Duration saveDelay;
+  final MeshMetricsHistory _history;
+  final Map<String, _TableCounters> _tables = {};
+  final Stopwatch _clock = Stopwatch()..start();
+  bool _persistent = false;
+  Timer? _saveTimer;
+
+  DatabaseTelemetry({this.saveDelay = const Duration(minutes: 1)})
+    : _history = MeshMetricsHistory(
+        saveDelay: saveDelay,
+        storageKey: _historyKey,
+        seriesLimit: maxTables * 3,
+      );
+
+  /// Restore the persisted summary and rollups and start saving changes
+  Future<void> initialize() async {
+    if (_persistent) return;
+    _persistent = true;
+    await _history.initialize();
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      final data = prefs.getString(_summaryKey);
+      if (data != null) _decode(data);
+      _logger.info('Restored telemetry for ${_tables.length} tables');
+    } catch (e) {
+      _logger.warning('Failed to restore database telemetry: $e');
+    }
+  }
+
+  /// Run [statement] against [table] and record its latency
+  Future<T> time<T>(
+    String table,
+    Future<T> Function() statement, {
+    bool write = false,
+  }) async {
+    final start = _clock.elapsedMicroseconds;
+    try {
+      return await statement();
+    } finally {
+      final counters = _countersFor(table);
+      if (counters != null) {
+        if (!write) counters.reads++;
+        _history.record(
+          _series(table, 'latency_ms'),
+          (_clock.elapsedMicroseconds - start) / 1000,
+        );
+      }
+    }
+  }
+
+  /// Count one write to [table] changing [rows] rows (negative for deletes)
+  /// and carrying about [bytes] of payload
+  void recordWrite(
+    String table, {
+    int rows = 0,
+    int bytes = 0,
+    DateTime? now,
+  }) {
+    final counters = _countersFor(table);
+    if (counters == null) return;
+    counters
+      ..rowDelta += rows
+      ..bytesWritten += bytes
+      ..writes++;
+    _history
+      ..increment(_series(table, 'rows'), by: rows.toDouble(), now: now)
+      ..increment(_series(table, 'bytes'), by: bytes.toDouble(), now: now);
+    _scheduleSave();
+  }
+
+  /// Replace row baselines with exact counts from a full snapshot.
+  ///
+  /// Only tables the repositories already report on are rebased, so FTS
+  /// shadow tables and other untouched tables never take up [maxTables].
+  void rebase(Map<String, int> rowCounts) {
+    for (final entry in rowCounts.entries) {
+      final counters = _tables[entry.key];
+      if (counters == null) continue;
+      counters
+        ..baseline = entry.value
+        ..rowDelta = 0;
+    }
+    _scheduleSave();
+  }
+
+  /// Approximate stored size of one row's [values]
+  static int estimateBytes(Map<String, Object?> values) {
+    var bytes = 0;
+    for (final value in values.values) {
+      bytes += switch (value) {
+        null => 1,
+        String s => s.length,
+        List<int> b => b.length,
+        bool _ => 1,
+        _ => 8,
+      };
+    }
+    return bytes;
+  }
+
+  Iterable<String> get tableNames => _tables.keys;
+
+  TableTelemetry? forTable(String table, {DateTime? now}) {
+    final counters = _tables[table];
+    if (counters == null) return null;
+
+    final at = now ?? DateTime.now();
+    final latency = _history.query(
+      _series(table, 'latency_ms'),
+      MetricRollup.oneMinute,
+      since: at.subtract(const Duration(hours: 1)),
+      now: at,
+    );
+    final samples = latency.fold<int>(0, (sum, p) => sum + p.count);
+    final baseline = counters.baseline;
+    return TableTelemetry(
+      table: table,
+      estimatedRows: baseline == null ? null : baseline + counters.rowDelta,
+      rowDelta: counters.rowDelta,
+      bytesWritten: counters.bytesWritten,
+      writes: counters.writes,
+      reads: counters.reads,
+      writesLastHour: _history
+          .query(
+            _series(table, 'rows'),
+            MetricRollup.oneMinute,
+            since: at.subtract(const Duration(hours: 1)),
+            now: at,
+          )
+          .fold<int>(0, (sum, p) => sum + p.count),
+      bytesLastDay: _history
+          .total(_series(table, 'bytes'), const Duration(days: 1), now: at)
+          .round(),
+      meanLatencyMs: samples == 0
+          ? 0
+          : latency.fold<double>(0, (sum, p) => sum + p.sum) / samples,
+      maxLatencyMs: latency.fold<double>(
+        0,
+        (max, p) => p.max > max ? p.max : max,
+      ),
+    );
+  }
+
+  Map<String, TableTelemetry> tables({DateTime? now}) => {
+    for (final name in _tables.keys) name: forTable(name, now: now)!,
+  };
+
+  /// Write pending changes now
+  Future<void> flush() async {
+    _saveTimer?.cancel();
+    _saveTimer = null;
+    if (!_persistent) return;
+    await _history.flush();
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      await prefs.setString(_summaryKey, _encode());
+    } catch (e) {
+      _logger.warning('Failed to persist database telemetry: $e');
+    }
+  }
+
+  void clear() {
+    _saveTimer?.cancel();
+    _saveTimer = null;
+    _tables.clear();
+    _history.clear();
+  }
+
+  static String _series(String table, String metric) => 'db.$table.$metric';
+
+  _TableCounters? _countersFor(String table) {
+    final existing = _tables[table];
+    if (existing != null) return existing;
+    if (_tables.length >= maxTables) return null;
+    return _tables[table] = _TableCounters();
+  }
+
+  void _scheduleSave() {
+    if (!_persistent || _saveTimer != null) return;
+    _saveTimer = Timer(saveDelay, () => unawaited(flush()));
+  }
+
+  String _encode() => jsonEncode({
+    for (final entry in _tables.entries) entry.key: entry.value.toJson(),
+  });
+
+  void _decode(String data) {
+    final decoded = jsonDecode(data) as Map<String, dynamic>;
+    for (final entry in decoded.entries) {
+      final counters = _countersFor(entry.key);
+      if (counters == null) break;
+      counters.restore(entry.value as Map<String, dynamic>);
+    }
+  }
+}
+
+class _TableCounters {
+  int? baseline;
+  int rowDelta = 0;
+  int bytesWritten = 0;
+  int writes = 0;
+  int reads = 0;
+
+  Map<String, dynamic> toJson() => {
+    if (baseline != null) 'baseline': baseline,
+    'delta': rowDelta,
+    'bytes': bytesWritten,
+    'writes': writes,
+    'reads': reads,
+  };
+
+  /// Merge persisted totals under anything counted since startup
+  void restore(Map<String, dynamic> json) {
+    baseline ??= json['baseline'] as int?;
+    rowDelta += json['delta'] as int? ?? 0;
+    bytesWritten += json['bytes'] as int? ?? 0;
+    writes += json['writes'] as int? ?? 0;
+    reads += json['reads'] as int? ?? 0;
+  }
+}
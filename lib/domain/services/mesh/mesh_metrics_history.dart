@@ -0,0 +1,339 @@
+import 'dart:async';
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:logging/logging.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+
+/// Fixed-resolution rollup kept for every metric series
+enum MetricRollup {
+  /// 30 minutes at 10 s resolution (live view, not persisted)
+  tenSeconds(Duration(seconds: 10), 180, persisted: false),
+
+  /// 12 hours at 1 min resolution
+  oneMinute(Duration(minutes: 1), 720),
+
+  /// 7 days at 1 h resolution
+  oneHour(Duration(hours: 1), 168);
+
+  const MetricRollup(this.resolution, this.capacity, {this.persisted = true});
+
+  final Duration resolution;
+  final int capacity;
+  final bool persisted;
+
+  Duration get span => resolution * capacity;
+}
+
+/// One rollup bucket: every sample recorded in [start, start + resolution)
+class MetricPoint {
+  final DateTime start;
+  final int count;
+  final double sum;
+  final double min;
+  final double max;
+
+  const MetricPoint({
+    required this.start,
+    required this.count,
+    required this.sum,
+    required this.min,
+    required this.max,
+  });
+
+  double get mean => count == 0 ? 0 : sum / count;
+}
+
+/// Time-series history of mesh health: relay throughput, drops by reason,
+/// queue depth, handshake and pairing latency and link counts.
+///
+/// Each series keeps one ring buffer per [MetricRollup], so appending from a
+/// hot path is a few array writes and never allocates once the series
+/// exists. Counters ([increment]) are read back through [MetricPoint.sum],
+/// gauges and latencies ([record]) through mean/min/max. The minute and
+/// hour rollups are persisted as packed binary so history survives
+/// restarts; screens query buckets directly instead of recomputing stats.
+class MeshMetricsHistory {
+  static final _logger = Logger('MeshMetricsHistory');
+
+  /// Process-wide history fed by the relay engine, queue, BLE connection
+  /// tracker and handshake coordinator.
+  static final MeshMetricsHistory instance = MeshMetricsHistory();
+
+  static const String relayed = 'relay.relayed';
+  static const String deliveredToSelf = 'relay.delivered';
+  static const String dropPrefix = 'relay.drop.';
+  static const String directQueueDepth = 'queue.direct';
+  static const String relayQueueDepth = 'queue.relay';
+  static const String handshakeLatencyMs = 'handshake.latency_ms';
+  static const String handshakeFailures = 'handshake.failed';
+  static const String pairingLatencyMs = 'pairing.latency_ms';
+  static const String pairingOverBudget = 'pairing.over_budget';
+  static const String linkCount = 'links.connected';
+
+  /// Distinct series kept; further drop reasons fold into `other`.
+  static const int maxSeries = 32;
+  static const String defaultStorageKey = 'mesh_metrics_history_v1';
+  static const int _slotBytes = 20;
+
+  final Duration saveDelay;
+
+  /// Preferences key; other histories (e.g. database telemetry) use their own
+  final String storageKey;
+  final int seriesLimit;
+  final Map<String, List<_Ring>> _series = {};
+  bool _persistent = false;
+  Timer? _saveTimer;
+
+  MeshMetricsHistory({
+    this.saveDelay = const Duration(minutes: 1),
+    this.storageKey = defaultStorageKey,
+    this.seriesLimit = maxSeries,
+  });
+
+  /// Restore persisted rollups and start saving changes
+  Future<void> initialize() async {
+    if (_persistent) return;
+    _persistent = true;
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      final data = prefs.getString(storageKey);
+      if (data != null) _decode(data);
+      _logger.info('Restored ${_series.length} metric series');
+    } catch (e) {
+      _logger.warning('Failed to restore metric history: $e');
+    }
+  }
+
+  /// Add [by] to counter [series] in the current bucket
+  void increment(String series, {double by = 1, DateTime? now}) =>
+      record(series, by, now: now);
+
+  /// Record one sample of gauge or latency [series]
+  void record(String series, double value, {DateTime? now}) {
+    final rings = _ringsFor(series);
+    if (rings == null) return;
+    final at = (now ?? DateTime.now()).millisecondsSinceEpoch;
+    for (final ring in rings) {
+      ring.add(at, value);
+    }
+    _scheduleSave();
+  }
+
+  /// Count a dropped relay under a bounded reason key
+  void recordDrop(String reason, {DateTime? now}) {
+    final key = '$dropPrefix${reasonKey(reason)}';
+    increment(
+      _series.containsKey(key) || _series.length < seriesLimit
+          ? key
+          : '${dropPrefix}other',
+      now: now,
+    );
+  }
+
+  /// Normalise a free-text drop reason into a stable series key
+  static String reasonKey(String reason) {
+    final head = reason.split(':').first.toLowerCase();
+    final key = head
+        .replaceAll(RegExp(r'[0-9]+'), '')
+        .replaceAll(RegExp(r'[^a-z]+'), '_')
+        .replaceAll(RegExp(r'^_+|_+$'), '');
+    return key.isEmpty ? 'other' : key;
+  }
+
+  Iterable<String> get seriesNames => _series.keys;
+
+  /// Non-empty buckets of [series] at [rollup], oldest first
+  List<MetricPoint> query(
+    String series,
+    MetricRollup rollup, {
+    DateTime? since,
+    DateTime? now,
+  }) {
+    final ring = _series[series]?[rollup.index];
+    if (ring == null) return const [];
+    final at = (now ?? DateTime.now()).millisecondsSinceEpoch;
+    final from =
+        since?.millisecondsSinceEpoch ?? at - rollup.span.inMilliseconds;
+    return ring.points(from, at);
+  }
+
+  /// Sum of [series] over the last [window], read from the coarsest
+  /// rollup that still resolves it
+  double total(String series, Duration window, {DateTime? now}) {
+    final rollup = MetricRollup.values.firstWhere(
+      (r) => r.span >= window,
+      orElse: () => MetricRollup.oneHour,
+    );
+    final at = now ?? DateTime.now();
+    return query(
+      series,
+      rollup,
+      since: at.subtract(window),
+      now: at,
+    ).fold<double>(0, (sum, p) => sum + p.sum);
+  }
+
+  /// Total drops per reason over the last [window]
+  Map<String, double> dropsByReason(Duration window, {DateTime? now}) => {
+    for (final name in _series.keys.where((n) => n.startsWith(dropPrefix)))
+      name.substring(dropPrefix.length): total(name, window, now: now),
+  }..removeWhere((_, count) => count == 0);
+
+  /// Write pending changes now
+  Future<void> flush() async {
+    _saveTimer?.cancel();
+    _saveTimer = null;
+    if (!_persistent) return;
+    try {
+      final prefs = await SharedPreferences.getInstance();
+      await prefs.setString(storageKey, _encode());
+    } catch (e) {
+      _logger.warning('Failed to persist metric history: $e');
+    }
+  }
+
+  void clear() {
+    _saveTimer?.cancel();
+    _saveTimer = null;
+    _series.clear();
+  }
+
+  List<_Ring>? _ringsFor(String series) {
+    final existing = _series[series];
+    if (existing != null) return existing;
+    if (_series.length >= seriesLimit) return null;
+    return _series[series] = [
+      for (final rollup in MetricRollup.values) _Ring(rollup),
+    ];
+  }
+
+  void _scheduleSave() {
+    if (!_persistent || _saveTimer != null) return;
+    _saveTimer = Timer(saveDelay, () => unawaited(flush()));
+  }
+
+  String _encode() => jsonEncode({
+    for (final entry in _series.entries)
+      entry.key: {
+        for (final ring in entry.value)
+          if (ring.rollup.persisted)
+            ring.rollup.name: base64Encode(ring.pack()),
+      },
+  });
+
+  void _decode(String data) {
+    final decoded = jsonDecode(data) as Map<String, dynamic>;
+    for (final entry in decoded.entries) {
+      final rings = _ringsFor(entry.key);
+      if (rings == null) break;
+      final packed = entry.value as Map<String, dynamic>;
+      for (final ring in rings) {
+        final blob = packed[ring.rollup.name] as String?;
+        if (blob != null) ring.unpack(base64Decode(blob));
+      }
+    }
+  }
+}
+
+/// Ring buffer of buckets for one series at one rollup
+class _Ring {
+  _Ring(this.rollup)
+    : _bucket = Int32List(rollup.capacity)
+        ..fillRange(0, rollup.capacity, -1),
+      _count = Int32List(rollup.capacity),
+      _sum = Float32List(rollup.capacity),
+      _min = Float32List(rollup.capacity),
+      _max = Float32List(rollup.capacity);
+
+  final MetricRollup rollup;
+  final Int32List _bucket;
+  final Int32List _count;
+  final Float32List _sum;
+  final Float32List _min;
+  final Float32List _max;
+
+  int _bucketOf(int ms) => ms ~/ rollup.resolution.inMilliseconds;
+
+  void add(int ms, double value) {
+    final bucket = _bucketOf(ms);
+    final slot = bucket % rollup.capacity;
+    if (_bucket[slot] != bucket) {
+      _bucket[slot] = bucket;
+      _count[slot] = 0;
+      _sum[slot] = 0;
+      _min[slot] = value;
+      _max[slot] = value;
+    }
+    _count[slot]++;
+    _sum[slot] += value;
+    if (value < _min[slot]) _min[slot] = value;
+    if (value > _max[slot]) _max[slot] = value;
+  }
+
+  List<MetricPoint> points(int fromMs, int toMs) {
+    final first = _bucketOf(fromMs);
+    final last = _bucketOf(toMs);
+    final oldest = last - rollup.capacity + 1;
+    final points = <MetricPoint>[];
+    for (
+      var bucket = first < oldest ? oldest : first;
+      bucket <= last;
+      bucket++
+    ) {
+      final slot = bucket % rollup.capacity;
+      if (_bucket[slot] != bucket || _count[slot] == 0) continue;
+      points.add(
+        MetricPoint(
+          start: DateTime.fromMillisecondsSinceEpoch(
+            bucket * rollup.resolution.inMilliseconds,
+          ),
+          count: _count[slot],
+          sum: _sum[slot],
+          min: _min[slot],
+          max: _max[slot],
+        ),
+      );
+    }
+    return points;
+  }
+
+  /// Occupied slots as (bucket, count, sum, min, max) records
+  Uint8List pack() {
+    final used = [
+      for (var slot = 0; slot < rollup.capacity; slot++)
+        if (_bucket[slot] >= 0 && _count[slot] > 0) slot,
+    ];
+    final data = ByteData(used.length * MeshMetricsHistory._slotBytes);
+    var offset = 0;
+    for (final slot in used) {
+      data
+        ..setInt32(offset, _bucket[slot])
+        ..setInt32(offset + 4, _count[slot])
+        ..setFloat32(offset + 8, _sum[slot])
+        ..setFloat32(offset + 12, _min[slot])
+        ..setFloat32(offset + 16, _max[slot]);
+      offset += MeshMetricsHistory._slotBytes;
+    }
+    return data.buffer.asUint8List();
+  }
+
+  void unpack(Uint8List bytes) {
+    final data = ByteData.sublistView(bytes);
+    for (
+      var offset = 0;
+      offset + MeshMetricsHistory._slotBytes <= bytes.length;
+      offset += MeshMetricsHistory._slotBytes
+    ) {
+      final bucket = data.getInt32(offset);
+      final slot = bucket % rollup.capacity;
+      // Live samples win over a restored bucket for the same slot.
+      if (_bucket[slot] >= bucket) continue;
+      _bucket[slot] = bucket;
+      _count[slot] = data.getInt32(offset + 4);
+      _sum[slot] = data.getFloat32(offset + 8);
+      _min[slot] = data.getFloat32(offset + 12);
+      _max[slot] = data.getFloat32(offset + 16);
+    }
+  }
+}
@@ -13,6 +13,7 @@ import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart
 import 'package:pak_connect/domain/messaging/queue_sync_manager.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 import 'package:pak_connect/domain/config/kill_switches.dart';
 
@@ -544,6 +545,8 @@ class MeshQueueSyncCoordinator {
         connectedDeviceId != null &&
         connectedDeviceId.isNotEmpty) {
       MeshDebugLogger.deviceConnected(connectedDeviceId);
+      // Feeds encounter prediction for custody acceptance.
+      ConnectionQualityMonitor.instance.recordEncounter(connectedDeviceId);
       _messageQueue?.setOnline();
       await _deliverQueuedMessagesToDevice(connectedDeviceId);
       await _syncQueueWithDevice(connectedDeviceId);
@@ -588,9 +591,18 @@ class MeshQueueSyncCoordinator {
         return;
       }
 
+      // Within a priority, earliest deadline first: relay and custody copies
+      // expire with their bundle, so older bundles may be closer to expiry
+      // than newer direct messages.
       directMessages.sort((a, b) {
         final priorityCompare = b.priority.index.compareTo(a.priority.index);
         if (priorityCompare != 0) return priorityCompare;
+        final aDeadline = a.expiresAt;
+        final bDeadline = b.expiresAt;
+        if (aDeadline != null && bDeadline != null) {
+          final deadlineCompare = aDeadline.compareTo(bDeadline);
+          if (deadlineCompare != 0) return deadlineCompare;
+        }
         return a.queuedAt.compareTo(b.queuedAt);
       });
 
@@ -0,0 +1,64 @@
+import 'package:logging/logging.dart';
+
+import '../../models/peer_capabilities.dart';
+import '../../utils/string_extensions.dart';
+
+/// Capabilities each peer advertised during its handshake.
+///
+/// Entries are keyed by the ephemeral ID from the identity frame and
+/// [alias]ed to the persistent key once pairing maps the two, so lookups
+/// work with whichever ID a sender holds. Unknown peers report no
+/// capabilities, which keeps them on the baseline wire format.
+class PeerCapabilityRegistry {
+  static final _logger = Logger('PeerCapabilityRegistry');
+
+  static final PeerCapabilityRegistry instance = PeerCapabilityRegistry();
+
+  /// Peers remembered before the least recently recorded ones drop
+  static const int maxTrackedPeers = 4096;
+
+  final Map<String, int> _capabilities = {};
+
+  void record(String peerId, int capabilities) {
+    if (peerId.isEmpty) return;
+    _capabilities.remove(peerId);
+    _capabilities[peerId] = capabilities;
+    if (_capabilities.length > maxTrackedPeers) {
+      _capabilities.remove(_capabilities.keys.first);
+    }
+    _logger.fine(
+      '🧩 Peer ${peerId.shortId(8)}... capabilities: 0x'
+      '${capabilities.toRadixString(16)}',
+    );
+  }
+
+  /// Make [peerId] report the capabilities recorded for [knownId]
+  void alias(String peerId, String knownId) {
+    final capabilities = _capabilities[knownId];
+    if (capabilities == null || peerId == knownId) return;
+    record(peerId, capabilities);
+  }
+
+  int capabilitiesOf(String? peerId) =>
+      peerId == null ? 0 : _capabilities[peerId] ?? 0;
+
+  bool supports(String? peerId, int capability) =>
+      PeerCapabilities.has(capabilitiesOf(peerId), capability);
+
+  /// Whether [capability] was recorded under any of one peer's [peerIds]
+  /// (session, ephemeral or persistent ID, whichever are known)
+  bool supportsAny(Iterable<String?> peerIds, int capability) =>
+      peerIds.any((peerId) => supports(peerId, capability));
+
+  /// Whether every one of [peerIds] supports [capability]; false when empty
+  bool allSupport(Iterable<String> peerIds, int capability) {
+    var any = false;
+    for (final peerId in peerIds) {
+      if (!supports(peerId, capability)) return false;
+      any = true;
+    }
+    return any;
+  }
+
+  void clear() => _capabilities.clear();
+}
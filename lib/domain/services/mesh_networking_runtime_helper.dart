@@ -176,17 +176,34 @@ class _MeshNetworkingRuntimeHelper {
     _owner._queueCoordinator.enableQueueSyncHandling();
     _owner._queueCoordinator.startConnectionMonitoring();
 
-    _owner._connectionSub ??= _owner._bleService.connectionInfo.listen(
-      _owner._handleConnectionUpdateForGossip,
-      onError: (e) =>
-          MeshNetworkingService._logger.fine('Connection stream error: $e'),
-    );
+    final eventBus = _owner._eventBus;
+    if (eventBus != null) {
+      // Gossip scheduling is state logic: subscribe inline on the app bus
+      // instead of through a per-subscriber stream.
+      if (_owner._connectionEvents == null) {
+        _owner._connectionEvents = eventBus
+            .channel<ConnectionInfo>(AppEventChannels.connectionInfo)
+            .listen(_owner._handleConnectionUpdateForGossip);
+        _owner._handleConnectionUpdateForGossip(
+          _owner._bleService.currentConnectionInfo,
+        );
+      }
+      _owner._identityEvents ??= eventBus
+          .channel<String>(AppEventChannels.identityRevealed)
+          .listen(_owner._handleIdentityRevealedForGossip);
+    } else {
+      _owner._connectionSub ??= _owner._bleService.connectionInfo.listen(
+        _owner._handleConnectionUpdateForGossip,
+        onError: (e) =>
+            MeshNetworkingService._logger.fine('Connection stream error: $e'),
+      );
 
-    _owner._identitySub ??= _owner._bleService.identityRevealed.listen(
-      _owner._handleIdentityRevealedForGossip,
-      onError: (e) =>
-          MeshNetworkingService._logger.fine('Identity stream error: $e'),
-    );
+      _owner._identitySub ??= _owner._bleService.identityRevealed.listen(
+        _owner._handleIdentityRevealedForGossip,
+        onError: (e) =>
+            MeshNetworkingService._logger.fine('Identity stream error: $e'),
+      );
+    }
 
     _owner._binarySub ??= _owner._bleService.receivedBinaryStream.listen(
       _owner._handleBinaryPayload,
@@ -205,7 +222,8 @@ class _MeshNetworkingRuntimeHelper {
       peerId,
       delay: const Duration(seconds: 1),
     );
-    unawaited(_owner._flushPendingBinarySends());
+    // Runs inline in the bus emit; start sends outside the emitting call.
+    unawaited(Future.microtask(_owner._flushPendingBinarySends));
   }
 
   void handleIdentityRevealedForGossip(String peerId) {
@@ -366,6 +384,10 @@ class _MeshNetworkingRuntimeHelper {
     _owner._connectionSub = null;
     _owner._identitySub?.cancel();
     _owner._identitySub = null;
+    _owner._connectionEvents?.cancel();
+    _owner._connectionEvents = null;
+    _owner._identityEvents?.cancel();
+    _owner._identityEvents = null;
     _owner._binarySub?.cancel();
     _owner._binarySub = null;
     _owner._binaryController.close();
@@ -31,6 +31,8 @@ import '../interfaces/i_shared_message_queue_provider.dart';
 import 'mesh/mesh_network_health_monitor.dart';
 import 'mesh/mesh_queue_sync_coordinator.dart';
 import 'mesh/mesh_relay_coordinator.dart';
+import 'app_event_channels.dart';
+import 'typed_event_bus.dart';
 import '../utils/chat_utils.dart';
 import '../interfaces/i_message_repository.dart';
 import '../interfaces/i_connection_service.dart';
@@ -81,6 +83,9 @@ class MeshNetworkingService implements IMeshNetworkingService {
   String? _currentNodeId;
   bool _isInitialized = false;
   StreamSubscription<ConnectionInfo>? _connectionSub;
+  final TypedEventBus? _eventBus;
+  EventSubscription? _connectionEvents;
+  EventSubscription? _identityEvents;
   final Set<String> _initialSyncPeers = {};
 
   // Streams for UI consumption with late subscriber support
@@ -201,7 +206,9 @@ class MeshNetworkingService implements IMeshNetworkingService {
     MeshNetworkHealthMonitor? healthMonitor,
     MeshQueueSyncCoordinator? queueCoordinator,
     MeshRelayEngineFactory? relayEngineFactory,
+    TypedEventBus? eventBus,
   }) : _bleService = bleService,
+       _eventBus = eventBus,
        _messageHandler = messageHandler,
        _messageRepository = repositoryProvider.messageRepository,
        _sharedQueueProvider = sharedQueueProvider,
@@ -248,9 +248,9 @@ class MessageRouter {
         '📤 Flushing outbox for ${uniquePeers.length} peer(s) via OfflineMessageQueue...',
       );
 
-      for (final peerId in uniquePeers) {
-        await _offlineQueue.flushQueueForPeer(peerId);
-      }
+      // Each peer drains through its own ACK window, so flush them together
+      // rather than letting one slow link hold up every other chat.
+      await Future.wait(uniquePeers.map(_offlineQueue.flushQueueForPeer));
 
       _logger.info('✅ Flush all delegated to OfflineMessageQueue');
     } catch (e) {
@@ -470,6 +470,7 @@ class _FallbackOfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final now = DateTime.now();
     final id = Uuid().v4();
@@ -489,6 +490,7 @@ class _FallbackOfflineMessageQueue implements OfflineMessageQueueContract {
       originalMessageId: originalMessageId,
       relayNodeId: relayNodeId,
       messageHash: messageHash,
+      isOriginator: isOriginator,
     );
 
     _messages.add(message);
@@ -519,6 +521,7 @@ class _FallbackOfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await queueMessage(
       chatId: chatId.value,
@@ -534,6 +537,7 @@ class _FallbackOfflineMessageQueue implements OfflineMessageQueueContract {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
     return MessageId(id);
   }
@@ -0,0 +1,178 @@
+import 'dart:async';
+import 'dart:collection';
+
+import 'package:logging/logging.dart';
+
+import '../entities/message.dart';
+import '../interfaces/i_notification_handler.dart';
+import '../values/id_types.dart';
+
+/// Posts a [MessageNotificationDigest] to the platform
+typedef MessageDigestSink =
+    Future<void> Function(MessageNotificationDigest digest);
+
+/// Collapses bursts of inbound message notifications.
+///
+/// The first message for a quiet chat is posted straight away and opens a
+/// [window] for that chat; messages arriving inside the window are only
+/// buffered, and when it closes the chat gets one updated notification with
+/// the running count and latest lines. Posts across all chats are spaced at
+/// least [minInterval] apart, so a reconnect flush of hundreds of messages
+/// costs a handful of platform calls instead of one per message.
+///
+/// The window only governs post timing. Count and lines keep running until
+/// [clearChat] (chat opened or marked read), because each post replaces the
+/// chat's single notification.
+class NotificationCoalescer {
+  static final _logger = Logger('NotificationCoalescer');
+
+  static const Duration defaultWindow = Duration(seconds: 2);
+  static const Duration defaultMinInterval = Duration(milliseconds: 500);
+  static const int defaultMaxLines = 5;
+
+  final MessageDigestSink _post;
+  final Duration window;
+  final Duration minInterval;
+  final int maxLines;
+  final DateTime Function() _now;
+
+  final Map<ChatId, _ChatBurst> _bursts = {};
+
+  /// Chats with unposted messages whose window allows a post, in FIFO order
+  final LinkedHashSet<ChatId> _due = LinkedHashSet();
+  DateTime? _lastPostAt;
+  Timer? _rateTimer;
+
+  NotificationCoalescer({
+    required MessageDigestSink post,
+    this.window = defaultWindow,
+    this.minInterval = defaultMinInterval,
+    this.maxLines = defaultMaxLines,
+    DateTime Function()? now,
+  }) : _post = post,
+       _now = now ?? DateTime.now;
+
+  /// Number of chats with an open window
+  int get activeChats => _bursts.values.where((b) => b.timer != null).length;
+
+  /// Number of chats whose notification still carries unread messages
+  int get trackedChats => _bursts.length;
+
+  /// Queue [message]; completes once any post it triggered immediately has
+  /// been delivered (buffered messages complete at once).
+  Future<void> add({
+    required Message message,
+    required String contactName,
+    String? contactAvatar,
+    String? contactPublicKey,
+  }) {
+    final chatId = message.chatId;
+    final burst = _bursts.putIfAbsent(chatId, _ChatBurst.new)
+      ..contactName = contactName
+      ..record(message, maxLines);
+    if (contactAvatar != null) burst.contactAvatar = contactAvatar;
+    if (contactPublicKey != null) burst.contactPublicKey = contactPublicKey;
+
+    if (burst.timer == null) {
+      _due.add(chatId);
+      _openWindow(chatId, burst);
+    }
+    return _pump();
+  }
+
+  /// Reset the count and lines of [chatId] (chat opened or marked read)
+  void clearChat(ChatId chatId) {
+    _bursts.remove(chatId)?.timer?.cancel();
+    _due.remove(chatId);
+  }
+
+  void dispose() {
+    for (final burst in _bursts.values) {
+      burst.timer?.cancel();
+    }
+    _bursts.clear();
+    _due.clear();
+    _rateTimer?.cancel();
+    _rateTimer = null;
+  }
+
+  void _openWindow(ChatId chatId, _ChatBurst burst) {
+    burst.timer = Timer(window, () {
+      burst.timer = null;
+      if (!identical(_bursts[chatId], burst)) return;
+      // Quiet for a whole window: the next message posts at once again,
+      // still counting the unread ones before it.
+      if (!burst.pending && !_due.contains(chatId)) return;
+      _due.add(chatId);
+      _openWindow(chatId, burst);
+      unawaited(_pump());
+    });
+  }
+
+  Future<void> _pump() {
+    final posts = <Future<void>>[];
+    while (_due.isNotEmpty) {
+      final now = _now();
+      final last = _lastPostAt;
+      if (last != null) {
+        final wait = minInterval - now.difference(last);
+        if (wait > Duration.zero) {
+          _rateTimer ??= Timer(wait, () {
+            _rateTimer = null;
+            unawaited(_pump());
+          });
+          break;
+        }
+      }
+
+      final chatId = _due.first;
+      _due.remove(chatId);
+      final burst = _bursts[chatId];
+      if (burst == null || !burst.pending) continue;
+
+      burst.pending = false;
+      _lastPostAt = now;
+      posts.add(_deliver(burst.snapshot()));
+    }
+    return posts.isEmpty ? Future.value() : Future.wait(posts);
+  }
+
+  Future<void> _deliver(MessageNotificationDigest digest) async {
+    _logger.fine(
+      '🔔 Posting ${digest.messageCount} message(s) for '
+      '${digest.contactName}',
+    );
+    try {
+      await _post(digest);
+    } catch (e) {
+      _logger.warning('Failed to post message notification: $e');
+    }
+  }
+}
+
+class _ChatBurst {
+  late String contactName;
+  String? contactAvatar;
+  String? contactPublicKey;
+  final Queue<Message> lines = Queue();
+  int count = 0;
+  bool pending = false;
+  Timer? timer;
+
+  void record(Message message, int maxLines) {
+    count++;
+    pending = true;
+    lines.addLast(message);
+    while (lines.length > maxLines) {
+      lines.removeFirst();
+    }
+  }
+
+  MessageNotificationDigest snapshot() => MessageNotificationDigest(
+    contactName: contactName,
+    contactAvatar: contactAvatar,
+    contactPublicKey: contactPublicKey,
+    messageCount: count,
+    recentMessages: List.unmodifiable(lines),
+  );
+}
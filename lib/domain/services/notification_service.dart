@@ -9,6 +9,8 @@ import '../interfaces/i_preferences_repository.dart';
 import '../entities/preference_keys.dart' show PreferenceKeys;
 import '../../domain/entities/message.dart';
 import '../../domain/interfaces/i_notification_handler.dart';
+import '../values/id_types.dart';
+import 'notification_coalescer.dart';
 
 /// Foreground notification handler (current implementation)
 /// Uses HapticFeedback and SystemSound for immediate feedback
@@ -185,6 +187,12 @@ class NotificationService {
   static INotificationHandler? _handler;
   static bool _isInitialized = false;
 
+  // Bursts of inbound messages (e.g. a reconnect flush) collapse into one
+  // updating notification per chat.
+  static NotificationCoalescer? _coalescer;
+  static NotificationCoalescer get _messageCoalescer =>
+      _coalescer ??= NotificationCoalescer(post: _postMessageDigest);
+
   /// Initialize with a specific handler composed by the caller.
   /// For Android background service: inject BackgroundNotificationHandler
   static Future<void> initialize({
@@ -239,18 +247,53 @@ class NotificationService {
         return;
       }
 
-      await _handler!.showMessageNotification(
+      await _messageCoalescer.add(
         message: message,
         contactName: contactName,
         contactAvatar: contactAvatar,
       );
-
-      _logger.info('✅ Notification shown for message from $contactName');
     } catch (e) {
       _logger.warning('Failed to show message notification: $e');
     }
   }
 
+  /// Drop buffered message notifications for [chatId] (chat opened)
+  static void clearMessageNotifications(ChatId chatId) {
+    _coalescer?.clearChat(chatId);
+  }
+
+  static Future<void> _postMessageDigest(
+    MessageNotificationDigest digest,
+  ) async {
+    final handler = _handler;
+    if (handler == null) return;
+
+    if (digest.messageCount == 1) {
+      await handler.showMessageNotification(
+        message: digest.latest,
+        contactName: digest.contactName,
+        contactAvatar: digest.contactAvatar,
+        contactPublicKey: digest.contactPublicKey,
+      );
+    } else if (handler is IMessageDigestNotificationHandler) {
+      await handler.showMessageDigestNotification(digest);
+    } else {
+      await handler.showNotification(
+        id: digest.notificationId,
+        title: '${digest.contactName} (${digest.messageCount})',
+        body: digest.recentMessages.map((m) => m.content).join('\n'),
+        channel: NotificationChannel.messages,
+        priority: NotificationPriority.high,
+        payload: digest.latest.chatId.value,
+      );
+    }
+
+    _logger.info(
+      '✅ Notification shown for ${digest.messageCount} message(s) from '
+      '${digest.contactName}',
+    );
+  }
+
   /// Show notification for new chat
   static Future<void> showChatNotification({
     required String contactName,
@@ -390,6 +433,8 @@ class NotificationService {
   /// Dispose notification service
   static void dispose() {
     _logger.info('Disposing notification service');
+    _coalescer?.dispose();
+    _coalescer = null;
     _handler?.dispose();
     _handler = null;
     _isInitialized = false;
@@ -400,7 +445,9 @@ class NotificationService {
   static Future<void> swapHandler(INotificationHandler newHandler) async {
     _logger.info('Swapping notification handler to ${newHandler.runtimeType}');
 
-    // Dispose old handler
+    // Dispose old handler; buffered messages belong to its notifications
+    _coalescer?.dispose();
+    _coalescer = null;
     _handler?.dispose();
 
     // Initialize new handler
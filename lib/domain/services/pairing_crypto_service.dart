@@ -121,11 +121,16 @@ class PairingCryptoService {
       return;
     }
 
+    // Lanes are usable as soon as the in-memory keys exist; the secure
+    // storage writes for every id then run together.
     for (final id in ids) {
       _runtimeConversationSecrets?[id] = sharedSecret;
-      await _contactRepository.cacheSharedSecret(id, sharedSecret);
       ConversationCryptoService.initializeConversation(id, sharedSecret);
     }
+    await Future.wait([
+      for (final id in ids)
+        _contactRepository.cacheSharedSecret(id, sharedSecret),
+    ]);
   }
 
   Future<String?> computeAndCacheSharedSecret(
@@ -0,0 +1,81 @@
+import 'package:logging/logging.dart';
+
+import 'mesh/mesh_metrics_history.dart';
+
+/// Checkpoints of one pairing, from the peer's code being entered to our
+/// persistent key going out
+enum PairingStage { codeEntered, verified, keysSent, contactSaved }
+
+/// Times a pairing end to end against [budget].
+///
+/// [start] runs when the user enters the peer's code; later stages are
+/// marked as the flow reaches them. [finish] records the total in
+/// [MeshMetricsHistory] and logs the per-stage breakdown when the run went
+/// over budget, so slow pairings at busy events show where time went.
+class PairingLatencyTracker {
+  static final _logger = Logger('PairingLatencyTracker');
+
+  static const Duration defaultBudget = Duration(seconds: 1);
+
+  final Duration budget;
+  final MeshMetricsHistory _history;
+  final Stopwatch _stopwatch = Stopwatch();
+  final Map<PairingStage, Duration> _marks = {};
+
+  PairingLatencyTracker({
+    this.budget = defaultBudget,
+    MeshMetricsHistory? history,
+  }) : _history = history ?? MeshMetricsHistory.instance;
+
+  bool get isRunning => _stopwatch.isRunning;
+
+  /// Time from [start] to each stage reached so far
+  Map<PairingStage, Duration> get marks => Map.unmodifiable(_marks);
+
+  void start() {
+    _marks.clear();
+    _stopwatch
+      ..reset()
+      ..start();
+    _marks[PairingStage.codeEntered] = Duration.zero;
+  }
+
+  void mark(PairingStage stage) {
+    if (!_stopwatch.isRunning) return;
+    _marks[stage] ??= _stopwatch.elapsed;
+  }
+
+  /// Stop timing and record the total; null when no pairing was running
+  Duration? finish({DateTime? now}) {
+    if (!_stopwatch.isRunning) return null;
+    _stopwatch.stop();
+    final total = _stopwatch.elapsed;
+
+    _history.record(
+      MeshMetricsHistory.pairingLatencyMs,
+      total.inMicroseconds / 1000,
+      now: now,
+    );
+    if (total > budget) {
+      _history.increment(MeshMetricsHistory.pairingOverBudget, now: now);
+      final stages = _marks.entries
+          .map((e) => '${e.key.name}=${e.value.inMilliseconds}ms')
+          .join(', ');
+      _logger.warning(
+        '⏱️ Pairing took ${total.inMilliseconds}ms '
+        '(budget ${budget.inMilliseconds}ms): $stages',
+      );
+    } else {
+      _logger.info('⏱️ Pairing completed in ${total.inMilliseconds}ms');
+    }
+    return total;
+  }
+
+  /// Drop a run that ended without completing (failure or cancel)
+  void abandon() {
+    _stopwatch
+      ..stop()
+      ..reset();
+    _marks.clear();
+  }
+}
@@ -0,0 +1,214 @@
+import 'dart:async';
+
+import 'package:logging/logging.dart';
+
+/// Cooperative cancellation flag checked by search sources between
+/// database round trips
+class SearchCancelToken {
+  bool _cancelled = false;
+
+  bool get isCancelled => _cancelled;
+
+  void cancel() => _cancelled = true;
+}
+
+/// Results found so far for [query]
+class SearchPage<T> {
+  final String query;
+  final List<T> results;
+
+  /// The source finished (or was cut at the result cap); no more pages
+  /// follow for this query.
+  final bool isComplete;
+
+  /// Matches exist beyond [results] (result cap reached)
+  final bool hasMore;
+  final Duration elapsed;
+
+  const SearchPage({
+    required this.query,
+    required this.results,
+    required this.isComplete,
+    required this.hasMore,
+    required this.elapsed,
+  });
+}
+
+/// Streams matches for a query in pages, stopping once [token] is
+/// cancelled
+typedef SearchSource<T> =
+    Stream<List<T>> Function(String query, SearchCancelToken token);
+
+/// Search-as-you-type session over a paged [SearchSource].
+///
+/// Keystrokes are debounced; each new query cancels the token of the one
+/// it supersedes so the source stops issuing queries, and pages from a
+/// superseded query are never emitted. When a query only extends the last
+/// completed one (and that result was not capped), the previous results
+/// are narrowed in memory with [matches] instead of searching again.
+class SearchSession<T> {
+  static final _logger = Logger('SearchSession');
+
+  static const Duration defaultDebounce = Duration(milliseconds: 250);
+
+  final SearchSource<T> _source;
+  final bool Function(T item, String query)? _matches;
+  final Duration debounce;
+  final int maxResults;
+
+  final StreamController<SearchPage<T>> _pages = StreamController.broadcast();
+  Timer? _debounceTimer;
+  SearchCancelToken? _active;
+  String? _query;
+  SearchPage<T>? _current;
+  SearchPage<T>? _lastComplete;
+
+  SearchSession({
+    required SearchSource<T> source,
+    bool Function(T item, String query)? matches,
+    this.debounce = defaultDebounce,
+    this.maxResults = 200,
+  }) : _source = source,
+       _matches = matches;
+
+  Stream<SearchPage<T>> get pages => _pages.stream;
+
+  /// Latest page emitted for the current query, if any
+  SearchPage<T>? get current => _current;
+
+  String? get query => _query;
+
+  /// Search for [query]; [immediate] skips the debounce (e.g. on submit)
+  void update(String query, {bool immediate = false}) {
+    final normalized = query.trim();
+    if (normalized == _query) {
+      if (immediate && _debounceTimer != null) {
+        _debounceTimer!.cancel();
+        _debounceTimer = null;
+        unawaited(_run(normalized));
+      }
+      return;
+    }
+    _supersede();
+    _query = normalized;
+
+    if (normalized.isEmpty) {
+      _emit(
+        SearchPage(
+          query: normalized,
+          results: const [],
+          isComplete: true,
+          hasMore: false,
+          elapsed: Duration.zero,
+        ),
+      );
+      return;
+    }
+
+    final narrowed = _narrow(normalized);
+    if (narrowed != null) {
+      _lastComplete = narrowed;
+      _emit(narrowed);
+      return;
+    }
+
+    if (immediate || debounce == Duration.zero) {
+      unawaited(_run(normalized));
+    } else {
+      _debounceTimer = Timer(debounce, () {
+        _debounceTimer = null;
+        unawaited(_run(normalized));
+      });
+    }
+  }
+
+  /// Forget reusable results (e.g. filters changed) and re-run the query
+  void restart({bool immediate = true}) {
+    final query = _query;
+    _supersede();
+    _query = null;
+    _lastComplete = null;
+    if (query != null) update(query, immediate: immediate);
+  }
+
+  Future<void> dispose() async {
+    _supersede();
+    await _pages.close();
+  }
+
+  void _supersede() {
+    _debounceTimer?.cancel();
+    _debounceTimer = null;
+    _active?.cancel();
+    _active = null;
+  }
+
+  SearchPage<T>? _narrow(String query) {
+    final previous = _lastComplete;
+    final matches = _matches;
+    if (previous == null || matches == null || previous.hasMore) return null;
+    if (previous.query.isEmpty ||
+        !query.toLowerCase().startsWith(previous.query.toLowerCase())) {
+      return null;
+    }
+    return SearchPage(
+      query: query,
+      results: previous.results.where((item) => matches(item, query)).toList(),
+      isComplete: true,
+      hasMore: false,
+      elapsed: Duration.zero,
+    );
+  }
+
+  Future<void> _run(String query) async {
+    final token = SearchCancelToken();
+    _active = token;
+    final stopwatch = Stopwatch()..start();
+    final results = <T>[];
+    var hasMore = false;
+
+    try {
+      await for (final chunk in _source(query, token)) {
+        if (token.isCancelled) return;
+        final room = maxResults - results.length;
+        results.addAll(chunk.length > room ? chunk.take(room) : chunk);
+        if (chunk.length > room) {
+          hasMore = true;
+          token.cancel();
+          break;
+        }
+        _emit(
+          SearchPage(
+            query: query,
+            results: List.unmodifiable(results),
+            isComplete: false,
+            hasMore: false,
+            elapsed: stopwatch.elapsed,
+          ),
+        );
+      }
+    } catch (e, stack) {
+      if (token.isCancelled && !hasMore) return;
+      _logger.warning('Search for "$query" failed: $e');
+      if (!_pages.isClosed) _pages.addError(e, stack);
+      return;
+    }
+    if (!identical(_active, token)) return;
+    _active = null;
+
+    final page = SearchPage<T>(
+      query: query,
+      results: List.unmodifiable(results),
+      isComplete: true,
+      hasMore: hasMore,
+      elapsed: stopwatch.elapsed,
+    );
+    _lastComplete = page;
+    _emit(page);
+  }
+
+  void _emit(SearchPage<T> page) {
+    _current = page;
+    if (!_pages.isClosed) _pages.add(page);
+  }
+}
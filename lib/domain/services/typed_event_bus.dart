@@ -0,0 +1,277 @@
+import 'dart:async';
+import 'dart:collection';
+
+import 'package:logging/logging.dart';
+
+/// How a subscriber receives events from an [EventChannel]
+enum EventDelivery {
+  /// Inline on the emitting call; for protocol and state logic that must
+  /// observe every event in order.
+  sync,
+
+  /// Batched once per frame; events with the same key inside one frame
+  /// collapse to the latest. For UI subscribers that only render state.
+  frame,
+}
+
+/// Schedules [callback] for the next frame
+typedef FrameScheduler = void Function(void Function() callback);
+
+/// Counters for one [EventChannel] since it was registered
+class EventChannelStats {
+  final String name;
+  final int subscribers;
+  final int emitted;
+  final int delivered;
+
+  /// Frame-delivered events replaced by a later event with the same key
+  final int coalesced;
+
+  /// Time spent running synchronous subscribers per emit
+  final Duration totalDispatch;
+  final Duration maxDispatch;
+
+  /// Longest wait between an emit and its frame delivery
+  final Duration maxFrameLatency;
+
+  const EventChannelStats({
+    required this.name,
+    required this.subscribers,
+    required this.emitted,
+    required this.delivered,
+    required this.coalesced,
+    required this.totalDispatch,
+    required this.maxDispatch,
+    required this.maxFrameLatency,
+  });
+
+  Duration get meanDispatch => emitted == 0
+      ? Duration.zero
+      : Duration(microseconds: totalDispatch.inMicroseconds ~/ emitted);
+
+  @override
+  String toString() =>
+      '$name: $emitted emitted, $delivered delivered, $coalesced coalesced, '
+      '$subscribers subscribers, dispatch mean ${meanDispatch.inMicroseconds}'
+      'µs max ${maxDispatch.inMicroseconds}µs, frame latency max '
+      '${maxFrameLatency.inMilliseconds}ms';
+}
+
+/// Handle returned by [EventChannel.listen]
+abstract interface class EventSubscription {
+  void cancel();
+}
+
+/// Registry of named, typed [EventChannel]s.
+///
+/// Channels are registered once up front, so emitting is a field read and
+/// a loop over an immutable subscriber list: no per-event snapshot copies
+/// or closures. Subscribing and cancelling swap in a new list instead.
+class TypedEventBus {
+  /// One frame at 60 Hz; used when no [FrameScheduler] is supplied
+  static const Duration defaultFrameInterval = Duration(milliseconds: 16);
+
+  final Logger _logger;
+  final FrameScheduler _scheduleFrame;
+  final Stopwatch _clock = Stopwatch()..start();
+  final Map<String, EventChannel<Object?>> _channels = {};
+
+  TypedEventBus({Logger? logger, FrameScheduler? scheduleFrame})
+    : _logger = logger ?? Logger('TypedEventBus'),
+      _scheduleFrame =
+          scheduleFrame ??
+          ((callback) => Timer(defaultFrameInterval, callback));
+
+  EventChannel<T> register<T>(String name) {
+    if (_channels.containsKey(name)) {
+      throw StateError('Event channel "$name" is already registered');
+    }
+    final channel = EventChannel<T>._(name, this);
+    _channels[name] = channel;
+    return channel;
+  }
+
+  EventChannel<T> channel<T>(String name) {
+    final channel = _channels[name];
+    if (channel == null) {
+      throw StateError('Event channel "$name" is not registered');
+    }
+    return channel as EventChannel<T>;
+  }
+
+  Map<String, EventChannelStats> get stats => {
+    for (final channel in _channels.values) channel.name: channel.stats,
+  };
+
+  /// Drop every subscriber on every channel (counters are kept)
+  void clear() {
+    for (final channel in _channels.values) {
+      channel.clear();
+    }
+  }
+}
+
+/// One typed event stream on a [TypedEventBus]
+class EventChannel<T> {
+  EventChannel._(this.name, this._bus);
+
+  final String name;
+  final TypedEventBus _bus;
+  List<_Subscriber<T>> _subscribers = const [];
+
+  int _emitted = 0;
+  int _delivered = 0;
+  int _coalesced = 0;
+  int _dispatchMicros = 0;
+  int _maxDispatchMicros = 0;
+  int _maxFrameLatencyMicros = 0;
+
+  bool get hasSubscribers => _subscribers.isNotEmpty;
+
+  EventChannelStats get stats => EventChannelStats(
+    name: name,
+    subscribers: _subscribers.length,
+    emitted: _emitted,
+    delivered: _delivered,
+    coalesced: _coalesced,
+    totalDispatch: Duration(microseconds: _dispatchMicros),
+    maxDispatch: Duration(microseconds: _maxDispatchMicros),
+    maxFrameLatency: Duration(microseconds: _maxFrameLatencyMicros),
+  );
+
+  /// Subscribe [onEvent]. With [EventDelivery.frame], [keyOf] decides which
+  /// events collapse within a frame (default: equal events).
+  EventSubscription listen(
+    void Function(T event) onEvent, {
+    EventDelivery delivery = EventDelivery.sync,
+    Object? Function(T event)? keyOf,
+  }) {
+    final subscriber = switch (delivery) {
+      EventDelivery.sync => _Subscriber<T>(this, onEvent),
+      EventDelivery.frame => _FrameSubscriber<T>(this, onEvent, keyOf),
+    };
+    _subscribers = List.unmodifiable([..._subscribers, subscriber]);
+    return subscriber;
+  }
+
+  /// Stream view of [listen]; [initial] is read and sent first on each
+  /// subscription.
+  Stream<T> stream({
+    EventDelivery delivery = EventDelivery.sync,
+    Object? Function(T event)? keyOf,
+    T Function()? initial,
+  }) {
+    return Stream<T>.multi((controller) {
+      if (initial != null) controller.add(initial());
+      final subscription = listen(
+        controller.add,
+        delivery: delivery,
+        keyOf: keyOf,
+      );
+      controller.onCancel = subscription.cancel;
+    });
+  }
+
+  void emit(T event) {
+    _emitted++;
+    final subscribers = _subscribers;
+    if (subscribers.isEmpty) return;
+
+    final start = _bus._clock.elapsedMicroseconds;
+    for (final subscriber in subscribers) {
+      subscriber.add(event, start);
+    }
+    final took = _bus._clock.elapsedMicroseconds - start;
+    _dispatchMicros += took;
+    if (took > _maxDispatchMicros) _maxDispatchMicros = took;
+  }
+
+  void clear() {
+    for (final subscriber in _subscribers) {
+      subscriber.cancelled = true;
+    }
+    _subscribers = const [];
+  }
+
+  void _remove(_Subscriber<T> subscriber) {
+    _subscribers = List.unmodifiable(
+      _subscribers.where((s) => !identical(s, subscriber)),
+    );
+  }
+
+  void _deliver(void Function(T event) onEvent, T event) {
+    try {
+      onEvent(event);
+      _delivered++;
+    } catch (error, stackTrace) {
+      _bus._logger.warning(
+        'Error notifying $name subscriber: $error',
+        error,
+        stackTrace,
+      );
+    }
+  }
+}
+
+class _Subscriber<T> implements EventSubscription {
+  _Subscriber(this.channel, this.onEvent);
+
+  final EventChannel<T> channel;
+  final void Function(T event) onEvent;
+  bool cancelled = false;
+
+  void add(T event, int emittedAt) {
+    if (!cancelled) channel._deliver(onEvent, event);
+  }
+
+  @override
+  void cancel() {
+    if (cancelled) return;
+    cancelled = true;
+    channel._remove(this);
+  }
+}
+
+class _FrameSubscriber<T> extends _Subscriber<T> {
+  _FrameSubscriber(super.channel, super.onEvent, this.keyOf);
+
+  final Object? Function(T event)? keyOf;
+  final LinkedHashMap<Object?, T> _pending = LinkedHashMap();
+  int _firstQueuedAt = 0;
+
+  @override
+  void add(T event, int emittedAt) {
+    if (cancelled) return;
+    if (_pending.isEmpty) {
+      _firstQueuedAt = emittedAt;
+      channel._bus._scheduleFrame(_flush);
+    }
+    final key = keyOf == null ? event : keyOf!(event);
+    if (_pending.containsKey(key)) {
+      channel._coalesced++;
+      // Re-insert at the end so the flush follows each key's latest event.
+      _pending.remove(key);
+    }
+    _pending[key] = event;
+  }
+
+  void _flush() {
+    if (cancelled || _pending.isEmpty) return;
+    final latency = channel._bus._clock.elapsedMicroseconds - _firstQueuedAt;
+    if (latency > channel._maxFrameLatencyMicros) {
+      channel._maxFrameLatencyMicros = latency;
+    }
+    final events = _pending.values.toList(growable: false);
+    _pending.clear();
+    for (final event in events) {
+      if (cancelled) return;
+      channel._deliver(onEvent, event);
+    }
+  }
+
+  @override
+  void cancel() {
+    _pending.clear();
+    super.cancel();
+  }
+}
@@ -11,6 +11,7 @@
 // 3. Sort mapped values and encode deltas using Golomb-Rice coding
 // 4. Golomb-Rice: delta = quotient (unary) + remainder (P bits)
 
+import 'dart:convert';
 import 'dart:typed_data';
 import 'package:crypto/crypto.dart';
 import 'dart:math' as math;
@@ -24,14 +25,19 @@ class GCSFilterParams {
   const GCSFilterParams({required this.p, required this.m, required this.data});
 
   /// Convert to JSON for serialization
-  Map<String, dynamic> toJson() => {'p': p, 'm': m, 'data': data.toList()};
+  ///
+  /// The bitstream is base64 rather than an integer array (~4x smaller).
+  Map<String, dynamic> toJson() => {'p': p, 'm': m, 'data': base64Encode(data)};
 
-  /// Create from JSON
+  /// Create from JSON (base64 or legacy integer-array bitstream)
   factory GCSFilterParams.fromJson(Map<String, dynamic> json) {
+    final raw = json['data'];
     return GCSFilterParams(
       p: json['p'] as int,
       m: json['m'] as int,
-      data: Uint8List.fromList((json['data'] as List).cast<int>()),
+      data: raw is String
+          ? base64Decode(raw)
+          : Uint8List.fromList((raw as List).cast<int>()),
     );
   }
 }
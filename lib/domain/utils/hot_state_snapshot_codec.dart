@@ -0,0 +1,227 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+/// Versioned flat binary container for hot in-memory state.
+///
+/// Format (big-endian):
+/// [0..3]   : magic 'PKHS'
+/// [4..5]   : format version (u16)
+/// [6..7]   : section count (u16)
+/// [8..15]  : written-at epoch millis (i64)
+/// then per section:
+///   tag (u16), section version (u16), payload length (u32),
+///   CRC-32 of payload (u32), payload bytes
+///
+/// Each section is checked independently, so a corrupt or outdated section
+/// only sends its owner back to the database; the others still restore.
+class HotStateSnapshotCodec {
+  static const List<int> magic = [0x50, 0x4B, 0x48, 0x53]; // 'PKHS'
+  static const int formatVersion = 1;
+  static const int _headerLength = 16;
+  static const int _sectionHeaderLength = 12;
+
+  static Uint8List encode(
+    Iterable<HotStateSection> sections, {
+    required DateTime writtenAt,
+  }) {
+    final list = sections.toList(growable: false);
+    final writer = HotStateWriter()
+      ..bytes(magic)
+      ..u16(formatVersion)
+      ..u16(list.length)
+      ..i64(writtenAt.millisecondsSinceEpoch);
+    for (final section in list) {
+      writer
+        ..u16(section.tag)
+        ..u16(section.version)
+        ..u32(section.payload.length)
+        ..u32(crc32(section.payload))
+        ..bytes(section.payload);
+    }
+    return writer.takeBytes();
+  }
+
+  /// Parse the section table. Returns `null` when the magic, format version
+  /// or section table is invalid; payload checksums are verified lazily by
+  /// [HotStateSnapshot.section].
+  static HotStateSnapshot? decode(Uint8List bytes) {
+    if (bytes.length < _headerLength) return null;
+    for (var i = 0; i < magic.length; i++) {
+      if (bytes[i] != magic[i]) return null;
+    }
+
+    final data = ByteData.sublistView(bytes);
+    if (data.getUint16(4) != formatVersion) return null;
+    final count = data.getUint16(6);
+    final writtenAt = DateTime.fromMillisecondsSinceEpoch(data.getInt64(8));
+
+    final entries = <int, _SectionEntry>{};
+    var offset = _headerLength;
+    for (var i = 0; i < count; i++) {
+      if (offset + _sectionHeaderLength > bytes.length) return null;
+      final tag = data.getUint16(offset);
+      final version = data.getUint16(offset + 2);
+      final length = data.getUint32(offset + 4);
+      final checksum = data.getUint32(offset + 8);
+      offset += _sectionHeaderLength;
+      if (offset + length > bytes.length) return null;
+      entries[tag] = _SectionEntry(
+        version: version,
+        checksum: checksum,
+        payload: Uint8List.sublistView(bytes, offset, offset + length),
+      );
+      offset += length;
+    }
+
+    return HotStateSnapshot._(writtenAt, entries);
+  }
+
+  static final Uint32List _crcTable = _buildCrcTable();
+
+  static Uint32List _buildCrcTable() {
+    final table = Uint32List(256);
+    for (var n = 0; n < 256; n++) {
+      var c = n;
+      for (var k = 0; k < 8; k++) {
+        c = (c & 1) != 0 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+      }
+      table[n] = c;
+    }
+    return table;
+  }
+
+  /// IEEE 802.3 CRC-32.
+  static int crc32(Uint8List bytes) {
+    var crc = 0xFFFFFFFF;
+    for (final b in bytes) {
+      crc = _crcTable[(crc ^ b) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+  }
+}
+
+/// One owner's slice of the snapshot.
+class HotStateSection {
+  const HotStateSection({
+    required this.tag,
+    required this.version,
+    required this.payload,
+  });
+
+  final int tag;
+  final int version;
+  final Uint8List payload;
+}
+
+/// Decoded snapshot. Payloads are views into the file buffer.
+class HotStateSnapshot {
+  HotStateSnapshot._(this.writtenAt, this._entries);
+
+  final DateTime writtenAt;
+  final Map<int, _SectionEntry> _entries;
+
+  Iterable<int> get tags => _entries.keys;
+
+  /// Payload for [tag] if it was written with [version] and its checksum
+  /// still matches; otherwise `null`.
+  Uint8List? section(int tag, {required int version}) {
+    final entry = _entries[tag];
+    if (entry == null || entry.version != version) return null;
+    if (HotStateSnapshotCodec.crc32(entry.payload) != entry.checksum) {
+      return null;
+    }
+    return entry.payload;
+  }
+}
+
+class _SectionEntry {
+  const _SectionEntry({
+    required this.version,
+    required this.checksum,
+    required this.payload,
+  });
+
+  final int version;
+  final int checksum;
+  final Uint8List payload;
+}
+
+/// Append-only big-endian writer for section payloads.
+class HotStateWriter {
+  final BytesBuilder _builder = BytesBuilder(copy: false);
+  final ByteData _scratch = ByteData(8);
+
+  void u8(int value) => _builder.addByte(value & 0xFF);
+
+  void u16(int value) {
+    _scratch.setUint16(0, value);
+    _builder.add(Uint8List.sublistView(_scratch, 0, 2));
+  }
+
+  void u32(int value) {
+    _scratch.setUint32(0, value);
+    _builder.add(Uint8List.sublistView(_scratch, 0, 4));
+  }
+
+  void i64(int value) {
+    _scratch.setInt64(0, value);
+    _builder.add(Uint8List.sublistView(_scratch, 0, 8));
+  }
+
+  void bytes(List<int> value) => _builder.add(value);
+
+  /// Length-prefixed (u16) UTF-8 string.
+  void string(String value) {
+    final encoded = utf8.encode(value);
+    u16(encoded.length);
+    _builder.add(encoded);
+  }
+
+  Uint8List takeBytes() => _builder.takeBytes();
+}
+
+/// Sequential reader matching [HotStateWriter]. Throws [RangeError] when the
+/// payload is shorter than expected.
+class HotStateReader {
+  HotStateReader(Uint8List bytes)
+    : _bytes = bytes,
+      _data = ByteData.sublistView(bytes);
+
+  final Uint8List _bytes;
+  final ByteData _data;
+  int _offset = 0;
+
+  bool get isAtEnd => _offset >= _bytes.length;
+
+  int u8() => _data.getUint8(_offset++);
+
+  int u16() {
+    final value = _data.getUint16(_offset);
+    _offset += 2;
+    return value;
+  }
+
+  int u32() {
+    final value = _data.getUint32(_offset);
+    _offset += 4;
+    return value;
+  }
+
+  int i64() {
+    final value = _data.getInt64(_offset);
+    _offset += 8;
+    return value;
+  }
+
+  String string() {
+    final length = u16();
+    if (_offset + length > _bytes.length) {
+      throw RangeError('String of $length bytes overruns snapshot payload');
+    }
+    final value = utf8.decode(
+      Uint8List.sublistView(_bytes, _offset, _offset + length),
+    );
+    _offset += length;
+    return value;
+  }
+}
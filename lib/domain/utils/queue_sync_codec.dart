@@ -0,0 +1,243 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import '../models/mesh_relay_models.dart';
+import '../models/message_id_digests.dart';
+import 'gcs_filter.dart';
+
+/// Binary wire form of [QueueSyncMessage].
+///
+/// Sync frames go out periodically on every link, so they skip JSON
+/// entirely. Layout (integers are unsigned LEB128 varints unless noted):
+///
+/// ```
+/// u8 format version, u8 sync type, u8 section flags
+/// varint sync timestamp (epoch millis)
+/// str queue hash, str node ID
+/// [ids]   u8 digest width, varint count, count x width digest bytes
+/// [gcs]   varint p, varint m, varint length, raw Golomb-Rice bitstream
+/// [stats] varint total, pending, failed, last sync millis; f64 success rate
+/// ```
+///
+/// `str` is `varint(length << 1 | packed)` followed by either packed nibbles
+/// (lower-case hex such as hashes and keys, half the bytes) or UTF-8.
+///
+/// Message IDs travel as [MessageIdDigests]; per-message hashes are not
+/// carried (no receiver reads them).
+class QueueSyncCodec {
+  static const int formatVersion = 1;
+
+  static const int _flagIds = 0x01;
+  static const int _flagGcs = 0x02;
+  static const int _flagStats = 0x04;
+
+  static Uint8List encode(QueueSyncMessage message) {
+    final digests =
+        message.messageIdDigests ??
+        (message.messageIds.isEmpty
+            ? null
+            : MessageIdDigests.fromMessageIds(message.messageIds));
+    final gcs = message.gcsFilter;
+    final stats = message.queueStats;
+
+    final writer = _SyncWriter()
+      ..u8(formatVersion)
+      ..u8(message.syncType.index)
+      ..u8(
+        (digests != null ? _flagIds : 0) |
+            (gcs != null ? _flagGcs : 0) |
+            (stats != null ? _flagStats : 0),
+      )
+      ..varint(message.syncTimestamp.millisecondsSinceEpoch)
+      ..string(message.queueHash)
+      ..string(message.nodeId);
+
+    if (digests != null) {
+      final packed = digests.toPacked();
+      writer
+        ..u8(digests.width)
+        ..varint(digests.length)
+        ..bytes(packed);
+    }
+    if (gcs != null) {
+      writer
+        ..varint(gcs.p)
+        ..varint(gcs.m)
+        ..varint(gcs.data.length)
+        ..bytes(gcs.data);
+    }
+    if (stats != null) {
+      writer
+        ..varint(stats.totalMessages)
+        ..varint(stats.pendingMessages)
+        ..varint(stats.failedMessages)
+        ..varint(stats.lastSyncTime.millisecondsSinceEpoch)
+        ..f64(stats.successRate);
+    }
+    return writer.takeBytes();
+  }
+
+  /// Decode straight from [bytes] with no intermediate maps; the GCS
+  /// bitstream is a view into it. Throws [FormatException] on malformed or
+  /// unknown frames.
+  static QueueSyncMessage decode(Uint8List bytes) {
+    try {
+      final reader = _SyncReader(bytes);
+      final version = reader.u8();
+      if (version != formatVersion) {
+        throw FormatException('Unsupported queue sync format: $version');
+      }
+      final syncTypeIndex = reader.u8();
+      if (syncTypeIndex >= QueueSyncType.values.length) {
+        throw FormatException('Unknown queue sync type: $syncTypeIndex');
+      }
+      final flags = reader.u8();
+      final syncTimestamp = DateTime.fromMillisecondsSinceEpoch(
+        reader.varint(),
+      );
+      final queueHash = reader.string();
+      final nodeId = reader.string();
+
+      MessageIdDigests? digests;
+      if ((flags & _flagIds) != 0) {
+        final width = reader.u8();
+        final count = reader.varint();
+        digests = MessageIdDigests.fromPacked(
+          reader.view(count * width),
+          width: width,
+        );
+      }
+
+      GCSFilterParams? gcs;
+      if ((flags & _flagGcs) != 0) {
+        final p = reader.varint();
+        final m = reader.varint();
+        gcs = GCSFilterParams(p: p, m: m, data: reader.view(reader.varint()));
+      }
+
+      QueueSyncStats? stats;
+      if ((flags & _flagStats) != 0) {
+        stats = QueueSyncStats(
+          totalMessages: reader.varint(),
+          pendingMessages: reader.varint(),
+          failedMessages: reader.varint(),
+          lastSyncTime: DateTime.fromMillisecondsSinceEpoch(reader.varint()),
+          successRate: reader.f64(),
+        );
+      }
+
+      return QueueSyncMessage(
+        queueHash: queueHash,
+        messageIds: const <String>[],
+        syncTimestamp: syncTimestamp,
+        nodeId: nodeId,
+        syncType: QueueSyncType.values[syncTypeIndex],
+        queueStats: stats,
+        gcsFilter: gcs,
+        messageIdDigests: digests,
+      );
+    } on RangeError {
+      throw const FormatException('Truncated queue sync frame');
+    }
+  }
+}
+
+class _SyncWriter {
+  final BytesBuilder _builder = BytesBuilder(copy: false);
+  final ByteData _scratch = ByteData(8);
+
+  void u8(int value) => _builder.addByte(value & 0xFF);
+
+  void varint(int value) {
+    if (value < 0) {
+      throw ArgumentError.value(value, 'value', 'must be non-negative');
+    }
+    var remaining = value;
+    while (remaining >= 0x80) {
+      _builder.addByte((remaining & 0x7F) | 0x80);
+      remaining >>= 7;
+    }
+    _builder.addByte(remaining);
+  }
+
+  void f64(double value) {
+    _scratch.setFloat64(0, value);
+    _builder.add(Uint8List.sublistView(_scratch, 0, 8));
+  }
+
+  void bytes(List<int> value) => _builder.add(value);
+
+  void string(String value) {
+    if (value.isNotEmpty && value.length.isEven && _isLowerHex(value)) {
+      final packed = Uint8List(value.length ~/ 2);
+      for (var i = 0; i < packed.length; i++) {
+        packed[i] = int.parse(value.substring(i * 2, i * 2 + 2), radix: 16);
+      }
+      varint(packed.length << 1 | 1);
+      bytes(packed);
+      return;
+    }
+    final encoded = utf8.encode(value);
+    varint(encoded.length << 1);
+    bytes(encoded);
+  }
+
+  Uint8List takeBytes() => _builder.takeBytes();
+
+  static bool _isLowerHex(String value) {
+    for (final unit in value.codeUnits) {
+      final isDigit = unit >= 0x30 && unit <= 0x39;
+      final isLower = unit >= 0x61 && unit <= 0x66;
+      if (!isDigit && !isLower) return false;
+    }
+    return true;
+  }
+}
+
+class _SyncReader {
+  _SyncReader(this._bytes) : _data = ByteData.sublistView(_bytes);
+
+  final Uint8List _bytes;
+  final ByteData _data;
+  int _offset = 0;
+
+  int u8() => _data.getUint8(_offset++);
+
+  int varint() {
+    var result = 0;
+    var shift = 0;
+    while (true) {
+      if (shift > 56) throw const FormatException('Varint too long');
+      final byte = u8();
+      result |= (byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return result;
+      shift += 7;
+    }
+  }
+
+  double f64() {
+    final value = _data.getFloat64(_offset);
+    _offset += 8;
+    return value;
+  }
+
+  Uint8List view(int length) {
+    if (length < 0 || _offset + length > _bytes.length) {
+      throw RangeError('Frame truncated');
+    }
+    final view = Uint8List.sublistView(_bytes, _offset, _offset + length);
+    _offset += length;
+    return view;
+  }
+
+  String string() {
+    final header = varint();
+    final raw = view(header >> 1);
+    if ((header & 1) == 0) return utf8.decode(raw);
+    final buffer = StringBuffer();
+    for (final byte in raw) {
+      buffer.write(byte.toRadixString(16).padLeft(2, '0'));
+    }
+    return buffer.toString();
+  }
+}
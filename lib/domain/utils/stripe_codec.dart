@@ -0,0 +1,87 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+/// Block coding for transfers striped across several routes.
+///
+/// The UTF-8 payload is zero-padded and cut into `dataBlocks` equal blocks,
+/// followed by one XOR parity block, each base64-encoded so it can travel
+/// as ordinary relay content. Any `dataBlocks` of the `dataBlocks + 1`
+/// blocks rebuild the payload, so one lost or late route costs nothing.
+class StripeCodec {
+  static List<String> encode(String content, int dataBlocks) {
+    if (dataBlocks < 1) {
+      throw ArgumentError.value(dataBlocks, 'dataBlocks', 'must be positive');
+    }
+    final bytes = utf8.encode(content);
+    final blockSize = blockSizeFor(bytes.length, dataBlocks);
+    final parity = Uint8List(blockSize);
+    final blocks = <String>[];
+    for (var i = 0; i < dataBlocks; i++) {
+      final block = Uint8List(blockSize);
+      final start = i * blockSize;
+      if (start < bytes.length) {
+        final end = start + blockSize;
+        block.setRange(
+          0,
+          (end > bytes.length ? bytes.length : end) - start,
+          bytes,
+          start,
+        );
+      }
+      _xorInto(parity, block);
+      blocks.add(base64Encode(block));
+    }
+    blocks.add(base64Encode(parity));
+    return blocks;
+  }
+
+  /// Rebuild the payload from [blocks] (index to base64 block), or `null`
+  /// while more than one data block is missing.
+  static String? decode(
+    Map<int, String> blocks, {
+    required int dataBlocks,
+    required int length,
+  }) {
+    if (dataBlocks < 1 || length < 0) {
+      throw FormatException('Invalid stripe shape $dataBlocks/$length');
+    }
+    final missing = [
+      for (var i = 0; i < dataBlocks; i++)
+        if (!blocks.containsKey(i)) i,
+    ];
+    if (missing.length > 1) return null;
+    if (missing.length == 1 && !blocks.containsKey(dataBlocks)) return null;
+
+    final blockSize = blockSizeFor(length, dataBlocks);
+    final decoded = <int, Uint8List>{
+      for (final entry in blocks.entries)
+        if (entry.key <= dataBlocks) entry.key: base64Decode(entry.value),
+    };
+    if (decoded.values.any((block) => block.length != blockSize)) {
+      throw const FormatException('Stripe block size mismatch');
+    }
+
+    if (missing.isNotEmpty) {
+      final rebuilt = Uint8List.fromList(decoded[dataBlocks]!);
+      for (var i = 0; i < dataBlocks; i++) {
+        if (i != missing.first) _xorInto(rebuilt, decoded[i]!);
+      }
+      decoded[missing.first] = rebuilt;
+    }
+
+    final payload = Uint8List(blockSize * dataBlocks);
+    for (var i = 0; i < dataBlocks; i++) {
+      payload.setRange(i * blockSize, (i + 1) * blockSize, decoded[i]!);
+    }
+    return utf8.decode(Uint8List.sublistView(payload, 0, length));
+  }
+
+  static int blockSizeFor(int length, int dataBlocks) =>
+      length == 0 ? 1 : (length + dataBlocks - 1) ~/ dataBlocks;
+
+  static void _xorInto(Uint8List target, Uint8List source) {
+    for (var i = 0; i < target.length; i++) {
+      target[i] ^= source[i];
+    }
+  }
+}
@@ -6,6 +6,7 @@ import 'package:flutter_riverpod/flutter_riverpod.dart';
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 import 'package:logging/logging.dart';
 
+import 'background_dispatcher.dart';
 import 'core/app_core.dart';
 import 'core/di/service_locator.dart' show configureDataLayerRegistrar;
 import 'data/di/data_layer_service_registrar.dart';
@@ -116,6 +117,12 @@ class _AppWrapperState extends ConsumerState<AppWrapper>
         await _appCore.initialize();
         _logger.info('✅ App core initialized successfully from AppWrapper');
 
+        // Monitoring, power optimization, auto-archive and archive search
+        // start once the first post-ready frame is on screen.
+        WidgetsBinding.instance.addPostFrameCallback((_) {
+          _appCore.startDeferredInitialization();
+        });
+
         // 🧭 Register navigation callbacks (fix Core → Presentation layer violation)
         NavigationService.setChatScreenBuilder(
           ({
@@ -136,6 +143,8 @@ class _AppWrapperState extends ConsumerState<AppWrapper>
           NavigationServiceNotificationHandler(),
         );
         _logger.info('✅ Navigation callbacks registered');
+
+        await scheduleBackgroundRelayWork();
       } catch (e) {
         _logger.severe('❌ Failed to initialize app core from AppWrapper: $e');
       }
@@ -162,6 +171,8 @@ class _AppWrapperState extends ConsumerState<AppWrapper>
             'App paused - power management handled by burst scanning controller',
           );
           // Note: Power management is now handled automatically by BurstScanningController
+          // The process may be killed while paused; keep the restart path fast.
+          _appCore.persistHotStateSnapshot();
           break;
         case AppLifecycleState.resumed:
           _logger.info(
@@ -385,7 +396,8 @@ class _AppWrapperState extends ConsumerState<AppWrapper>
               // Otherwise show permission screen
               return const PermissionScreen();
             },
-            loading: () => _buildLoadingScreen(Theme.of(context)),
+            // BLE starts after READY; show the chat list meanwhile
+            loading: () => const HomeScreen(),
             error: (error, stack) => const PermissionScreen(),
           );
         },
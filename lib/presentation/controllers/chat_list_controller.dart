@@ -1,4 +1,5 @@
 import '../../domain/entities/chat_list_item.dart';
+import '../../domain/models/chat_list_model.dart';
 
 class ChatListController {
   List<ChatListItem> mergeChats({
@@ -29,15 +30,80 @@ class ChatListController {
     return _sorted(chats);
   }
 
+  /// Apply a coordinator [diff] to the rows on screen.
+  ///
+  /// The coordinator tracks the full, unfiltered list while the screen shows
+  /// a loaded page or search results, so rows are matched by chat ID and
+  /// placed by binary search instead of by the diff's index. Returns null
+  /// when [diff] does not touch the rows on screen.
+  List<ChatListItem>? applyDiff({
+    required List<ChatListItem> existing,
+    required ChatListDiff diff,
+    bool isSearching = false,
+    bool hasMore = false,
+    int pageSize = 50,
+  }) {
+    switch (diff) {
+      // Search results come from their own query.
+      case ChatListReset() when isSearching:
+        return null;
+      case ChatListReset(:final items):
+        final loaded = existing.length < pageSize ? pageSize : existing.length;
+        return items.take(loaded).toList();
+      case ChatRowInserted(:final item) ||
+          ChatRowUpdated(:final item) ||
+          ChatRowMoved(:final item):
+        return _place(existing, item, isSearching, hasMore);
+    }
+  }
+
+  List<ChatListItem>? _place(
+    List<ChatListItem> existing,
+    ChatListItem item,
+    bool isSearching,
+    bool hasMore,
+  ) {
+    final from = existing.indexWhere((c) => c.chatId == item.chatId);
+    // A filtered list only shows rows that matched the query.
+    if (from == -1 && isSearching) return null;
+
+    final chats = [...existing];
+    if (from != -1) chats.removeAt(from);
+    final to = _slotFor(chats, item);
+    // Rows sorting after the last loaded one belong to an unloaded page.
+    if (to == chats.length && hasMore && !isSearching) {
+      return from == -1 ? null : chats;
+    }
+    chats.insert(to, item);
+    return chats;
+  }
+
   List<ChatListItem> _sorted(List<ChatListItem> list) {
     final chats = [...list];
-    chats.sort((a, b) {
-      if (a.isOnline && !b.isOnline) return -1;
-      if (!a.isOnline && b.isOnline) return 1;
-      final aTime = a.lastMessageTime ?? DateTime(1970);
-      final bTime = b.lastMessageTime ?? DateTime(1970);
-      return bTime.compareTo(aTime);
-    });
+    chats.sort(_compare);
     return chats;
   }
+
+  /// First slot in [chats] whose row does not sort before [item]
+  static int _slotFor(List<ChatListItem> chats, ChatListItem item) {
+    var lo = 0;
+    var hi = chats.length;
+    while (lo < hi) {
+      final mid = (lo + hi) >> 1;
+      if (_compare(chats[mid], item) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  static int _compare(ChatListItem a, ChatListItem b) {
+    if (a.isOnline && !b.isOnline) return -1;
+    if (!a.isOnline && b.isOnline) return 1;
+    final aTime = a.lastMessageTime ?? DateTime(1970);
+    final bTime = b.lastMessageTime ?? DateTime(1970);
+    return bTime.compareTo(aTime);
+  }
 }
@@ -4,6 +4,7 @@ import 'package:logging/logging.dart';
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/entities/chat_list_item.dart';
 import '../../domain/entities/message.dart';
+import '../../domain/services/notification_service.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 
 /// Handles all scroll-related logic for ChatScreen
@@ -185,6 +186,7 @@ class ChatScrollingController {
       _hasScrolledAwayFromBottom = false;
       onUnreadCountChanged(0);
       await chatsRepository.markChatAsRead(chatId);
+      NotificationService.clearMessageNotifications(chatId);
       _logger.info('✅ Marked messages as read');
       _notifyStateChanged();
     } catch (e) {
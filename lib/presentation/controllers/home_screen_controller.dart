@@ -10,12 +10,14 @@ import 'package:logging/logging.dart';
 
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/interfaces/i_home_screen_facade.dart';
+import '../../domain/models/chat_list_model.dart';
 import '../../domain/models/connection_info.dart';
 import '../../domain/models/connection_status.dart';
 import '../../domain/entities/chat_list_item.dart';
 import '../../domain/services/chat_management_service.dart';
 import '../../domain/values/id_types.dart';
 import '../providers/ble_providers.dart';
+import 'chat_list_controller.dart';
 import '../providers/home_screen_providers.dart';
 import '../../domain/services/performance_monitor.dart';
 
@@ -65,6 +67,7 @@ class HomeScreenController extends ChangeNotifier {
   final ChatManagementService _chatManagementService;
   final IHomeScreenFacade _homeScreenFacade;
   final PerformanceMonitor _performanceMonitor = PerformanceMonitor();
+  final ChatListController _listController = ChatListController();
 
   bool _isDisposed = false;
   bool _isPaging = false;
@@ -80,6 +83,7 @@ class HomeScreenController extends ChangeNotifier {
   StreamSubscription? _connectionInfoSubscription;
   StreamSubscription? _discoveryDataSubscription;
   StreamSubscription? _globalMessageSubscription;
+  StreamSubscription<ChatListDiff>? _chatListSubscription;
 
   Future<void> initialize() async {
     if (_isDisposed) return;
@@ -92,6 +96,7 @@ class HomeScreenController extends ChangeNotifier {
     _setupPeripheralConnectionListener();
     _setupDiscoveryListener();
     _setupUnreadCountStream();
+    _setupChatListChanges();
     _setupGlobalMessageListener();
   }
 
@@ -268,18 +273,40 @@ class HomeScreenController extends ChangeNotifier {
     await loadChats();
   }
 
+  /// Patch rows from the facade's change feed instead of re-querying the
+  /// list for every stored message
+  void _setupChatListChanges() {
+    if (_isDisposed) return;
+    _chatListSubscription ??= _homeScreenFacade.chatListChanges.listen(
+      _applyChatListDiff,
+    );
+  }
+
+  void _applyChatListDiff(ChatListDiff diff) {
+    if (_isDisposed) return;
+    final updated = _listController.applyDiff(
+      existing: chats,
+      diff: diff,
+      isSearching: searchQuery.trim().isNotEmpty,
+      hasMore: _hasMore,
+      pageSize: _pageSize,
+    );
+    if (updated == null) return;
+    if (diff case ChatListReset(:final items)) {
+      _hasMore = items.length > updated.length;
+    }
+    chats = updated;
+    _offset = chats.length;
+    _safeNotifyListeners();
+  }
+
   void _setupGlobalMessageListener() {
     if (_isDisposed) return;
     try {
       final bleService = ref.read(connectionServiceProvider);
 
-      _globalMessageSubscription = bleService.receivedMessages.listen((
-        _,
-      ) async {
-        _logger.info(
-          'Global listener: New message received - updating chat list',
-        );
-        await updateSingleChatItem();
+      // The change feed patches the row once the message is stored.
+      _globalMessageSubscription = bleService.receivedMessages.listen((_) {
         _refreshUnreadCount();
       });
     } catch (e) {
@@ -394,6 +421,7 @@ class HomeScreenController extends ChangeNotifier {
     _connectionInfoSubscription?.cancel();
     _discoveryDataSubscription?.cancel();
     _globalMessageSubscription?.cancel();
+    _chatListSubscription?.cancel();
     _chatManagementService.dispose();
     _homeScreenFacade.dispose();
     super.dispose();
@@ -47,13 +47,23 @@ class _QRContactScreenState extends ConsumerState<QRContactScreen> {
       validityPeriod: const Duration(days: 14),
     );
 
-    // Save to repository
-    await _introHintRepo.saveMyActiveHint(hint);
-
+    if (!mounted) return;
     setState(() {
       _myHint = hint;
       _myQRData = hint.toQRString();
     });
+
+    // Show the code first; peers only match the saved hint during later
+    // discovery, long after this write lands.
+    try {
+      await _introHintRepo.saveMyActiveHint(hint);
+    } catch (e) {
+      if (mounted) {
+        ScaffoldMessenger.of(
+          context,
+        ).showSnackBar(SnackBar(content: Text('Failed to save QR hint: $e')));
+      }
+    }
   }
 
   IUserPreferences _resolveUserPreferences() {
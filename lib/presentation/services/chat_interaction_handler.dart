@@ -8,6 +8,7 @@ import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/interfaces/i_shared_message_queue_provider.dart';
 import '../../domain/entities/chat_list_item.dart';
 import '../../domain/services/chat_management_service.dart';
+import '../../domain/services/notification_service.dart';
 import '../../domain/values/id_types.dart';
 import '../providers/archive_provider.dart';
 import '../providers/ble_providers.dart';
@@ -83,6 +84,7 @@ class ChatInteractionHandler implements IChatInteractionHandler {
 
     try {
       await _chatsRepository?.markChatAsRead(chat.chatId);
+      NotificationService.clearMessageNotifications(chat.chatId);
 
       if (!_canNavigate()) return;
 
@@ -639,6 +641,7 @@ class ChatInteractionHandler implements IChatInteractionHandler {
   Future<void> markChatAsRead(ChatId chatId) async {
     try {
       await _chatsRepository?.markChatAsRead(chatId);
+      NotificationService.clearMessageNotifications(chatId);
       _logger.info('✅ Chat marked as read: ${chatId.value}');
     } catch (e) {
       _logger.severe('❌ Error marking chat as read: $e');
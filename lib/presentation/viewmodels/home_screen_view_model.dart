@@ -10,6 +10,7 @@ import 'package:logging/logging.dart';
 
 import '../../domain/interfaces/i_chats_repository.dart';
 import '../../domain/interfaces/i_home_screen_facade.dart';
+import '../../domain/models/chat_list_model.dart';
 import '../../domain/models/connection_info.dart';
 import '../../domain/models/connection_status.dart';
 import '../../domain/services/performance_monitor.dart';
@@ -36,6 +37,7 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
         args.chatListController ?? _ref.read(chatListControllerProvider);
 
     _ref.onDispose(() {
+      unawaited(_chatListSubscription?.cancel());
       if (_disposeFacadeOnTearDown) {
         unawaited(_homeScreenFacade.dispose());
       }
@@ -59,6 +61,7 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
   final PerformanceMonitor _performanceMonitor = PerformanceMonitor();
   late final ChatListController _listController;
   late final bool _disposeFacadeOnTearDown;
+  StreamSubscription<ChatListDiff>? _chatListSubscription;
 
   bool _initialized = false;
   bool _isPaging = false;
@@ -77,6 +80,7 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
     _setupPeripheralConnectionListener();
     _setupDiscoveryListener();
     _setupUnreadCountStream();
+    _setupChatListChanges();
     _setupGlobalMessageListener();
     _setupChatNotificationListeners();
   }
@@ -241,13 +245,35 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
     await loadChats();
   }
 
+  /// Patch rows from the facade's change feed instead of re-querying the
+  /// list for every stored message
+  void _setupChatListChanges() {
+    _chatListSubscription ??= _homeScreenFacade.chatListChanges.listen(
+      _applyChatListDiff,
+    );
+  }
+
+  void _applyChatListDiff(ChatListDiff diff) {
+    if (!mounted) return;
+    final chats = _listController.applyDiff(
+      existing: state.chats,
+      diff: diff,
+      isSearching: _searchQuery.trim().isNotEmpty,
+      hasMore: _hasMore,
+      pageSize: _pageSize,
+    );
+    if (chats == null) return;
+    if (diff case ChatListReset(:final items)) {
+      _hasMore = items.length > chats.length;
+    }
+    _offset = chats.length;
+    _updateState(state.copyWith(chats: chats, hasMore: _hasMore));
+  }
+
   void _setupGlobalMessageListener() {
     _ref.listen<AsyncValue<String>>(receivedMessagesProvider, (previous, next) {
-      next.whenData((_) async {
-        _logger.info(
-          'Global listener: New message received - updating chat list',
-        );
-        await updateSingleChatItem();
+      next.whenData((_) {
+        // The change feed patches the row once the message is stored.
         _refreshUnreadCount();
       });
     });
@@ -326,9 +352,9 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
       next,
     ) {
       next.whenData((event) async {
+        // Archive, pin and delete change which rows are listed.
         _logger.fine('Chat update received: $event');
-        await updateSingleChatItem();
-        _refreshUnreadCount();
+        await loadChats();
       });
     });
 
@@ -336,9 +362,8 @@ class HomeScreenViewModel extends StateNotifier<HomeScreenState> {
       previous,
       next,
     ) {
-      next.whenData((event) async {
+      next.whenData((event) {
         _logger.fine('Message update received: $event');
-        await updateSingleChatItem();
         _refreshUnreadCount();
       });
     });
@@ -4,6 +4,7 @@ import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
 import '../../domain/entities/enhanced_message.dart';
 import '../../domain/services/chat_management_service.dart' as chat_service;
+import '../../domain/services/search_session.dart';
 import '../../domain/values/id_types.dart';
 import 'modern_message_bubble.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
@@ -13,8 +14,23 @@ class ModernSearchDelegate extends SearchDelegate<String> {
   final chat_service.ChatManagementService _chatService;
   final ChatId? chatId;
 
+  /// Shortest query searched while typing; shorter ones show quick actions
+  static const int minLiveQueryLength = 2;
+
   // Search state
   chat_service.MessageSearchFilter? _currentFilter;
+  String? _recordedQuery;
+
+  /// Debounced, cancellable search shared by suggestions and results
+  late final SearchSession<EnhancedMessage> _session = SearchSession(
+    source: (query, token) => _chatService.streamMessageSearch(
+      query: query,
+      chatId: chatId?.value,
+      filter: _currentFilter,
+      cancelToken: token,
+    ),
+    matches: _chatService.messageMatchesQuery,
+  );
 
   ModernSearchDelegate({
     required chat_service.ChatManagementService chatService,
@@ -90,31 +106,25 @@ class ModernSearchDelegate extends SearchDelegate<String> {
     );
   }
 
+  @override
+  void close(BuildContext context, String result) {
+    // Cancel any search still reading the database.
+    _session.update('');
+    super.close(context, result);
+  }
+
   @override
   Widget buildResults(BuildContext context) {
     if (query.trim().isEmpty) {
       return _buildEmptyState(context, 'Enter a search term to find messages');
     }
 
-    return FutureBuilder<chat_service.MessageSearchResult>(
-      future: _performSearch(),
-      builder: (context, snapshot) {
-        if (snapshot.connectionState == ConnectionState.waiting) {
-          return _buildLoadingState(context);
-        }
-
-        if (snapshot.hasError) {
-          return _buildErrorState(context, snapshot.error.toString());
-        }
-
-        final result = snapshot.data;
-        if (result == null || result.results.isEmpty) {
-          return _buildEmptyState(context, 'No messages found for "$query"');
-        }
-
-        return _buildSearchResults(context, result);
-      },
-    );
+    if (_recordedQuery != query) {
+      _recordedQuery = query;
+      _chatService.recordMessageSearch(query);
+    }
+    _performSearch(immediate: true);
+    return _buildLiveResults(context);
   }
 
   @override
@@ -137,7 +147,11 @@ class ModernSearchDelegate extends SearchDelegate<String> {
         .toList();
 
     if (filteredSuggestions.isEmpty) {
-      return _buildQuickActions(context);
+      if (query.trim().length < minLiveQueryLength) {
+        return _buildQuickActions(context);
+      }
+      _performSearch();
+      return _buildLiveResults(context);
     }
 
     return ListView.builder(
@@ -174,21 +188,56 @@ class ModernSearchDelegate extends SearchDelegate<String> {
     );
   }
 
-  /// Perform search with current query and filters
-  Future<chat_service.MessageSearchResult> _performSearch() async {
-    return await _chatService.searchMessages(
-      query: query,
-      chatId: chatId?.value,
-      filter: _currentFilter,
-      limit: 50,
+  /// Point the search session at the current query and filters; typing is
+  /// debounced and supersedes any search still running
+  void _performSearch({bool immediate = false}) {
+    _session.update(query, immediate: immediate);
+  }
+
+  /// Results for the current query, re-rendered as each page arrives
+  Widget _buildLiveResults(BuildContext context) {
+    final current = _session.current;
+    return StreamBuilder<SearchPage<EnhancedMessage>>(
+      stream: _session.pages,
+      initialData: current?.query == query.trim() ? current : null,
+      builder: (context, snapshot) {
+        if (snapshot.hasError) {
+          return _buildErrorState(context, snapshot.error.toString());
+        }
+
+        // Keep showing the previous query's results until the new one
+        // produces its first page.
+        final page = snapshot.data;
+        final isStale = page?.query != query.trim();
+        if (page == null || (page.results.isEmpty && !page.isComplete)) {
+          return _buildLoadingState(context);
+        }
+
+        if (page.results.isEmpty) {
+          if (isStale) return _buildLoadingState(context);
+          return _buildEmptyState(context, 'No messages found for "$query"');
+        }
+
+        return _buildSearchResults(
+          context,
+          chat_service.MessageSearchResult.fromResults(
+            results: page.results,
+            query: page.query,
+            searchTime: page.elapsed,
+            hasMore: page.hasMore,
+          ),
+          isSearching: isStale || !page.isComplete,
+        );
+      },
     );
   }
 
   /// Build search results list
   Widget _buildSearchResults(
     BuildContext context,
-    chat_service.MessageSearchResult result,
-  ) {
+    chat_service.MessageSearchResult result, {
+    bool isSearching = false,
+  }) {
     final theme = Theme.of(context);
 
     return Column(
@@ -225,6 +274,8 @@ class ModernSearchDelegate extends SearchDelegate<String> {
           ),
         ),
 
+        if (isSearching) const LinearProgressIndicator(minHeight: 2),
+
         // Results list
         Expanded(
           child: chatId != null
@@ -574,6 +625,7 @@ class ModernSearchDelegate extends SearchDelegate<String> {
 
     if (result != null) {
       _currentFilter = result;
+      _session.restart();
       if (query.isNotEmpty) {
         WidgetsBinding.instance.addPostFrameCallback((_) {
           if (context.mounted) showResults(context);
@@ -650,6 +702,7 @@ class ModernSearchDelegate extends SearchDelegate<String> {
   void _viewStarredMessages(BuildContext context) {
     query = '';
     _currentFilter = const chat_service.MessageSearchFilter(isStarred: true);
+    _session.restart();
     showResults(context);
   }
 
@@ -663,6 +716,7 @@ class ModernSearchDelegate extends SearchDelegate<String> {
     _currentFilter = chat_service.MessageSearchFilter(
       dateRange: chat_service.DateTimeRange(start: today, end: tomorrow),
     );
+    _session.restart();
     showResults(context);
   }
 }
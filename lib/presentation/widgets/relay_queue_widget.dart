@@ -3,6 +3,7 @@ import 'package:logging/logging.dart';
 import '../../domain/messaging/offline_message_queue_contract.dart';
 import '../../domain/interfaces/i_mesh_networking_service.dart';
 import '../../domain/models/mesh_network_models.dart';
+import '../../domain/services/mesh/mesh_metrics_history.dart';
 import '../../domain/utils/mesh_debug_logger.dart';
 import 'package:pak_connect/domain/utils/string_extensions.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
@@ -168,6 +169,13 @@ class RelayQueueWidgetState extends State<RelayQueueWidget> {
                   ),
                   style: TextStyle(fontSize: 14, color: Colors.grey[600]),
                 ),
+                if (_buildRelayHistorySummary() case final history?) ...[
+                  SizedBox(height: 2),
+                  Text(
+                    history,
+                    style: TextStyle(fontSize: 12, color: Colors.grey[500]),
+                  ),
+                ],
               ],
             ),
           ),
@@ -226,6 +234,20 @@ class RelayQueueWidgetState extends State<RelayQueueWidget> {
     return '$statusText • $connectionText';
   }
 
+  /// Relay throughput over the last hour, read from the metrics history
+  String? _buildRelayHistorySummary() {
+    const window = Duration(hours: 1);
+    final history = MeshMetricsHistory.instance;
+    final relayed = history.total(MeshMetricsHistory.relayed, window).round();
+    final dropped = history
+        .dropsByReason(window)
+        .values
+        .fold<double>(0, (sum, count) => sum + count)
+        .round();
+    if (relayed == 0 && dropped == 0) return null;
+    return 'Last hour: $relayed relayed • $dropped dropped';
+  }
+
   /// Build the main queue list
   Widget _buildQueueList(MeshNetworkStatus status) {
     final queueMessages = status.queueMessages;
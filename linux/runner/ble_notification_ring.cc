@@ -0,0 +1,164 @@
+#include "ble_notification_ring.h"
+
+#include <cstring>
+#include <utility>
+
+constexpr uint32_t BleNotificationRing::kWrapMarker;
+constexpr size_t BleNotificationRing::kRecordHeaderSize;
+constexpr size_t BleNotificationRing::kDefaultCapacity;
+
+BleNotificationRing::BleNotificationRing(size_t capacity)
+    : capacity_(Align(capacity < kRecordHeaderSize * 2 ? kRecordHeaderSize * 2
+                                                        : capacity)),
+      buffer_(capacity_, 0) {}
+
+bool BleNotificationRing::Push(uint64_t connection,
+                               const uint8_t* data,
+                               size_t length) {
+  const size_t record = kRecordHeaderSize + Align(length);
+  if (length >= kWrapMarker || record > capacity_) {
+    dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const uint64_t write = write_pos_.load(std::memory_order_relaxed);
+  const uint64_t read = read_pos_.load(std::memory_order_acquire);
+  const size_t offset = static_cast<size_t>(write % capacity_);
+  const size_t tail_room = capacity_ - offset;
+  const size_t skip = tail_room < record ? tail_room : 0;
+  if ((write - read) + skip + record > capacity_) {
+    dropped_frames_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  uint64_t position = write;
+  if (skip > 0) {
+    // Offsets are multiples of 8 and headers are 16 bytes; a tail shorter
+    // than a header is never read (Peek stops at the buffer end).
+    if (tail_room >= kRecordHeaderSize) {
+      WriteHeader(offset, 0, kWrapMarker);
+    }
+    position += skip;
+  }
+
+  const size_t start = static_cast<size_t>(position % capacity_);
+  WriteHeader(start, connection, static_cast<uint32_t>(length));
+  if (length > 0) {
+    std::memcpy(&buffer_[start + kRecordHeaderSize], data, length);
+  }
+  const size_t padding = Align(length) - length;
+  if (padding > 0) {
+    std::memset(&buffer_[start + kRecordHeaderSize + length], 0, padding);
+  }
+
+  write_pos_.store(position + record, std::memory_order_release);
+  pushed_frames_.fetch_add(1, std::memory_order_relaxed);
+  pushed_bytes_.fetch_add(length, std::memory_order_relaxed);
+
+  if (!wakeup_pending_.exchange(true, std::memory_order_acq_rel)) {
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+    if (wakeup_) {
+      wakeup_();
+    }
+  }
+  return true;
+}
+
+void BleNotificationRing::SetWakeupCallback(std::function<void()> callback) {
+  wakeup_ = std::move(callback);
+}
+
+void BleNotificationRing::BeginDrain() {
+  wakeup_pending_.store(false, std::memory_order_release);
+}
+
+size_t BleNotificationRing::Peek(const uint8_t** data) {
+  uint64_t read = read_pos_.load(std::memory_order_relaxed);
+  const uint64_t write = write_pos_.load(std::memory_order_acquire);
+
+  if (read < write) {
+    const size_t offset = static_cast<size_t>(read % capacity_);
+    const size_t tail_room = capacity_ - offset;
+    if (tail_room < kRecordHeaderSize || LengthAt(offset) == kWrapMarker) {
+      read += tail_room;
+      read_pos_.store(read, std::memory_order_release);
+    }
+  }
+
+  const size_t start = static_cast<size_t>(read % capacity_);
+  uint64_t position = read;
+  while (position < write) {
+    const size_t offset = static_cast<size_t>(position % capacity_);
+    if (position != read && offset == 0) {
+      break;  // Reached the physical end; the rest is a separate span.
+    }
+    if (capacity_ - offset < kRecordHeaderSize) {
+      break;
+    }
+    const uint32_t length = LengthAt(offset);
+    if (length == kWrapMarker) {
+      break;
+    }
+    position += kRecordHeaderSize + Align(length);
+  }
+
+  *data = buffer_.data() + start;
+  return static_cast<size_t>(position - read);
+}
+
+void BleNotificationRing::Release(size_t bytes) {
+  const uint64_t read = read_pos_.load(std::memory_order_relaxed);
+  const uint64_t write = write_pos_.load(std::memory_order_acquire);
+  const uint64_t target = read + bytes;
+  read_pos_.store(target > write ? write : target, std::memory_order_release);
+}
+
+bool BleNotificationRing::HasPending() const {
+  return read_pos_.load(std::memory_order_acquire) <
+         write_pos_.load(std::memory_order_acquire);
+}
+
+BleNotificationRing::Stats BleNotificationRing::stats() const {
+  return Stats{pushed_frames_.load(std::memory_order_relaxed),
+               pushed_bytes_.load(std::memory_order_relaxed),
+               dropped_frames_.load(std::memory_order_relaxed),
+               wakeups_.load(std::memory_order_relaxed)};
+}
+
+uint32_t BleNotificationRing::LengthAt(size_t offset) const {
+  uint32_t length = 0;
+  std::memcpy(&length, &buffer_[offset + 8], sizeof(length));
+  return length;
+}
+
+void BleNotificationRing::WriteHeader(size_t offset,
+                                      uint64_t connection,
+                                      uint32_t length) {
+  const uint32_t reserved = 0;
+  std::memcpy(&buffer_[offset], &connection, sizeof(connection));
+  std::memcpy(&buffer_[offset + 8], &length, sizeof(length));
+  std::memcpy(&buffer_[offset + 12], &reserved, sizeof(reserved));
+}
+
+uint32_t SyntheticNotificationSource::Emit(uint64_t connection,
+                                           uint32_t count,
+                                           uint32_t size) {
+  if (size < 4) {
+    size = 4;
+  }
+  std::vector<uint8_t> payload(size);
+  uint32_t accepted = 0;
+  for (uint32_t n = 0; n < count; ++n) {
+    const uint32_t sequence = next_sequence_++;
+    for (uint32_t i = 0; i < 4; ++i) {
+      payload[i] = static_cast<uint8_t>(sequence >> (8 * i));
+    }
+    for (uint32_t i = 4; i < size; ++i) {
+      payload[i] = static_cast<uint8_t>(sequence + i);
+    }
+    if (ring_->Push(connection, payload.data(), payload.size())) {
+      ++accepted;
+    }
+  }
+  return accepted;
+}
@@ -0,0 +1,108 @@
+#ifndef RUNNER_BLE_NOTIFICATION_RING_H_
+#define RUNNER_BLE_NOTIFICATION_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Single-producer / single-consumer byte ring for inbound GATT notifications.
+//
+// The producer is the GLib main loop (acquired notify sockets or the
+// synthetic source); the consumer is the Dart isolate through the FFI exports
+// in ble_notification_ring_plugin.cc. Records are laid out in host byte order
+// as
+//
+//   [u64 connection][u32 length][u32 reserved][payload, zero-padded to 8]
+//
+// where |connection| is the remote's 48-bit Bluetooth address. Records never
+// straddle the end of the buffer: when one does not fit, a wrap marker
+// (length == kWrapMarker) is written and the record starts again at offset 0.
+// Peek() therefore always returns one contiguous span that Dart can copy in a
+// single memcpy instead of one platform-channel message per notification.
+class BleNotificationRing {
+ public:
+  static constexpr uint32_t kWrapMarker = 0xFFFFFFFFu;
+  static constexpr size_t kRecordHeaderSize = 16;
+  static constexpr size_t kDefaultCapacity = 1 << 20;
+
+  struct Stats {
+    uint64_t pushed_frames;
+    uint64_t pushed_bytes;
+    uint64_t dropped_frames;
+    uint64_t wakeups;
+  };
+
+  // |capacity| is rounded up to a multiple of 8.
+  explicit BleNotificationRing(size_t capacity);
+
+  BleNotificationRing(const BleNotificationRing&) = delete;
+  BleNotificationRing& operator=(const BleNotificationRing&) = delete;
+
+  // Producer side. Returns false (and counts a drop) when the ring is full.
+  bool Push(uint64_t connection, const uint8_t* data, size_t length);
+
+  // Called once per batch: on the first Push after BeginDrain().
+  void SetWakeupCallback(std::function<void()> callback);
+
+  // Consumer side. Re-arms the wakeup before reading so frames pushed while
+  // draining schedule exactly one further wakeup.
+  void BeginDrain();
+
+  // Consumer side. Contiguous readable span at the read cursor. Returns the
+  // span length in bytes (0 when empty) and stores its start in |data|.
+  size_t Peek(const uint8_t** data);
+
+  // Consumer side. Give back |bytes| previously returned by Peek().
+  void Release(size_t bytes);
+
+  // True when frames are waiting; used to re-signal a late listener.
+  bool HasPending() const;
+
+  Stats stats() const;
+
+ private:
+  static size_t Align(size_t length) { return (length + 7) & ~size_t{7}; }
+
+  uint32_t LengthAt(size_t offset) const;
+  void WriteHeader(size_t offset, uint64_t connection, uint32_t length);
+
+  const size_t capacity_;
+  std::vector<uint8_t> buffer_;
+
+  // Absolute positions; index = position % capacity_.
+  std::atomic<uint64_t> write_pos_{0};
+  std::atomic<uint64_t> read_pos_{0};
+
+  std::atomic<bool> wakeup_pending_{false};
+  std::function<void()> wakeup_;
+
+  std::atomic<uint64_t> pushed_frames_{0};
+  std::atomic<uint64_t> pushed_bytes_{0};
+  std::atomic<uint64_t> dropped_frames_{0};
+  std::atomic<uint64_t> wakeups_{0};
+};
+
+// Deterministic frames for tests and throughput measurements. Each payload
+// starts with a little-endian u32 sequence number followed by bytes
+// (sequence + i) & 0xFF.
+//
+// Emit() pushes directly and must run on the ring's producer thread; the
+// plugin hops to the main loop first.
+class SyntheticNotificationSource {
+ public:
+  explicit SyntheticNotificationSource(BleNotificationRing* ring)
+      : ring_(ring) {}
+
+  // Returns how many of the |count| frames the ring accepted.
+  uint32_t Emit(uint64_t connection, uint32_t count, uint32_t size);
+
+  uint32_t next_sequence() const { return next_sequence_; }
+
+ private:
+  BleNotificationRing* ring_;
+  uint32_t next_sequence_ = 0;
+};
+
+#endif  // RUNNER_BLE_NOTIFICATION_RING_H_
@@ -0,0 +1,189 @@
+#include "ble_notification_ring_plugin.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ble_notification_ring.h"
+#include "bluez_notify_source.h"
+
+namespace {
+
+constexpr char kChannelName[] = "pak_connect/ble_notification_ring";
+
+BleNotificationRing* Ring() {
+  static BleNotificationRing* ring =
+      new BleNotificationRing(BleNotificationRing::kDefaultCapacity);
+  return ring;
+}
+
+std::unique_ptr<BluezNotifySource> g_bluez_source;
+std::unique_ptr<SyntheticNotificationSource> g_synthetic_source;
+FlEventChannel* g_channel = nullptr;
+bool g_listening = false;
+const uint8_t* g_peek_data = nullptr;
+// Acquire outcomes reached before Dart subscribed; sent from OnListen.
+std::vector<std::pair<uint64_t, bool>> g_unsent_outcomes;
+
+void SendEvent(FlValue* event) {
+  g_autoptr(GError) error = nullptr;
+  if (!fl_event_channel_send(g_channel, event, nullptr, &error)) {
+    g_warning("BLE notification ring: failed to send event: %s",
+              error->message);
+  }
+}
+
+void SendAcquireOutcome(uint64_t connection, bool acquired) {
+  g_autoptr(FlValue) event = fl_value_new_list();
+  fl_value_append_take(event,
+                       fl_value_new_int(static_cast<int64_t>(connection)));
+  fl_value_append_take(event, fl_value_new_bool(acquired));
+  SendEvent(event);
+}
+
+gboolean EmitWakeup(gpointer user_data) {
+  if (g_channel != nullptr && g_listening) {
+    g_autoptr(FlValue) event = fl_value_new_null();
+    SendEvent(event);
+  }
+  return G_SOURCE_REMOVE;
+}
+
+void OnAcquired(uint64_t connection, bool acquired) {
+  if (g_channel != nullptr && g_listening) {
+    SendAcquireOutcome(connection, acquired);
+  } else {
+    g_unsent_outcomes.emplace_back(connection, acquired);
+  }
+}
+
+FlMethodErrorResponse* OnListen(FlEventChannel* channel,
+                                FlValue* args,
+                                gpointer user_data) {
+  g_listening = true;
+  for (const auto& outcome : g_unsent_outcomes) {
+    SendAcquireOutcome(outcome.first, outcome.second);
+  }
+  g_unsent_outcomes.clear();
+  // Frames pushed before Dart subscribed already consumed their wakeup.
+  if (Ring()->HasPending()) {
+    g_idle_add(EmitWakeup, nullptr);
+  }
+  return nullptr;
+}
+
+FlMethodErrorResponse* OnCancel(FlEventChannel* channel,
+                                FlValue* args,
+                                gpointer user_data) {
+  g_listening = false;
+  return nullptr;
+}
+
+struct InjectionRequest {
+  uint64_t connection;
+  uint32_t count;
+  uint32_t size;
+};
+
+gboolean RunInjection(gpointer user_data) {
+  std::unique_ptr<InjectionRequest> request(
+      static_cast<InjectionRequest*>(user_data));
+  g_synthetic_source->Emit(request->connection, request->count,
+                           request->size);
+  return G_SOURCE_REMOVE;
+}
+
+}  // namespace
+
+void ble_notification_ring_plugin_register(FlBinaryMessenger* messenger) {
+  g_autoptr(FlStandardMethodCodec) codec = fl_standard_method_codec_new();
+  g_clear_object(&g_channel);
+  g_channel =
+      fl_event_channel_new(messenger, kChannelName, FL_METHOD_CODEC(codec));
+  fl_event_channel_set_stream_handlers(g_channel, OnListen, OnCancel, nullptr,
+                                       nullptr);
+
+  // The ring's producers run on the main loop; defer the event so it is
+  // never sent from inside a socket or D-Bus dispatch.
+  Ring()->SetWakeupCallback([]() { g_idle_add(EmitWakeup, nullptr); });
+  g_synthetic_source = std::make_unique<SyntheticNotificationSource>(Ring());
+  g_bluez_source = std::make_unique<BluezNotifySource>(Ring(), OnAcquired);
+}
+
+int32_t pak_ble_ring_available() {
+  return g_channel != nullptr ? 1 : 0;
+}
+
+int32_t pak_ble_ring_acquire(uint64_t connection,
+                             uint64_t uuid_high,
+                             uint64_t uuid_low) {
+  if (g_bluez_source == nullptr) {
+    return 0;
+  }
+  g_autofree gchar* uuid = g_strdup_printf(
+      "%08x-%04x-%04x-%04x-%012llx", static_cast<guint>(uuid_high >> 32),
+      static_cast<guint>((uuid_high >> 16) & 0xFFFF),
+      static_cast<guint>(uuid_high & 0xFFFF),
+      static_cast<guint>(uuid_low >> 48),
+      static_cast<unsigned long long>(uuid_low & 0xFFFFFFFFFFFFULL));
+  return g_bluez_source->Acquire(connection, uuid) ? 1 : 0;
+}
+
+void pak_ble_ring_release_link(uint64_t connection) {
+  if (g_bluez_source != nullptr) {
+    g_bluez_source->Release(connection);
+  }
+}
+
+void pak_ble_ring_stop() {
+  if (g_bluez_source != nullptr) {
+    g_bluez_source->Stop();
+  }
+}
+
+void pak_ble_ring_begin_drain() {
+  Ring()->BeginDrain();
+}
+
+int64_t pak_ble_ring_peek() {
+  return static_cast<int64_t>(Ring()->Peek(&g_peek_data));
+}
+
+const uint8_t* pak_ble_ring_peek_data() {
+  return g_peek_data;
+}
+
+void pak_ble_ring_release(int64_t bytes) {
+  if (bytes > 0) {
+    Ring()->Release(static_cast<size_t>(bytes));
+  }
+  g_peek_data = nullptr;
+}
+
+void pak_ble_ring_inject_synthetic(uint64_t connection,
+                                   uint32_t count,
+                                   uint32_t size) {
+  if (g_synthetic_source == nullptr) {
+    return;
+  }
+  // Thread-safe: hops to the main context so the ring keeps a single
+  // producer.
+  g_main_context_invoke(nullptr, RunInjection,
+                        new InjectionRequest{connection, count, size});
+}
+
+uint64_t pak_ble_ring_stat(int32_t index) {
+  const BleNotificationRing::Stats stats = Ring()->stats();
+  switch (index) {
+    case 0:
+      return stats.pushed_frames;
+    case 1:
+      return stats.pushed_bytes;
+    case 2:
+      return stats.dropped_frames;
+    case 3:
+      return stats.wakeups;
+    default:
+      return 0;
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef RUNNER_BLE_NOTIFICATION_RING_PLUGIN_H_
+#define RUNNER_BLE_NOTIFICATION_RING_PLUGIN_H_
+
+#include <flutter_linux/flutter_linux.h>
+
+#include <cstdint>
+
+/**
+ * ble_notification_ring_plugin_register:
+ * @messenger: the engine's binary messenger.
+ *
+ * Creates the event channel "pak_connect/ble_notification_ring". It emits
+ * null once per batch of ring frames and a [connection, acquired] list with
+ * the outcome of each pak_ble_ring_acquire(). Frames themselves are read
+ * through the exported pak_ble_ring_* C functions over dart:ffi.
+ */
+void ble_notification_ring_plugin_register(FlBinaryMessenger* messenger);
+
+#define PAK_FFI_EXPORT extern "C" __attribute__((visibility("default"))) \
+  __attribute__((used))
+
+// Returns 1 once the runner has created the ring.
+PAK_FFI_EXPORT int32_t pak_ble_ring_available();
+
+// Take over notifications of the characteristic whose 128-bit UUID is
+// |uuid_high|:|uuid_low| on the link to |connection| (48-bit address), so
+// they reach Dart only through the ring. Returns 1 when the request was sent;
+// the outcome follows on the event channel.
+PAK_FFI_EXPORT int32_t pak_ble_ring_acquire(uint64_t connection,
+                                            uint64_t uuid_high,
+                                            uint64_t uuid_low);
+
+// Hand |connection|'s notifications back to BlueZ.
+PAK_FFI_EXPORT void pak_ble_ring_release_link(uint64_t connection);
+
+PAK_FFI_EXPORT void pak_ble_ring_stop();
+
+PAK_FFI_EXPORT void pak_ble_ring_begin_drain();
+
+// Length in bytes of the next contiguous span (0 when empty). The span start
+// is returned by pak_ble_ring_peek_data() until the next peek or release.
+PAK_FFI_EXPORT int64_t pak_ble_ring_peek();
+PAK_FFI_EXPORT const uint8_t* pak_ble_ring_peek_data();
+
+PAK_FFI_EXPORT void pak_ble_ring_release(int64_t bytes);
+
+// Queue |count| synthetic frames of |size| bytes for |connection|.
+PAK_FFI_EXPORT void pak_ble_ring_inject_synthetic(uint64_t connection,
+                                                  uint32_t count,
+                                                  uint32_t size);
+
+// Counter |index|: 0 pushed frames, 1 pushed bytes, 2 dropped frames,
+// 3 wakeups.
+PAK_FFI_EXPORT uint64_t pak_ble_ring_stat(int32_t index);
+
+#endif  // RUNNER_BLE_NOTIFICATION_RING_PLUGIN_H_
@@ -0,0 +1,305 @@
+#include "bluez_notify_source.h"
+
+#include <gio/gunixfdlist.h>
+#include <glib-unix.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <memory>
+#include <utility>
+
+namespace {
+
+constexpr char kBluezService[] = "org.bluez";
+constexpr char kObjectManagerInterface[] =
+    "org.freedesktop.DBus.ObjectManager";
+constexpr char kCharacteristicInterface[] = "org.bluez.GattCharacteristic1";
+constexpr gint kCallTimeoutMs = 2000;
+// Largest ATT MTU; a notification never exceeds it.
+constexpr size_t kMaxAttMtu = 517;
+
+// Object path of the characteristic with |uuid| on the device at
+// |connection|, or an empty string.
+std::string FindCharacteristicPath(GVariant* reply,
+                                   uint64_t connection,
+                                   const std::string& uuid) {
+  g_autoptr(GVariant) objects = g_variant_get_child_value(reply, 0);
+  GVariantIter iter;
+  g_variant_iter_init(&iter, objects);
+  const gchar* path = nullptr;
+  GVariant* interfaces = nullptr;
+  while (g_variant_iter_next(&iter, "{&o@a{sa{sv}}}", &path, &interfaces)) {
+    g_autoptr(GVariant) owned = interfaces;
+    if (BluezNotifySource::ConnectionFromPath(path) != connection) {
+      continue;
+    }
+    g_autoptr(GVariant) properties = g_variant_lookup_value(
+        interfaces, kCharacteristicInterface, G_VARIANT_TYPE_VARDICT);
+    const gchar* value = nullptr;
+    if (properties != nullptr &&
+        g_variant_lookup(properties, "UUID", "&s", &value) &&
+        g_ascii_strcasecmp(value, uuid.c_str()) == 0) {
+      return path;
+    }
+  }
+  return std::string();
+}
+
+}  // namespace
+
+BluezNotifySource::BluezNotifySource(BleNotificationRing* ring,
+                                     AcquireCallback on_acquired)
+    : ring_(ring), on_acquired_(std::move(on_acquired)) {}
+
+BluezNotifySource::~BluezNotifySource() {
+  Stop();
+  std::lock_guard<std::mutex> lock(mutex_);
+  g_clear_object(&bus_);
+}
+
+bool BluezNotifySource::Acquire(uint64_t connection,
+                                const std::string& characteristic_uuid) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (connection == 0 || !EnsureBusLocked()) {
+    return false;
+  }
+
+  auto found = links_.find(connection);
+  if (found != links_.end()) {
+    CloseLocked(&found->second);
+  }
+  Link& link = links_[connection];
+  link = Link();
+  link.serial = ++next_serial_;
+  g_autofree gchar* lowered =
+      g_ascii_strdown(characteristic_uuid.c_str(), -1);
+  link.uuid = lowered;
+
+  // The UUID is not part of the BlueZ object path, so the characteristic is
+  // looked up among the managed objects first. Both steps are asynchronous
+  // so neither the main loop nor |mutex_| waits on BlueZ.
+  g_dbus_connection_call(
+      bus_, kBluezService, "/", kObjectManagerInterface, "GetManagedObjects",
+      nullptr, G_VARIANT_TYPE("(a{oa{sa{sv}}})"), G_DBUS_CALL_FLAGS_NONE,
+      kCallTimeoutMs, cancellable_, OnObjectsListed,
+      new Request{this, connection, link.serial});
+  return true;
+}
+
+void BluezNotifySource::Release(uint64_t connection) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = links_.find(connection);
+  if (found == links_.end()) {
+    return;
+  }
+  CloseLocked(&found->second);
+  links_.erase(found);
+}
+
+void BluezNotifySource::Stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cancellable_ != nullptr) {
+    g_cancellable_cancel(cancellable_);
+    g_clear_object(&cancellable_);
+  }
+  for (auto& entry : links_) {
+    CloseLocked(&entry.second);
+  }
+  links_.clear();
+}
+
+uint64_t BluezNotifySource::ConnectionFromPath(const gchar* object_path) {
+  const gchar* device = g_strstr_len(object_path, -1, "/dev_");
+  if (device == nullptr) {
+    return 0;
+  }
+  device += 5;
+
+  uint64_t address = 0;
+  for (int octet = 0; octet < 6; ++octet) {
+    const gint high = g_ascii_xdigit_value(device[0]);
+    const gint low = high < 0 ? -1 : g_ascii_xdigit_value(device[1]);
+    if (high < 0 || low < 0) {
+      return 0;
+    }
+    address = (address << 8) | static_cast<uint64_t>((high << 4) | low);
+    device += 2;
+    if (octet < 5) {
+      if (*device != '_') {
+        return 0;
+      }
+      ++device;
+    }
+  }
+  return address;
+}
+
+void BluezNotifySource::OnObjectsListed(GObject* source,
+                                        GAsyncResult* result,
+                                        gpointer user_data) {
+  std::unique_ptr<Request> request(static_cast<Request*>(user_data));
+  g_autoptr(GError) error = nullptr;
+  g_autoptr(GVariant) reply =
+      g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), result, &error);
+  if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    return;
+  }
+
+  BluezNotifySource* self = request->source;
+  {
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    Link* link = self->FindLocked(*request);
+    if (link == nullptr) {
+      return;
+    }
+    const std::string path =
+        reply != nullptr
+            ? FindCharacteristicPath(reply, request->connection, link->uuid)
+            : std::string();
+    if (!path.empty()) {
+      g_dbus_connection_call_with_unix_fd_list(
+          self->bus_, kBluezService, path.c_str(), kCharacteristicInterface,
+          "AcquireNotify", g_variant_new("(a{sv})", nullptr),
+          G_VARIANT_TYPE("(hq)"), G_DBUS_CALL_FLAGS_NONE, kCallTimeoutMs,
+          nullptr, self->cancellable_, OnNotifyAcquired, request.release());
+      return;
+    }
+    g_warning("BLE notification ring: no %s characteristic on %012llx: %s",
+              link->uuid.c_str(),
+              static_cast<unsigned long long>(request->connection),
+              error != nullptr ? error->message : "not found");
+    self->links_.erase(request->connection);
+  }
+  self->on_acquired_(request->connection, false);
+}
+
+void BluezNotifySource::OnNotifyAcquired(GObject* source,
+                                         GAsyncResult* result,
+                                         gpointer user_data) {
+  std::unique_ptr<Request> request(static_cast<Request*>(user_data));
+  g_autoptr(GError) error = nullptr;
+  GUnixFDList* fd_list = nullptr;
+  g_autoptr(GVariant) reply = g_dbus_connection_call_with_unix_fd_list_finish(
+      G_DBUS_CONNECTION(source), &fd_list, result, &error);
+  g_autoptr(GUnixFDList) fds = fd_list;
+  if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    return;
+  }
+
+  int fd = -1;
+  guint16 mtu = 0;
+  if (reply != nullptr && fds != nullptr) {
+    gint32 handle = 0;
+    g_variant_get(reply, "(hq)", &handle, &mtu);
+    fd = g_unix_fd_list_get(fds, handle, &error);
+  }
+
+  BluezNotifySource* self = request->source;
+  bool acquired = false;
+  {
+    std::lock_guard<std::mutex> lock(self->mutex_);
+    Link* link = self->FindLocked(*request);
+    if (link == nullptr) {
+      // Released while the call was in flight; closing the socket hands
+      // the characteristic back to BlueZ.
+      if (fd >= 0) {
+        close(fd);
+      }
+      return;
+    }
+    if (fd < 0) {
+      g_warning("BLE notification ring: AcquireNotify on %012llx failed: %s",
+                static_cast<unsigned long long>(request->connection),
+                error != nullptr ? error->message : "no socket");
+      self->links_.erase(request->connection);
+    } else {
+      g_unix_set_fd_nonblocking(fd, TRUE, nullptr);
+      link->fd = fd;
+      link->mtu = mtu > kMaxAttMtu ? mtu : kMaxAttMtu;
+      link->watch_id = g_unix_fd_add_full(
+          G_PRIORITY_DEFAULT, fd,
+          static_cast<GIOCondition>(G_IO_IN | G_IO_HUP | G_IO_ERR),
+          OnReadable, new Request(*request),
+          [](gpointer data) { delete static_cast<Request*>(data); });
+      acquired = true;
+    }
+  }
+  self->on_acquired_(request->connection, acquired);
+}
+
+gboolean BluezNotifySource::OnReadable(gint fd,
+                                       GIOCondition condition,
+                                       gpointer user_data) {
+  const auto* request = static_cast<const Request*>(user_data);
+  BluezNotifySource* self = request->source;
+  std::lock_guard<std::mutex> lock(self->mutex_);
+  Link* link = self->FindLocked(*request);
+  if (link == nullptr) {
+    return G_SOURCE_REMOVE;
+  }
+
+  if ((condition & G_IO_IN) != 0) {
+    self->read_buffer_.resize(link->mtu);
+    // One datagram per notification; drain them all in this dispatch.
+    while (true) {
+      const ssize_t length = recv(fd, self->read_buffer_.data(),
+                                  self->read_buffer_.size(), MSG_DONTWAIT);
+      if (length > 0) {
+        self->ring_->Push(request->connection, self->read_buffer_.data(),
+                          static_cast<size_t>(length));
+        continue;
+      }
+      if (length < 0 && errno == EINTR) {
+        continue;
+      }
+      if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return G_SOURCE_CONTINUE;
+      }
+      break;  // End of stream or socket error.
+    }
+  }
+
+  // BlueZ closes the socket when the link drops or notifications stop. The
+  // source is removed by returning, so only the descriptor is closed here.
+  link->watch_id = 0;
+  close(link->fd);
+  self->links_.erase(request->connection);
+  return G_SOURCE_REMOVE;
+}
+
+bool BluezNotifySource::EnsureBusLocked() {
+  if (bus_ == nullptr) {
+    g_autoptr(GError) error = nullptr;
+    bus_ = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+    if (bus_ == nullptr) {
+      g_warning("BLE notification ring: system bus unavailable: %s",
+                error != nullptr ? error->message : "unknown");
+      return false;
+    }
+  }
+  if (cancellable_ == nullptr) {
+    cancellable_ = g_cancellable_new();
+  }
+  return true;
+}
+
+BluezNotifySource::Link* BluezNotifySource::FindLocked(
+    const Request& request) {
+  auto found = links_.find(request.connection);
+  if (found == links_.end() || found->second.serial != request.serial) {
+    return nullptr;
+  }
+  return &found->second;
+}
+
+void BluezNotifySource::CloseLocked(Link* link) {
+  if (link->watch_id != 0) {
+    g_source_remove(link->watch_id);
+    link->watch_id = 0;
+  }
+  if (link->fd >= 0) {
+    close(link->fd);
+    link->fd = -1;
+  }
+}
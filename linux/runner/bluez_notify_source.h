@@ -0,0 +1,95 @@
+#ifndef RUNNER_BLUEZ_NOTIFY_SOURCE_H_
+#define RUNNER_BLUEZ_NOTIFY_SOURCE_H_
+
+#include <gio/gio.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ble_notification_ring.h"
+
+// Feeds the ring from GATT characteristics the runner has taken over with
+// BlueZ AcquireNotify.
+//
+// BlueZ writes every notification of an acquired characteristic to a
+// SOCK_SEQPACKET socket instead of emitting a D-Bus "Value" change, so the
+// Bluetooth plugin never sees those frames and the ring is their only
+// delivery path. BlueZ refuses AcquireNotify on a characteristic that is
+// already notifying, so callers acquire instead of (not after) enabling
+// notifications through the plugin.
+//
+// Acquire/Release/Stop may be called from the Dart thread. D-Bus replies and
+// socket reads are dispatched on the global default main context, which
+// keeps the main loop the ring's only producer.
+class BluezNotifySource {
+ public:
+  // Runs on the main loop with the outcome of each Acquire().
+  using AcquireCallback =
+      std::function<void(uint64_t connection, bool acquired)>;
+
+  BluezNotifySource(BleNotificationRing* ring, AcquireCallback on_acquired);
+  ~BluezNotifySource();
+
+  BluezNotifySource(const BluezNotifySource&) = delete;
+  BluezNotifySource& operator=(const BluezNotifySource&) = delete;
+
+  // Take over notifications of |characteristic_uuid| (128-bit string form)
+  // on the link to |connection|. Returns false when the request could not be
+  // sent; otherwise the outcome arrives through the callback.
+  bool Acquire(uint64_t connection, const std::string& characteristic_uuid);
+
+  // Close the socket for |connection|; BlueZ then stops notifying it.
+  void Release(uint64_t connection);
+
+  // Release every link and cancel lookups in flight.
+  void Stop();
+
+  // "/org/bluez/hci0/dev_AA_BB_CC_DD_EE_FF/..." -> 0xAABBCCDDEEFF, or 0.
+  static uint64_t ConnectionFromPath(const gchar* object_path);
+
+ private:
+  struct Link {
+    uint64_t serial = 0;
+    std::string uuid;
+    int fd = -1;
+    guint watch_id = 0;
+    size_t mtu = 0;
+  };
+
+  // Identifies one Acquire() across its asynchronous steps; a reply whose
+  // link was released or re-acquired meanwhile is discarded.
+  struct Request {
+    BluezNotifySource* source;
+    uint64_t connection;
+    uint64_t serial;
+  };
+
+  static void OnObjectsListed(GObject* source,
+                              GAsyncResult* result,
+                              gpointer user_data);
+  static void OnNotifyAcquired(GObject* source,
+                               GAsyncResult* result,
+                               gpointer user_data);
+  static gboolean OnReadable(gint fd,
+                             GIOCondition condition,
+                             gpointer user_data);
+
+  bool EnsureBusLocked();
+  Link* FindLocked(const Request& request);
+  void CloseLocked(Link* link);
+
+  BleNotificationRing* ring_;
+  AcquireCallback on_acquired_;
+  std::mutex mutex_;
+  GDBusConnection* bus_ = nullptr;
+  GCancellable* cancellable_ = nullptr;
+  uint64_t next_serial_ = 0;
+  std::map<uint64_t, Link> links_;
+  std::vector<uint8_t> read_buffer_;
+};
+
+#endif  // RUNNER_BLUEZ_NOTIFY_SOURCE_H_
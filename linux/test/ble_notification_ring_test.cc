@@ -0,0 +1,195 @@
+// Runner-side notification ring exercised through SyntheticNotificationSource,
+// without BlueZ or a Flutter engine.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "runner/ble_notification_ring.h"
+
+namespace {
+
+int g_failures = 0;
+
+#define EXPECT(condition)                                              \
+  do {                                                                 \
+    if (!(condition)) {                                                \
+      std::fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, \
+                   #condition);                                        \
+      ++g_failures;                                                    \
+    }                                                                  \
+  } while (0)
+
+struct Frame {
+  uint64_t connection;
+  std::vector<uint8_t> payload;
+};
+
+// Same record layout the Dart decoder reads.
+std::vector<Frame> Decode(const uint8_t* data, size_t length) {
+  std::vector<Frame> frames;
+  size_t offset = 0;
+  while (offset + BleNotificationRing::kRecordHeaderSize <= length) {
+    Frame frame;
+    uint32_t size = 0;
+    std::memcpy(&frame.connection, data + offset, sizeof(frame.connection));
+    std::memcpy(&size, data + offset + 8, sizeof(size));
+    const size_t start = offset + BleNotificationRing::kRecordHeaderSize;
+    if (start + size > length) {
+      break;
+    }
+    frame.payload.assign(data + start, data + start + size);
+    frames.push_back(std::move(frame));
+    offset = start + ((size + 7) & ~size_t{7});
+  }
+  return frames;
+}
+
+std::vector<Frame> DrainAll(BleNotificationRing* ring) {
+  std::vector<Frame> frames;
+  ring->BeginDrain();
+  while (true) {
+    const uint8_t* data = nullptr;
+    const size_t bytes = ring->Peek(&data);
+    if (bytes == 0) {
+      break;
+    }
+    std::vector<Frame> span = Decode(data, bytes);
+    frames.insert(frames.end(), span.begin(), span.end());
+    ring->Release(bytes);
+  }
+  return frames;
+}
+
+uint32_t SequenceOf(const Frame& frame) {
+  uint32_t sequence = 0;
+  for (int i = 0; i < 4; ++i) {
+    sequence |= static_cast<uint32_t>(frame.payload[i]) << (8 * i);
+  }
+  return sequence;
+}
+
+bool PayloadIsIntact(const Frame& frame) {
+  const uint32_t sequence = SequenceOf(frame);
+  for (size_t i = 4; i < frame.payload.size(); ++i) {
+    if (frame.payload[i] != static_cast<uint8_t>(sequence + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BatchesShareOneWakeup() {
+  BleNotificationRing ring(4096);
+  SyntheticNotificationSource source(&ring);
+  int wakeups = 0;
+  ring.SetWakeupCallback([&wakeups]() { ++wakeups; });
+
+  EXPECT(source.Emit(0xAABBCCDDEEFF, 20, 13) == 20);
+  EXPECT(wakeups == 1);
+
+  const std::vector<Frame> frames = DrainAll(&ring);
+  EXPECT(frames.size() == 20);
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT(frames[i].connection == 0xAABBCCDDEEFF);
+    EXPECT(frames[i].payload.size() == 13);
+    EXPECT(SequenceOf(frames[i]) == i);
+    EXPECT(PayloadIsIntact(frames[i]));
+  }
+
+  source.Emit(0x112233445566, 3, 8);
+  EXPECT(wakeups == 2);
+  EXPECT(ring.stats().wakeups == 2);
+  EXPECT(DrainAll(&ring).size() == 3);
+  EXPECT(!ring.HasPending());
+}
+
+void WrapKeepsFramesInOrder() {
+  // 30-byte payloads take 48-byte records, so a 256-byte ring wraps often
+  // and leaves tails shorter than a header.
+  BleNotificationRing ring(256);
+  SyntheticNotificationSource source(&ring);
+
+  uint32_t expected = 0;
+  for (int round = 0; round < 50; ++round) {
+    EXPECT(source.Emit(1, 3, 30) == 3);
+    const std::vector<Frame> frames = DrainAll(&ring);
+    EXPECT(frames.size() == 3);
+    for (const Frame& frame : frames) {
+      EXPECT(SequenceOf(frame) == expected++);
+      EXPECT(PayloadIsIntact(frame));
+    }
+  }
+  EXPECT(ring.stats().dropped_frames == 0);
+}
+
+void FullRingDropsAndCounts() {
+  BleNotificationRing ring(128);
+  SyntheticNotificationSource source(&ring);
+
+  // 24-byte records: five fit in 128 bytes.
+  EXPECT(source.Emit(1, 8, 8) == 5);
+  EXPECT(ring.stats().pushed_frames == 5);
+  EXPECT(ring.stats().dropped_frames == 3);
+  // Larger than the whole ring.
+  EXPECT(source.Emit(1, 1, 200) == 0);
+
+  EXPECT(DrainAll(&ring).size() == 5);
+  EXPECT(source.Emit(1, 2, 8) == 2);
+}
+
+void ConcurrentProducerAndConsumer() {
+  BleNotificationRing ring(1 << 12);
+  SyntheticNotificationSource source(&ring);
+  constexpr uint32_t kFrames = 20000;
+  std::atomic<bool> done{false};
+
+  std::thread producer([&]() {
+    for (uint32_t sent = 0; sent < kFrames; sent += 16) {
+      source.Emit(7, 16, 20 + sent % 40);
+      std::this_thread::yield();
+    }
+    done.store(true);
+  });
+
+  std::vector<Frame> received;
+  while (true) {
+    const bool finished = done.load();
+    std::vector<Frame> frames = DrainAll(&ring);
+    received.insert(received.end(), frames.begin(), frames.end());
+    if (finished && frames.empty()) {
+      break;
+    }
+  }
+  producer.join();
+
+  const BleNotificationRing::Stats stats = ring.stats();
+  EXPECT(received.size() + stats.dropped_frames == kFrames);
+  EXPECT(received.size() == stats.pushed_frames);
+  uint32_t previous = 0;
+  for (size_t i = 0; i < received.size(); ++i) {
+    const uint32_t sequence = SequenceOf(received[i]);
+    EXPECT(i == 0 || sequence > previous);
+    EXPECT(PayloadIsIntact(received[i]));
+    previous = sequence;
+  }
+}
+
+}  // namespace
+
+int main() {
+  BatchesShareOneWakeup();
+  WrapKeepsFramesInOrder();
+  FullRingDropsAndCounts();
+  ConcurrentProducerAndConsumer();
+  if (g_failures > 0) {
+    std::fprintf(stderr, "%d expectation(s) failed\n", g_failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("ble_notification_ring_test: all passed\n");
+  return EXIT_SUCCESS;
+}
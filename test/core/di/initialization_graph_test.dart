@@ -0,0 +1,201 @@
+import 'dart:async';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/core/di/initialization_graph.dart';
+
+void main() {
+  group('InitializationGraph', () {
+    test('runs dependencies before dependents', () async {
+      final order = <String>[];
+      final graph = InitializationGraph()
+        ..addAll([
+          InitNode(
+            name: 'ble',
+            dependsOn: const ['identity', 'queue'],
+            run: () async => order.add('ble'),
+          ),
+          InitNode(name: 'repos', run: () async => order.add('repos')),
+          InitNode(
+            name: 'identity',
+            dependsOn: const ['repos'],
+            run: () async => order.add('identity'),
+          ),
+          InitNode(
+            name: 'queue',
+            dependsOn: const ['repos'],
+            run: () async => order.add('queue'),
+          ),
+        ]);
+
+      await graph.runEager();
+
+      expect(order.first, 'repos');
+      expect(order.last, 'ble');
+      expect(graph.isComplete('ble'), isTrue);
+    });
+
+    test('independent nodes run concurrently', () async {
+      final gateA = Completer<void>();
+      final gateB = Completer<void>();
+      var bothStarted = false;
+
+      final graph = InitializationGraph()
+        ..addAll([
+          InitNode(
+            name: 'a',
+            run: () async {
+              gateA.complete();
+              await gateB.future;
+            },
+          ),
+          InitNode(
+            name: 'b',
+            run: () async {
+              await gateA.future;
+              bothStarted = true;
+              gateB.complete();
+            },
+          ),
+        ]);
+
+      await graph.runEager().timeout(const Duration(seconds: 1));
+
+      expect(bothStarted, isTrue);
+    });
+
+    test('deferred nodes wait for runDeferred unless an eager node needs '
+        'them', () async {
+      final ran = <String>{};
+      final graph = InitializationGraph()
+        ..addAll([
+          InitNode(name: 'eager', run: () async => ran.add('eager')),
+          InitNode(
+            name: 'pulledForward',
+            tier: InitTier.deferred,
+            run: () async => ran.add('pulledForward'),
+          ),
+          InitNode(
+            name: 'needsDeferred',
+            dependsOn: const ['pulledForward'],
+            run: () async => ran.add('needsDeferred'),
+          ),
+          InitNode(
+            name: 'later',
+            tier: InitTier.deferred,
+            run: () async => ran.add('later'),
+          ),
+          InitNode(
+            name: 'onDemand',
+            tier: InitTier.lazy,
+            run: () async => ran.add('onDemand'),
+          ),
+        ]);
+
+      await graph.runEager();
+      expect(ran, {'eager', 'pulledForward', 'needsDeferred'});
+
+      await graph.runDeferred();
+      expect(ran, contains('later'));
+      expect(ran, isNot(contains('onDemand')));
+
+      await graph.ensure('onDemand');
+      expect(ran, contains('onDemand'));
+    });
+
+    test('each node runs once even when requested repeatedly', () async {
+      var runs = 0;
+      final graph = InitializationGraph()
+        ..add(
+          InitNode(
+            name: 'search',
+            tier: InitTier.lazy,
+            run: () async => runs++,
+          ),
+        );
+
+      await Future.wait([graph.ensure('search'), graph.ensure('search')]);
+      await graph.ensure('search');
+
+      expect(runs, 1);
+    });
+
+    test('eager failure propagates and dependents do not run', () async {
+      var dependentRan = false;
+      final graph = InitializationGraph()
+        ..addAll([
+          InitNode(name: 'db', run: () async => throw StateError('db down')),
+          InitNode(
+            name: 'chats',
+            dependsOn: const ['db'],
+            run: () async => dependentRan = true,
+          ),
+        ]);
+
+      await expectLater(graph.runEager(), throwsA(isA<StateError>()));
+      expect(dependentRan, isFalse);
+      final dbTiming = graph.timings.singleWhere((t) => t.name == 'db');
+      expect(dbTiming.succeeded, isFalse);
+      expect(dbTiming.error, contains('db down'));
+    });
+
+    test('deferred failure is contained', () async {
+      final graph = InitializationGraph()
+        ..add(
+          InitNode(
+            name: 'monitoring',
+            tier: InitTier.deferred,
+            run: () async => throw StateError('no metrics'),
+          ),
+        );
+
+      await graph.runDeferred();
+
+      expect(graph.isComplete('monitoring'), isFalse);
+    });
+
+    test('rejects cycles and unknown dependencies', () async {
+      final cyclic = InitializationGraph()
+        ..addAll([
+          InitNode(name: 'a', dependsOn: const ['b'], run: () async {}),
+          InitNode(name: 'b', dependsOn: const ['a'], run: () async {}),
+        ]);
+      expect(cyclic.runEager, throwsA(isA<StateError>()));
+
+      final dangling = InitializationGraph()
+        ..add(InitNode(name: 'a', dependsOn: const ['ghost'], run: () async {}));
+      expect(dangling.runEager, throwsA(isA<StateError>()));
+    });
+
+    test('abort skips nodes that have not started', () async {
+      var abort = false;
+      var secondRan = false;
+      final graph = InitializationGraph(shouldAbort: () => abort)
+        ..addAll([
+          InitNode(name: 'first', run: () async => abort = true),
+          InitNode(
+            name: 'second',
+            dependsOn: const ['first'],
+            run: () async => secondRan = true,
+          ),
+        ]);
+
+      await graph.runEager();
+
+      expect(secondRan, isFalse);
+      expect(graph.timings.last.skipped, isTrue);
+    });
+
+    test('exports per-node timings', () async {
+      final graph = InitializationGraph()
+        ..add(InitNode(name: 'repos', run: () async {}));
+
+      await graph.runEager();
+      final exported = graph.exportTimings();
+
+      expect(exported['wallClockMs'], isA<int>());
+      final nodes = exported['nodes'] as List;
+      expect((nodes.single as Map)['name'], 'repos');
+      expect((nodes.single as Map)['tier'], 'eager');
+    });
+  });
+}
@@ -15,11 +15,13 @@ import 'package:pak_connect/domain/interfaces/i_preferences_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_security_service.dart';
 import 'package:pak_connect/domain/interfaces/i_seen_message_store.dart';
 import 'package:pak_connect/domain/interfaces/i_shared_message_queue_provider.dart';
+import 'package:pak_connect/domain/services/app_event_channels.dart';
 import 'package:pak_connect/domain/services/archive_management_service.dart';
 import 'package:pak_connect/domain/services/archive_search_service.dart';
 import 'package:pak_connect/domain/services/chat_management_service.dart';
 import 'package:pak_connect/domain/services/contact_management_service.dart';
 import 'package:pak_connect/domain/services/mesh/mesh_network_health_monitor.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
 
 /// Tests for the internal service registry bootstrap boundary.
 void main() {
@@ -242,6 +244,17 @@ void main() {
           expect(bootstrap.homeScreenFacadeFactory, isNotNull);
           expect(bootstrap.chatConnectionManagerFactory, isNotNull);
           expect(bootstrap.chatListCoordinatorFactory, isNotNull);
+          expect(
+            bootstrap.eventBus,
+            same(resolveRegistered<TypedEventBus>()),
+          );
+          expect(
+            bootstrap.eventBus!.stats.keys,
+            containsAll([
+              AppEventChannels.connectionInfo,
+              AppEventChannels.connectionStatus,
+            ]),
+          );
         },
       );
 
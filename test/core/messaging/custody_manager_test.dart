@@ -0,0 +1,179 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/core/messaging/custody_manager.dart';
+import 'package:pak_connect/core/messaging/offline_message_queue.dart';
+import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
+
+MeshRelayMessage _bundle(
+  String id, {
+  MessagePriority priority = MessagePriority.normal,
+  bool custody = true,
+  String content = 'payload',
+}) {
+  final origin = RelayMetadata.create(
+    originalMessageContent: content,
+    priority: priority,
+    originalSender: 'origin',
+    finalRecipient: 'final',
+    currentNodeId: 'origin',
+    custody: custody,
+  );
+  return MeshRelayMessage.createRelay(
+    originalMessageId: id,
+    originalContent: content,
+    metadata: origin.nextHop('relay'),
+    relayNodeId: 'origin',
+  );
+}
+
+QueuedMessage _held(MeshRelayMessage bundle) => QueuedMessage(
+  id: 'held_${bundle.originalMessageId}',
+  chatId: '${CustodyManager.chatIdPrefix}next',
+  content: bundle.originalContent,
+  recipientPublicKey: 'next',
+  senderPublicKey: 'origin',
+  priority: bundle.relayMetadata.priority,
+  queuedAt: DateTime.now(),
+  maxRetries: 3,
+  expiresAt: bundle.relayMetadata.deadline,
+  isRelayMessage: true,
+  relayMetadata: bundle.relayMetadata,
+  originalMessageId: bundle.originalMessageId,
+);
+
+void main() {
+  late _HeldQueue queue;
+  late CustodyManager custody;
+
+  setUp(() {
+    queue = _HeldQueue();
+    custody = CustodyManager(
+      logger: Logger('CustodyManagerTest'),
+      messageQueue: queue,
+      qualityMonitor: ConnectionQualityMonitor(),
+      maxBundles: 2,
+    );
+  });
+
+  test('custody flag and deadline survive the wire form', () {
+    final metadata = _bundle(
+      'm1',
+      priority: MessagePriority.high,
+    ).relayMetadata;
+    final decoded = RelayMetadata.fromJson(metadata.toWireJson());
+
+    expect(decoded.custody, isTrue);
+    expect(decoded.nextHop('next').custody, isTrue);
+    expect(
+      decoded.deadline.millisecondsSinceEpoch,
+      metadata.relayTimestamp
+          .add(const Duration(hours: 12))
+          .millisecondsSinceEpoch,
+    );
+    expect(
+      _bundle('m2', custody: false).relayMetadata.toJson(),
+      isNot(contains('cu')),
+    );
+  });
+
+  test('accepts custody only when the bundle asks for it', () {
+    expect(
+      custody.tryAcceptCustody(
+        relayMessage: _bundle('m1'),
+        nextHopNodeId: 'next',
+      ),
+      isNotNull,
+    );
+    expect(
+      custody.tryAcceptCustody(
+        relayMessage: _bundle('m2', custody: false),
+        nextHopNodeId: 'next',
+      ),
+      isNull,
+    );
+  });
+
+  test('declines bundles that expire before the next encounter', () {
+    final bundle = _bundle('m1', priority: MessagePriority.low);
+    final nearDeadline = bundle.relayMetadata.deadline.subtract(
+      const Duration(minutes: 10),
+    );
+
+    expect(
+      custody.tryAcceptCustody(
+        relayMessage: bundle,
+        nextHopNodeId: 'next',
+        now: nearDeadline,
+      ),
+      isNull,
+    );
+  });
+
+  test('evicts the lowest-ranked bundle only once admitted', () async {
+    final low = _held(_bundle('low', priority: MessagePriority.low));
+    final high = _held(_bundle('high', priority: MessagePriority.high));
+    queue.held.addAll([low, high]);
+
+    final admission = custody.tryAcceptCustody(
+      relayMessage: _bundle('urgent', priority: MessagePriority.urgent),
+      nextHopNodeId: 'next',
+    );
+
+    expect(admission!.victims.map((m) => m.id), [low.id]);
+    expect(queue.removed, isEmpty);
+
+    await custody.evict(admission);
+    expect(queue.removed, [low.id]);
+  });
+
+  test('counts encoded bytes, not UTF-16 code units', () {
+    custody = CustodyManager(
+      logger: Logger('CustodyManagerTest'),
+      messageQueue: queue,
+      qualityMonitor: ConnectionQualityMonitor(),
+      maxBytes: 40,
+    );
+    // 20 code units, 60 bytes as UTF-8.
+    final wide = List.filled(20, '\u20ac').join();
+
+    expect(
+      custody.tryAcceptCustody(
+        relayMessage: _bundle('wide', content: wide),
+        nextHopNodeId: 'next',
+      ),
+      isNull,
+    );
+  });
+
+  test('keeps held bundles that outrank the incoming one', () {
+    queue.held.addAll([
+      _held(_bundle('a', priority: MessagePriority.high)),
+      _held(_bundle('b', priority: MessagePriority.urgent)),
+    ]);
+
+    final admission = custody.tryAcceptCustody(
+      relayMessage: _bundle('low', priority: MessagePriority.low),
+      nextHopNodeId: 'next',
+    );
+
+    expect(admission, isNull);
+    expect(queue.removed, isEmpty);
+  });
+}
+
+class _HeldQueue extends OfflineMessageQueue {
+  final List<QueuedMessage> held = [];
+  final List<String> removed = [];
+
+  @override
+  List<QueuedMessage> getMessagesByStatus(QueuedMessageStatus status) =>
+      held.where((m) => m.status == status).toList();
+
+  @override
+  Future<void> removeMessage(String messageId) async {
+    removed.add(messageId);
+    held.removeWhere((m) => m.id == messageId);
+  }
+}
@@ -565,6 +565,7 @@ class _FakeOfflineMessageQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async => 'queued_id';
 
  @override
@@ -582,6 +583,7 @@ class _FakeOfflineMessageQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async => const MessageId('queued_id');
 
  @override
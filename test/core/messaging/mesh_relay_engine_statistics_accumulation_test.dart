@@ -849,6 +849,7 @@ class _FakeOfflineQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async => 'queued_id';
 
  @override
@@ -866,6 +867,7 @@ class _FakeOfflineQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async => MessageId('queued_id');
 
  @override
@@ -0,0 +1,357 @@
+import 'dart:convert';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/core/messaging/multipath_relay_sender.dart';
+import 'package:pak_connect/core/messaging/offline_message_queue.dart';
+import 'package:pak_connect/core/messaging/relay_send_pipeline.dart';
+import 'package:pak_connect/core/messaging/stripe_assembler.dart';
+import 'package:pak_connect/domain/interfaces/i_mesh_routing_service.dart';
+import 'package:pak_connect/domain/interfaces/i_multipath_routing_service.dart';
+import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/message_priority.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/routing/multipath_stripe_tracker.dart';
+import 'package:pak_connect/domain/routing/routing_models.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
+import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
+import 'package:pak_connect/domain/utils/stripe_codec.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+
+final _payload = List.generate(300, (i) => 'block-$i ✓').join(' ');
+
+MessageRoute _route(List<String> hops, double score) => MessageRoute(
+  hops: hops,
+  score: score,
+  quality: RouteQuality.good,
+  estimatedLatency: 1000,
+  reliability: 0.9,
+);
+
+List<MeshRelayMessage> _stripes(String content, int dataBlocks) {
+  final metadata = RelayMetadata.create(
+    originalMessageContent: content,
+    priority: MessagePriority.normal,
+    originalSender: 'origin',
+    finalRecipient: 'dest',
+    currentNodeId: 'origin',
+  );
+  final encoded = StripeCodec.encode(content, dataBlocks);
+  return [
+    for (var i = 0; i < encoded.length; i++)
+      MeshRelayMessage.createRelay(
+        originalMessageId: 'msg#$i',
+        originalContent: encoded[i],
+        metadata: metadata.forStripe(
+          RelayStripe(
+            transferId: 'msg',
+            index: i,
+            dataBlocks: dataBlocks,
+            length: utf8.encode(content).length,
+          ),
+        ),
+        relayNodeId: 'origin',
+      ),
+  ];
+}
+
+void main() {
+  test('codec rebuilds the payload with any one block missing', () {
+    final blocks = StripeCodec.encode(_payload, 4);
+    expect(blocks, hasLength(5));
+    final length = utf8.encode(_payload).length;
+
+    for (var lost = 0; lost < blocks.length; lost++) {
+      final received = {
+        for (var i = 0; i < blocks.length; i++)
+          if (i != lost) i: blocks[i],
+      };
+      expect(
+        StripeCodec.decode(received, dataBlocks: 4, length: length),
+        _payload,
+      );
+    }
+    expect(
+      StripeCodec.decode(
+        {0: blocks[0], 1: blocks[1]},
+        dataBlocks: 4,
+        length: length,
+      ),
+      isNull,
+    );
+  });
+
+  test('selects node-disjoint routes only', () {
+    final paths = MultipathRoute.selectDisjoint(
+      [
+        _route(['me', 'a', 'x', 'dest'], 0.9),
+        _route(['me', 'b', 'x', 'dest'], 0.8),
+        _route(['me', 'a', 'dest'], 0.7),
+        _route(['me', 'c', 'dest'], 0.6),
+      ],
+      capacityOf: (route) => route.score,
+    );
+
+    expect(paths.map((p) => p.firstHop), ['a', 'c']);
+    expect(paths.first.capacity, 0.9);
+  });
+
+  test('assigns blocks in proportion to path weight', () {
+    final assignment = MultipathStripeTracker.assignBlocks({
+      'fast': 3.0,
+      'slow': 1.0,
+    }, 8);
+
+    expect(assignment['fast'], hasLength(6));
+    expect(assignment['slow'], hasLength(2));
+    // Interleaved rather than one path's share back to back.
+    expect(assignment['slow']!.first, lessThan(4));
+  });
+
+  test('assembler delivers once enough blocks arrive over any route', () {
+    final blocks = _stripes('hello multipath', 2);
+    final assembler = StripeAssembler(logger: Logger('StripeAssemblerTest'));
+
+    expect(assembler.add(blocks[2]), isNull);
+    final assembled = assembler.add(blocks[0]);
+
+    expect(assembled, isNotNull);
+    expect(assembled!.originalMessageId, 'msg');
+    expect(assembled.originalContent, 'hello multipath');
+    expect(assembler.add(blocks[1]), isNull);
+    expect(assembler.pendingTransfers, 0);
+  });
+
+  test('assembler rejects stripes outside the sender limits', () {
+    final assembler = StripeAssembler(logger: Logger('StripeAssemblerTest'));
+    final block = _stripes('hello multipath', 2).first;
+    MeshRelayMessage hostile(int index, int dataBlocks, int length) =>
+        MeshRelayMessage.createRelay(
+          originalMessageId: 'evil#$index',
+          originalContent: block.originalContent,
+          metadata: block.relayMetadata.forStripe(
+            RelayStripe(
+              transferId: 'evil',
+              index: index,
+              dataBlocks: dataBlocks,
+              length: length,
+            ),
+          ),
+          relayNodeId: 'origin',
+        );
+
+    for (final (index, dataBlocks, length) in [
+      (0, 1 << 40, 15),
+      (0, 0, 15),
+      (0, -1, 15),
+      (0, 2, -1),
+      (3, 2, 15),
+      (-1, 2, 15),
+      (0, 2, 2 * MultipathRelaySender.targetBlockBytes + 1),
+    ]) {
+      expect(assembler.add(hostile(index, dataBlocks, length)), isNull);
+    }
+    expect(assembler.pendingTransfers, 0);
+    expect(
+      () => StripeCodec.decode({}, dataBlocks: 0, length: 15),
+      throwsFormatException,
+    );
+  });
+
+  test('stripe position survives the wire form', () {
+    final metadata = _stripes('payload', 1).last.relayMetadata;
+    final decoded = RelayMetadata.fromJson(metadata.toWireJson());
+
+    expect(decoded.stripe!.transferId, 'msg');
+    expect(decoded.stripe!.isParity, isTrue);
+    expect(decoded.nextHop('relay').stripe!.index, 1);
+    expect(
+      decoded.messageHash,
+      isNot(_stripes('payload', 1).first.relayMetadata.messageHash),
+    );
+  });
+
+  test('ACK progress moves outstanding blocks to the faster path', () async {
+    final tracker = MultipathStripeTracker();
+    final stripes = _stripes(_payload, 4);
+    final resent = <(String, String)>[];
+    tracker.registerTransfer(
+      transferId: 'msg',
+      dataBlocks: 4,
+      blocks: {
+        0: (stripes[0], 'fast'),
+        1: (stripes[1], 'slow'),
+        2: (stripes[2], 'slow'),
+        3: (stripes[3], 'slow'),
+        4: (stripes[4], 'slow'),
+      },
+      resend: (block, hop) async => resent.add((block.originalMessageId, hop)),
+    );
+    MultipathRoute route(String hop) =>
+        MultipathRoute(route: _route(['me', hop, 'dest'], 0.8), capacity: 1);
+
+    await tracker.recordAck('msg#0');
+
+    expect(resent, [('msg#4', 'fast')]);
+    expect(
+      tracker.weightOf(route('fast')),
+      greaterThan(tracker.weightOf(route('slow'))),
+    );
+    await tracker.recordAck('unrelated#1');
+    expect(tracker.trackedTransfers, 1);
+  });
+
+  group('MultipathRelaySender', () {
+    late _HopQueue queue;
+    late MultipathRelaySender sender;
+
+    MeshRelayMessage originated() {
+      final content = List.filled(4, _payload).join();
+      return MeshRelayMessage.createRelay(
+        originalMessageId: 'big',
+        originalContent: content,
+        metadata: RelayMetadata.create(
+          originalMessageContent: content,
+          priority: MessagePriority.normal,
+          originalSender: 'origin',
+          finalRecipient: 'dest',
+          currentNodeId: 'origin',
+        ),
+        relayNodeId: 'origin',
+      );
+    }
+
+    Future<int> send() => sender.trySend(
+      relayMessage: originated(),
+      availableHops: ['a', 'b'],
+      routingService: _TwoRoutes(),
+    );
+
+    setUp(() {
+      queue = _HopQueue();
+      sender = MultipathRelaySender(
+        logger: Logger('MultipathRelaySenderTest'),
+        sendPipeline: RelaySendPipeline(
+          logger: Logger('MultipathRelaySenderTest'),
+          messageQueue: queue,
+          spamPrevention: _NoopSpamPrevention(),
+        ),
+        tracker: MultipathStripeTracker(),
+      );
+    });
+
+    tearDown(PeerCapabilityRegistry.instance.clear);
+
+    test('stripes only when every hop and the destination support it', () async {
+      for (final peer in ['a', 'b']) {
+        PeerCapabilityRegistry.instance.record(peer, PeerCapabilities.local);
+      }
+      expect(await send(), 0);
+      expect(queue.held, isEmpty);
+
+      PeerCapabilityRegistry.instance.record('dest', PeerCapabilities.local);
+      expect(await send(), 2);
+      expect(queue.held.map((m) => m.recipientPublicKey).toSet(), {'a', 'b'});
+    });
+
+    test('withdraws queued blocks when too few went out', () async {
+      for (final peer in ['a', 'b', 'dest']) {
+        PeerCapabilityRegistry.instance.record(peer, PeerCapabilities.local);
+      }
+      queue.rejectedHop = 'b';
+
+      expect(await send(), 0);
+      expect(queue.held, isEmpty);
+    });
+  });
+
+  test('stripe blocks are not deliveries', () {
+    final result = RelayProcessingResult.stripeReceived();
+
+    expect(result.type, RelayProcessingType.stripeBlock);
+    expect(result.isDelivered, isFalse);
+  });
+}
+
+class _TwoRoutes implements IMeshRoutingService, IMultipathRoutingService {
+  @override
+  Future<List<MultipathRoute>> determineMultipathRoutes({
+    required String finalRecipient,
+    required List<String> availableHops,
+    required MessagePriority priority,
+    int maxPaths = 3,
+  }) async => [
+    for (final hop in availableHops)
+      MultipathRoute(
+        route: _route(['me', hop, finalRecipient], 0.8),
+        capacity: 1,
+      ),
+  ];
+
+  @override
+  dynamic noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+class _HopQueue extends OfflineMessageQueue {
+  final List<QueuedMessage> held = [];
+  String? rejectedHop;
+
+  @override
+  Future<MessageId> queueMessageWithIds({
+    required ChatId chatId,
+    required String content,
+    required ChatId recipientId,
+    required ChatId senderId,
+    MessagePriority priority = MessagePriority.normal,
+    MessageId? replyToMessageId,
+    List<String> attachments = const [],
+    bool isRelayMessage = false,
+    RelayMetadata? relayMetadata,
+    String? originalMessageId,
+    String? relayNodeId,
+    String? messageHash,
+    bool persistToStorage = true,
+    bool isOriginator = false,
+  }) async {
+    if (recipientId.value == rejectedHop) {
+      throw const MessageQueueException('relay quota exceeded');
+    }
+    final id = 'held_${held.length}';
+    held.add(
+      QueuedMessage(
+        id: id,
+        chatId: chatId.value,
+        content: content,
+        recipientPublicKey: recipientId.value,
+        senderPublicKey: senderId.value,
+        priority: priority,
+        queuedAt: DateTime.now(),
+        maxRetries: 3,
+        isRelayMessage: isRelayMessage,
+        relayMetadata: relayMetadata,
+        originalMessageId: originalMessageId,
+      ),
+    );
+    return MessageId(id);
+  }
+
+  @override
+  List<QueuedMessage> getMessagesByStatus(QueuedMessageStatus status) =>
+      held.where((m) => m.status == status).toList();
+
+  @override
+  Future<void> removeMessage(String messageId) async {
+    held.removeWhere((m) => m.id == messageId);
+  }
+}
+
+class _NoopSpamPrevention extends SpamPreventionManager {
+  @override
+  Future<void> recordRelayOperation({
+    required String fromNodeId,
+    required String toNodeId,
+    required String messageHash,
+    required int messageSize,
+  }) async {}
+}
@@ -53,6 +53,7 @@ class _SpyOfflineMessageQueue extends OfflineMessageQueue {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = 'msg-${_messages.length + 1}';
     final message = QueuedMessage(
@@ -92,6 +93,7 @@ class _SpyOfflineMessageQueue extends OfflineMessageQueue {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await queueMessage(
       chatId: chatId.value,
@@ -107,6 +109,7 @@ class _SpyOfflineMessageQueue extends OfflineMessageQueue {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
     return MessageId(id);
   }
@@ -0,0 +1,80 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/core/messaging/outbox_ack_window.dart';
+
+void main() {
+  test('releases up to the window and refills on out-of-order ACKs', () {
+    final window = OutboxAckWindow(windowSize: 3);
+    final ids = List.generate(6, (i) => 'm$i');
+
+    expect(window.enqueue('peer', ids), ['m0', 'm1', 'm2']);
+    expect(window.waitingFor('peer'), 3);
+
+    expect(window.complete('m2'), ['m3']);
+    expect(window.complete('m0'), ['m4']);
+    expect(window.complete('unknown'), isEmpty);
+    expect(window.inFlightFor('peer'), 3);
+  });
+
+  test('ignores messages already in flight or waiting', () {
+    final window = OutboxAckWindow(windowSize: 1);
+
+    expect(window.enqueue('peer', ['a', 'b']), ['a']);
+    expect(window.enqueue('peer', ['a', 'b', 'c']), isEmpty);
+    expect(window.waitingFor('peer'), 2);
+
+    // Completing a waiting message drops it without releasing anything.
+    expect(window.complete('b'), isEmpty);
+    expect(window.complete('a'), ['c']);
+  });
+
+  test('peers have independent windows', () {
+    final window = OutboxAckWindow(windowSize: 1);
+
+    expect(window.enqueue('p1', ['a1', 'a2']), ['a1']);
+    expect(window.enqueue('p2', ['b1']), ['b1']);
+    expect(window.complete('b1'), isEmpty);
+    expect(window.complete('a1'), ['a2']);
+  });
+
+  test('reclaims slots that never report back', () {
+    final window = OutboxAckWindow(
+      windowSize: 1,
+      slotTimeout: const Duration(seconds: 10),
+    );
+    final start = DateTime(2024);
+
+    expect(window.enqueue('peer', ['a', 'b'], now: start), ['a']);
+    expect(
+      window.enqueue(
+        'peer',
+        const [],
+        now: start.add(const Duration(seconds: 11)),
+      ),
+      ['b'],
+    );
+    expect(window.complete('a'), isEmpty);
+  });
+
+  test('reclaimExpired frees timed-out slots across peers', () {
+    final window = OutboxAckWindow(
+      windowSize: 1,
+      slotTimeout: const Duration(seconds: 10),
+    );
+    final start = DateTime(2024);
+    window
+      ..enqueue('p1', ['a1', 'a2'], now: start)
+      ..enqueue('p2', ['b1'], now: start.add(const Duration(seconds: 5)));
+
+    expect(window.reclaimExpired(now: start), isEmpty);
+    expect(
+      window.reclaimExpired(now: start.add(const Duration(seconds: 11))),
+      ['a2'],
+    );
+    expect(
+      window.reclaimExpired(now: start.add(const Duration(seconds: 16))),
+      isEmpty,
+    );
+    expect(window.inFlightFor('p1'), 1);
+    expect(window.hasInFlight, isTrue);
+  });
+}
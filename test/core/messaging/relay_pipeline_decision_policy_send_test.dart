@@ -542,6 +542,7 @@ class _FakeOfflineQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async {
  queuedCount++;
  return 'queued_id';
@@ -562,6 +563,7 @@ class _FakeOfflineQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async {
  queuedCount++;
  return const MessageId('queued_id');
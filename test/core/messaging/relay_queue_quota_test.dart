@@ -0,0 +1,158 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/core/messaging/relay_queue_quota.dart';
+import 'package:pak_connect/domain/entities/queued_message.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/message_priority.dart';
+
+QueuedMessage _relay(
+  String id, {
+  String origin = 'origin',
+  String destination = 'dest',
+  int bytes = 100,
+  String? content,
+  MessagePriority priority = MessagePriority.normal,
+  bool originated = false,
+}) {
+  final metadata = RelayMetadata.create(
+    originalMessageContent: id,
+    priority: priority,
+    originalSender: origin,
+    finalRecipient: destination,
+    currentNodeId: origin,
+  ).nextHop('me').nextHop('next');
+  return QueuedMessage(
+    id: id,
+    chatId: 'mesh_relay_next',
+    content: content ?? 'x' * bytes,
+    recipientPublicKey: 'next',
+    senderPublicKey: origin,
+    priority: priority,
+    queuedAt: DateTime.now(),
+    maxRetries: 3,
+    isRelayMessage: true,
+    relayMetadata: metadata,
+    originalMessageId: id,
+    relayNodeId: origin,
+    isOriginator: originated,
+  );
+}
+
+void main() {
+  test('messages this node originated are never charged', () {
+    final quota = RelayQueueQuota(maxTotalBytes: 50);
+    final own = _relay('own', bytes: 500, originated: true);
+
+    expect(RelayQueueQuota.isCharged(own), isFalse);
+    expect(quota.admit(own, const []).admitted, isTrue);
+    quota.charge(own);
+    expect(quota.totalBytes, 0);
+  });
+
+  test('a short routing path from a peer does not exempt a relay', () {
+    final quota = RelayQueueQuota(maxTotalBytes: 50);
+    final spoofed = QueuedMessage(
+      id: 'spoofed',
+      chatId: 'mesh_relay_next',
+      content: 'x' * 500,
+      recipientPublicKey: 'next',
+      senderPublicKey: 'origin',
+      priority: MessagePriority.normal,
+      queuedAt: DateTime.now(),
+      maxRetries: 3,
+      isRelayMessage: true,
+      relayMetadata: RelayMetadata.create(
+        originalMessageContent: 'spoofed',
+        priority: MessagePriority.normal,
+        originalSender: 'origin',
+        finalRecipient: 'dest',
+        currentNodeId: 'origin',
+      ),
+      relayNodeId: 'origin',
+    );
+
+    expect(RelayQueueQuota.isCharged(spoofed), isTrue);
+    expect(quota.admit(spoofed, const []).admitted, isFalse);
+  });
+
+  test('charges encoded bytes, not UTF-16 code units', () {
+    final quota = RelayQueueQuota();
+    quota.charge(_relay('wide', content: 'ü' * 10));
+
+    expect(quota.totalBytes, 20);
+  });
+
+  test('charge and release keep origin and destination totals', () {
+    final quota = RelayQueueQuota();
+    final a = _relay('a', origin: 'o1', destination: 'd1');
+    final b = _relay('b', origin: 'o1', destination: 'd2', bytes: 50);
+
+    quota
+      ..charge(a)
+      ..charge(b)
+      ..charge(a);
+    expect(quota.totalBytes, 150);
+    expect(quota.bytesFromOrigin('o1'), 150);
+    expect(quota.bytesToDestination('d2'), 50);
+
+    quota.release('a');
+    expect(quota.totalBytes, 50);
+    expect(quota.bytesToDestination('d1'), 0);
+  });
+
+  test('evicts the lowest-utility relay to make room', () {
+    final quota = RelayQueueQuota(maxTotalBytes: 250);
+    final low = _relay('low', origin: 'o1', priority: MessagePriority.low);
+    final normal = _relay('normal', origin: 'o2');
+    quota
+      ..charge(low)
+      ..charge(normal);
+
+    final decision = quota.admit(
+      _relay('urgent', origin: 'o3', priority: MessagePriority.urgent),
+      [low, normal],
+    );
+
+    expect(decision.admitted, isTrue);
+    expect(decision.victims.map((m) => m.id), ['low']);
+  });
+
+  test('rejects an incoming relay worth less than everything queued', () {
+    final quota = RelayQueueQuota(maxTotalBytes: 150);
+    final high = _relay('high', priority: MessagePriority.high);
+    quota.charge(high);
+
+    final decision = quota.admit(
+      _relay('low', origin: 'o2', priority: MessagePriority.low),
+      [high],
+    );
+
+    expect(decision.admitted, isFalse);
+    expect(decision.reason, 'relay storage full');
+  });
+
+  test('per-origin quota only evicts from the same origin', () {
+    final quota = RelayQueueQuota(maxBytesPerOrigin: 150);
+    final flooder = _relay('flood-1', origin: 'flooder', destination: 'd1');
+    final other = _relay(
+      'other',
+      origin: 'quiet',
+      priority: MessagePriority.low,
+    );
+    quota
+      ..charge(flooder)
+      ..charge(other);
+
+    final decision = quota.admit(
+      _relay(
+        'flood-2',
+        origin: 'flooder',
+        destination: 'd2',
+        priority: MessagePriority.high,
+      ),
+      [flooder, other],
+    );
+
+    expect(decision.admitted, isTrue);
+    expect(decision.victims.map((m) => m.id), ['flood-1']);
+  });
+}
@@ -1,7 +1,9 @@
 import 'package:flutter_test/flutter_test.dart';
 import 'package:logging/logging.dart';
+import 'package:pak_connect/core/messaging/custody_manager.dart';
 import 'package:pak_connect/core/messaging/offline_message_queue.dart';
 import 'package:pak_connect/core/messaging/relay_send_pipeline.dart';
+import 'package:pak_connect/domain/entities/queue_enums.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
@@ -73,11 +75,132 @@ void main() {
       expect(intermediateRecord.recipient, 'peer-b');
       expect(intermediateRecord.originalMessageId, 'msg-1');
     });
+
+    test('custody bundles persist under the custody chat prefix', () async {
+      final intermediateMeta = RelayMetadata.create(
+        originalMessageContent: 'hello',
+        priority: MessagePriority.normal,
+        originalSender: 'origin',
+        finalRecipient: 'final',
+        currentNodeId: 'origin',
+        custody: true,
+      ).nextHop('peer-a');
+
+      await pipeline.relayToNextHop(
+        relayMessage: MeshRelayMessage.createRelay(
+          originalMessageId: 'msg-2',
+          originalContent: 'hello',
+          metadata: intermediateMeta,
+          relayNodeId: 'peer-a',
+        ),
+        nextHopNodeId: 'peer-b',
+        custody: true,
+      );
+
+      final record = queue.records.single;
+      expect(record.persistToStorage, isTrue);
+      expect(record.chatId, '${CustodyManager.chatIdPrefix}peer-b');
+      expect(record.relayMetadata!.custody, isTrue);
+    });
+  });
+
+  group('RelaySendPipeline spray-and-wait', () {
+    test('binary spray halves the budget per new neighbour', () {
+      final plan = RelaySendPipeline.planSpray(
+        replicas: 8,
+        neighbors: ['a', 'b', 'c', 'd'],
+        destination: 'dest',
+      );
+
+      expect(plan.shares, {'a': 4, 'b': 2, 'c': 1});
+      expect(plan.kept, 1);
+      expect(
+        RelaySendPipeline.planSpray(
+          replicas: 8,
+          neighbors: ['a', 'dest'],
+          destination: 'dest',
+        ).shares,
+        {'dest': 1},
+      );
+      expect(
+        RelaySendPipeline.planSpray(
+          replicas: null,
+          neighbors: ['a', 'b'],
+          destination: 'dest',
+        ).shares,
+        {'a': null, 'b': null},
+      );
+    });
+
+    test('a single copy waits for the destination', () async {
+      final queue = _RecordingQueue();
+      final pipeline = RelaySendPipeline(
+        logger: Logger('RelaySendPipelineTest'),
+        messageQueue: queue,
+        spamPrevention: _StubSpamPreventionManager(),
+      );
+      final metadata = RelayMetadata.create(
+        originalMessageContent: 'hello',
+        priority: MessagePriority.normal,
+        originalSender: 'origin',
+        finalRecipient: 'dest',
+        currentNodeId: 'origin',
+        replicas: 2,
+      ).nextHop('relay', replicas: 1);
+
+      final count = await pipeline.broadcastToNeighbors(
+        relayMessage: MeshRelayMessage.createRelay(
+          originalMessageId: 'msg-3',
+          originalContent: 'hello',
+          metadata: metadata,
+          relayNodeId: 'relay',
+        ),
+        availableNeighbors: ['peer-a', 'peer-b'],
+      );
+
+      expect(count, 1);
+      final record = queue.records.single;
+      expect(record.recipient, 'dest');
+      expect(record.chatId, '${RelaySendPipeline.sprayWaitChatIdPrefix}dest');
+      expect(record.relayMetadata!.replicas, 1);
+    });
+
+    test('a rejected wait copy leaves the neighbour copies counted', () async {
+      final queue = _RecordingQueue()
+        ..rejectedChatPrefix = RelaySendPipeline.sprayWaitChatIdPrefix;
+      final pipeline = RelaySendPipeline(
+        logger: Logger('RelaySendPipelineTest'),
+        messageQueue: queue,
+        spamPrevention: _StubSpamPreventionManager(),
+      );
+      final metadata = RelayMetadata.create(
+        originalMessageContent: 'hello',
+        priority: MessagePriority.normal,
+        originalSender: 'origin',
+        finalRecipient: 'dest',
+        currentNodeId: 'origin',
+        replicas: 8,
+      ).nextHop('relay', replicas: 4);
+
+      final count = await pipeline.broadcastToNeighbors(
+        relayMessage: MeshRelayMessage.createRelay(
+          originalMessageId: 'msg-4',
+          originalContent: 'hello',
+          metadata: metadata,
+          relayNodeId: 'relay',
+        ),
+        availableNeighbors: ['peer-a', 'peer-b'],
+      );
+
+      expect(count, 2);
+      expect(queue.records.map((r) => r.recipient), ['peer-a', 'peer-b']);
+    });
   });
 }
 
 class _RecordingQueue extends OfflineMessageQueue {
   final List<_QueueRecord> records = [];
+  String? rejectedChatPrefix;
 
   @override
   Future<MessageId> queueMessageWithIds({
@@ -94,7 +217,12 @@ class _RecordingQueue extends OfflineMessageQueue {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
+    final rejected = rejectedChatPrefix;
+    if (rejected != null && chatId.value.startsWith(rejected)) {
+      throw const MessageQueueException('relay quota exceeded');
+    }
     final id = MessageId('rec_${records.length}');
     records.add(
       _QueueRecord(
@@ -0,0 +1,235 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/core/services/background_relay_runner.dart';
+import 'package:pak_connect/domain/entities/queue_enums.dart';
+import 'package:pak_connect/domain/entities/queued_message.dart';
+import 'package:pak_connect/domain/interfaces/i_preferences_repository.dart';
+
+import '../../test_helpers/messaging/in_memory_offline_message_queue.dart';
+import '../../test_helpers/test_seen_message_store.dart';
+
+void main() {
+  group('BackgroundRelayRunner', () {
+    late InMemoryOfflineMessageQueue queue;
+    late TestSeenMessageStore seenStore;
+    late _MemoryPreferencesRepository prefs;
+    final now = DateTime(2026, 1, 1, 12);
+
+    setUp(() {
+      queue = InMemoryOfflineMessageQueue()..setOffline();
+      seenStore = TestSeenMessageStore();
+      prefs = _MemoryPreferencesRepository();
+    });
+
+    BackgroundRelayRunner buildRunner({BackgroundDeliveryHandler? handler}) {
+      return BackgroundRelayRunner(
+        messageQueue: queue,
+        seenMessageStore: seenStore,
+        preferencesRepository: prefs,
+        deliveryHandler: handler,
+        clock: () => now,
+      );
+    }
+
+    test('drops expired messages and relay copies already seen', () async {
+      await queue.addSyncedMessage(
+        _message(
+          'expired',
+          queuedAt: now,
+          expiresAt: now.subtract(const Duration(minutes: 1)),
+        ),
+      );
+      await queue.addSyncedMessage(
+        _message('relay-copy', queuedAt: now, isRelay: true),
+      );
+      await queue.addSyncedMessage(_message('fresh', queuedAt: now));
+      await seenStore.markDelivered('relay-copy-original');
+
+      final report = await buildRunner().runWakeup();
+
+      expect(report.expired, 1);
+      expect(report.duplicates, 1);
+      expect(report.deferred, 1);
+      expect(queue.getMessageById('expired'), isNull);
+      expect(queue.getMessageById('relay-copy'), isNull);
+      expect(queue.getMessageById('fresh'), isNotNull);
+    });
+
+    test('delivers in priority order through the handler', () async {
+      await queue.addSyncedMessage(
+        _message('low', queuedAt: now, priority: MessagePriority.low),
+      );
+      await queue.addSyncedMessage(
+        _message('urgent', queuedAt: now, priority: MessagePriority.urgent),
+      );
+      final sent = <String>[];
+
+      final report = await buildRunner(
+        handler: (message) async {
+          sent.add(message.id);
+          return true;
+        },
+      ).runWakeup();
+
+      expect(sent, <String>['urgent', 'low']);
+      expect(report.delivered, 2);
+      expect(queue.getPendingMessages(), isEmpty);
+    });
+
+    test('stops at the message budget and resumes after checkpoint', () async {
+      for (var i = 0; i < 5; i++) {
+        await queue.addSyncedMessage(
+          _message('m$i', queuedAt: now.add(Duration(seconds: i))),
+        );
+      }
+      final seen = <String>[];
+      final runner = buildRunner(
+        handler: (message) async {
+          seen.add(message.id);
+          return false;
+        },
+      );
+      const budget = BackgroundWorkBudget(maxMessages: 3);
+
+      final first = await runner.runWakeup(budget: budget);
+      expect(first.budgetExhausted, isTrue);
+      expect(first.processed, 3);
+      expect(first.checkpoint.resumeAfterMessageId, 'm2');
+
+      final second = await runner.runWakeup(budget: budget);
+      expect(seen.sublist(3), <String>['m3', 'm4', 'm0']);
+      expect(second.checkpoint.totalWakeups, 2);
+      expect(second.checkpoint.totalProcessed, 6);
+    });
+
+    test('marks message failed when handler throws', () async {
+      await queue.addSyncedMessage(_message('boom', queuedAt: now));
+
+      final report = await buildRunner(
+        handler: (_) async => throw StateError('link lost'),
+      ).runWakeup();
+
+      expect(report.failed, 1);
+      expect(
+        queue.getMessageById('boom')?.status,
+        QueuedMessageStatus.failed,
+      );
+    });
+
+    test('stops when the foreground takes the queue over', () async {
+      for (var i = 0; i < 3; i++) {
+        await queue.addSyncedMessage(_message('m$i', queuedAt: now));
+      }
+      var foregroundUp = false;
+      final runner = BackgroundRelayRunner(
+        messageQueue: queue,
+        seenMessageStore: seenStore,
+        preferencesRepository: prefs,
+        deliveryHandler: (_) async {
+          foregroundUp = true;
+          return true;
+        },
+        shouldYield: () => foregroundUp,
+        clock: () => now,
+      );
+
+      final report = await runner.runWakeup();
+
+      expect(report.processed, 1);
+      expect(report.budgetExhausted, isTrue);
+      expect(queue.getPendingMessages(), hasLength(2));
+    });
+
+    test('zero usable time processes nothing but still checkpoints', () async {
+      await queue.addSyncedMessage(_message('waiting', queuedAt: now));
+      final runner = buildRunner();
+
+      final report = await runner.runWakeup(
+        budget: const BackgroundWorkBudget(
+          timeBudget: Duration(seconds: 1),
+          safetyMargin: Duration(seconds: 2),
+        ),
+      );
+
+      expect(report.processed, 0);
+      expect(report.budgetExhausted, isTrue);
+      final checkpoint = await runner.loadCheckpoint();
+      expect(checkpoint.totalWakeups, 1);
+      expect(await runner.loadLastReport(), isNotNull);
+    });
+
+    test('unreadable checkpoint falls back to empty', () async {
+      await prefs.setString(BackgroundRelayRunner.checkpointKey, '{not json');
+
+      final checkpoint = await buildRunner().loadCheckpoint();
+
+      expect(checkpoint.totalWakeups, 0);
+      expect(checkpoint.resumeAfterMessageId, isNull);
+    });
+  });
+}
+
+QueuedMessage _message(
+  String id, {
+  required DateTime queuedAt,
+  MessagePriority priority = MessagePriority.normal,
+  DateTime? expiresAt,
+  bool isRelay = false,
+}) {
+  return QueuedMessage(
+    id: id,
+    chatId: 'chat',
+    content: 'hello',
+    recipientPublicKey: 'recipient',
+    senderPublicKey: 'sender',
+    priority: priority,
+    queuedAt: queuedAt,
+    maxRetries: 3,
+    expiresAt: expiresAt,
+    isRelayMessage: isRelay,
+    originalMessageId: isRelay ? '$id-original' : null,
+  );
+}
+
+class _MemoryPreferencesRepository implements IPreferencesRepository {
+  final Map<String, Object> values = <String, Object>{};
+
+  @override
+  Future<void> clearAll() async => values.clear();
+
+  @override
+  Future<void> delete(String key) async => values.remove(key);
+
+  @override
+  Future<Map<String, dynamic>> getAll() async =>
+      Map<String, dynamic>.of(values);
+
+  @override
+  Future<bool> getBool(String key, {bool? defaultValue}) async =>
+      values[key] as bool? ?? (defaultValue ?? false);
+
+  @override
+  Future<double> getDouble(String key, {double? defaultValue}) async =>
+      values[key] as double? ?? (defaultValue ?? 0.0);
+
+  @override
+  Future<int> getInt(String key, {int? defaultValue}) async =>
+      values[key] as int? ?? (defaultValue ?? 0);
+
+  @override
+  Future<String> getString(String key, {String? defaultValue}) async =>
+      values[key] as String? ?? (defaultValue ?? '');
+
+  @override
+  Future<void> setBool(String key, bool value) async => values[key] = value;
+
+  @override
+  Future<void> setDouble(String key, double value) async =>
+      values[key] = value;
+
+  @override
+  Future<void> setInt(String key, int value) async => values[key] = value;
+
+  @override
+  Future<void> setString(String key, String value) async =>
+      values[key] = value;
+}
@@ -1,3 +1,5 @@
+import 'dart:async';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:logging/logging.dart';
 import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
@@ -5,6 +7,7 @@ import 'package:pak_connect/core/services/chat_list_coordinator.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/entities/chat_list_item.dart';
 import 'package:pak_connect/domain/entities/contact.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 
 import '../../test_helpers/mocks/mock_connection_service.dart';
@@ -166,6 +169,46 @@ void main() {
       await coordinator.dispose();
     });
 
+    test('change feed patches rows without re-querying', () async {
+      final repo = _ScriptedChatsRepository([
+        [
+          _chat('a', lastMessageTime: DateTime(2025, 1, 2)),
+          _chat('b', lastMessageTime: DateTime(2025, 1, 1)),
+        ],
+      ]);
+      final events = StreamController<ChatListEvent>.broadcast();
+      final connectionService = MockConnectionService();
+      final coordinator = ChatListCoordinator(
+        chatsRepository: repo,
+        bleService: connectionService,
+        changeEvents: events.stream,
+      );
+      await coordinator.initialize();
+      final diffs = <ChatListDiff>[];
+      coordinator.chatListChanges.listen(diffs.add);
+      final before = repo.loadCount;
+
+      connectionService.emitIncomingMessage('payload');
+      events
+        ..add(
+          ChatMessageInserted(
+            chatId: _cid('b'),
+            content: 'newest',
+            timestamp: DateTime(2025, 1, 3),
+          ),
+        )
+        ..add(ChatUnreadChanged(chatId: _cid('b'), unreadCount: 1));
+      await Future<void>.delayed(Duration(milliseconds: 10));
+
+      expect(repo.loadCount, before);
+      expect(coordinator.currentChats.map((c) => c.chatId.value), ['b', 'a']);
+      expect(coordinator.currentChats.first.unreadCount, 1);
+      expect(diffs, [isA<ChatRowMoved>(), isA<ChatRowUpdated>()]);
+
+      await coordinator.dispose();
+      await events.close();
+    });
+
     // Note: connection status debounce covered indirectly in integration suites.
   });
 }
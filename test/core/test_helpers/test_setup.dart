@@ -54,6 +54,7 @@ import 'package:pak_connect/domain/services/mesh_networking_service.dart'
 import 'package:pak_connect/domain/services/message_router.dart';
 import 'package:pak_connect/data/database/database_encryption.dart';
 import 'package:pak_connect/data/database/database_helper.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
 import 'package:pak_connect/data/di/data_layer_service_registrar.dart';
 import 'package:pak_connect/data/repositories/contact_repository.dart';
 import 'package:pak_connect/data/repositories/message_repository.dart';
@@ -101,6 +102,7 @@ class TestSetup {
 
     FakeBlePlatform.ensureRegistered();
     FlutterSecureStoragePlatform.instance = InMemorySecureStorage();
+    await SecureStorageVault.instance.invalidate();
     DatabaseEncryption.overrideSecureStorage(MockFlutterSecureStorage());
     BatteryOptimizer.disableForTests();
 
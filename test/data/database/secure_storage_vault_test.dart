@@ -0,0 +1,168 @@
+import 'dart:async';
+
+import 'package:flutter_secure_storage/flutter_secure_storage.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
+
+import '../../test_helpers/mocks/mock_flutter_secure_storage.dart';
+
+/// Counts plugin round trips, can fail writes to selected keys and can
+/// hold a readAll result back until [readAllGate] completes
+class _CountingStorage extends MockFlutterSecureStorage {
+  int readAlls = 0;
+  int reads = 0;
+  final Set<String> failingKeys = {};
+  Completer<void>? readAllGate;
+
+  @override
+  Future<Map<String, String>> readAll({
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) async {
+    readAlls++;
+    final entries = await super.readAll();
+    await readAllGate?.future;
+    return entries;
+  }
+
+  @override
+  Future<String?> read({
+    required String key,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) {
+    reads++;
+    return super.read(key: key);
+  }
+
+  @override
+  Future<void> write({
+    required String key,
+    required String? value,
+    AppleOptions? iOptions,
+    AndroidOptions? aOptions,
+    LinuxOptions? lOptions,
+    WebOptions? webOptions,
+    AppleOptions? mOptions,
+    WindowsOptions? wOptions,
+  }) async {
+    if (failingKeys.contains(key)) throw StateError('keyring locked');
+    await super.write(key: key, value: value);
+  }
+}
+
+void main() {
+  Logger.root.level = Level.OFF;
+
+  late _CountingStorage storage;
+  late SecureStorageVault vault;
+
+  setUp(() async {
+    storage = _CountingStorage();
+    await storage.write(key: 'db_encryption_key_v1', value: 'db-key');
+    await storage.write(key: 'ecdh_public_key_v2', value: 'pub');
+    vault = SecureStorageVault(storage);
+  });
+
+  test('concurrent cold reads share one readAll', () async {
+    final values = await Future.wait([
+      vault.read('db_encryption_key_v1'),
+      vault.read('ecdh_public_key_v2'),
+      vault.read('shared_secret_missing'),
+    ]);
+    await vault.readMany(['ecdh_public_key_v2', 'ecdh_private_key_v2']);
+
+    expect(values, ['db-key', 'pub', null]);
+    expect(storage.readAlls, 1);
+    expect(storage.reads, 0);
+  });
+
+  test('writes land in storage and cache together', () async {
+    await vault.writeAll({
+      'ecdh_public_key_v2': 'pub-2',
+      'ecdh_private_key_v2': 'priv-2',
+      'db_encryption_key_v1': null,
+    });
+
+    final keys = await vault.readMany([
+      'ecdh_public_key_v2',
+      'ecdh_private_key_v2',
+    ]);
+    expect(keys, {
+      'ecdh_public_key_v2': 'pub-2',
+      'ecdh_private_key_v2': 'priv-2',
+    });
+    expect(await vault.read('db_encryption_key_v1'), isNull);
+    expect(await storage.read(key: 'ecdh_private_key_v2'), 'priv-2');
+    expect(await storage.read(key: 'db_encryption_key_v1'), isNull);
+    expect(storage.readAlls, 1);
+  });
+
+  test('a failed batch reloads from storage', () async {
+    await vault.load();
+    storage.failingKeys.add('ecdh_private_key_v2');
+
+    await expectLater(
+      vault.writeAll({
+        'ecdh_public_key_v2': 'pub-2',
+        'ecdh_private_key_v2': 'priv-2',
+      }),
+      throwsStateError,
+    );
+
+    expect(vault.isLoaded, isFalse);
+    expect(await vault.read('ecdh_private_key_v2'), isNull);
+    expect(storage.readAlls, 2);
+  });
+
+  test('forced load and deleteAll resync with storage', () async {
+    await vault.load();
+    await storage.write(key: 'import_checkpoint', value: 'outside');
+    expect(await vault.read('import_checkpoint'), isNull);
+
+    await vault.load(force: true);
+    expect(await vault.read('import_checkpoint'), 'outside');
+
+    await vault.deleteAll();
+    expect(await vault.read('ecdh_public_key_v2'), isNull);
+    expect(await storage.readAll(), isEmpty);
+  });
+
+  test('invalidate discards a readAll already in flight', () async {
+    final gate = storage.readAllGate = Completer<void>();
+    final stale = vault.read('ecdh_public_key_v2');
+    await Future<void>.delayed(Duration.zero);
+
+    await storage.write(key: 'ecdh_public_key_v2', value: 'pub-2');
+    await vault.invalidate();
+    storage.readAllGate = null;
+    gate.complete();
+
+    expect(await stale, 'pub-2');
+    expect(await vault.read('ecdh_public_key_v2'), 'pub-2');
+    expect(storage.readAlls, 2);
+  });
+
+  test('storage view reads and writes through the cache', () async {
+    final view = vault.asStorage();
+
+    expect(await view.read(key: 'db_encryption_key_v1'), 'db-key');
+    await view.write(key: 'noise_static_private', value: 'priv');
+    await view.delete(key: 'ecdh_public_key_v2');
+
+    expect(await vault.read('noise_static_private'), 'priv');
+    expect(await view.containsKey(key: 'ecdh_public_key_v2'), isFalse);
+    expect(await storage.read(key: 'noise_static_private'), 'priv');
+    expect(storage.readAlls, 1);
+    expect(storage.reads, 1);
+  });
+}
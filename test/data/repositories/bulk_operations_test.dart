@@ -0,0 +1,107 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/data/database/database_helper.dart';
+import 'package:pak_connect/data/repositories/chats_repository.dart';
+import 'package:pak_connect/data/repositories/message_repository.dart';
+import 'package:pak_connect/domain/entities/message.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+import '../../test_helpers/test_setup.dart';
+
+/// Set-based multi-select operations on ChatsRepository and
+/// MessageRepository
+void main() {
+  Logger.root.level = Level.OFF;
+
+  setUpAll(() async {
+    await TestSetup.initializeTestEnvironment(dbLabel: 'bulk_operations');
+  });
+
+  setUp(() async {
+    await TestSetup.fullDatabaseReset();
+  });
+
+  final messages = MessageRepository();
+  final chats = ChatsRepository();
+
+  Future<void> seed(String chatId, int count) async {
+    for (var i = 0; i < count; i++) {
+      await messages.saveMessage(
+        Message(
+          id: MessageId('${chatId}_m$i'),
+          chatId: ChatId(chatId),
+          content: 'message $i',
+          timestamp: DateTime(2025, 1, 1, 12, i),
+          isFromMe: false,
+          status: MessageStatus.delivered,
+        ),
+      );
+      await chats.incrementUnreadCount(ChatId(chatId));
+    }
+  }
+
+  Future<int> count(String table) async {
+    final db = await DatabaseHelper.database;
+    final rows = await db.rawQuery('SELECT COUNT(*) AS n FROM $table');
+    return rows.first['n'] as int;
+  }
+
+  test('deleteMessagesByIds reports the chat of each deleted row', () async {
+    await seed('chat_a', 2);
+    await seed('chat_b', 1);
+
+    final deleted = await messages.deleteMessagesByIds([
+      MessageId('chat_a_m0'),
+      MessageId('chat_b_m0'),
+      MessageId('missing'),
+    ]);
+
+    expect(deleted, {
+      MessageId('chat_a_m0'): ChatId('chat_a'),
+      MessageId('chat_b_m0'): ChatId('chat_b'),
+    });
+    expect(await count('messages'), 1);
+  });
+
+  test('markChatsAsRead resets every selected chat at once', () async {
+    await seed('chat_a', 2);
+    await seed('chat_b', 3);
+    await seed('chat_c', 1);
+
+    final updated = await chats.markChatsAsRead([
+      ChatId('chat_a'),
+      ChatId('chat_b'),
+    ]);
+
+    expect(updated, 2);
+    expect(await chats.getTotalUnreadCount(), 1);
+  });
+
+  test('deleteChats removes chats together with their messages', () async {
+    final ids = [for (var i = 0; i < 3; i++) 'chat_$i'];
+    for (final id in ids) {
+      await seed(id, 2);
+    }
+    await seed('kept', 1);
+
+    final db = await DatabaseHelper.database;
+    final deleted = await db.transaction(
+      (txn) => MessageRepository.deleteForChats(txn, ids.sublist(0, 1)),
+    );
+    expect(deleted, hasLength(2));
+
+    final rest = await chats.deleteChats([
+      for (final id in ids.sublist(1)) ChatId(id),
+    ]);
+    expect(rest, hasLength(4));
+    expect(await count('messages'), 1);
+    expect(await count('chats'), 2);
+  });
+
+  test('inClauseChunks splits lists at the parameter limit', () {
+    final values = List.generate(2500, (i) => i);
+    final chunks = DatabaseHelper.inClauseChunks(values).toList();
+
+    expect(chunks.map((c) => c.length), [999, 999, 502]);
+    expect(chunks.expand((c) => c), values);
+  });
+}
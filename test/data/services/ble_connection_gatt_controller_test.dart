@@ -0,0 +1,115 @@
+import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/data/services/ble_connection_gatt_controller.dart';
+import 'package:pak_connect/data/services/linux_ble_notification_ring.dart';
+import 'package:pak_connect/domain/constants/ble_constants.dart';
+
+class _TestPeripheral implements Peripheral {
+  const _TestPeripheral(this.uuid);
+  @override
+  final UUID uuid;
+  @override
+  dynamic noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+class _TestCharacteristic implements GATTCharacteristic {
+  const _TestCharacteristic(this.uuid);
+  @override
+  final UUID uuid;
+  @override
+  List<GATTCharacteristicProperty> get properties => const [
+    GATTCharacteristicProperty.notify,
+  ];
+  @override
+  dynamic noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+class _TestCentralManager implements CentralManager {
+  int notifyStateCalls = 0;
+
+  @override
+  Future<void> setCharacteristicNotifyState(
+    Peripheral peripheral,
+    GATTCharacteristic characteristic, {
+    required bool state,
+  }) async {
+    notifyStateCalls++;
+  }
+
+  @override
+  dynamic noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
+}
+
+class _TestBatchSource implements BleNotificationBatchSource {
+  _TestBatchSource({required this.acquireResult});
+  final bool acquireResult;
+  final List<(String, String)> acquired = [];
+
+  @override
+  Stream<List<BleNotificationFrame>> get batches => const Stream.empty();
+
+  @override
+  Future<bool> acquire(String peripheralId, String characteristicUuid) async {
+    acquired.add((peripheralId, characteristicUuid));
+    return acquireResult;
+  }
+
+  @override
+  void dispose() {}
+}
+
+void main() {
+  final peripheral = _TestPeripheral(
+    UUID.fromString('00000000-0000-0000-0000-aabbccddeeff'),
+  );
+  final characteristic = _TestCharacteristic(
+    BLEConstants.messageCharacteristicUUID,
+  );
+
+  BleConnectionGattController controllerFor(
+    _TestCentralManager centralManager,
+    BleNotificationBatchSource? source,
+  ) => BleConnectionGattController(
+    logger: Logger('test.gatt'),
+    centralManager: centralManager,
+    isTransientConnectError: (_) => false,
+    notificationBatchSource: source,
+  );
+
+  test('acquired links are not also enabled through the plugin', () async {
+    final centralManager = _TestCentralManager();
+    final source = _TestBatchSource(acquireResult: true);
+
+    await controllerFor(centralManager, source).enableNotifications(
+      device: peripheral,
+      characteristic: characteristic,
+      formattedAddress: 'AA:BB',
+    );
+
+    expect(source.acquired, [
+      (peripheral.uuid.toString(), characteristic.uuid.toString()),
+    ]);
+    expect(centralManager.notifyStateCalls, 0);
+  });
+
+  test('notifications fall back to the plugin when acquire fails', () async {
+    final centralManager = _TestCentralManager();
+    final source = _TestBatchSource(acquireResult: false);
+
+    await controllerFor(centralManager, source).enableNotifications(
+      device: peripheral,
+      characteristic: characteristic,
+      formattedAddress: 'AA:BB',
+    );
+    expect(source.acquired, hasLength(1));
+    expect(centralManager.notifyStateCalls, 1);
+
+    await controllerFor(centralManager, null).enableNotifications(
+      device: peripheral,
+      characteristic: characteristic,
+      formattedAddress: 'AA:BB',
+    );
+    expect(centralManager.notifyStateCalls, 2);
+  });
+}
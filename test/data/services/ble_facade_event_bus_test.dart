@@ -0,0 +1,42 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/data/services/ble_facade_event_bus.dart';
+import 'package:pak_connect/domain/models/connection_status.dart';
+import 'package:pak_connect/domain/services/app_event_channels.dart';
+
+void main() {
+  test('an injected app bus carries facade and chat channel stats', () {
+    final appBus = AppEventChannels.createBus();
+    final facadeBus = BleFacadeEventBus(logger: Logger('test'), bus: appBus);
+    final hints = <String>[];
+    appBus.channel<String>(AppEventChannels.hintMatch).listen(hints.add);
+
+    facadeBus
+      ..emitHintMatch('a')
+      ..emitHintMatch('b');
+    appBus
+        .channel<ConnectionStatus>(AppEventChannels.connectionStatus)
+        .emit(ConnectionStatus.connected);
+
+    expect(hints, ['a', 'b']);
+    expect(appBus.stats[AppEventChannels.hintMatch]!.emitted, 2);
+    expect(appBus.stats[AppEventChannels.hintMatch]!.delivered, 2);
+    expect(appBus.stats[AppEventChannels.connectionStatus]!.emitted, 1);
+    expect(facadeBus.stats.keys, appBus.stats.keys);
+
+    // The app bus outlives the facade, so its subscribers stay attached.
+    facadeBus.clear();
+    facadeBus.emitHintMatch('c');
+    expect(hints, ['a', 'b', 'c']);
+  });
+
+  test('a facade without the app bus keeps a private one', () {
+    final appBus = AppEventChannels.createBus();
+    final facadeBus = BleFacadeEventBus(logger: Logger('test'));
+
+    facadeBus.emitHintMatch('a');
+
+    expect(facadeBus.stats[AppEventChannels.hintMatch]!.emitted, 1);
+    expect(appBus.stats[AppEventChannels.hintMatch]!.emitted, 0);
+  });
+}
@@ -7,6 +7,8 @@ import 'package:logging/logging.dart';
 import 'package:pak_connect/data/services/ble_connection_manager.dart';
 import 'package:pak_connect/data/services/ble_connection_service.dart';
 import 'package:pak_connect/data/services/ble_facade_lifecycle_coordinator.dart';
+import 'package:pak_connect/data/services/linux_ble_notification_ring.dart';
+import 'package:pak_connect/domain/constants/ble_constants.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_advertising_service.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_discovery_service.dart';
 import 'package:pak_connect/domain/interfaces/i_ble_handshake_service.dart';
@@ -277,6 +279,25 @@ class _TestConnectionManager implements BLEConnectionManager {
   dynamic noSuchMethod(Invocation invocation) => super.noSuchMethod(invocation);
 }
 
+class _TestBatchSource implements BleNotificationBatchSource {
+  final StreamController<List<BleNotificationFrame>> _controller =
+      StreamController<List<BleNotificationFrame>>.broadcast();
+
+  void emit(List<BleNotificationFrame> frames) => _controller.add(frames);
+
+  @override
+  Stream<List<BleNotificationFrame>> get batches => _controller.stream;
+
+  @override
+  Future<bool> acquire(String peripheralId, String characteristicUuid) async =>
+      true;
+
+  @override
+  void dispose() {
+    _controller.close();
+  }
+}
+
 class _TestDiscoveryService implements IBLEDiscoveryService {
   int initializeCalls = 0;
   @override
@@ -611,6 +632,58 @@ void main() {
     expect(messagingService.lastSenderDeviceId, peripheral.uuid.toString());
   });
 
+  test('native notification batches deliver every frame', () async {
+    final batchSource = _TestBatchSource();
+    addTearDown(batchSource.dispose);
+    final batchedCoordinator = BleLifecycleCoordinator(
+      logger: Logger('test.lifecycle.batched'),
+      platformHost: platformHost,
+      connectionManager: connectionManager,
+      getConnectionService: () => connectionService,
+      getDiscoveryService: () => discoveryService,
+      getAdvertisingService: () => advertisingService,
+      getMessagingService: () => messagingService,
+      getHandshakeService: () => handshakeService,
+      notificationBatchSource: batchSource,
+    );
+    addTearDown(batchedCoordinator.dispose);
+    batchedCoordinator.ensureConnectionServicePrepared();
+
+    // Acquired links reach Dart only through the ring, so nothing is
+    // filtered: each frame is delivered once, in order.
+    batchSource.emit([
+      BleNotificationFrame(
+        connection: 0xAABBCCDDEEFF,
+        payload: Uint8List.fromList([1]),
+      ),
+      BleNotificationFrame(
+        connection: 0x112233445566,
+        payload: Uint8List.fromList([2]),
+      ),
+    ]);
+    await Future<void>.delayed(Duration.zero);
+    await Future<void>.delayed(Duration.zero);
+    expect(messagingService.processCalls, 2);
+    expect(messagingService.lastProcessedData, [2]);
+    expect(
+      messagingService.lastSenderDeviceId,
+      '00000000-0000-0000-0000-112233445566',
+    );
+
+    // Links that fell back to the plugin keep the plugin path.
+    centralManager.emitNotified(
+      GATTCharacteristicNotifiedEventArgs(
+        _TestPeripheral(UUID.fromString('00000000-0000-0000-0000-aabbccddeeff')),
+        _TestCharacteristic(BLEConstants.messageCharacteristicUUID),
+        Uint8List.fromList([3]),
+      ),
+    );
+    await Future<void>.delayed(Duration.zero);
+    await Future<void>.delayed(Duration.zero);
+    expect(messagingService.processCalls, 3);
+    expect(messagingService.lastProcessedData, [3]);
+  });
+
   test('unsupported platform stream bindings are tolerated', () async {
     final unsupportedCoordinator = BleLifecycleCoordinator(
       logger: Logger('test.lifecycle.unsupported'),
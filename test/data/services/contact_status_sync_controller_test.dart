@@ -194,6 +194,39 @@ void main() {
 
       expect(() => controller.dispose(), returnsNormally);
     });
+
+    test('status versions grow on change and stale updates are dropped', () async {
+      weHaveThem = false;
+      await controller.requestContactStatusExchange();
+      weHaveThem = true;
+      await controller.requestContactStatusExchange();
+
+      final firstVersion = sentMessages.first.contactStatusVersion;
+      final secondVersion = sentMessages.last.contactStatusVersion;
+      expect(firstVersion, isNotNull);
+      expect(secondVersion, greaterThan(firstVersion!));
+
+      await controller.handleContactStatus(
+        true,
+        'peer_public_key',
+        statusVersion: 10,
+      );
+      expect(controller.theyHaveUsAsContact, isTrue);
+
+      await controller.handleContactStatus(
+        false,
+        'peer_public_key',
+        statusVersion: 9,
+      );
+      expect(controller.theyHaveUsAsContact, isTrue);
+
+      await controller.handleContactStatus(
+        false,
+        'peer_public_key',
+        statusVersion: 11,
+      );
+      expect(controller.theyHaveUsAsContact, isFalse);
+    });
   });
 }
 
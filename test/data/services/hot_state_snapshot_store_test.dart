@@ -0,0 +1,93 @@
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/data/services/hot_state_snapshot_store.dart';
+
+void main() {
+  group('HotStateSnapshotStore', () {
+    late Directory dir;
+
+    setUp(() async {
+      dir = await Directory.systemTemp.createTemp('hot_state_snapshot');
+    });
+
+    tearDown(() async {
+      if (await dir.exists()) {
+        await dir.delete(recursive: true);
+      }
+    });
+
+    HotStateSnapshotStore buildStore() =>
+        HotStateSnapshotStore(directoryResolver: () async => dir);
+
+    test('flushed sections are readable by a new store', () async {
+      final writer = buildStore()
+        ..registerSection(
+          3,
+          version: 1,
+          producer: () async => Uint8List.fromList([9, 8, 7]),
+        )
+        ..registerSection(4, version: 1, producer: () async => null);
+      await writer.flush();
+
+      final reader = buildStore();
+
+      expect(await reader.readSection(3, version: 1), [9, 8, 7]);
+      expect(await reader.readSection(4, version: 1), isNull);
+      expect(
+        File('${dir.path}/${HotStateSnapshotStore.fileName}.tmp').existsSync(),
+        isFalse,
+      );
+    });
+
+    test('failing producer does not block other sections', () async {
+      final writer = buildStore()
+        ..registerSection(
+          1,
+          version: 1,
+          producer: () async => throw StateError('db closed'),
+        )
+        ..registerSection(
+          2,
+          version: 1,
+          producer: () async => Uint8List.fromList([1]),
+        );
+      await writer.flush();
+
+      final reader = buildStore();
+
+      expect(await reader.readSection(1, version: 1), isNull);
+      expect(await reader.readSection(2, version: 1), [1]);
+    });
+
+    test('garbage file and missing directory fall back to no snapshot',
+        () async {
+      await File(
+        '${dir.path}/${HotStateSnapshotStore.fileName}',
+      ).writeAsBytes([1, 2, 3, 4, 5]);
+
+      expect(await buildStore().readSection(1, version: 1), isNull);
+
+      final unavailable = HotStateSnapshotStore(
+        directoryResolver: () async => throw const FileSystemException('gone'),
+      );
+      expect(await unavailable.readSection(1, version: 1), isNull);
+    });
+
+    test('invalidate removes the snapshot', () async {
+      final store = buildStore()
+        ..registerSection(
+          1,
+          version: 1,
+          producer: () async => Uint8List.fromList([1]),
+        );
+      await store.flush();
+
+      await store.invalidate();
+
+      expect(await store.readSection(1, version: 1), isNull);
+      expect(await buildStore().readSection(1, version: 1), isNull);
+    });
+  });
+}
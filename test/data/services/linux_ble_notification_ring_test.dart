@@ -0,0 +1,112 @@
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/data/services/linux_ble_notification_ring.dart';
+
+/// Builds a span the way linux/runner/ble_notification_ring.cc lays it out.
+Uint8List _span(List<(int, List<int>)> records, {Endian endian = Endian.little}) {
+  final builder = BytesBuilder();
+  for (final (connection, payload) in records) {
+    final header = ByteData(BleNotificationBatchDecoder.headerSize)
+      ..setUint64(0, connection, endian)
+      ..setUint32(8, payload.length, endian);
+    builder.add(header.buffer.asUint8List());
+    builder.add(payload);
+    builder.add(List.filled((8 - payload.length % 8) % 8, 0));
+  }
+  return builder.toBytes();
+}
+
+void main() {
+  group('BleNotificationBatchDecoder', () {
+    test('decodes padded records in order as views into the span', () {
+      final span = _span([
+        (0xAABBCCDDEEFF, [1, 2, 3]),
+        (0x112233445566, List.generate(8, (i) => i)),
+        (0xAABBCCDDEEFF, []),
+        (0xAABBCCDDEEFF, List.generate(20, (i) => 100 + i)),
+      ]);
+
+      final frames = BleNotificationBatchDecoder.decode(
+        span,
+        endian: Endian.little,
+      );
+
+      expect(frames.map((f) => f.connection), [
+        0xAABBCCDDEEFF,
+        0x112233445566,
+        0xAABBCCDDEEFF,
+        0xAABBCCDDEEFF,
+      ]);
+      expect(frames[0].payload, [1, 2, 3]);
+      expect(frames[1].payload, List.generate(8, (i) => i));
+      expect(frames[2].payload, isEmpty);
+      expect(frames[3].payload, List.generate(20, (i) => 100 + i));
+      expect(identical(frames[3].payload.buffer, span.buffer), isTrue);
+    });
+
+    test('ignores a truncated trailing record', () {
+      final span = _span([
+        (1, [1, 2, 3, 4]),
+        (2, List.filled(16, 7)),
+      ]);
+      final truncated = Uint8List.sublistView(span, 0, span.length - 4);
+
+      final frames = BleNotificationBatchDecoder.decode(
+        truncated,
+        endian: Endian.little,
+      );
+
+      expect(frames, hasLength(1));
+      expect(frames.single.payload, [1, 2, 3, 4]);
+    });
+
+    test('groups frames per remote preserving arrival order', () {
+      final frames = BleNotificationBatchDecoder.decode(
+        _span([
+          (1, [1]),
+          (2, [2]),
+          (1, [3]),
+        ]),
+        endian: Endian.little,
+      );
+
+      final grouped = BleNotificationBatchDecoder.byConnection(frames);
+
+      expect(grouped.keys, [1, 2]);
+      expect(grouped[1]!.map((f) => f.payload.single), [1, 3]);
+      expect(grouped[2]!.map((f) => f.payload.single), [2]);
+    });
+  });
+
+  group('BleNotificationFrame peripheral IDs', () {
+    test('round-trips the address through the Linux peripheral ID', () {
+      final frame = BleNotificationFrame(
+        connection: 0x0A0B0C0D0E0F,
+        payload: Uint8List(0),
+      );
+
+      expect(frame.peripheralId, '00000000-0000-0000-0000-0a0b0c0d0e0f');
+      expect(
+        BleNotificationFrame.connectionForPeripheralId(
+          '00000000-0000-0000-0000-0A0B0C0D0E0F',
+        ),
+        0x0A0B0C0D0E0F,
+      );
+    });
+
+    test('rejects IDs that are not address-derived', () {
+      expect(
+        BleNotificationFrame.connectionForPeripheralId(
+          '6e400001-b5a3-f393-e0a9-e50e24dcca9e',
+        ),
+        isNull,
+      );
+      expect(BleNotificationFrame.connectionForPeripheralId('AA:BB'), isNull);
+    });
+  });
+
+  test('LinuxBleNotificationRing is unavailable without the runner exports', () {
+    expect(LinuxBleNotificationRing.tryOpen(), isNull);
+  });
+}
@@ -8,7 +8,9 @@ import 'package:pak_connect/domain/interfaces/i_mesh_relay_engine_factory.dart';
 import 'package:pak_connect/domain/messaging/mesh_relay_engine.dart';
 import 'package:pak_connect/domain/messaging/offline_message_queue_contract.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import 'package:pak_connect/domain/models/protocol_message.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 import 'package:pak_connect/domain/services/spam_prevention_manager.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 
@@ -407,6 +409,49 @@ void main() {
       }
     });
 
+    test('custody ACKs go to the previous holder only if it supports them', () async {
+      final sent = <(String, ProtocolMessage)>[];
+      MeshRelayHandler.configurePeerAckTransport((peerId, message) async {
+        sent.add((peerId, message));
+        return true;
+      });
+      addTearDown(() {
+        MeshRelayHandler.configurePeerAckTransport(null);
+        PeerCapabilityRegistry.instance.clear();
+      });
+      var broadcastAcks = 0;
+      handler.onSendAckMessage = (_) => broadcastAcks++;
+
+      await handler.initializeRelaySystem(
+        currentNodeId: 'node-self',
+        messageQueue: queue,
+      );
+      engine.incomingResult = RelayProcessingResult.relayed(
+        'next-hop',
+        custodyAccepted: true,
+      );
+
+      await handler.handleIncomingRelay(
+        protocolMessage: _relayProtocolMessage(),
+        senderPublicKey: 'old-holder',
+      );
+      expect(sent, isEmpty);
+
+      PeerCapabilityRegistry.instance.record(
+        'new-holder',
+        PeerCapabilities.local,
+      );
+      await handler.handleIncomingRelay(
+        protocolMessage: _relayProtocolMessage(),
+        senderPublicKey: 'new-holder',
+      );
+
+      expect(sent.single.$1, 'new-holder');
+      expect(sent.single.$2.relayAckCustody, isTrue);
+      expect(sent.single.$2.relayAckDelivered, isFalse);
+      expect(broadcastAcks, 0);
+    });
+
     test('handleRelayAck marks originated queued message as delivered', () async {
       when(queue.getMessageById('orig-1')).thenReturn(_queuedMessage());
       MessageId? callbackMessageId;
@@ -460,6 +505,47 @@ void main() {
       );
     });
 
+    test('handleRelayAck locates this node in a compact digest path', () async {
+      when(queue.getMessageById('relay-msg-1')).thenReturn(null);
+      ProtocolMessage? forwardedAck;
+      handler.onSendAckMessage = (message) => forwardedAck = message;
+
+      await handler.initializeRelaySystem(
+        currentNodeId: 'origin-node',
+        messageQueue: queue,
+      );
+      engine.incomingResult = RelayProcessingResult.relayed('hop-1');
+
+      final wireMetadata = _metadata().toWireJson(compact: true);
+      await handler.handleIncomingRelay(
+        protocolMessage: ProtocolMessage.meshRelay(
+          originalMessageId: 'relay-msg-1',
+          originalSender: 'sender-key',
+          finalRecipient: 'recipient-key',
+          relayMetadata: wireMetadata,
+          originalPayload: const {'content': 'hello'},
+        ),
+        senderPublicKey: 'relay-node',
+      );
+
+      final ackPath = RelayMetadata.fromJson(wireMetadata).ackRoutingPath;
+      expect(ackPath, isNot(contains('origin-node')));
+
+      await handler.handleRelayAck(
+        originalMessageId: 'relay-msg-1',
+        relayNode: 'recipient-key',
+        delivered: true,
+        ackRoutingPath: ackPath,
+      );
+
+      expect(forwardedAck, isNotNull);
+      // Our own digest goes out as our full ID for hops that only match it.
+      expect(forwardedAck?.payload['ackRoutingPath'], [
+        ackPath.first,
+        'origin-node',
+      ]);
+    });
+
     test('handleRelayAck skips propagation when routing path missing or origin reached', () async {
       when(queue.getMessageById('orig-3')).thenReturn(null);
       var sendCalls = 0;
@@ -596,6 +682,42 @@ void main() {
       expect(deliveredSender, 'sender-self');
     });
 
+    test('relay frames carry one path form per next hop', () async {
+      final sent = <String, Map<String, dynamic>>{};
+      handler.onSendRelayMessage = (message, nextHop) =>
+          sent[nextHop] = message.meshRelayMetadata!;
+      addTearDown(PeerCapabilityRegistry.instance.clear);
+      PeerCapabilityRegistry.instance.record(
+        'compact-hop',
+        PeerCapabilities.local,
+      );
+      await handler.initializeRelaySystem(
+        currentNodeId: 'node-self',
+        messageQueue: queue,
+      );
+
+      engine.relayCallback?.call(_relayMessage(), 'legacy-hop');
+      expect(sent['legacy-hop']!['routingPath'], isNotNull);
+      expect(sent['legacy-hop']!.containsKey('rp'), isFalse);
+
+      final compactOnly = MeshRelayMessage(
+        originalMessageId: 'relay-msg-1',
+        originalContent: 'hello',
+        relayMetadata: RelayMetadata.fromJson(
+          _metadata().toWireJson(compact: true),
+        ).nextHop('node-self'),
+        relayNodeId: 'node-self',
+        relayedAt: DateTime.fromMillisecondsSinceEpoch(2000),
+      );
+      sent.clear();
+      engine.relayCallback?.call(compactOnly, 'legacy-hop');
+      engine.relayCallback?.call(compactOnly, 'compact-hop');
+
+      expect(sent.keys, ['compact-hop']);
+      expect(sent['compact-hop']!.containsKey('routingPath'), isFalse);
+      expect(sent['compact-hop']!['rp'], isA<String>());
+    });
+
     test('dispose is safe and setCurrentNodeId updates ACK sender', () async {
       ProtocolMessage? forwardedAck;
       handler.onSendAckMessage = (message) => forwardedAck = message;
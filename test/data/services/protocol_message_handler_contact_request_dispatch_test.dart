@@ -5,8 +5,10 @@ import 'package:pak_connect/domain/interfaces/i_contact_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_security_service.dart';
 import 'package:pak_connect/domain/models/crypto_header.dart';
 import 'package:pak_connect/domain/models/encryption_method.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
 import 'package:pak_connect/domain/models/protocol_message.dart';
 import 'package:pak_connect/domain/models/security_level.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
 
 /// Supplementary tests for ProtocolMessageHandler
 /// Covers message type dispatch: contactRequest, contactAccept, contactReject,
@@ -254,6 +256,27 @@ void main() {
 
  expect(result, isNull);
  });
+
+ test('ping is answered with a compact pong only for compactAck peers',
+ () async {
+ addTearDown(PeerCapabilityRegistry.instance.clear);
+ final sent = <ProtocolMessage>[];
+ handler.onSendAckMessage(sent.add);
+
+ await handler.processProtocolMessage(message: ProtocolMessage.ping(),
+ fromDeviceId: 'device-legacy',
+ fromNodeId: 'node-legacy',
+);
+ expect(sent, isEmpty);
+
+ PeerCapabilityRegistry.instance.record('node-8', PeerCapabilities.local);
+ await handler.processProtocolMessage(message: ProtocolMessage.ping(),
+ fromDeviceId: 'device-8',
+ fromNodeId: 'node-8',
+);
+ expect(sent.single.type, ProtocolMessageType.pong);
+ expect(sent.single.toBytes().first, 0x04);
+ });
  });
 
  group('ack dispatch', () {
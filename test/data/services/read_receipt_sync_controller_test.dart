@@ -0,0 +1,195 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/data/database/database_helper.dart';
+import 'package:pak_connect/data/repositories/message_repository.dart';
+import 'package:pak_connect/data/services/read_receipt_sync_controller.dart';
+import 'package:pak_connect/domain/entities/message.dart';
+import 'package:pak_connect/domain/models/protocol_message.dart';
+import 'package:pak_connect/domain/models/read_watermark.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+
+import '../../test_helpers/test_setup.dart';
+
+void main() {
+  late MessageRepository messageRepository;
+  late ReadReceiptSyncController controller;
+  late List<(ChatId, ProtocolMessage)> sent;
+  late bool peerReachable;
+
+  setUpAll(() async {
+    await TestSetup.initializeTestEnvironment(dbLabel: 'read_receipt_sync');
+  });
+
+  setUp(() async {
+    await TestSetup.fullDatabaseReset();
+    messageRepository = MessageRepository();
+    sent = [];
+    peerReachable = true;
+    controller = ReadReceiptSyncController(
+      messageRepository: messageRepository,
+      // Flushes are driven explicitly below.
+      flushDelay: const Duration(hours: 1),
+      retryDelay: const Duration(hours: 1),
+    )..configureTransport((chatId, message) async {
+        if (!peerReachable) return false;
+        sent.add((chatId, message));
+        return true;
+      });
+  });
+
+  tearDown(() {
+    controller.dispose();
+  });
+
+  tearDownAll(() async {
+    await DatabaseHelper.deleteDatabase();
+  });
+
+  Future<void> saveMessage(
+    String id,
+    String chatId, {
+    required bool fromMe,
+    required int timestampMs,
+    MessageStatus status = MessageStatus.delivered,
+  }) => messageRepository.saveMessage(
+    Message(
+      id: MessageId(id),
+      chatId: ChatId(chatId),
+      content: 'content $id',
+      timestamp: DateTime.fromMillisecondsSinceEpoch(timestampMs),
+      isFromMe: fromMe,
+      status: status,
+    ),
+  );
+
+  Future<Set<String>> readMessageIds(String chatId) async {
+    final db = await DatabaseHelper.database;
+    final rows = await db.query(
+      'messages',
+      columns: ['id'],
+      where: 'chat_id = ? AND read_receipt_json IS NOT NULL',
+      whereArgs: [chatId],
+    );
+    return rows.map((row) => row['id'] as String).toSet();
+  }
+
+  group('ReadReceiptSyncController (reader side)', () {
+    test('300 unread messages produce one small watermark frame', () async {
+      for (var i = 0; i < 300; i++) {
+        await saveMessage(
+          'in-$i',
+          'peer-a',
+          fromMe: false,
+          timestampMs: 1000 + i,
+        );
+      }
+
+      // Scrolling re-marks the chat several times before the flush.
+      for (var i = 0; i < 5; i++) {
+        await controller.recordChatRead(const ChatId('peer-a'));
+      }
+      await controller.flush();
+
+      expect(sent, hasLength(1));
+      final (chatId, frame) = sent.single;
+      expect(chatId, const ChatId('peer-a'));
+      expect(frame.type, ProtocolMessageType.readReceipt);
+      expect(frame.readWatermark!.anchorMessageId, 'in-299');
+      expect(frame.toBytes().length, lessThan(160));
+
+      await controller.flush();
+      expect(sent, hasLength(1));
+    });
+
+    test('a newer anchor supersedes the pending one', () async {
+      controller.recordReadUpTo(const ChatId('peer-b'), const MessageId('m1'));
+      await controller.flush();
+      expect(sent.single.$2.readWatermark!.anchorMessageId, 'm1');
+
+      controller.recordReadUpTo(
+        const ChatId('peer-b'),
+        const MessageId('newest'),
+      );
+      await controller.flush();
+      final watermark = sent.last.$2.readWatermark!;
+      expect(watermark.anchorMessageId, 'newest');
+      expect(watermark.isNewerThan(sent.first.$2.readWatermark), isTrue);
+    });
+
+    test('unreachable peers keep their watermark pending', () async {
+      peerReachable = false;
+      controller.recordReadUpTo(const ChatId('peer-c'), const MessageId('m1'));
+      await controller.flush();
+      expect(sent, isEmpty);
+      expect(controller.getStatistics()['pendingChats'], 1);
+
+      peerReachable = true;
+      await controller.flush();
+      expect(sent, hasLength(1));
+      expect(controller.getStatistics()['pendingChats'], 0);
+    });
+
+    test('disabled receipts send nothing', () async {
+      controller.receiptsEnabled = () async => false;
+      controller.recordReadUpTo(const ChatId('peer-d'), const MessageId('m1'));
+      await controller.flush();
+      expect(sent, isEmpty);
+    });
+  });
+
+  group('ReadReceiptSyncController (sender side)', () {
+    test('watermark marks delivered messages up to the anchor in one pass', () async {
+      await saveMessage('out-1', 'peer-e', fromMe: true, timestampMs: 1000);
+      await saveMessage(
+        'out-2',
+        'peer-e',
+        fromMe: true,
+        timestampMs: 2000,
+        status: MessageStatus.sent,
+      );
+      await saveMessage('out-3', 'peer-e', fromMe: true, timestampMs: 3000);
+      await saveMessage('out-4', 'peer-e', fromMe: true, timestampMs: 4000);
+      await saveMessage('out-5', 'peer-e', fromMe: true, timestampMs: 5000);
+      await saveMessage('in-1', 'peer-e', fromMe: false, timestampMs: 1500);
+
+      final updated = await controller.applyRemoteWatermark(
+        const ChatId('peer-e'),
+        const ReadWatermark(version: 10, anchorMessageId: 'out-3'),
+      );
+
+      // out-2 may still be in flight; out-4 and out-5 are past the anchor.
+      expect(updated, 2);
+      expect(await readMessageIds('peer-e'), {'out-1', 'out-3'});
+    });
+
+    test('stale and replayed watermarks are ignored', () async {
+      await saveMessage('out-1', 'peer-f', fromMe: true, timestampMs: 1000);
+      await saveMessage('out-2', 'peer-f', fromMe: true, timestampMs: 2000);
+
+      await controller.handleReadReceipt(
+        ProtocolMessage.readReceipt(
+          watermark: const ReadWatermark(version: 5, anchorMessageId: 'out-1'),
+        ),
+        'peer-f',
+      );
+      final stale = await controller.applyRemoteWatermark(
+        const ChatId('peer-f'),
+        const ReadWatermark(version: 4, anchorMessageId: 'out-2'),
+      );
+
+      expect(stale, 0);
+      expect(await readMessageIds('peer-f'), {'out-1'});
+    });
+
+    test('watermark payload round-trips through the wire format', () {
+      final frame = ProtocolMessage.readReceipt(
+        watermark: const ReadWatermark(version: 7, anchorMessageId: 'a'),
+      );
+
+      final decoded = ProtocolMessage.fromBytes(frame.toBytes());
+
+      expect(decoded.type, ProtocolMessageType.readReceipt);
+      expect(decoded.readWatermark!.version, 7);
+      expect(decoded.readWatermark!.anchorMessageId, 'a');
+    });
+  });
+}
@@ -0,0 +1,137 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/entities/chat_list_item.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+
+ChatListItem _chat(String id, int minute, {bool online = false}) =>
+    ChatListItem(
+      chatId: ChatId(id),
+      contactName: 'User $id',
+      contactPublicKey: 'pk-$id',
+      lastMessage: 'hi',
+      lastMessageTime: DateTime(2025, 1, 1, 12, minute),
+      unreadCount: 0,
+      isOnline: online,
+      hasUnsentMessages: false,
+    );
+
+List<String> _ids(ChatListModel model) =>
+    model.items.map((c) => c.chatId.value).toList();
+
+void main() {
+  late ChatListModel model;
+
+  setUp(() {
+    model = ChatListModel()
+      ..reset([_chat('on', 0, online: true), _chat('a', 3), _chat('b', 2)]);
+  });
+
+  test('new message moves its row to the top of its group', () {
+    final patch = model.apply(
+      ChatMessageInserted(
+        chatId: ChatId('b'),
+        content: 'latest',
+        timestamp: DateTime(2025, 1, 1, 12, 5),
+      ),
+    );
+
+    expect(patch.refetch, isFalse);
+    final moved = patch.diff as ChatRowMoved;
+    expect((moved.from, moved.to), (2, 1));
+    expect(moved.item.lastMessage, 'latest');
+    expect(_ids(model), ['on', 'b', 'a']);
+  });
+
+  test('late older message keeps the preview and only flags failure', () {
+    final late = model.apply(
+      ChatMessageInserted(
+        chatId: ChatId('a'),
+        content: 'relayed late',
+        timestamp: DateTime(2025, 1, 1, 12, 1),
+      ),
+    );
+    expect(late.diff, isNull);
+    expect(late.refetch, isFalse);
+    expect(model.itemFor(ChatId('a'))!.lastMessage, 'hi');
+    expect(_ids(model), ['on', 'a', 'b']);
+
+    final failed = model.apply(
+      ChatMessageInserted(
+        chatId: ChatId('a'),
+        content: 'flushed late',
+        timestamp: DateTime(2025, 1, 1, 12, 1),
+        failed: true,
+      ),
+    );
+    final updated = failed.diff as ChatRowUpdated;
+    expect(updated.item.hasUnsentMessages, isTrue);
+    expect(updated.item.lastMessage, 'hi');
+    expect(updated.item.lastMessageTime, DateTime(2025, 1, 1, 12, 3));
+    expect(_ids(model), ['on', 'a', 'b']);
+  });
+
+  test('unread, rename and presence patch rows by key', () {
+    final unread = model.apply(
+      ChatUnreadChanged(chatId: ChatId('a'), unreadCount: 4),
+    );
+    expect(unread.diff, isA<ChatRowUpdated>());
+    expect(model.itemFor(ChatId('a'))!.unreadCount, 4);
+
+    model.apply(
+      const ChatContactRenamed(publicKey: 'pk-b', displayName: 'Bea'),
+    );
+    expect(model.itemFor(ChatId('b'))!.contactName, 'Bea');
+
+    final presence = model.apply(
+      const ChatPresenceChanged(publicKey: 'pk-b', isOnline: true),
+    );
+    expect(presence.diff, isA<ChatRowMoved>());
+    expect(_ids(model), ['b', 'on', 'a']);
+
+    // Unchanged values produce no diff.
+    expect(
+      model
+          .apply(ChatUnreadChanged(chatId: ChatId('a'), unreadCount: 4))
+          .diff,
+      isNull,
+    );
+  });
+
+  test('events the model cannot settle ask for a refetch', () {
+    expect(
+      model
+          .apply(
+            ChatMessageInserted(
+              chatId: ChatId('new'),
+              content: 'hello',
+              timestamp: DateTime(2025),
+            ),
+          )
+          .refetch,
+      isTrue,
+    );
+
+    model.apply(
+      ChatMessageStatusChanged(chatId: ChatId('a'), failed: true),
+    );
+    expect(model.itemFor(ChatId('a'))!.hasUnsentMessages, isTrue);
+    expect(
+      model
+          .apply(ChatMessageStatusChanged(chatId: ChatId('a'), failed: false))
+          .refetch,
+      isTrue,
+    );
+    expect(
+      model.apply(const ChatListInvalidated('message deleted')).refetch,
+      isTrue,
+    );
+  });
+
+  test('upsert inserts unknown chats at their ordered slot', () {
+    final diff = model.upsert(_chat('c', 1)) as ChatRowInserted;
+
+    expect(diff.index, 3);
+    expect(_ids(model), ['on', 'a', 'b', 'c']);
+    expect(model.itemFor(ChatId('c')), same(diff.item));
+  });
+}
@@ -0,0 +1,159 @@
+import 'dart:convert';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/models/compact_routing_path.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/message_priority.dart';
+
+String _ephemeralKey(int seed) =>
+    List.generate(64, (i) => ((seed * 31 + i) % 16).toRadixString(16)).join();
+
+void main() {
+  final nodeA = _ephemeralKey(1);
+  final nodeB = _ephemeralKey(2);
+  final nodeC = _ephemeralKey(3);
+  final nodeD = _ephemeralKey(4);
+
+  RelayMetadata origin() => RelayMetadata.create(
+    originalMessageContent: 'hello',
+    priority: MessagePriority.urgent,
+    originalSender: 'sender',
+    finalRecipient: 'recipient',
+    currentNodeId: nodeA,
+  );
+
+  group('RelayMetadata compact wire path', () {
+    test('compact wire form carries 4-byte hop digests instead of keys', () {
+      final metadata = origin().nextHop(nodeB).nextHop(nodeC);
+      final compact = metadata.toWireJson(compact: true);
+
+      final full = jsonEncode(metadata.toJson());
+      final wire = jsonEncode(compact);
+
+      expect(compact.containsKey('routingPath'), isFalse);
+      expect(wire, isNot(contains(nodeA)));
+      expect(
+        base64Decode(compact['rp'] as String),
+        hasLength(3 * CompactRoutingPath.digestLength),
+      );
+      expect(full.length - wire.length, greaterThan(3 * 60));
+    });
+
+    test('default wire form keeps the full path for older peers', () {
+      final metadata = origin().nextHop(nodeB);
+      final json =
+          jsonDecode(jsonEncode(metadata.toWireJson()))
+              as Map<String, dynamic>;
+
+      // Older decoders call List<String>.from(json['routingPath']).
+      expect(List<String>.from(json['routingPath']), [nodeA, nodeB]);
+      expect(json.containsKey('rp'), isFalse);
+    });
+
+    test('decoded wire path keeps loop detection and hop accounting', () {
+      final sent = origin().nextHop(nodeB);
+      final received = RelayMetadata.fromJson(
+        jsonDecode(jsonEncode(sent.toWireJson(compact: true)))
+            as Map<String, dynamic>,
+      );
+
+      expect(received.routingPath, isEmpty);
+      expect(received.pathLength, 2);
+      expect(received.isOriginator, isFalse);
+      expect(received.hasNodeInPath(nodeA), isTrue);
+      expect(received.hasNodeInPath(nodeB), isTrue);
+      expect(received.hasNodeInPath(nodeC), isFalse);
+      expect(() => received.nextHop(nodeA), throwsA(isA<RelayException>()));
+
+      final forwarded = received.nextHop(nodeC);
+      expect(forwarded.routingPath, [nodeC]);
+      expect(forwarded.pathLength, 3);
+      expect(forwarded.hasNodeInPath(nodeC), isTrue);
+
+      // Older peers would read [nodeC] as the whole path.
+      expect(forwarded.hasFullRoutingPath, isFalse);
+      expect(forwarded.toWireJson, throwsA(isA<RelayException>()));
+      expect(sent.hasFullRoutingPath, isTrue);
+
+      // Persisting and restoring keeps the compact path.
+      final restored = RelayMetadata.fromJson(forwarded.toJson());
+      expect(restored.pathLength, 3);
+      expect(restored.hasNodeInPath(nodeA), isTrue);
+    });
+
+    test('ACK return path locates relays by keyed digest', () {
+      final received = RelayMetadata.fromJson(
+        origin().nextHop(nodeB).nextHop(nodeC).toWireJson(compact: true),
+      );
+      final ackPath = received.ackRoutingPath;
+
+      expect(ackPath, hasLength(3));
+      expect(
+        CompactRoutingPath.indexOfNode(
+          ackPath,
+          nodeB,
+          key: received.messageHash,
+        ),
+        1,
+      );
+      // Without the message hash a digest entry cannot be matched.
+      expect(CompactRoutingPath.indexOfNode(ackPath, nodeB), -1);
+      expect(CompactRoutingPath.indexOfNode([nodeC, nodeB], nodeB), 1);
+    });
+
+    test('ACK return path uses full IDs for hops known locally', () {
+      final received = RelayMetadata.fromJson(
+        origin().nextHop(nodeB).toWireJson(compact: true),
+      ).nextHop(nodeC);
+      final ackPath = received.ackRoutingPath;
+
+      expect(ackPath, hasLength(3));
+      expect(ackPath.first, nodeC);
+      expect(
+        CompactRoutingPath.resolveEntries(
+          ackPath,
+          [nodeA],
+          key: received.messageHash,
+        ).last,
+        nodeA,
+      );
+    });
+
+    test('digests differ per message so hops are not linkable', () {
+      expect(
+        CompactRoutingPath.digestFor(nodeA, 'hash-1'),
+        isNot(CompactRoutingPath.digestFor(nodeA, 'hash-2')),
+      );
+    });
+  });
+
+  group('CompactRoutingPath', () {
+    test('long paths keep a digest for every hop', () {
+      final nodes = List.generate(12, (i) => _ephemeralKey(100 + i));
+      final path = CompactRoutingPath.fromNodeIds(nodes, key: 'hash');
+
+      expect(path.length, nodes.length);
+      expect(path.digests, hasLength(nodes.length));
+      expect(nodes.every(path.contains), isTrue);
+      expect(
+        CompactRoutingPath.indexOfNode(path.entryIds, nodes.first, key: 'hash'),
+        0,
+      );
+
+      final decoded = CompactRoutingPath.fromJson(
+        jsonDecode(jsonEncode(path.toJson())) as Map<String, dynamic>,
+        key: 'hash',
+      )!;
+      expect(decoded.length, nodes.length);
+      expect(nodes.every(decoded.contains), isTrue);
+      expect(decoded.contains(nodeD), isFalse);
+    });
+
+    test('legacy frames without compact fields decode to null', () {
+      expect(
+        CompactRoutingPath.fromJson(const {'routingPath': []}, key: 'hash'),
+        isNull,
+      );
+    });
+  });
+}
@@ -0,0 +1,124 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/models/protocol_message.dart';
+
+void main() {
+  group('ProtocolMessage control frames', () {
+    test('compact ACK round-trips through the control frame', () {
+      final ack = ProtocolMessage.ack(
+        originalMessageId: 'msg-✓-42',
+        compact: true,
+      );
+
+      final bytes = ack.toBytes();
+      final decoded = ProtocolMessage.fromBytes(bytes);
+
+      expect(bytes.first, 0x04);
+      expect(bytes.length, 10 + utf8.encode('msg-✓-42').length);
+      expect(decoded.type, ProtocolMessageType.ack);
+      expect(decoded.ackOriginalId, 'msg-✓-42');
+      expect(
+        decoded.timestamp.millisecondsSinceEpoch,
+        ack.timestamp.millisecondsSinceEpoch,
+      );
+    });
+
+    test('payload is only built on request and re-encodes compactly', () {
+      final decoded = ProtocolMessage.fromBytes(
+        ProtocolMessage.ack(originalMessageId: 'm1', compact: true).toBytes(),
+      );
+
+      expect(decoded.payload, {'originalMessageId': 'm1'});
+      expect(decoded.toBytes().first, 0x04);
+    });
+
+    test('ACKs stay on JSON frames unless built compact', () {
+      final plain = ProtocolMessage.ack(originalMessageId: 'm1');
+      final signed = ProtocolMessage(
+        type: ProtocolMessageType.ack,
+        payload: {'originalMessageId': 'm1'},
+        timestamp: DateTime.now(),
+        signature: 'sig',
+      );
+      final extended = ProtocolMessage(
+        type: ProtocolMessageType.ack,
+        payload: {'originalMessageId': 'm1', 'extra': true},
+        timestamp: DateTime.now(),
+      );
+
+      expect(plain.toBytes(enableCompression: false).first, 0x00);
+      expect(signed.toBytes(enableCompression: false).first, 0x00);
+      final decoded = ProtocolMessage.fromBytes(
+        extended.toBytes(enableCompression: false),
+      );
+      expect(decoded.payload['extra'], isTrue);
+      expect(ProtocolMessage.ping().toBytes().first, 0x00);
+    });
+
+    test('compact ping and pong are bodyless control frames', () {
+      for (final message in [
+        ProtocolMessage.ping(compact: true),
+        ProtocolMessage.pong(compact: true),
+      ]) {
+        final bytes = message.toBytes();
+        final decoded = ProtocolMessage.fromBytes(bytes);
+
+        expect(bytes, hasLength(10));
+        expect(bytes.first, 0x04);
+        expect(decoded.type, message.type);
+        expect(decoded.payload, isEmpty);
+      }
+      expect(ProtocolMessage.pong().toBytes().first, 0x00);
+    });
+
+    test('rejects truncated and non-ACK control frames', () {
+      final bytes = ProtocolMessage.ack(
+        originalMessageId: 'm1',
+        compact: true,
+      ).toBytes();
+
+      expect(
+        () => ProtocolMessage.fromBytes(bytes.sublist(0, 6)),
+        throwsArgumentError,
+      );
+      bytes[1] = ProtocolMessageType.textMessage.wireType;
+      expect(() => ProtocolMessage.fromBytes(bytes), throwsArgumentError);
+      // Ping and pong frames carry no body.
+      bytes[1] = ProtocolMessageType.ping.wireType;
+      expect(() => ProtocolMessage.fromBytes(bytes), throwsArgumentError);
+    });
+
+    test('payload views follow writes to the payload map', () {
+      final handshake = ProtocolMessage(
+        type: ProtocolMessageType.noiseHandshake1,
+        payload: {'handshakeData': base64.encode([1])},
+        timestamp: DateTime.now(),
+      );
+      expect(handshake.noiseHandshakeData, [1]);
+
+      handshake.payload['handshakeData'] = base64.encode([2]);
+      expect(handshake.noiseHandshakeData, [2]);
+    });
+
+    test('received payloads are read-only and their views memoized', () {
+      final received = ProtocolMessage.fromBytes(
+        ProtocolMessage.noiseHandshake1(
+          handshakeData: Uint8List.fromList([1, 2]),
+          peerId: 'peer',
+        ).toBytes(),
+      );
+
+      expect(received.noiseHandshakeData, [1, 2]);
+      expect(
+        received.noiseHandshakeData,
+        same(received.noiseHandshakeData),
+      );
+      expect(
+        () => received.payload['handshakeData'] = base64.encode([3]),
+        throwsUnsupportedError,
+      );
+    });
+  });
+}
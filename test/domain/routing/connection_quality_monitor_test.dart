@@ -2,8 +2,12 @@ import 'package:bluetooth_low_energy/bluetooth_low_energy.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/routing/connection_quality_monitor.dart';
+import 'package:pak_connect/domain/routing/network_topology_analyzer.dart';
+import 'package:pak_connect/domain/routing/route_calculator.dart';
 import 'package:pak_connect/domain/routing/routing_models.dart';
+import 'package:pak_connect/domain/routing/smart_mesh_router.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
+import 'package:shared_preferences/shared_preferences.dart';
 
 import '../../test_helpers/mocks/mock_connection_service.dart';
 
@@ -171,5 +175,78 @@ void main() {
       monitor.dispose();
       expect(monitor.getMonitoringStats().monitoredConnections, 0);
     });
+
+    test('a router does not clear the monitor it was handed', () async {
+      final monitor = ConnectionQualityMonitor();
+      monitor.recordMessageSent('node-a', 'msg-1');
+      monitor.recordMessageAcknowledged('node-a', 'msg-1', latency: 90.0);
+
+      final router = SmartMeshRouter(
+        routeCalculator: RouteCalculator(qualityMonitor: monitor),
+        topologyAnalyzer: NetworkTopologyAnalyzer(),
+        qualityMonitor: monitor,
+        currentNodeId: 'self',
+      );
+      await router.clearAll();
+      router.dispose();
+
+      expect(monitor.getLinkEstimate('node-a')!.srttMs, 90.0);
+    });
+
+    test('ranks links by ETX x RTT cost', () {
+      final monitor = ConnectionQualityMonitor();
+
+      monitor.recordMessageSent('good', 'm1');
+      monitor.recordMessageAcknowledged('good', 'm1', latency: 100.0);
+      for (var i = 0; i < 5; i++) {
+        monitor.recordMessageSent('bad', 'b$i');
+      }
+
+      expect(monitor.getLinkEstimate('good')!.srttMs, 100.0);
+      expect(
+        monitor.getLinkEtx('bad'),
+        greaterThan(monitor.getLinkEtx('good')),
+      );
+      expect(
+        monitor.getLinkCost('good'),
+        lessThan(monitor.getLinkCost('unknown')),
+      );
+      expect(
+        monitor.getLinkCost('unknown'),
+        lessThan(monitor.getLinkCost('bad')),
+      );
+    });
+
+    test('restores links by stable identity after a restart', () async {
+      SharedPreferences.setMockInitialValues({});
+      ConnectionQualityMonitor.configureStableKeyResolver(
+        (nodeId) => nodeId.startsWith('session-') ? 'persistent-a' : null,
+      );
+      addTearDown(
+        () => ConnectionQualityMonitor.configureStableKeyResolver(null),
+      );
+
+      final first = ConnectionQualityMonitor();
+      await first.initialize();
+      first.recordMessageSent('session-1', 'msg-1');
+      first.recordMessageAcknowledged('session-1', 'msg-1', latency: 150.0);
+      first.recordMessageSent('ephemeral-only', 'msg-2');
+      first.dispose();
+      await pumpEventQueue();
+
+      final prefs = await SharedPreferences.getInstance();
+      final stored = prefs.getString('connection_quality_links_v1')!;
+      expect(stored, isNot(contains('persistent-a')));
+      expect(stored, isNot(contains('session-1')));
+
+      // Same neighbour, new ephemeral session ID.
+      final second = ConnectionQualityMonitor();
+      await second.initialize();
+      addTearDown(second.dispose);
+
+      expect(second.getLinkEstimate('session-2')!.srttMs, 150.0);
+      expect(second.getLinkEstimate('ephemeral-only'), isNull);
+      expect(await second.getConnectionScore('session-2'), greaterThan(0.5));
+    });
   });
 }
@@ -0,0 +1,112 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/routing/link_estimate.dart';
+
+void main() {
+  final t0 = DateTime.utc(2026, 1, 1, 12);
+
+  group('LinkEstimate', () {
+    test('new links start at the prior delivery ratio', () {
+      final link = LinkEstimate(firstSeen: t0);
+
+      expect(link.deliveryRatio(t0), LinkEstimate.priorDeliveryRatio);
+      expect(link.srttMs, isNull);
+      expect(link.rttBoundMs(), LinkEstimate.defaultRttMs);
+    });
+
+    test('ETX rises with losses and decays back toward the prior', () {
+      final link = LinkEstimate(firstSeen: t0);
+      for (var i = 0; i < 10; i++) {
+        link.recordSent(t0);
+      }
+      link.recordAck(t0);
+
+      final lossyEtx = link.etx(t0);
+      expect(lossyEtx, greaterThan(3.0));
+
+      final later = t0.add(LinkEstimate.deliveryHalfLife * 6);
+      expect(link.etx(later), lessThan(lossyEtx));
+      expect(
+        link.deliveryRatio(later),
+        closeTo(LinkEstimate.priorDeliveryRatio, 0.1),
+      );
+    });
+
+    test('smooths RTT and tracks its deviation', () {
+      final link = LinkEstimate(firstSeen: t0);
+      link.recordSent(t0);
+      link.recordAck(t0, rttMs: 200);
+      expect(link.srttMs, 200);
+      expect(link.rttVarMs, 100);
+
+      link.recordSent(t0);
+      link.recordAck(t0, rttMs: 600);
+      expect(link.srttMs, 250);
+      expect(link.rttVarMs, 175);
+      expect(link.rttBoundMs(), 250 + 4 * 175);
+    });
+
+    test('signal trend goes negative while the link fades', () {
+      final link = LinkEstimate(firstSeen: t0);
+      for (final strength in [0.9, 0.8, 0.6, 0.4]) {
+        link.recordSignal(t0, strength);
+      }
+
+      expect(link.signal, lessThan(0.9));
+      expect(link.signalTrend, lessThan(0));
+    });
+
+    test('predicts the next encounter from inter-contact gaps', () {
+      final link = LinkEstimate(firstSeen: t0)..recordEncounter(t0);
+      expect(link.predictedEncounterWait(t0), isNull);
+
+      // A reconnect within the minimum gap is not a new encounter.
+      link.recordEncounter(t0.add(const Duration(seconds: 20)));
+      expect(link.encounterIntervalMs, isNull);
+
+      final t1 = t0.add(const Duration(minutes: 40));
+      link.recordEncounter(t1);
+      expect(
+        link.encounterIntervalMs,
+        const Duration(minutes: 40).inMilliseconds,
+      );
+      expect(
+        link.predictedEncounterWait(t1.add(const Duration(minutes: 10))),
+        const Duration(minutes: 30),
+      );
+      // Overdue: expect one more interval rather than zero.
+      expect(
+        link.predictedEncounterWait(t1.add(const Duration(hours: 2))),
+        const Duration(minutes: 40),
+      );
+
+      final restored = LinkEstimate.fromJson(link.toJson())!;
+      expect(restored.encounterIntervalMs, link.encounterIntervalMs);
+      expect(
+        restored.lastEncounter!.millisecondsSinceEpoch,
+        t1.millisecondsSinceEpoch,
+      );
+    });
+
+    test('round-trips through JSON', () {
+      final link = LinkEstimate(firstSeen: t0)
+        ..recordSent(t0)
+        ..recordSent(t0)
+        ..recordAck(t0, rttMs: 120)
+        ..recordSignal(t0, 0.7);
+
+      final restored = LinkEstimate.fromJson(link.toJson())!;
+
+      expect(
+        restored.deliveryRatio(t0),
+        closeTo(link.deliveryRatio(t0), 1e-3),
+      );
+      expect(restored.srttMs, link.srttMs);
+      expect(restored.signal, link.signal);
+      expect(
+        restored.lastSeen.millisecondsSinceEpoch,
+        link.lastSeen.millisecondsSinceEpoch,
+      );
+      expect(LinkEstimate.fromJson(const {'s': 1}), isNull);
+    });
+  });
+}
@@ -105,6 +105,39 @@ void main() {
       expect(AutoArchiveScheduler.isRunning, isFalse);
     });
 
+    test('indexed repositories are read in keyset chunks, not listed', () async {
+      final indexed = _IndexedChatsRepository(
+        List.generate(
+          60,
+          (i) => (
+            chatId: ChatId('chat-$i'),
+            contactName: 'Chat $i',
+            lastMessageTime: DateTime.now().subtract(Duration(days: 90 - i)),
+          ),
+        ),
+      );
+      _configure(
+        preferences: preferences,
+        chatsRepository: indexed,
+        archiveService: archiveService,
+      );
+      preferences.boolValues[PreferenceKeys.autoArchiveOldChats] = true;
+      preferences.intValues[PreferenceKeys.archiveAfterDays] = 30;
+      // A failed chat stays in the index but is not read again this run.
+      archiveService.resultByChatId['chat-0'] = ArchiveOperationResult.failure(
+        message: 'failed',
+        operationType: ArchiveOperationType.archive,
+        operationTime: Duration.zero,
+      );
+
+      final count = await AutoArchiveScheduler.checkNow();
+
+      expect(count, 59);
+      expect(indexed.getAllChatsCalls, 0);
+      expect(indexed.pageSizes, [25, 25, 10]);
+      expect(archiveService.archivedChatIds, hasLength(60));
+    });
+
     test('start catches preference exceptions and keeps scheduler stopped', () async {
       _configure(
         preferences: preferences,
@@ -228,6 +261,33 @@ class _FakeChatsRepository extends Fake implements IChatsRepository {
   }
 }
 
+class _IndexedChatsRepository extends _FakeChatsRepository
+    implements IChatActivityIndex {
+  _IndexedChatsRepository(this.rows);
+
+  final List<InactiveChat> rows;
+  final List<int> pageSizes = <int>[];
+
+  @override
+  Future<List<InactiveChat>> getChatsInactiveSince(
+    DateTime cutoff, {
+    ChatActivityCursor? after,
+    int limit = 50,
+  }) async {
+    final page = rows
+        .where((row) => !row.lastMessageTime.isAfter(cutoff))
+        .where(
+          (row) =>
+              after == null ||
+              row.lastMessageTime.isAfter(after.lastMessageTime),
+        )
+        .take(limit)
+        .toList();
+    pageSizes.add(page.length);
+    return page;
+  }
+}
+
 class _FakeArchiveManagementService extends Fake
     implements ArchiveManagementService {
   final Map<String, ArchiveOperationResult> resultByChatId =
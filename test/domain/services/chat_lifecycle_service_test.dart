@@ -234,6 +234,34 @@ void main() {
       expect(cacheState.starredMessageIds, isEmpty);
     });
 
+    test('deleteChat removes the chat row like deleteChats', () async {
+      final bulkRepository = _BulkChatsRepository([]);
+      final bulkService = ChatLifecycleService(
+        chatsRepository: bulkRepository,
+        messageRepository: messageRepository,
+        archiveRepository: archiveRepository,
+        archiveManagementService: archiveManagementService,
+        cacheState: cacheState,
+        notificationService: notificationService,
+        syncService: syncService,
+      );
+      cacheState.pinnedChats.addAll({ChatId('chat_1'), ChatId('chat_2')});
+      cacheState.starredMessageIds.addAll({MessageId('m1'), MessageId('m4')});
+
+      final single = await bulkService.deleteChat('chat_1');
+      final batch = await bulkService.deleteChats(['chat_2']);
+
+      expect(single.success, isTrue);
+      expect(batch.success, isTrue);
+      expect(bulkRepository.deletedChats, [
+        [ChatId('chat_1')],
+        [ChatId('chat_2')],
+      ]);
+      expect(messageRepository.clearedChatIds, isEmpty);
+      expect(cacheState.pinnedChats, isEmpty);
+      expect(cacheState.starredMessageIds, isEmpty);
+    });
+
     test('clearChatMessages only clears chat messages and related starred IDs', () async {
       cacheState.starredMessageIds.addAll({MessageId('m1'), MessageId('m4')});
 
@@ -548,6 +576,30 @@ class _FakeChatsRepository implements IChatsRepository {
       throw UnimplementedError('Unexpected method call: $invocation');
 }
 
+class _BulkChatsRepository extends _FakeChatsRepository
+    implements IBulkChatOperations {
+  _BulkChatsRepository(super.chats);
+
+  final List<List<ChatId>> deletedChats = [];
+
+  @override
+  Future<List<MessageId>> deleteChats(List<ChatId> chatIds) async {
+    deletedChats.add(chatIds);
+    return [
+      for (final chatId in chatIds)
+        if (chatId.value == 'chat_1') ...[
+          MessageId('m1'),
+          MessageId('m2'),
+          MessageId('m3'),
+        ] else
+          MessageId('m4'),
+    ];
+  }
+
+  @override
+  Future<int> markChatsAsRead(List<ChatId> chatIds) async => chatIds.length;
+}
+
 class _FakeMessageRepository implements IMessageRepository {
   _FakeMessageRepository(this._messagesByChatId);
 
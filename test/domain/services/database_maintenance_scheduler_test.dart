@@ -0,0 +1,126 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/data/database/database_helper.dart';
+import 'package:pak_connect/data/database/database_provider.dart';
+import 'package:pak_connect/domain/services/database_maintenance_scheduler.dart';
+
+import '../../test_helpers/test_setup.dart';
+
+Future<int> _freePages() async {
+  final db = await DatabaseHelper.database;
+  final rows = await db.rawQuery('PRAGMA freelist_count');
+  return rows.first.values.first as int;
+}
+
+/// Fill and drop a scratch table so the file has free pages to reclaim
+Future<void> _leaveFreePages() async {
+  final db = await DatabaseHelper.database;
+  await db.execute('CREATE TABLE IF NOT EXISTS scratch (data BLOB)');
+  await db.transaction((txn) async {
+    for (var i = 0; i < 200; i++) {
+      await txn.rawInsert('INSERT INTO scratch VALUES (zeroblob(4000))');
+    }
+  });
+  await db.execute('DROP TABLE scratch');
+}
+
+void main() {
+  setUpAll(() async {
+    await TestSetup.initializeTestEnvironment(
+      dbLabel: 'db_maintenance_scheduler',
+    );
+  });
+
+  setUp(() async {
+    await TestSetup.fullDatabaseReset();
+  });
+
+  tearDownAll(() async {
+    await DatabaseHelper.deleteDatabase();
+  });
+
+  test('new databases use incremental auto_vacuum', () async {
+    final db = await DatabaseHelper.database;
+    final rows = await db.rawQuery('PRAGMA auto_vacuum');
+    expect(rows.first.values.first, 2);
+  });
+
+  test('reclaims free pages in steps and optimizes', () async {
+    await _leaveFreePages();
+    final before = await _freePages();
+    expect(before, greaterThan(0));
+
+    final scheduler = DatabaseMaintenanceScheduler(
+      databaseProvider: DatabaseProvider(),
+      runBudget: const Duration(seconds: 5),
+    );
+    final report = await scheduler.runNow();
+
+    expect(report.pagesReclaimed, before);
+    expect(report.pagesRemaining, 0);
+    expect(report.optimized, isTrue);
+    expect(await _freePages(), 0);
+  });
+
+  test('a cancelled run stops before doing work', () async {
+    await _leaveFreePages();
+    final before = await _freePages();
+
+    final scheduler = DatabaseMaintenanceScheduler(
+      databaseProvider: DatabaseProvider(),
+    );
+    final report = await scheduler.runNow(
+      token: MaintenanceCancelToken()..cancel(),
+    );
+
+    expect(report.cancelled, isTrue);
+    expect(report.optimized, isFalse);
+    expect(await _freePages(), before);
+  });
+
+  test('start runs once after the startup delay', () async {
+    await _leaveFreePages();
+    final scheduler = DatabaseMaintenanceScheduler(
+      databaseProvider: DatabaseProvider(),
+      startupDelay: const Duration(milliseconds: 10),
+      runBudget: const Duration(seconds: 5),
+    )..start();
+    addTearDown(scheduler.stop);
+
+    for (var i = 0; i < 100 && scheduler.lastReport == null; i++) {
+      await Future<void>.delayed(const Duration(milliseconds: 20));
+    }
+
+    expect(scheduler.lastReport, isNotNull);
+    expect(await _freePages(), 0);
+  });
+
+  test('a pending conversion runs once idle and charging', () async {
+    final db = await DatabaseHelper.database;
+    await db.rawQuery('PRAGMA auto_vacuum = NONE');
+    await db.execute('VACUUM');
+
+    var idleAndCharging = false;
+    final scheduler = DatabaseMaintenanceScheduler(
+      databaseProvider: DatabaseProvider(),
+      canRunHeavyWork: () => idleAndCharging,
+      startupDelay: const Duration(hours: 1),
+    )..start();
+    addTearDown(scheduler.stop);
+
+    final first = await scheduler.runNow();
+    expect(first.convertedToIncremental, isFalse);
+    expect(scheduler.conversionPending, isTrue);
+
+    scheduler.onConditionsChanged();
+    expect(scheduler.lastReport, same(first));
+
+    idleAndCharging = true;
+    scheduler.onConditionsChanged();
+    final second = await scheduler.runNow();
+
+    expect(second.convertedToIncremental, isTrue);
+    expect(scheduler.conversionPending, isFalse);
+    final rows = await db.rawQuery('PRAGMA auto_vacuum');
+    expect(rows.first.values.first, 2);
+  });
+}
@@ -0,0 +1,108 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/services/database_telemetry.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  final start = DateTime.utc(2025, 3, 1, 14);
+
+  test('writes roll up per table and rebase seeds row estimates', () {
+    final telemetry = DatabaseTelemetry();
+    for (var i = 0; i < 3; i++) {
+      telemetry.recordWrite(
+        'messages',
+        rows: 1,
+        bytes: 100,
+        now: start.add(Duration(minutes: i)),
+      );
+    }
+    telemetry.recordWrite(
+      'messages',
+      rows: -1,
+      now: start.add(const Duration(minutes: 3)),
+    );
+
+    final now = start.add(const Duration(minutes: 5));
+    var messages = telemetry.forTable('messages', now: now)!;
+    expect(messages.estimatedRows, isNull);
+    expect(messages.rowDelta, 2);
+    expect(messages.bytesWritten, 300);
+    expect(messages.writes, 4);
+    expect(messages.writesLastHour, 4);
+    expect(messages.bytesLastDay, 300);
+
+    telemetry
+      ..rebase({'messages': 40})
+      ..recordWrite('messages', rows: 1, now: now);
+    messages = telemetry.forTable('messages', now: now)!;
+    expect(messages.estimatedRows, 41);
+    expect(telemetry.forTable('chats'), isNull);
+  });
+
+  test('rebase skips tables nothing has reported on', () {
+    final telemetry = DatabaseTelemetry()
+      ..recordWrite('offline_message_queue', rows: 2);
+
+    telemetry.rebase({
+      for (var i = 0; i < DatabaseTelemetry.maxTables; i++)
+        'archived_messages_fts_$i': 10,
+      'offline_message_queue': 5,
+    });
+    telemetry.recordWrite('seen_messages', rows: 1);
+
+    expect(telemetry.tableNames, ['offline_message_queue', 'seen_messages']);
+    expect(telemetry.forTable('offline_message_queue')!.estimatedRows, 5);
+  });
+
+  test('timed statements record reads and latency', () async {
+    final telemetry = DatabaseTelemetry();
+
+    final result = await telemetry.time('contacts', () async => 7);
+    await expectLater(
+      telemetry.time('contacts', () async => throw StateError('boom')),
+      throwsStateError,
+    );
+
+    final contacts = telemetry.forTable('contacts')!;
+    expect(result, 7);
+    expect(contacts.reads, 2);
+    expect(contacts.writes, 0);
+    expect(contacts.maxLatencyMs, greaterThanOrEqualTo(0));
+  });
+
+  test('estimates row bytes from column values', () {
+    expect(
+      DatabaseTelemetry.estimateBytes({
+        'id': 'abcd',
+        'blob': [1, 2, 3],
+        'count': 5,
+        'flag': true,
+        'missing': null,
+      }),
+      4 + 3 + 8 + 1 + 1,
+    );
+  });
+
+  test('totals and baselines survive a restart', () async {
+    SharedPreferences.setMockInitialValues({});
+    final telemetry = DatabaseTelemetry();
+    await telemetry.initialize();
+    telemetry
+      ..rebase({'chats': 10})
+      ..recordWrite('chats', rows: 2, bytes: 64, now: start);
+    await telemetry.flush();
+
+    final restored = DatabaseTelemetry();
+    await restored.initialize();
+    final chats = restored.forTable(
+      'chats',
+      now: start.add(const Duration(minutes: 1)),
+    )!;
+
+    expect(chats.estimatedRows, 12);
+    expect(chats.bytesWritten, 64);
+    expect(chats.bytesLastDay, 64);
+    restored.clear();
+  });
+}
@@ -663,6 +663,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
     String? relayNodeId,
     String? messageHash,
     bool? persistToStorage = true,
+    bool? isOriginator = false,
   }) =>
       (super.noSuchMethod(
             Invocation.method(#queueMessage, [], {
@@ -679,6 +680,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
               #relayNodeId: relayNodeId,
               #messageHash: messageHash,
               #persistToStorage: persistToStorage,
+              #isOriginator: isOriginator,
             }),
             returnValue: _i7.Future<String>.value(
               _i14.dummyValue<String>(
@@ -697,6 +699,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -717,6 +720,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -738,6 +742,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
     String? relayNodeId,
     String? messageHash,
     bool? persistToStorage = true,
+    bool? isOriginator = false,
   }) =>
       (super.noSuchMethod(
             Invocation.method(#queueMessageWithIds, [], {
@@ -754,6 +759,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
               #relayNodeId: relayNodeId,
               #messageHash: messageHash,
               #persistToStorage: persistToStorage,
+              #isOriginator: isOriginator,
             }),
             returnValue: _i7.Future<_i3.MessageId>.value(
               _FakeMessageId_1(
@@ -772,6 +778,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -792,6 +799,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -0,0 +1,126 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
+import 'package:shared_preferences/shared_preferences.dart';
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  final start = DateTime.utc(2025, 3, 1, 14);
+
+  test('rolls samples up into every resolution', () {
+    final history = MeshMetricsHistory();
+    for (var s = 0; s < 120; s += 5) {
+      history.increment(
+        MeshMetricsHistory.relayed,
+        now: start.add(Duration(seconds: s)),
+      );
+    }
+    final now = start.add(const Duration(minutes: 2));
+
+    final tenSecond = history.query(
+      MeshMetricsHistory.relayed,
+      MetricRollup.tenSeconds,
+      now: now,
+    );
+    expect(tenSecond, hasLength(12));
+    expect(tenSecond.every((p) => p.sum == 2), isTrue);
+
+    final perMinute = history.query(
+      MeshMetricsHistory.relayed,
+      MetricRollup.oneMinute,
+      now: now,
+    );
+    expect(perMinute.map((p) => p.sum), [12, 12]);
+    expect(
+      history.total(
+        MeshMetricsHistory.relayed,
+        const Duration(hours: 1),
+        now: now,
+      ),
+      24,
+    );
+  });
+
+  test('gauges keep mean, min and max per bucket', () {
+    final history = MeshMetricsHistory();
+    for (final (i, value) in [40.0, 120.0, 80.0].indexed) {
+      history.record(
+        MeshMetricsHistory.handshakeLatencyMs,
+        value,
+        now: start.add(Duration(seconds: i)),
+      );
+    }
+
+    final point = history
+        .query(
+          MeshMetricsHistory.handshakeLatencyMs,
+          MetricRollup.oneMinute,
+          now: start.add(const Duration(seconds: 30)),
+        )
+        .single;
+    expect(point.count, 3);
+    expect(point.mean, 80);
+    expect(point.min, 40);
+    expect(point.max, 120);
+  });
+
+  test('old buckets are overwritten once the ring wraps', () {
+    final history = MeshMetricsHistory();
+    history.increment(MeshMetricsHistory.relayed, now: start);
+    final later = start.add(MetricRollup.tenSeconds.span);
+    history.increment(MeshMetricsHistory.relayed, by: 5, now: later);
+
+    final points = history.query(
+      MeshMetricsHistory.relayed,
+      MetricRollup.tenSeconds,
+      since: start,
+      now: later,
+    );
+    expect(points.single.sum, 5);
+  });
+
+  test('drop reasons are normalised into bounded series', () {
+    final history = MeshMetricsHistory();
+    history
+      ..recordDrop('Message TTL exceeded', now: start)
+      ..recordDrop('Message TTL exceeded', now: start)
+      ..recordDrop('Processing failed: StateError(42)', now: start);
+
+    expect(
+      history.dropsByReason(
+        const Duration(minutes: 5),
+        now: start.add(const Duration(seconds: 1)),
+      ),
+      {'message_ttl_exceeded': 2, 'processing_failed': 1},
+    );
+  });
+
+  test('minute and hour rollups survive a restart', () async {
+    SharedPreferences.setMockInitialValues({});
+    final history = MeshMetricsHistory();
+    await history.initialize();
+    history.record(MeshMetricsHistory.linkCount, 3, now: start);
+    await history.flush();
+
+    final restored = MeshMetricsHistory();
+    await restored.initialize();
+    final now = start.add(const Duration(seconds: 5));
+
+    expect(
+      restored
+          .query(MeshMetricsHistory.linkCount, MetricRollup.oneHour, now: now)
+          .single
+          .max,
+      3,
+    );
+    expect(
+      restored.query(
+        MeshMetricsHistory.linkCount,
+        MetricRollup.tenSeconds,
+        now: now,
+      ),
+      isEmpty,
+    );
+    restored.clear();
+  });
+}
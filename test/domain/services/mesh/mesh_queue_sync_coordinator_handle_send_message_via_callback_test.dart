@@ -205,6 +205,7 @@ class _CallbackCapturingQueue extends Fake
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async {
  final msg = QueuedMessage(id: 'q-${messages.length}',
  chatId: chatId,
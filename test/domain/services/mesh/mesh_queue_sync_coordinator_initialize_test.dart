@@ -157,6 +157,7 @@ class _FakeQueue extends Fake implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async {
  final msg = QueuedMessage(id: 'queued-${_messages.length}',
  chatId: chatId,
@@ -261,6 +261,7 @@ class _RecordingOfflineQueue extends InMemoryOfflineMessageQueue {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await super.queueMessage(
       chatId: chatId,
@@ -276,6 +277,7 @@ class _RecordingOfflineQueue extends InMemoryOfflineMessageQueue {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
 
     recordedMessages.add({
@@ -310,6 +312,7 @@ class _RecordingOfflineQueue extends InMemoryOfflineMessageQueue {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await super.queueMessageWithIds(
       chatId: chatId,
@@ -325,6 +328,7 @@ class _RecordingOfflineQueue extends InMemoryOfflineMessageQueue {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
 
     recordedMessages.add({
@@ -0,0 +1,89 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/models/peer_capabilities.dart';
+import 'package:pak_connect/domain/models/protocol_message.dart';
+import 'package:pak_connect/domain/services/mesh/peer_capability_registry.dart';
+
+void main() {
+  Logger.root.level = Level.OFF;
+
+  late PeerCapabilityRegistry registry;
+
+  setUp(() => registry = PeerCapabilityRegistry());
+
+  test('unknown peers keep the baseline format', () {
+    expect(registry.supports(null, PeerCapabilities.compactRelayPath), isFalse);
+    expect(
+      registry.supports('ephemeral-1', PeerCapabilities.compactRelayPath),
+      isFalse,
+    );
+    expect(registry.allSupport(const [], PeerCapabilities.local), isFalse);
+  });
+
+  test('capabilities follow the peer from ephemeral to persistent ID', () {
+    registry.record('ephemeral-1', PeerCapabilities.local);
+    registry.record('ephemeral-2', 0);
+    registry.alias('persistent-1', 'ephemeral-1');
+
+    expect(
+      registry.supports('persistent-1', PeerCapabilities.compactRelayPath),
+      isTrue,
+    );
+    expect(
+      registry.allSupport([
+        'ephemeral-1',
+        'persistent-1',
+      ], PeerCapabilities.compactRelayPath),
+      isTrue,
+    );
+    expect(
+      registry.allSupport([
+        'ephemeral-1',
+        'ephemeral-2',
+      ], PeerCapabilities.compactRelayPath),
+      isFalse,
+    );
+    expect(
+      registry.supportsAny([
+        null,
+        'session-1',
+        'persistent-1',
+      ], PeerCapabilities.binaryQueueSync),
+      isTrue,
+    );
+    expect(
+      registry.supportsAny(['ephemeral-2'], PeerCapabilities.binaryQueueSync),
+      isFalse,
+    );
+  });
+
+  test('identity frames carry the mask and older ones read as none', () {
+    final current = ProtocolMessage.fromBytes(
+      ProtocolMessage.identity(
+        publicKey: 'ephemeral-1',
+        displayName: 'Ali',
+        capabilities: PeerCapabilities.local,
+      ).toBytes(),
+    );
+    final legacy = ProtocolMessage.identity(
+      publicKey: 'ephemeral-2',
+      displayName: 'Sana',
+    );
+
+    expect(current.identityCapabilities, PeerCapabilities.local);
+    expect(legacy.identityCapabilities, 0);
+    expect(legacy.payload.containsKey('caps'), isFalse);
+  });
+
+  test('bounded: the least recently recorded peer drops first', () {
+    for (var i = 0; i <= PeerCapabilityRegistry.maxTrackedPeers; i++) {
+      registry.record('peer-$i', PeerCapabilities.local);
+    }
+
+    expect(registry.capabilitiesOf('peer-0'), 0);
+    expect(
+      registry.capabilitiesOf('peer-${PeerCapabilityRegistry.maxTrackedPeers}'),
+      PeerCapabilities.local,
+    );
+  });
+}
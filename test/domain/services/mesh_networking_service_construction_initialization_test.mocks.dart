@@ -2346,6 +2346,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
     String? relayNodeId,
     String? messageHash,
     bool? persistToStorage = true,
+    bool? isOriginator = false,
   }) =>
       (super.noSuchMethod(
             Invocation.method(#queueMessage, [], {
@@ -2362,6 +2363,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
               #relayNodeId: relayNodeId,
               #messageHash: messageHash,
               #persistToStorage: persistToStorage,
+              #isOriginator: isOriginator,
             }),
             returnValue: _i13.Future<String>.value(
               _i20.dummyValue<String>(
@@ -2380,6 +2382,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -2400,6 +2403,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -2421,6 +2425,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
     String? relayNodeId,
     String? messageHash,
     bool? persistToStorage = true,
+    bool? isOriginator = false,
   }) =>
       (super.noSuchMethod(
             Invocation.method(#queueMessageWithIds, [], {
@@ -2437,6 +2442,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
               #relayNodeId: relayNodeId,
               #messageHash: messageHash,
               #persistToStorage: persistToStorage,
+              #isOriginator: isOriginator,
             }),
             returnValue: _i13.Future<_i11.MessageId>.value(
               _FakeMessageId_15(
@@ -2455,6 +2461,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
@@ -2475,6 +2482,7 @@ class MockOfflineMessageQueueContract extends _i1.Mock
                   #relayNodeId: relayNodeId,
                   #messageHash: messageHash,
                   #persistToStorage: persistToStorage,
+                  #isOriginator: isOriginator,
                 }),
               ),
             ),
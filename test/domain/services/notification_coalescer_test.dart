@@ -0,0 +1,104 @@
+import 'package:fake_async/fake_async.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/entities/message.dart';
+import 'package:pak_connect/domain/interfaces/i_notification_handler.dart';
+import 'package:pak_connect/domain/services/notification_coalescer.dart';
+import 'package:pak_connect/domain/values/id_types.dart';
+
+Message _message(String chat, int n) => Message(
+  id: MessageId('$chat-$n'),
+  chatId: ChatId(chat),
+  content: 'line $n',
+  timestamp: DateTime(2026, 1, 1, 12, 0, n),
+  isFromMe: false,
+  status: MessageStatus.delivered,
+);
+
+void main() {
+  late List<MessageNotificationDigest> posted;
+
+  NotificationCoalescer coalescer(FakeAsync async) => NotificationCoalescer(
+    post: (digest) async => posted.add(digest),
+    now: async.getClock(DateTime(2026)).now,
+  );
+
+  setUp(() => posted = []);
+
+  test('posts the first message at once and collapses the burst', () {
+    fakeAsync((async) {
+      final sut = coalescer(async);
+
+      for (var i = 0; i < 200; i++) {
+        sut.add(message: _message('a', i), contactName: 'Alice');
+      }
+      async.flushMicrotasks();
+      expect(posted, hasLength(1));
+      expect(posted.single.messageCount, 1);
+
+      async.elapse(NotificationCoalescer.defaultWindow);
+      expect(posted, hasLength(2));
+      final digest = posted.last;
+      expect(digest.messageCount, 200);
+      expect(
+        digest.recentMessages.map((m) => m.content),
+        ['line 195', 'line 196', 'line 197', 'line 198', 'line 199'],
+      );
+      expect(digest.notificationId, 'chat_a');
+
+      // A quiet window closes, but the unread count and lines keep running:
+      // the next message posts at once and replaces the same notification.
+      async.elapse(NotificationCoalescer.defaultWindow * 2);
+      expect(sut.activeChats, 0);
+      expect(sut.trackedChats, 1);
+      sut.add(message: _message('a', 300), contactName: 'Alice');
+      async.flushMicrotasks();
+      expect(posted, hasLength(3));
+      expect(posted.last.messageCount, 201);
+      expect(
+        posted.last.recentMessages.map((m) => m.content),
+        ['line 196', 'line 197', 'line 198', 'line 199', 'line 300'],
+      );
+
+      // Opening the chat resets it.
+      sut.clearChat(const ChatId('a'));
+      async.elapse(NotificationCoalescer.defaultWindow * 2);
+      sut.add(message: _message('a', 301), contactName: 'Alice');
+      async.flushMicrotasks();
+      expect(posted.last.messageCount, 1);
+    });
+  });
+
+  test('spaces posts across chats by the global minimum interval', () {
+    fakeAsync((async) {
+      final sut = coalescer(async);
+
+      for (final chat in ['a', 'b', 'c']) {
+        sut.add(message: _message(chat, 0), contactName: chat);
+      }
+      async.flushMicrotasks();
+      expect(posted.map((d) => d.latest.chatId.value), ['a']);
+
+      async.elapse(NotificationCoalescer.defaultMinInterval);
+      expect(posted.map((d) => d.latest.chatId.value), ['a', 'b']);
+
+      async.elapse(NotificationCoalescer.defaultMinInterval);
+      expect(posted.map((d) => d.latest.chatId.value), ['a', 'b', 'c']);
+    });
+  });
+
+  test('clearChat drops buffered messages', () {
+    fakeAsync((async) {
+      final sut = coalescer(async);
+
+      sut
+        ..add(message: _message('a', 0), contactName: 'Alice')
+        ..add(message: _message('a', 1), contactName: 'Alice')
+        ..clearChat(const ChatId('a'));
+      async.elapse(NotificationCoalescer.defaultWindow * 2);
+
+      expect(posted, hasLength(1));
+      expect(sut.activeChats, 0);
+      expect(sut.trackedChats, 0);
+    });
+  });
+}
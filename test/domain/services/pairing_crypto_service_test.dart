@@ -1,3 +1,5 @@
+import 'dart:async';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:logging/logging.dart';
 import 'package:pointycastle/export.dart';
@@ -8,9 +10,11 @@ import 'package:pak_connect/domain/services/simple_crypto.dart';
 class _FakeContactRepository extends Fake implements IContactRepository {
   final Map<String, String> cachedSecrets = <String, String>{};
   final List<String> clearedSecretIds = <String>[];
+  Completer<void>? writeGate;
 
   @override
   Future<void> cacheSharedSecret(String publicKey, String sharedSecret) async {
+    await writeGate?.future;
     cachedSecrets[publicKey] = sharedSecret;
   }
 
@@ -81,6 +85,25 @@ void main() {
     expect(service.hasConversationKey('alternate-pk'), isTrue);
   });
 
+  test('cacheSharedSecret opens lanes before storage writes finish', () async {
+    final gate = Completer<void>();
+    contactRepository.writeGate = gate;
+
+    final pending = service.cacheSharedSecret(
+      contactId: 'contact-pk',
+      alternateSessionId: 'alternate-pk',
+      sharedSecret: 'shared-secret',
+    );
+
+    expect(service.hasConversationKey('contact-pk'), isTrue);
+    expect(service.hasConversationKey('alternate-pk'), isTrue);
+    expect(contactRepository.cachedSecrets, isEmpty);
+
+    gate.complete();
+    await pending;
+    expect(contactRepository.cachedSecrets, hasLength(2));
+  });
+
   test(
     'restoreConversationFromCachedSecret restores cached runtime lane',
     () async {
@@ -0,0 +1,76 @@
+import 'package:flutter_test/flutter_test.dart';
+import 'package:logging/logging.dart';
+import 'package:pak_connect/domain/services/mesh/mesh_metrics_history.dart';
+import 'package:pak_connect/domain/services/pairing_latency_tracker.dart';
+
+void main() {
+  Logger.root.level = Level.OFF;
+
+  final now = DateTime.utc(2025, 3, 1, 14);
+
+  test('records the total and counts runs over budget', () async {
+    final history = MeshMetricsHistory();
+    final tracker = PairingLatencyTracker(
+      budget: const Duration(milliseconds: 5),
+      history: history,
+    );
+
+    tracker
+      ..start()
+      ..mark(PairingStage.verified);
+    await Future<void>.delayed(const Duration(milliseconds: 10));
+    tracker
+      ..mark(PairingStage.keysSent)
+      ..mark(PairingStage.keysSent);
+    final total = tracker.finish(now: now)!;
+
+    expect(total, greaterThanOrEqualTo(const Duration(milliseconds: 10)));
+    expect(tracker.marks.keys, [
+      PairingStage.codeEntered,
+      PairingStage.verified,
+      PairingStage.keysSent,
+    ]);
+    expect(
+      tracker.marks[PairingStage.keysSent],
+      greaterThan(tracker.marks[PairingStage.verified]!),
+    );
+
+    final latency = history.query(
+      MeshMetricsHistory.pairingLatencyMs,
+      MetricRollup.oneMinute,
+      now: now,
+    );
+    expect(latency.single.count, 1);
+    expect(
+      history.total(
+        MeshMetricsHistory.pairingOverBudget,
+        const Duration(hours: 1),
+        now: now,
+      ),
+      1,
+    );
+  });
+
+  test('abandoned or unstarted runs record nothing', () {
+    final history = MeshMetricsHistory();
+    final tracker = PairingLatencyTracker(history: history);
+
+    tracker.mark(PairingStage.verified);
+    expect(tracker.finish(now: now), isNull);
+
+    tracker
+      ..start()
+      ..abandon();
+    expect(tracker.isRunning, isFalse);
+    expect(tracker.marks, isEmpty);
+    expect(tracker.finish(now: now), isNull);
+    expect(
+      history.query(
+        MeshMetricsHistory.pairingLatencyMs,
+        MetricRollup.oneMinute,
+        now: now,
+      ),
+      isEmpty,
+    );
+  });
+}
@@ -0,0 +1,123 @@
+import 'package:fake_async/fake_async.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/services/search_session.dart';
+
+const _corpus = [
+  ['hello world', 'help me'],
+  ['hello again', 'shell'],
+  ['yellow', 'hello there'],
+];
+
+/// Source yielding one page per corpus chunk, recording how far it got
+class _Source {
+  final List<String> queries = [];
+  int chunksRead = 0;
+
+  Stream<List<String>> call(String query, SearchCancelToken token) async* {
+    queries.add(query);
+    for (final chunk in _corpus) {
+      await Future<void>.delayed(const Duration(milliseconds: 10));
+      if (token.isCancelled) return;
+      chunksRead++;
+      yield chunk.where((text) => text.contains(query)).toList();
+    }
+  }
+}
+
+void main() {
+  test('debounces keystrokes and streams pages for the last query', () {
+    fakeAsync((async) {
+      final source = _Source();
+      final session = SearchSession<String>(source: source.call);
+      final pages = <SearchPage<String>>[];
+      session.pages.listen(pages.add);
+
+      session
+        ..update('h')
+        ..update('he')
+        ..update('hel');
+      async.elapse(const Duration(milliseconds: 400));
+
+      expect(source.queries, ['hel']);
+      expect(pages.map((p) => p.results.length), [2, 4, 5, 5]);
+      expect(pages.last.isComplete, isTrue);
+      expect(pages.last.results, contains('hello there'));
+    });
+  });
+
+  test('a new query cancels the running one before it finishes', () {
+    fakeAsync((async) {
+      final source = _Source();
+      final session = SearchSession<String>(
+        source: source.call,
+        debounce: Duration.zero,
+      );
+      final pages = <SearchPage<String>>[];
+      session.pages.listen(pages.add);
+
+      session.update('hello');
+      async.elapse(const Duration(milliseconds: 15));
+      session.update('yellow');
+      async.elapse(const Duration(milliseconds: 100));
+
+      // 'hello' read one chunk before being cancelled; 'yellow' read all.
+      expect(source.chunksRead, 1 + _corpus.length);
+      expect(
+        pages.where((p) => p.isComplete).map((p) => p.query),
+        ['yellow'],
+      );
+    });
+  });
+
+  test('extending a completed query narrows results in memory', () {
+    fakeAsync((async) {
+      final source = _Source();
+      final session = SearchSession<String>(
+        source: source.call,
+        matches: (text, query) => text.contains(query),
+        debounce: Duration.zero,
+      );
+
+      session.update('hel');
+      async.elapse(const Duration(milliseconds: 100));
+      session.update('hello');
+
+      expect(source.queries, ['hel']);
+      expect(session.current!.query, 'hello');
+      expect(session.current!.results, [
+        'hello world',
+        'hello again',
+        'hello there',
+      ]);
+
+      // Filters changed: results can no longer be reused.
+      session.restart();
+      async.elapse(const Duration(milliseconds: 100));
+      expect(source.queries, ['hel', 'hello']);
+    });
+  });
+
+  test('stops the source once the result cap is reached', () {
+    fakeAsync((async) {
+      final source = _Source();
+      final session = SearchSession<String>(
+        source: source.call,
+        matches: (text, query) => text.contains(query),
+        debounce: Duration.zero,
+        maxResults: 3,
+      );
+
+      session.update('l');
+      async.elapse(const Duration(milliseconds: 100));
+
+      expect(session.current!.results, hasLength(3));
+      expect(session.current!.hasMore, isTrue);
+      expect(source.chunksRead, 2);
+
+      // A capped result is not a complete superset, so it is not reused.
+      session.update('ll');
+      async.elapse(const Duration(milliseconds: 100));
+      expect(source.queries, ['l', 'll']);
+    });
+  });
+}
@@ -0,0 +1,92 @@
+import 'package:fake_async/fake_async.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/services/typed_event_bus.dart';
+
+void main() {
+  test('sync subscribers see every event inline, in order', () {
+    final bus = TypedEventBus();
+    final channel = bus.register<int>('numbers');
+    final seen = <int>[];
+    final subscription = channel.listen(seen.add);
+
+    channel
+      ..emit(1)
+      ..emit(2);
+    expect(seen, [1, 2]);
+
+    subscription.cancel();
+    channel.emit(3);
+    expect(seen, [1, 2]);
+    expect(channel.stats.emitted, 3);
+    expect(channel.stats.delivered, 2);
+    expect(channel.hasSubscribers, isFalse);
+  });
+
+  test('frame subscribers get one batch with same-key events collapsed', () {
+    fakeAsync((async) {
+      final bus = TypedEventBus();
+      final channel = bus.register<(String, int)>('presence');
+      final seen = <(String, int)>[];
+      channel.listen(
+        seen.add,
+        delivery: EventDelivery.frame,
+        keyOf: (event) => event.$1,
+      );
+
+      channel
+        ..emit(('a', 1))
+        ..emit(('b', 1))
+        ..emit(('a', 2))
+        ..emit(('a', 3));
+      expect(seen, isEmpty);
+
+      async.elapse(TypedEventBus.defaultFrameInterval);
+      expect(seen, [('b', 1), ('a', 3)]);
+      expect(channel.stats.coalesced, 2);
+    });
+  });
+
+  test('a collapsed key is delivered in its latest position', () {
+    fakeAsync((async) {
+      final bus = TypedEventBus();
+      final channel = bus.register<String>('link');
+      final seen = <String>[];
+      channel.listen(
+        seen.add,
+        delivery: EventDelivery.frame,
+        keyOf: (state) => state == 'disconnected' ? 'down' : 'up',
+      );
+
+      channel
+        ..emit('connected')
+        ..emit('disconnected')
+        ..emit('connected');
+      async.elapse(TypedEventBus.defaultFrameInterval);
+
+      expect(seen, ['disconnected', 'connected']);
+    });
+  });
+
+  test('a throwing subscriber does not stop delivery to the rest', () {
+    final bus = TypedEventBus();
+    final channel = bus.register<String>('hints');
+    final seen = <String>[];
+    channel
+      ..listen((_) => throw StateError('boom'))
+      ..listen(seen.add);
+
+    channel.emit('hint');
+
+    expect(seen, ['hint']);
+    expect(channel.stats.delivered, 1);
+  });
+
+  test('channels are registered once and looked up by type', () {
+    final bus = TypedEventBus()..register<int>('numbers');
+
+    expect(() => bus.register<int>('numbers'), throwsStateError);
+    expect(bus.channel<int>('numbers').name, 'numbers');
+    expect(() => bus.channel<int>('missing'), throwsStateError);
+    expect(bus.stats.keys, ['numbers']);
+  });
+}
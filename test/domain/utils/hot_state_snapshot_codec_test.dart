@@ -0,0 +1,99 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/utils/hot_state_snapshot_codec.dart';
+
+void main() {
+  group('HotStateSnapshotCodec', () {
+    final writtenAt = DateTime.fromMillisecondsSinceEpoch(1700000000000);
+
+    Uint8List encodeTwoSections() => HotStateSnapshotCodec.encode([
+      HotStateSection(
+        tag: 1,
+        version: 2,
+        payload: Uint8List.fromList([1, 2, 3]),
+      ),
+      HotStateSection(
+        tag: 7,
+        version: 1,
+        payload: Uint8List.fromList(utf8.encode('topology')),
+      ),
+    ], writtenAt: writtenAt);
+
+    test('round-trips sections and header', () {
+      final snapshot = HotStateSnapshotCodec.decode(encodeTwoSections())!;
+
+      expect(snapshot.writtenAt, writtenAt);
+      expect(snapshot.tags, unorderedEquals([1, 7]));
+      expect(snapshot.section(1, version: 2), [1, 2, 3]);
+      expect(utf8.decode(snapshot.section(7, version: 1)!), 'topology');
+    });
+
+    test('rejects a section with a different version', () {
+      final snapshot = HotStateSnapshotCodec.decode(encodeTwoSections())!;
+
+      expect(snapshot.section(1, version: 3), isNull);
+      expect(snapshot.section(99, version: 1), isNull);
+    });
+
+    test('corrupt payload only invalidates its own section', () {
+      final bytes = encodeTwoSections();
+      // First payload starts after the 16-byte header and 12-byte section
+      // header.
+      bytes[16 + 12] ^= 0xFF;
+
+      final snapshot = HotStateSnapshotCodec.decode(bytes)!;
+
+      expect(snapshot.section(1, version: 2), isNull);
+      expect(snapshot.section(7, version: 1), isNotNull);
+    });
+
+    test('returns null for bad magic, format version or truncation', () {
+      final badMagic = encodeTwoSections()..[0] = 0;
+      final badFormat = encodeTwoSections()..[5] = 99;
+      final full = encodeTwoSections();
+      final truncated = Uint8List.sublistView(full, 0, full.length - 2);
+
+      expect(HotStateSnapshotCodec.decode(badMagic), isNull);
+      expect(HotStateSnapshotCodec.decode(badFormat), isNull);
+      expect(HotStateSnapshotCodec.decode(truncated), isNull);
+      expect(HotStateSnapshotCodec.decode(Uint8List(3)), isNull);
+    });
+
+    test('crc32 matches the IEEE check value', () {
+      expect(
+        HotStateSnapshotCodec.crc32(
+          Uint8List.fromList(ascii.encode('123456789')),
+        ),
+        0xCBF43926,
+      );
+    });
+  });
+
+  group('HotStateWriter / HotStateReader', () {
+    test('round-trips primitive fields', () {
+      final writer = HotStateWriter()
+        ..u8(200)
+        ..u16(65000)
+        ..u32(4000000000)
+        ..i64(-1234567890123)
+        ..string('héllo');
+
+      final reader = HotStateReader(writer.takeBytes());
+
+      expect(reader.u8(), 200);
+      expect(reader.u16(), 65000);
+      expect(reader.u32(), 4000000000);
+      expect(reader.i64(), -1234567890123);
+      expect(reader.string(), 'héllo');
+      expect(reader.isAtEnd, isTrue);
+    });
+
+    test('throws on overrun', () {
+      final reader = HotStateReader(Uint8List.fromList([0, 5, 65]));
+
+      expect(reader.string, throwsRangeError);
+    });
+  });
+}
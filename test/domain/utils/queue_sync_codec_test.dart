@@ -0,0 +1,143 @@
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:flutter_test/flutter_test.dart';
+import 'package:pak_connect/domain/models/mesh_relay_models.dart';
+import 'package:pak_connect/domain/models/message_id_digests.dart';
+import 'package:pak_connect/domain/models/protocol_message.dart';
+import 'package:pak_connect/domain/utils/gcs_filter.dart';
+import 'package:pak_connect/domain/utils/queue_sync_codec.dart';
+
+List<String> _messageIds(int count) => List.generate(
+  count,
+  (i) => '2.$i.${i.toRadixString(16).padLeft(32, 'a')}',
+);
+
+QueueSyncMessage _request(List<String> ids) => QueueSyncMessage.createRequest(
+  messageIds: ids,
+  nodeId: List.filled(64, 'c').join(),
+  gcsFilter: GCSFilter.buildFilter(
+    ids: ids.map((id) => Uint8List.fromList(utf8.encode(id))).toList(),
+    maxBytes: 512,
+    targetFpr: 0.01,
+  ),
+);
+
+void main() {
+  group('QueueSyncCodec', () {
+    test('round-trips every section', () {
+      final ids = _messageIds(40);
+      final message = QueueSyncMessage(
+        queueHash: List.filled(64, 'f').join(),
+        messageIds: ids,
+        syncTimestamp: DateTime.fromMillisecondsSinceEpoch(1700000000123),
+        nodeId: 'node-abc',
+        syncType: QueueSyncType.response,
+        queueStats: QueueSyncStats(
+          totalMessages: 40,
+          pendingMessages: 3,
+          failedMessages: 1,
+          lastSyncTime: DateTime.fromMillisecondsSinceEpoch(1699999999000),
+          successRate: 0.925,
+        ),
+        gcsFilter: _request(ids).gcsFilter,
+      );
+
+      final decoded = QueueSyncCodec.decode(QueueSyncCodec.encode(message));
+
+      expect(decoded.queueHash, message.queueHash);
+      expect(decoded.nodeId, 'node-abc');
+      expect(decoded.syncType, QueueSyncType.response);
+      expect(decoded.syncTimestamp, message.syncTimestamp);
+      expect(decoded.queueStats!.pendingMessages, 3);
+      expect(decoded.queueStats!.successRate, 0.925);
+      expect(decoded.gcsFilter!.p, message.gcsFilter!.p);
+      expect(decoded.gcsFilter!.m, message.gcsFilter!.m);
+      expect(decoded.gcsFilter!.data, message.gcsFilter!.data);
+      expect(decoded.messageIds, isEmpty);
+      expect(decoded.messageCount, 40);
+      expect(ids.every(decoded.hasMessageId), isTrue);
+      expect(decoded.hasMessageId('2.999.unknown'), isFalse);
+    });
+
+    test('binary frame is far smaller than the JSON frame', () {
+      final message = _request(_messageIds(500));
+
+      final json = ProtocolMessage.queueSync(
+        queueMessage: message,
+      ).toBytes(enableCompression: false);
+      final binary = ProtocolMessage.queueSync(
+        queueMessage: message,
+        binary: true,
+      ).toBytes();
+
+      expect(binary.first, 0x02);
+      // 6-byte digests plus the raw filter vs ~50 bytes of text per ID.
+      expect(binary.length, lessThan(500 * 6 + 512 + 128));
+      expect(binary.length * 4, lessThan(json.length));
+    });
+
+    test('ProtocolMessage decodes binary frames and keeps the payload', () {
+      final ids = _messageIds(10);
+      final bytes = ProtocolMessage.queueSync(
+        queueMessage: _request(ids),
+        binary: true,
+      ).toBytes();
+
+      final decoded = ProtocolMessage.fromBytes(bytes);
+
+      expect(decoded.type, ProtocolMessageType.queueSync);
+      expect(decoded.queueSyncMessage!.messageCount, 10);
+      expect(decoded.queueSyncMessage!.gcsFilter, isNotNull);
+      expect(decoded.payload['nodeId'], List.filled(64, 'c').join());
+      expect(decoded.payload['queueHash'], isNotEmpty);
+    });
+
+    test('rejects truncated frames', () {
+      final bytes = QueueSyncCodec.encode(_request(_messageIds(20)));
+
+      expect(
+        () => QueueSyncCodec.decode(Uint8List.sublistView(bytes, 0, 30)),
+        throwsFormatException,
+      );
+    });
+  });
+
+  group('digest-only sync frames', () {
+    test('resolve against local IDs for excess and missing detection', () {
+      final peerIds = _messageIds(6);
+      final decoded = QueueSyncCodec.decode(
+        QueueSyncCodec.encode(_request(peerIds)),
+      );
+      final localIds = [...peerIds.take(4), 'local-only'];
+
+      expect(decoded.knownMessageIds(localIds), peerIds.take(4).toList());
+      // Digests cannot name what we lack; only the count is known.
+      expect(decoded.unknownMessageIds(localIds), isEmpty);
+      expect(decoded.unknownMessageCount(localIds), 2);
+      expect(decoded.getMissingMessages(localIds), ['local-only']);
+    });
+
+    test('digests start narrow and stay distinct', () {
+      final digests = MessageIdDigests.fromMessageIds([
+        ..._messageIds(1000),
+        ..._messageIds(10),
+      ]);
+
+      expect(digests.width, MessageIdDigests.widths.first);
+      expect(digests.length, 1000);
+      expect(digests.toPacked(), hasLength(1000 * digests.width));
+    });
+  });
+
+  test('GCS params serialize the bitstream as base64 and read legacy arrays', () {
+    final filter = _request(_messageIds(30)).gcsFilter!;
+
+    final json = filter.toJson();
+    expect(json['data'], isA<String>());
+    expect(GCSFilterParams.fromJson(json).data, filter.data);
+
+    final legacy = {'p': filter.p, 'm': filter.m, 'data': filter.data.toList()};
+    expect(GCSFilterParams.fromJson(legacy).data, filter.data);
+  });
+}
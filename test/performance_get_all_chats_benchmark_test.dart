@@ -9,7 +9,7 @@ library;
 import 'package:flutter/foundation.dart' show debugPrint;
 import 'package:flutter_test/flutter_test.dart';
 import 'package:logging/logging.dart';
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
 import 'package:pak_connect/data/repositories/chats_repository.dart';
 import 'package:pak_connect/data/repositories/contact_repository.dart';
 import 'package:pak_connect/data/repositories/message_repository.dart';
@@ -44,8 +44,10 @@ void main() {
       // Set up UserPreferences with a test public key
       // This is needed for getAllChats() to work properly
       const myPublicKey = 'mykey';
-      final storage = FlutterSecureStorage();
-      await storage.write(key: 'ecdh_public_key_v2', value: myPublicKey);
+      await SecureStorageVault.instance.write(
+        'ecdh_public_key_v2',
+        myPublicKey,
+      );
 
       chatsRepo = ChatsRepository();
       contactRepo = ContactRepository();
@@ -1,5 +1,6 @@
 import 'package:flutter_test/flutter_test.dart';
 import 'package:pak_connect/domain/entities/chat_list_item.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/values/id_types.dart';
 import 'package:pak_connect/presentation/controllers/chat_list_controller.dart';
 
@@ -156,5 +157,78 @@ void main() {
 
       expect(result.map((chat) => chat.chatId.value), ['inserted', 'existing']);
     });
+
+    test('applyDiff leaves rows past a partial page unloaded', () {
+      final newer = _chat(
+        id: 'newer',
+        isOnline: false,
+        lastMessageTime: DateTime(2026, 1, 3),
+      );
+      final older = _chat(
+        id: 'older',
+        isOnline: false,
+        lastMessageTime: DateTime(2026, 1, 2),
+      );
+      final stale = _chat(
+        id: 'stale',
+        isOnline: false,
+        lastMessageTime: DateTime(2025),
+      );
+
+      expect(
+        controller.applyDiff(
+          existing: [newer, older],
+          diff: ChatRowInserted(5, stale),
+          hasMore: true,
+        ),
+        isNull,
+      );
+      final moved = controller.applyDiff(
+        existing: [newer, older],
+        diff: ChatRowMoved(
+          0,
+          5,
+          _chat(id: 'newer', isOnline: false, lastMessageTime: null),
+        ),
+        hasMore: true,
+      );
+      expect(moved!.map((chat) => chat.chatId.value), ['older']);
+    });
+
+    test('applyDiff only patches rows already in search results', () {
+      final match = _chat(
+        id: 'match',
+        isOnline: false,
+        lastMessageTime: DateTime(2026, 1, 1),
+      );
+      final other = _chat(
+        id: 'other',
+        isOnline: true,
+        lastMessageTime: DateTime(2026, 1, 2),
+      );
+
+      expect(
+        controller.applyDiff(
+          existing: [match],
+          diff: ChatRowInserted(0, other),
+          isSearching: true,
+        ),
+        isNull,
+      );
+      expect(
+        controller.applyDiff(
+          existing: [match],
+          diff: ChatListReset([other, match]),
+          isSearching: true,
+        ),
+        isNull,
+      );
+      final updated = controller.applyDiff(
+        existing: [match],
+        diff: ChatRowUpdated(1, match.copyWith(unreadCount: 2)),
+        isSearching: true,
+      );
+      expect(updated!.single.unreadCount, 2);
+    });
   });
 }
@@ -26,6 +26,7 @@ import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
 import 'package:pak_connect/domain/models/binary_payload.dart';
 import 'package:pak_connect/domain/models/ble_server_connection.dart';
 import 'package:pak_connect/domain/models/bluetooth_state_models.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/connection_status.dart';
 import 'package:pak_connect/domain/models/mesh_relay_models.dart';
@@ -141,6 +142,9 @@ class _Facade implements IHomeScreenFacade {
  @override
  Stream<int> get unreadCountStream => const Stream.empty();
 
+ @override
+ Stream<ChatListDiff> get chatListChanges => const Stream.empty();
+
  @override
  Future<void> initialize() async => initializeCalls++;
  @override
@@ -570,9 +574,10 @@ void main() {
 
  // -----------------------------------------------------------------------
  // _setupGlobalMessageListener — covers lines 271-283
- // receivedMessages stream triggers updateSingleChatItem
+ // receivedMessages only refreshes the unread count; rows come from the
+ // facade's change feed
  // -----------------------------------------------------------------------
- testWidgets('global message listener triggers chat update', (tester,
+ testWidgets('global message listener does not re-query chats', (tester,
 ) async {
  repo.queueResponse([_item(id: 'gm1', name: 'GlobalMsg')]);
  final cs = _FakeConnectionService();
@@ -582,13 +587,12 @@ void main() {
  await ctrl.initialize();
  await tester.pump(const Duration(milliseconds: 50));
 
- // Enqueue response for the chat update triggered by the listener
- repo.queueResponse([_item(id: 'gm1', name: 'GlobalMsg Updated')]);
+ final callsBefore = repo.getAllChatsCallCount;
  cs.receivedMessagesCtrl.add('incoming-msg');
  await tester.pump(const Duration(milliseconds: 100));
 
- // The listener should have called updateSingleChatItem
- expect(repo.getAllChatsCallCount, greaterThanOrEqualTo(2));
+ expect(repo.getAllChatsCallCount, callsBefore);
+ expect(ctrl.unreadCountStream, isNotNull);
 
  ctrl.dispose();
  cs.dispose();
@@ -10,6 +10,7 @@ import 'package:pak_connect/domain/entities/chat_list_item.dart';
 import 'package:pak_connect/domain/entities/contact.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/connection_status.dart';
 import 'package:pak_connect/domain/services/chat_management_service.dart';
@@ -145,6 +146,9 @@ class _FakeHomeScreenFacade implements IHomeScreenFacade {
   @override
   Stream<int> get unreadCountStream => const Stream<int>.empty();
 
+  @override
+  Stream<ChatListDiff> get chatListChanges => const Stream.empty();
+
   @override
   Future<void> archiveChat(ChatListItem chat) async {
     archiveCalls++;
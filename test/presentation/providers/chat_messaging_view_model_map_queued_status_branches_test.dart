@@ -654,6 +654,7 @@ class _FakeOfflineQueue implements OfflineMessageQueueContract {
  String? relayNodeId,
  String? messageHash,
  bool persistToStorage = true,
+ bool isOriginator = false,
  }) async {
  queueMessageCalls++;
  lastRecipientKey = recipientPublicKey;
@@ -9,6 +9,7 @@ import 'package:pak_connect/domain/interfaces/i_chat_interaction_handler.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade_factory.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/models/connection_status.dart';
 import 'package:pak_connect/domain/services/chat_management_service.dart';
 import 'package:pak_connect/presentation/controllers/chat_list_controller.dart';
@@ -78,6 +79,9 @@ class _FakeHomeScreenFacade extends Fake implements IHomeScreenFacade {
   @override
   Stream<int> get unreadCountStream => _unreadController.stream;
 
+  @override
+  Stream<ChatListDiff> get chatListChanges => const Stream.empty();
+
   @override
   Stream<ConnectionStatus> get connectionStatusStream =>
       _connectionController.stream;
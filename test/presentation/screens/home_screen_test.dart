@@ -9,6 +9,7 @@ import 'package:pak_connect/domain/entities/queued_message.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
 import 'package:pak_connect/domain/interfaces/i_mesh_networking_service.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/connection_status.dart';
 import 'package:pak_connect/domain/models/mesh_network_models.dart';
@@ -84,6 +85,9 @@ class _FakeHomeScreenFacade extends Fake implements IHomeScreenFacade {
   @override
   Stream<int> get unreadCountStream => _unreadController.stream;
 
+  @override
+  Stream<ChatListDiff> get chatListChanges => const Stream.empty();
+
   @override
   Stream<ConnectionStatus> get connectionStatusStream =>
       const Stream<ConnectionStatus>.empty();
@@ -7,6 +7,7 @@ import 'package:flutter_test/flutter_test.dart';
 import 'package:pak_connect/domain/entities/chat_list_item.dart';
 import 'package:pak_connect/domain/interfaces/i_chats_repository.dart';
 import 'package:pak_connect/domain/interfaces/i_home_screen_facade.dart';
+import 'package:pak_connect/domain/models/chat_list_model.dart';
 import 'package:pak_connect/domain/models/connection_info.dart';
 import 'package:pak_connect/domain/models/connection_status.dart';
 import 'package:pak_connect/domain/services/chat_management_service.dart';
@@ -84,6 +85,8 @@ class _FakeHomeScreenFacade extends Fake implements IHomeScreenFacade {
       StreamController<int>.broadcast();
   final StreamController<ConnectionStatus> _connectionStatusController =
       StreamController<ConnectionStatus>.broadcast();
+  final StreamController<ChatListDiff> diffController =
+      StreamController<ChatListDiff>.broadcast();
   bool _closed = false;
 
   @override
@@ -94,6 +97,9 @@ class _FakeHomeScreenFacade extends Fake implements IHomeScreenFacade {
   @override
   Stream<int> get unreadCountStream => _unreadController.stream;
 
+  @override
+  Stream<ChatListDiff> get chatListChanges => diffController.stream;
+
   @override
   Stream<ConnectionStatus> get connectionStatusStream =>
       _connectionStatusController.stream;
@@ -198,6 +204,7 @@ class _FakeHomeScreenFacade extends Fake implements IHomeScreenFacade {
     _closed = true;
     await _unreadController.close();
     await _connectionStatusController.close();
+    await diffController.close();
   }
 }
 
@@ -431,6 +438,38 @@ void main() {
       },
     );
 
+    testWidgets('change feed diffs patch rows without re-querying', (
+      tester,
+    ) async {
+      final repository = _FakeChatsRepository()
+        ..scriptedResponses.add(<ChatListItem>[
+          _chat(id: 'a', time: DateTime(2026, 1, 3)),
+          _chat(id: 'b', time: DateTime(2026, 1, 2)),
+        ]);
+      final managementService = _FakeChatManagementService();
+      final facade = _FakeHomeScreenFacade();
+
+      final harness = await _buildHarness(
+        tester,
+        chatsRepository: repository,
+        managementService: managementService,
+        facade: facade,
+      );
+      final calls = repository.getAllChatsCalls;
+
+      facade.diffController
+        ..add(ChatRowMoved(1, 0, _chat(id: 'b', time: DateTime(2026, 1, 4))))
+        ..add(ChatRowInserted(2, _chat(id: 'c', time: DateTime(2026))));
+      await _settleAsync(tester);
+
+      expect(_state(harness).chats.map((c) => c.chatId.value), [
+        'b',
+        'a',
+        'c',
+      ]);
+      expect(repository.getAllChatsCalls, calls);
+    });
+
     testWidgets('loadMoreChats paginates and clears paging flag', (
       tester,
     ) async {
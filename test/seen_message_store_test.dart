@@ -1,6 +1,9 @@
+import 'dart:io';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:logging/logging.dart';
 import 'package:pak_connect/data/database/database_helper.dart';
+import 'package:pak_connect/data/services/hot_state_snapshot_store.dart';
 import 'package:pak_connect/data/services/seen_message_store.dart';
 import 'package:pak_connect/data/repositories/contact_repository.dart';
 
@@ -224,6 +227,65 @@ void main() {
       expect(store.hasDelivered('msg_1'), true);
     });
 
+    group('hot state snapshot', () {
+      late Directory snapshotDir;
+
+      setUp(() async {
+        snapshotDir = await Directory.systemTemp.createTemp('seen_snapshot');
+      });
+
+      tearDown(() async {
+        SeenMessageStore.clearSnapshotStore();
+        await snapshotDir.delete(recursive: true);
+      });
+
+      HotStateSnapshotStore configureSnapshots() {
+        final snapshots = HotStateSnapshotStore(
+          directoryResolver: () async => snapshotDir,
+        );
+        SeenMessageStore.configureSnapshotStore(snapshots);
+        return snapshots;
+      }
+
+      /// Fresh snapshot reader + uninitialized store, as after a restart.
+      Future<void> restart() async {
+        store.resetForTests();
+        configureSnapshots();
+        await store.initialize();
+      }
+
+      test('restores sets from the snapshot when the database matches',
+          () async {
+        await store.markDelivered('snap_delivered');
+        await store.markRead('snap_read');
+        await configureSnapshots().flush();
+
+        await restart();
+
+        expect(
+          logRecords.any((r) => r.message.contains('from snapshot')),
+          isTrue,
+        );
+        expect(store.hasDelivered('snap_delivered'), isTrue);
+        expect(store.hasRead('snap_read'), isTrue);
+      });
+
+      test('falls back to the database when the snapshot is stale', () async {
+        await store.markDelivered('before_snapshot');
+        await configureSnapshots().flush();
+        await store.markDelivered('after_snapshot');
+
+        await restart();
+
+        expect(
+          logRecords.any((r) => r.message.contains('snapshot is stale')),
+          isTrue,
+        );
+        expect(store.hasDelivered('before_snapshot'), isTrue);
+        expect(store.hasDelivered('after_snapshot'), isTrue);
+      });
+    });
+
     test('ignores empty message IDs gracefully', () async {
       await store.markDelivered('');
       expect(store.hasDelivered(''), false);
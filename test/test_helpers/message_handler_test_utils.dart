@@ -1,6 +1,6 @@
 import 'dart:typed_data';
 
-import 'package:flutter_secure_storage/flutter_secure_storage.dart';
+import 'package:pak_connect/data/database/secure_storage_vault.dart';
 import 'package:pak_connect/domain/models/protocol_message.dart';
 
 const _publicKeyStorageKey = 'ecdh_public_key_v2';
@@ -15,7 +15,9 @@ Uint8List protocolMessageToWireBytes(ProtocolMessage message) =>
 
 /// Seeds the in-memory secure storage with a deterministic public key so
 /// [UserPreferences.getPublicKey] returns the same identity the tests expect.
+///
+/// Writes through [SecureStorageVault] so reseeding mid-suite is not masked
+/// by entries it already cached.
 Future<void> seedTestUserPublicKey(String key) async {
-  final storage = FlutterSecureStorage();
-  await storage.write(key: _publicKeyStorageKey, value: key);
+  await SecureStorageVault.instance.write(_publicKeyStorageKey, key);
 }
@@ -87,6 +87,7 @@ class InMemoryOfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = 'msg_${_counter++}';
     final now = DateTime.now();
@@ -106,6 +107,7 @@ class InMemoryOfflineMessageQueue implements OfflineMessageQueueContract {
       originalMessageId: originalMessageId,
       relayNodeId: relayNodeId,
       messageHash: messageHash,
+      isOriginator: isOriginator,
     );
 
     _messagesById[id] = message;
@@ -136,6 +138,7 @@ class InMemoryOfflineMessageQueue implements OfflineMessageQueueContract {
     String? relayNodeId,
     String? messageHash,
     bool persistToStorage = true,
+    bool isOriginator = false,
   }) async {
     final id = await queueMessage(
       chatId: chatId.value,
@@ -151,6 +154,7 @@ class InMemoryOfflineMessageQueue implements OfflineMessageQueueContract {
       relayNodeId: relayNodeId,
       messageHash: messageHash,
       persistToStorage: persistToStorage,
+      isOriginator: isOriginator,
     );
     return MessageId(id);
   }